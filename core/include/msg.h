@@ -147,6 +147,22 @@
  * }
  * ~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * Lock-free message queues
+ * ========================
+ * By default, sending a message to a queue and receiving it disables
+ * interrupts for the whole operation. With `USEMODULE += core_msg_mpsc`,
+ * message queues become lock-free multi-producer, single-consumer queues:
+ * threads and ISRs reserve a queue slot with an atomic compare-and-swap,
+ * copy the message and publish it by setting its `sender_pid`, and the
+ * receiving thread takes it without disabling interrupts. Interrupts are
+ * still disabled briefly to wake up a receive-blocked thread, to block a
+ * sender on a full queue and, with `core_thread_flags`, to set
+ * @ref THREAD_FLAG_MSG_WAITING.
+ *
+ * A sender preempted between reserving and publishing a slot delays the
+ * messages queued behind it until it resumes. Messages from threads blocked on
+ * a full queue may overtake messages in such a delayed slot.
+ *
  * Timing & messages
  * =================
  * Timing out the reception of a message or sending messages at a certain time
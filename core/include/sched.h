@@ -276,6 +276,24 @@ typedef void (*sched_callback_t)(kernel_pid_t active, kernel_pid_t next);
  * @param[in] callback The callback functions that will be called
  */
 void sched_register_cb(sched_callback_t callback);
+
+/**
+ * @brief   Scheduler ready callback
+ *
+ * Called with interrupts disabled whenever a thread is added to a runqueue,
+ * i.e., it became ready to run.
+ *
+ * @param   pid         Pid of the thread that became ready
+ */
+typedef void (*sched_ready_callback_t)(kernel_pid_t pid);
+
+/**
+ * @brief  Register a callback that will be called whenever a thread becomes
+ *         ready to run
+ *
+ * @param[in] callback The callback functions that will be called
+ */
+void sched_register_ready_cb(sched_ready_callback_t callback);
 #endif /* MODULE_SCHED_CB */
 
 /**
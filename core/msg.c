@@ -33,6 +33,9 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#ifdef MODULE_TRACE_EVENTS
+#include "trace.h"
+#endif
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -61,6 +64,233 @@ static int queue_msg(thread_t *target, const msg_t *m)
     return 1;
 }
 
+#if MODULE_CORE_MSG_MPSC
+/* A queue slot is free if its sender_pid is KERNEL_PID_UNDEF. Producers
+ * reserve the slot at msg_queue.write_count by a CAS, copy the message and
+ * publish it by setting sender_pid last. The receiver takes the slot at
+ * msg_queue.read_count once it is published, clears it and only then
+ * advances read_count. */
+static int _mpsc_put(thread_t *target, const msg_t *m, kernel_pid_t sender)
+{
+    cib_t *q = &target->msg_queue;
+    unsigned w = __atomic_load_n(&q->write_count, __ATOMIC_RELAXED);
+
+    do {
+        if ((w - __atomic_load_n(&q->read_count, __ATOMIC_ACQUIRE)) > q->mask) {
+            DEBUG("_mpsc_put(): message queue is full\n");
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&q->write_count, &w, w + 1, true,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    msg_t *dest = &target->msg_array[w & q->mask];
+
+    dest->type = m->type;
+    dest->content = m->content;
+    __atomic_store_n(&dest->sender_pid, sender, __ATOMIC_RELEASE);
+    return 1;
+}
+
+static int _mpsc_get(thread_t *me, msg_t *m)
+{
+    cib_t *q = &me->msg_queue;
+    msg_t *src = &me->msg_array[q->read_count & q->mask];
+    kernel_pid_t sender = __atomic_load_n(&src->sender_pid, __ATOMIC_ACQUIRE);
+
+    if (sender == KERNEL_PID_UNDEF) {
+        /* empty, or the next slot is reserved but not yet published */
+        return 0;
+    }
+    m->type = src->type;
+    m->content = src->content;
+    m->sender_pid = sender;
+    __atomic_store_n(&src->sender_pid, KERNEL_PID_UNDEF, __ATOMIC_RELAXED);
+    __atomic_store_n(&q->read_count, q->read_count + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/* number of messages _mpsc_get() can return in a row: reserved slots only
+ * count once they and all slots before them are published */
+static int _mpsc_avail(thread_t *me)
+{
+    cib_t *q = &me->msg_queue;
+    unsigned r = q->read_count;
+    unsigned w = __atomic_load_n(&q->write_count, __ATOMIC_ACQUIRE);
+    int n = 0;
+
+    while ((r + n != w) &&
+           (__atomic_load_n(&me->msg_array[(r + n) & q->mask].sender_pid,
+                            __ATOMIC_ACQUIRE) != KERNEL_PID_UNDEF)) {
+        n++;
+    }
+    return n;
+}
+
+/* wakes up the receiver of a message just published, returns its priority
+ * if it has to be scheduled */
+static uint16_t _mpsc_wake(thread_t *target)
+{
+    uint16_t prio = THREAD_PRIORITY_IDLE;
+
+    /* the receiver checks for a message with IRQs disabled before blocking,
+     * so either it sees the message or we see it blocked */
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+#if !MODULE_CORE_THREAD_FLAGS
+    if (*((volatile thread_status_t *)&target->status) !=
+        STATUS_RECEIVE_BLOCKED) {
+        return prio;
+    }
+#endif
+
+    unsigned state = irq_disable();
+
+#if MODULE_CORE_THREAD_FLAGS
+    target->flags |= THREAD_FLAG_MSG_WAITING;
+    thread_flags_wake(target);
+#endif
+    if (target->status == STATUS_RECEIVE_BLOCKED) {
+        DEBUG("_mpsc_wake(): waking up %" PRIkernel_pid "\n", target->pid);
+        sched_set_status(target, STATUS_PENDING);
+        prio = target->priority;
+    }
+    irq_restore(state);
+
+    return prio;
+}
+
+static int _msg_send_mpsc(thread_t *target, msg_t *m, bool block,
+                          unsigned state)
+{
+    thread_t *me = thread_get_active();
+    /* a thread in msg_send_receive() is not on the run queue anymore, so
+     * it must not be preempted until its message is queued */
+    bool reply = (me->status == STATUS_REPLY_BLOCKED);
+
+    if (!reply) {
+        irq_restore(state);
+    }
+
+    while (!_mpsc_put(target, m, m->sender_pid)) {
+        if (!block) {
+            if (reply) {
+                irq_restore(state);
+            }
+            return 0;
+        }
+        if (!reply) {
+            state = irq_disable();
+        }
+        if (cib_full(&target->msg_queue)) {
+            DEBUG("msg_send: %" PRIkernel_pid ": queue full, going send "
+                  "blocked.\n", me->pid);
+            me->wait_data = m;
+            sched_set_status(me, reply ? STATUS_REPLY_BLOCKED
+                                       : STATUS_SEND_BLOCKED);
+            thread_add_to_list(&(target->msg_waiters), me);
+#if MODULE_CORE_THREAD_FLAGS
+            target->flags |= THREAD_FLAG_MSG_WAITING;
+            thread_flags_wake(target);
+#endif
+            irq_restore(state);
+            thread_yield_higher();
+            return 1;
+        }
+        /* the receiver took a message in the meantime */
+        if (!reply) {
+            irq_restore(state);
+        }
+    }
+
+    uint16_t prio = _mpsc_wake(target);
+
+    if (reply) {
+        irq_restore(state);
+        thread_yield_higher();
+    }
+    else if (prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(prio);
+    }
+    return 1;
+}
+
+/* makes room for the message of a send blocked thread in the queue */
+static void _mpsc_admit_waiter(thread_t *me)
+{
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned state = irq_disable();
+    list_node_t *next = me->msg_waiters.next;
+
+    if (next) {
+        thread_t *sender =
+            container_of((clist_node_t *)next, thread_t, rq_entry);
+        msg_t *sender_msg = (msg_t *)sender->wait_data;
+
+        if (_mpsc_put(me, sender_msg, sender_msg->sender_pid)) {
+            list_remove_head(&me->msg_waiters);
+            if (sender->status != STATUS_REPLY_BLOCKED) {
+                sender->wait_data = NULL;
+                sched_set_status(sender, STATUS_PENDING);
+                sender_prio = sender->priority;
+            }
+        }
+    }
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+}
+
+static int _msg_receive_mpsc(thread_t *me, msg_t *m, int block)
+{
+    while (1) {
+        if (_mpsc_get(me, m)) {
+            if (me->msg_waiters.next) {
+                _mpsc_admit_waiter(me);
+            }
+            return 1;
+        }
+
+        unsigned state = irq_disable();
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+
+        if (next) {
+            /* queue empty (or blocked by an unpublished slot) */
+            thread_t *sender =
+                container_of((clist_node_t *)next, thread_t, rq_entry);
+            uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+
+            *m = *((msg_t *)sender->wait_data);
+            if (sender->status != STATUS_REPLY_BLOCKED) {
+                sender->wait_data = NULL;
+                sched_set_status(sender, STATUS_PENDING);
+                sender_prio = sender->priority;
+            }
+            irq_restore(state);
+            if (sender_prio < THREAD_PRIORITY_IDLE) {
+                sched_switch(sender_prio);
+            }
+            return 1;
+        }
+        if (!block) {
+            irq_restore(state);
+            return -1;
+        }
+        if (__atomic_load_n(&me->msg_array[me->msg_queue.read_count &
+                                           me->msg_queue.mask].sender_pid,
+                            __ATOMIC_ACQUIRE) != KERNEL_PID_UNDEF) {
+            /* published before we disabled IRQs */
+            irq_restore(state);
+            continue;
+        }
+        DEBUG("_msg_receive(): %" PRIkernel_pid ": No msg in queue. Going "
+              "blocked.\n", me->pid);
+        sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+        irq_restore(state);
+        thread_yield_higher();
+    }
+}
+#endif /* MODULE_CORE_MSG_MPSC */
+
 int msg_send(msg_t *m, kernel_pid_t target_pid)
 {
     if (irq_is_in()) {
@@ -102,6 +332,16 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
         return -1;
     }
 
+#ifdef MODULE_TRACE_EVENTS
+    trace_event(TRACE_MSG_SEND, target_pid, m->type);
+#endif
+
+#if MODULE_CORE_MSG_MPSC
+    if (thread_has_msg_queue(target)) {
+        return _msg_send_mpsc(target, m, block, state);
+    }
+#endif
+
     thread_t *me = thread_get_active();
 
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
@@ -179,6 +419,19 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
 
 int msg_send_to_self(msg_t *m)
 {
+#ifdef MODULE_TRACE_EVENTS
+    trace_event(TRACE_MSG_SEND, thread_getpid(), m->type);
+#endif
+#if MODULE_CORE_MSG_MPSC
+    thread_t *me = thread_get_active();
+
+    m->sender_pid = me->pid;
+    if (!thread_has_msg_queue(me) || !_mpsc_put(me, m, m->sender_pid)) {
+        return 0;
+    }
+    _mpsc_wake(me);
+    return 1;
+#else
     unsigned state = irq_disable();
 
     m->sender_pid = thread_getpid();
@@ -186,6 +439,7 @@ int msg_send_to_self(msg_t *m)
 
     irq_restore(state);
     return res;
+#endif
 }
 
 static int _msg_send_oneway(msg_t *m, kernel_pid_t target_pid)
@@ -203,6 +457,22 @@ static int _msg_send_oneway(msg_t *m, kernel_pid_t target_pid)
         return -1;
     }
 
+#ifdef MODULE_TRACE_EVENTS
+    trace_event(TRACE_MSG_SEND, target_pid, m->type);
+#endif
+
+#if MODULE_CORE_MSG_MPSC
+    if (thread_has_msg_queue(target)) {
+        if (!_mpsc_put(target, m, m->sender_pid)) {
+            return 0;
+        }
+        if (_mpsc_wake(target) < THREAD_PRIORITY_IDLE) {
+            sched_context_switch_request = 1;
+        }
+        return 1;
+    }
+#endif
+
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("%s: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", __func__, thread_getpid(), target_pid);
@@ -334,18 +604,44 @@ int msg_reply_int(msg_t *m, msg_t *reply)
     return 1;
 }
 
+#ifdef MODULE_TRACE_EVENTS
+static int _msg_receive_traced(msg_t *m, int block)
+{
+    int res = _msg_receive(m, block);
+
+    if (res == 1) {
+        trace_event(TRACE_MSG_RECV, m->sender_pid, m->type);
+    }
+    return res;
+}
+#endif
+
 int msg_try_receive(msg_t *m)
 {
+#ifdef MODULE_TRACE_EVENTS
+    return _msg_receive_traced(m, 0);
+#else
     return _msg_receive(m, 0);
+#endif
 }
 
 int msg_receive(msg_t *m)
 {
+#ifdef MODULE_TRACE_EVENTS
+    return _msg_receive_traced(m, 1);
+#else
     return _msg_receive(m, 1);
+#endif
 }
 
 static int _msg_receive(msg_t *m, int block)
 {
+#if MODULE_CORE_MSG_MPSC
+    if (thread_has_msg_queue(thread_get_active())) {
+        return _msg_receive_mpsc(thread_get_active(), m, block);
+    }
+#endif
+
     unsigned state = irq_disable();
 
     DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive.\n",
@@ -443,7 +739,11 @@ int msg_avail(void)
     int queue_index = -1;
 
     if (thread_has_msg_queue(me)) {
+#if MODULE_CORE_MSG_MPSC
+        queue_index = _mpsc_avail(me);
+#else
         queue_index = cib_avail(&(me->msg_queue));
+#endif
     }
 
     return queue_index;
@@ -455,6 +755,11 @@ void msg_init_queue(msg_t *array, int num)
 
     me->msg_array = array;
     cib_init(&(me->msg_queue), num);
+#if MODULE_CORE_MSG_MPSC
+    for (int i = 0; i < num; i++) {
+        array[i].sender_pid = KERNEL_PID_UNDEF;
+    }
+#endif
 }
 
 void msg_queue_print(void)
@@ -29,6 +29,9 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#ifdef MODULE_TRACE_EVENTS
+#include "trace.h"
+#endif
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -54,6 +57,9 @@ static inline __attribute__((always_inline)) void _block(mutex_t *mutex,
     assert(me != NULL);
     DEBUG("PID[%" PRIkernel_pid "] mutex_lock() Adding node to mutex queue: "
           "prio: %" PRIu32 "\n", thread_getpid(), (uint32_t)me->priority);
+#ifdef MODULE_TRACE_EVENTS
+    trace_event(TRACE_MUTEX_CONTEND, 0, (uintptr_t)mutex);
+#endif
     sched_set_status(me, STATUS_MUTEX_BLOCKED);
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = (list_node_t *)&me->rq_entry;
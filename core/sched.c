@@ -33,6 +33,10 @@
 #include "mpu.h"
 #endif
 
+#ifdef MODULE_TRACE_EVENTS
+#include "trace.h"
+#endif
+
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
@@ -77,6 +81,7 @@ static uint32_t runqueue_bitcache = 0;
 #ifdef MODULE_SCHED_CB
 static void (*sched_cb)(kernel_pid_t active_thread,
                         kernel_pid_t next_thread) = NULL;
+static sched_ready_callback_t sched_ready_cb = NULL;
 #endif
 
 /* Depending on whether the CLZ instruction is available, the order of the
@@ -180,6 +185,11 @@ thread_t *__attribute__((used)) sched_run(void)
         if (sched_cb && !active_thread) {
             sched_cb(KERNEL_PID_UNDEF, next_thread->pid);
         }
+#endif
+#ifdef MODULE_TRACE_EVENTS
+        if (!active_thread) {
+            trace_event(TRACE_SCHED_SWITCH, KERNEL_PID_UNDEF, next_thread->pid);
+        }
 #endif
         DEBUG("sched_run: done, sched_active_thread was not changed.\n");
     }
@@ -196,6 +206,11 @@ thread_t *__attribute__((used)) sched_run(void)
             sched_cb(KERNEL_PID_UNDEF, next_thread->pid);
         }
 #endif
+#ifdef MODULE_TRACE_EVENTS
+        trace_event(TRACE_SCHED_SWITCH,
+                    active_thread ? active_thread->pid : KERNEL_PID_UNDEF,
+                    next_thread->pid);
+#endif
 
 #ifdef PICOLIBC_TLS
         _set_tls(next_thread->tls);
@@ -224,6 +239,11 @@ void sched_set_status(thread_t *process, thread_status_t status)
             clist_rpush(&sched_runqueues[process->priority],
                         &(process->rq_entry));
             _set_runqueue_bit(process);
+#ifdef MODULE_SCHED_CB
+            if (sched_ready_cb) {
+                sched_ready_cb(process->pid);
+            }
+#endif
 
             /* some thread entered a runqueue
              * if it is the active runqueue
@@ -301,4 +321,9 @@ void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t))
 {
     sched_cb = callback;
 }
+
+void sched_register_ready_cb(sched_ready_callback_t callback)
+{
+    sched_ready_cb = callback;
+}
 #endif
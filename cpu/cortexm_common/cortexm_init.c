@@ -19,12 +19,63 @@
  */
 
 #include "cpu.h"
+#include "vectors_cortexm.h"
+
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
 
 /**
  * Interrupt vector base address, defined by the linker
  */
 extern const void *_isr_vectors;
 
+#if defined(CPU_CORE_CORTEX_M3) || defined(CPU_CORE_CORTEX_M33) || \
+    defined(CPU_CORE_CORTEX_M4) || defined(CPU_CORE_CORTEX_M4F) || \
+    defined(CPU_CORE_CORTEX_M7) || \
+    (defined(CPU_CORE_CORTEX_M0PLUS) || defined(CPU_CORE_CORTEX_M23) \
+    && (__VTOR_PRESENT == 1))
+#define HAS_VTOR    1
+#endif
+
+#if defined(MODULE_SCHEDSTATISTICS) && defined(HAS_VTOR)
+/* number of entries in the vector table, including the initial stack
+ * pointer */
+#define ISR_TABLE_LEN   (CPU_NONISR_EXCEPTIONS + 1 + CPU_IRQ_NUMOF)
+/* VTOR requires the table to be aligned to its size, rounded up to a power
+ * of two */
+#define ISR_TABLE_ALIGN ((ISR_TABLE_LEN <= 32) ? 128 : \
+                         (ISR_TABLE_LEN <= 64) ? 256 : \
+                         (ISR_TABLE_LEN <= 128) ? 512 : \
+                         (ISR_TABLE_LEN <= 256) ? 1024 : 2048)
+
+/* Cortex-M has no common entry point for ISRs, so the vector table is
+ * copied to RAM with all IRQs entering through _isr_schedstat() */
+static isr_t _isr_table[ISR_TABLE_LEN] __attribute__((aligned(ISR_TABLE_ALIGN)));
+
+static void _isr_schedstat(void)
+{
+    unsigned irq = __get_IPSR() - (CPU_NONISR_EXCEPTIONS + 1);
+    uint32_t start = schedstat_isr_enter();
+
+    ((const isr_t *)&_isr_vectors)[irq + CPU_NONISR_EXCEPTIONS + 1]();
+    schedstat_isr_exit(irq, start);
+}
+
+static void _init_isr_schedstat(void)
+{
+    const isr_t *vectors = (const isr_t *)&_isr_vectors;
+
+    for (unsigned i = 0; i <= CPU_NONISR_EXCEPTIONS; i++) {
+        _isr_table[i] = vectors[i];
+    }
+    for (unsigned i = CPU_NONISR_EXCEPTIONS + 1; i < ISR_TABLE_LEN; i++) {
+        _isr_table[i] = _isr_schedstat;
+    }
+    SCB->VTOR = (uint32_t)_isr_table;
+}
+#endif
+
 #if defined(CPU_CORTEXM_INIT_SUBFUNCTIONS)
 #define CORTEXM_STATIC_INLINE /*empty*/
 #else
@@ -71,11 +122,9 @@ CORTEXM_STATIC_INLINE void cortexm_init_misc(void)
 void cortexm_init(void)
 {
     /* configure the vector table location to internal flash */
-#if defined(CPU_CORE_CORTEX_M3) || defined(CPU_CORE_CORTEX_M33) || \
-    defined(CPU_CORE_CORTEX_M4) || defined(CPU_CORE_CORTEX_M4F) || \
-    defined(CPU_CORE_CORTEX_M7) || \
-    (defined(CPU_CORE_CORTEX_M0PLUS) || defined(CPU_CORE_CORTEX_M23) \
-    && (__VTOR_PRESENT == 1))
+#if defined(MODULE_SCHEDSTATISTICS) && defined(HAS_VTOR)
+    _init_isr_schedstat();
+#elif defined(HAS_VTOR)
     SCB->VTOR = (uint32_t)&_isr_vectors;
 #endif
 
@@ -26,6 +26,12 @@
 extern "C" {
 #endif
 
+#if defined(MODULE_SCHEDSTATISTICS_IRQ_OFF) || defined(DOXYGEN)
+/* see schedstatistics.h, which can't be included here */
+void schedstat_irq_off_begin(const void *pc);
+void schedstat_irq_off_end(void);
+#endif
+
 /**
  * @brief Disable all maskable interrupts
  */
@@ -34,6 +40,14 @@ static inline __attribute__((always_inline)) unsigned int irq_disable(void)
     uint32_t mask = __get_PRIMASK();
 
     __disable_irq();
+#ifdef MODULE_SCHEDSTATISTICS_IRQ_OFF
+    if (mask == 0) {
+        const void *pc;
+
+        __asm__ volatile ("mov %0, pc" : "=r" (pc));
+        schedstat_irq_off_begin(pc);
+    }
+#endif
     return mask;
 }
 
@@ -45,6 +59,11 @@ irq_enable(void)
 {
     unsigned result = __get_PRIMASK();
 
+#ifdef MODULE_SCHEDSTATISTICS_IRQ_OFF
+    if (result) {
+        schedstat_irq_off_end();
+    }
+#endif
     __enable_irq();
     return result;
 }
@@ -55,6 +74,11 @@ irq_enable(void)
 static inline __attribute__((always_inline)) void irq_restore(
     unsigned int state)
 {
+#ifdef MODULE_SCHEDSTATISTICS_IRQ_OFF
+    if ((state == 0) && __get_PRIMASK()) {
+        schedstat_irq_off_end();
+    }
+#endif
     __set_PRIMASK(state);
 }
 
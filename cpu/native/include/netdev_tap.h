@@ -27,6 +27,7 @@ extern "C" {
 #include <stdint.h>
 #include "net/netdev.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +36,17 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of frames received per wakeup
+ *
+ * On a wakeup by the host, the driver signals frames from the TAP until none
+ * is pending or this limit is reached, in which case it schedules another
+ * wakeup. Set this to 1 to signal one frame per wakeup.
+ */
+#ifndef CONFIG_NETDEV_TAP_RX_BATCH
+#define CONFIG_NETDEV_TAP_RX_BATCH      (16U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -40,6 +40,10 @@
 
 #include "native_internal.h"
 
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
+
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
@@ -164,6 +168,12 @@ unsigned irq_disable(void)
     prev_state = native_interrupts_enabled;
     native_interrupts_enabled = 0;
 
+#ifdef MODULE_SCHEDSTATISTICS_IRQ_OFF
+    if (prev_state && !_native_in_isr) {
+        schedstat_irq_off_begin(__builtin_return_address(0));
+    }
+#endif
+
     DEBUG("irq_disable(): return\n");
     _native_syscall_leave();
 
@@ -188,6 +198,12 @@ unsigned irq_enable(void)
     _native_syscall_enter();
     DEBUG("irq_enable()\n");
 
+#ifdef MODULE_SCHEDSTATISTICS_IRQ_OFF
+    if (!native_interrupts_enabled && !_native_in_isr) {
+        schedstat_irq_off_end();
+    }
+#endif
+
     /* Mark the IRQ as enabled first since sigprocmask could call the handler
      * before returning to userspace.
      */
@@ -270,7 +286,13 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+#ifdef MODULE_SCHEDSTATISTICS
+            uint32_t start = schedstat_isr_enter();
+#endif
             native_irq_handlers[sig]();
+#ifdef MODULE_SCHEDSTATISTICS
+            schedstat_isr_exit(sig, start);
+#endif
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
@@ -183,6 +183,7 @@ const mtd_desc_t native_flash_driver = {
     .write_page = _write_page,
     .erase = _erase,
     .init = _init,
+    .flags = MTD_DRIVER_FLAG_CLEARING_OVERWRITE,
 };
 
 /** @} */
@@ -94,16 +94,35 @@ static inline int _set_promiscuous(netdev_t *netdev, int value)
     return value;
 }
 
+static void _continue_reading(netdev_tap_t *dev);
+static bool _frame_pending(netdev_tap_t *dev);
+
 static inline void _isr(netdev_t *netdev)
 {
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-    }
+    netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
+
+    if (!netdev->event_callback) {
 #if DEVELHELP
-    else {
         puts("netdev_tap: _isr(): no event_callback set.");
-    }
 #endif
+        return;
+    }
+
+    /* drain the TAP: RX_COMPLETE is only signaled while a frame is pending,
+     * the upper layer then reads it straight into its own buffer. This saves
+     * the signal and thread switch round trip for every further frame. */
+    for (unsigned i = 0; i < CONFIG_NETDEV_TAP_RX_BATCH; i++) {
+        if (!_frame_pending(dev)) {
+            DEBUG("netdev_tap: drained after %u frames\n", i);
+            /* a new frame triggers a new SIGIO */
+            native_async_read_continue(dev->tap_fd);
+            return;
+        }
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+    }
+
+    /* there might be frames left */
+    _continue_reading(dev);
 }
 
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
@@ -204,6 +223,22 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+/* checks without blocking whether a frame can be read from the TAP */
+static bool _frame_pending(netdev_tap_t *dev)
+{
+    fd_set rfds;
+    struct timeval t;
+    memset(&t, 0, sizeof(t));
+    FD_ZERO(&rfds);
+    FD_SET(dev->tap_fd, &rfds);
+
+    _native_in_syscall++; /* no switching here */
+    int res = real_select(dev->tap_fd + 1, &rfds, NULL, NULL, &t);
+    _native_in_syscall--;
+
+    return (res == 1);
+}
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = container_of(netdev, netdev_tap_t, netdev);
@@ -216,21 +251,17 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 
             /* repeating `real_read` for small size on tap device results in
              * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
-            }
-            */
-
             static uint8_t nullbuf[ETHERNET_FRAME_LEN];
 
             real_read(dev->tap_fd, nullbuf, sizeof(nullbuf));
-
-            _continue_reading(dev);
         }
 
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
+        /* a Linux TAP supports neither FIONREAD nor MSG_PEEK, so there the
+         * maximum possible size is returned */
+        int size;
+        if ((real_ioctl(dev->tap_fd, FIONREAD, &size) == 0) && (size > 0)) {
+            return size;
+        }
         return ETHERNET_FRAME_LEN;
     }
 
@@ -247,19 +278,13 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                   hdr->dst[0], hdr->dst[1], hdr->dst[2],
                   hdr->dst[3], hdr->dst[4], hdr->dst[5]);
 
-            native_async_read_continue(dev->tap_fd);
-
             return 0;
         }
 
-        _continue_reading(dev);
-
         return nread;
     }
     else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
             err(EXIT_FAILURE, "netdev_tap: read");
         }
     }
@@ -33,6 +33,10 @@
 
 #include "vendor/riscv_csr.h"
 
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
+
 /* Default state of mstatus register */
 #define MSTATUS_DEFAULT     (MSTATUS_MPP | MSTATUS_MPIE)
 
@@ -96,9 +100,18 @@ static void __attribute((used)) handle_trap(uint32_t mcause)
 
 #ifdef MODULE_PERIPH_CORETIMER
         case IRQ_M_TIMER:
+        {
+#ifdef MODULE_SCHEDSTATISTICS
+            /* the core timer has no PLIC/CLIC ID, 0 is never claimed */
+            uint32_t start = schedstat_isr_enter();
+#endif
             /* Handle timer interrupt */
             timer_isr();
+#ifdef MODULE_SCHEDSTATISTICS
+            schedstat_isr_exit(0, start);
+#endif
             break;
+        }
 #endif
         case IRQ_M_EXT:
             /* Handle external interrupt */
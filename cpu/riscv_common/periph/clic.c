@@ -19,6 +19,10 @@
 #include <assert.h>
 #include "clic.h"
 
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
+
 /**
  * @brief CLIC registry offset helper
  */
@@ -66,5 +70,11 @@ void clic_set_handler(unsigned irq, clic_isr_cb_t cb)
 
 void clic_isr_handler(uint32_t irq)
 {
+#ifdef MODULE_SCHEDSTATISTICS
+    uint32_t start = schedstat_isr_enter();
+#endif
     _ext_isrs[irq](irq);
+#ifdef MODULE_SCHEDSTATISTICS
+    schedstat_isr_exit(irq, start);
+#endif
 }
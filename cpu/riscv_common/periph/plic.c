@@ -29,6 +29,10 @@
 #include "cpu.h"
 #include "plic.h"
 
+#ifdef MODULE_SCHEDSTATISTICS
+#include "schedstatistics.h"
+#endif
+
 /* Local macros to calculate register offsets */
 #define _REG32(p, i) 			(*(volatile uint32_t *) ((p) + (i)))
 #define PLIC_REG(offset) 		_REG32(PLIC_CTRL_ADDR, offset)
@@ -125,8 +129,14 @@ void plic_isr_handler(void)
 {
     unsigned irq = plic_claim_interrupt();
 
+#ifdef MODULE_SCHEDSTATISTICS
+    uint32_t start = schedstat_isr_enter();
+#endif
     /* Don't check here, just crash hard if no handler is available */
     _ext_isrs[irq](irq);
+#ifdef MODULE_SCHEDSTATISTICS
+    schedstat_isr_exit(irq, start);
+#endif
 
     plic_complete_interrupt(irq);
 }
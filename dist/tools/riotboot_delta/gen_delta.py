@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+
+#
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+#
+
+"""Generate delta patches for the riotboot_delta module
+
+The patch format is described in sys/include/riotboot/delta.h. The new image
+is built greedily from the longest matches found in the base image, the bytes
+in between are inserted literally.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = b"RDLT"
+OP_COPY = 0
+OP_INSERT = 1
+
+# length of the hashed blocks used to find matches
+BLOCK_LEN = 8
+# shorter matches are inserted, as a copy costs at least two bytes
+MIN_MATCH = 12
+# number of positions in the base image kept per block
+MAX_CANDIDATES = 32
+
+
+def encode_uint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def encode_int(value):
+    return encode_uint((value << 1) if value >= 0 else ((-value << 1) - 1))
+
+
+def decode_uint(patch, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = patch[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def _match_len(base, base_pos, new, new_pos):
+    length = 0
+    limit = min(len(base) - base_pos, len(new) - new_pos)
+    # compare in chunks first, matches in firmware images are often long
+    while length + 64 <= limit and \
+            base[base_pos + length:base_pos + length + 64] == \
+            new[new_pos + length:new_pos + length + 64]:
+        length += 64
+    while length < limit and base[base_pos + length] == new[new_pos + length]:
+        length += 1
+    return length
+
+
+def _index(base):
+    index = {}
+    for pos in range(len(base) - BLOCK_LEN + 1):
+        candidates = index.setdefault(base[pos:pos + BLOCK_LEN], [])
+        if len(candidates) < MAX_CANDIDATES:
+            candidates.append(pos)
+    return index
+
+
+def diff(base, new):
+    index = _index(base)
+    patch = bytearray(MAGIC)
+    patch += struct.pack("<II", len(base), len(new))
+    patch += hashlib.sha256(base).digest()
+
+    base_pos = 0
+    insert_start = 0
+    pos = 0
+
+    def flush_insert(end):
+        if end > insert_start:
+            patch.extend(encode_uint(((end - insert_start) << 1) | OP_INSERT))
+            patch.extend(new[insert_start:end])
+
+    while pos < len(new):
+        # continuing the last copy costs the least
+        best_pos = base_pos
+        best_len = _match_len(base, base_pos, new, pos) \
+            if base_pos < len(base) else 0
+        for candidate in index.get(new[pos:pos + BLOCK_LEN], ()):
+            length = _match_len(base, candidate, new, pos)
+            if length > best_len:
+                best_pos, best_len = candidate, length
+
+        if best_len < MIN_MATCH:
+            pos += 1
+            continue
+
+        flush_insert(pos)
+        patch.extend(encode_uint((best_len << 1) | OP_COPY))
+        patch.extend(encode_int(best_pos - base_pos))
+        base_pos = best_pos + best_len
+        pos += best_len
+        insert_start = pos
+
+    flush_insert(len(new))
+    return bytes(patch)
+
+
+def apply(base, patch):
+    if patch[:4] != MAGIC:
+        raise ValueError("not a patch")
+    base_len, new_len = struct.unpack("<II", patch[4:12])
+    if hashlib.sha256(base[:base_len]).digest() != patch[12:44]:
+        raise ValueError("patch doesn't apply to the base image")
+
+    new = bytearray()
+    base_pos = 0
+    pos = 44
+    while len(new) < new_len:
+        value, pos = decode_uint(patch, pos)
+        length = value >> 1
+        if value & 1 == OP_INSERT:
+            new += patch[pos:pos + length]
+            pos += length
+        else:
+            offset, pos = decode_uint(patch, pos)
+            base_pos += (offset >> 1) if not offset & 1 else -(offset >> 1) - 1
+            new += base[base_pos:base_pos + length]
+            base_pos += length
+    return bytes(new)
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('base', help='Image that is installed on the device')
+    parser.add_argument('new', help='Image to send as a patch')
+    parser.add_argument('output', help='Patch output file path')
+    return parser.parse_args()
+
+
+def main(args):
+    with open(args.base, 'rb') as f:
+        base = f.read()
+    with open(args.new, 'rb') as f:
+        new = f.read()
+
+    patch = diff(base, new)
+    if apply(base, patch) != new:
+        sys.exit("error: generated patch is invalid")
+
+    with open(args.output, 'wb') as f:
+        f.write(patch)
+    print("%s: %u bytes (%u%% of %u bytes)" %
+          (args.output, len(patch), 100 * len(patch) // max(len(new), 1),
+           len(new)))
+
+
+if __name__ == "__main__":
+    main(parse_arguments())
@@ -35,6 +35,9 @@ def parse_arguments():
                         help='Manifest vendor uuid')
     parser.add_argument('--uuid-class', '-C', default="native",
                         help='Manifest class uuid')
+    parser.add_argument('--delta', '-d', action='store_true',
+                        help='Fetch the payloads as delta patches '
+                             '(<slot file>.delta)')
     parser.add_argument('slotfiles', nargs="+",
                         help='The list of slot file paths')
     return parser.parse_args()
@@ -68,6 +71,8 @@ def main(args):
         filename, offset, comp_name = image
 
         uri = os.path.join(args.urlroot, os.path.basename(filename))
+        if args.delta:
+            uri += ".delta"
 
         component = {
             "install-id": comp_name,
@@ -0,0 +1,211 @@
+#! /usr/bin/env python3
+#
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Script to convert the output of `trace_drain_stdio()` or `trace_drain_vfs()`
+(provided by the `trace` module) to the Chrome trace event JSON format, as
+understood by `chrome://tracing` and https://ui.perfetto.dev.
+"""
+
+import argparse
+import binascii
+import collections
+import json
+import re
+import struct
+import sys
+
+MAGIC_LE = b"RTRC"
+MAGIC_BE = b"CRTR"
+HDR_SIZE = 12
+ENTRY_SIZE = 12
+PID_ISR = 0xff
+PID_UNDEF = 0
+
+(USER, SCHED_SWITCH, MSG_SEND, MSG_RECV, MUTEX_CONTEND, PKTBUF_ALLOC,
+ PKTBUF_FREE, NETIF_TX, NETIF_RX) = range(9)
+
+TRACE_LINE = re.compile(r"TRACE:([0-9a-fA-F]+)")
+
+Entry = collections.namedtuple("Entry", "time type pid arg16 arg")
+
+
+def parse_chunks(data):
+    """Yield (lost, entries) for each chunk in the binary trace `data`"""
+    pos = 0
+    while pos + HDR_SIZE <= len(data):
+        magic = data[pos:pos + 4]
+        if magic == MAGIC_LE:
+            endian = "<"
+        elif magic == MAGIC_BE:
+            endian = ">"
+        else:
+            raise ValueError("no trace header at offset {}".format(pos))
+        version, entry_size, count, lost = struct.unpack(
+            endian + "BBHI", data[pos + 4:pos + HDR_SIZE])
+        if version != 1 or entry_size != ENTRY_SIZE:
+            raise ValueError("unsupported trace version {} (entry size {})"
+                             .format(version, entry_size))
+        pos += HDR_SIZE
+        entries = []
+        for _ in range(count):
+            if pos + ENTRY_SIZE > len(data):
+                raise ValueError("truncated trace")
+            entries.append(Entry._make(struct.unpack(
+                endian + "IBBHI", data[pos:pos + ENTRY_SIZE])))
+            pos += ENTRY_SIZE
+        yield lost, entries
+
+
+def read_input(infile):
+    """Read a binary trace, or extract it from a terminal log"""
+    data = infile.read()
+    if data[:4] in (MAGIC_LE, MAGIC_BE):
+        return data
+    text = data.decode("utf-8", errors="replace")
+    return b"".join(binascii.unhexlify(m.group(1))
+                    for m in TRACE_LINE.finditer(text))
+
+
+class Converter:
+    """Converts trace entries to Chrome trace events"""
+
+    def __init__(self, names):
+        self.names = names
+        self.events = []
+        self.tids = set()
+        self.time_offset = 0
+        self.time_last = None
+        self.running = None     # (pid, start time)
+        self.msgs = collections.defaultdict(collections.deque)
+        self.pkts = {}
+        self.flow_id = 0
+
+    def _time(self, time):
+        # unwrap the 32 bit microsecond time stamps
+        if self.time_last is not None and time < self.time_last and \
+           self.time_last - time > 0x80000000:
+            self.time_offset += 0x100000000
+        self.time_last = time
+        return time + self.time_offset
+
+    def _add(self, ph, name, ts, tid, **kwargs):
+        self.tids.add(tid)
+        event = {"ph": ph, "name": name, "ts": ts, "pid": 1, "tid": tid}
+        event.update(kwargs)
+        self.events.append(event)
+
+    def _instant(self, name, ts, tid, args):
+        self._add("i", name, ts, tid, s="t", args=args)
+
+    def lost(self, count):
+        if self.time_last is not None:
+            self._add("i", "{} events lost".format(count),
+                      self.time_last + self.time_offset, PID_ISR, s="g")
+        # the state tracked so far might be incomplete now
+        self.msgs.clear()
+
+    def entry(self, entry):
+        ts = self._time(entry.time)
+        if entry.type == USER:
+            self._instant("trace", ts, entry.pid,
+                          {"value": "0x{:08x}".format(entry.arg)})
+        elif entry.type == SCHED_SWITCH:
+            self._switch(ts, entry.arg)
+        elif entry.type == MSG_SEND:
+            self.flow_id += 1
+            self.msgs[(entry.arg16, entry.arg)].append(self.flow_id)
+            args = {"target": entry.arg16, "type": "0x{:04x}".format(entry.arg)}
+            self._instant("msg_send", ts, entry.pid, args)
+            self._add("s", "msg", ts, entry.pid, cat="msg", id=self.flow_id)
+        elif entry.type == MSG_RECV:
+            args = {"sender": entry.arg16, "type": "0x{:04x}".format(entry.arg)}
+            self._instant("msg_recv", ts, entry.pid, args)
+            queue = self.msgs.get((entry.pid, entry.arg))
+            if queue:
+                self._add("f", "msg", ts, entry.pid, cat="msg", bp="e",
+                          id=queue.popleft())
+        elif entry.type == MUTEX_CONTEND:
+            self._instant("mutex_contend", ts, entry.pid,
+                          {"mutex": "0x{:08x}".format(entry.arg)})
+        elif entry.type == PKTBUF_ALLOC:
+            pkt = "0x{:08x}".format(entry.arg)
+            if pkt in self.pkts:
+                self._add("e", "pktsnip", ts, self.pkts[pkt], cat="pktbuf",
+                          id=pkt)
+            self.pkts[pkt] = entry.pid
+            self._add("b", "pktsnip", ts, entry.pid, cat="pktbuf", id=pkt,
+                      args={"size": entry.arg16})
+        elif entry.type == PKTBUF_FREE:
+            pkt = "0x{:08x}".format(entry.arg)
+            if pkt in self.pkts:
+                self._add("e", "pktsnip", ts, self.pkts.pop(pkt),
+                          cat="pktbuf", id=pkt)
+        elif entry.type in (NETIF_TX, NETIF_RX):
+            name = "netif_tx" if entry.type == NETIF_TX else "netif_rx"
+            self._instant(name, ts, entry.arg16,
+                          {"pkt": "0x{:08x}".format(entry.arg)})
+
+    def _switch(self, ts, next_pid):
+        if self.running is not None:
+            pid, start = self.running
+            if pid != PID_UNDEF:
+                self._add("X", "running", start, pid, dur=ts - start)
+        self.running = (next_pid, ts)
+
+    def finish(self):
+        if self.running is not None and self.time_last is not None:
+            self._switch(self.time_last + self.time_offset, PID_UNDEF)
+        meta = [{"ph": "M", "name": "process_name", "pid": 1,
+                 "args": {"name": "RIOT"}}]
+        for tid in sorted(self.tids):
+            if tid in self.names:
+                name = self.names[tid]
+            elif tid == PID_ISR:
+                name = "ISR"
+            else:
+                name = "thread {}".format(tid)
+            meta.append({"ph": "M", "name": "thread_name", "pid": 1,
+                         "tid": tid, "args": {"name": name}})
+        return {"traceEvents": meta + self.events}
+
+
+def parse_name(arg):
+    pid, _, name = arg.partition("=")
+    try:
+        return int(pid), name
+    except ValueError:
+        raise argparse.ArgumentTypeError("expected PID=NAME, got " + arg)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("infile", nargs="?", type=argparse.FileType("rb"),
+                        default=sys.stdin.buffer,
+                        help="binary trace or terminal log with TRACE: "
+                             "lines (default: stdin)")
+    parser.add_argument("-o", "--outfile", type=argparse.FileType("w"),
+                        default=sys.stdout,
+                        help="JSON output file (default: stdout)")
+    parser.add_argument("-n", "--name", type=parse_name, action="append",
+                        default=[], metavar="PID=NAME",
+                        help="name of the thread with PID (repeatable)")
+    args = parser.parse_args()
+
+    converter = Converter(dict(args.name))
+    for lost, entries in parse_chunks(read_input(args.infile)):
+        if lost:
+            converter.lost(lost)
+        for entry in entries:
+            converter.entry(entry)
+    json.dump(converter.finish(), args.outfile, indent=1)
+    args.outfile.write("\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -70,6 +70,14 @@ typedef struct {
  */
 #define MTD_DRIVER_FLAG_DIRECT_WRITE    (1 << 0)
 
+/**
+ * @brief   MTD driver can clear bits of programmed pages without erasing them
+ *
+ * This is the case for most NOR flash. Flash with ECC (e.g. the internal
+ * flash of the STM32L4) can only program a page once after an erase.
+ */
+#define MTD_DRIVER_FLAG_CLEARING_OVERWRITE  (1 << 1)
+
 /**
  * @brief   MTD driver interface
  *
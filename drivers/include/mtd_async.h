@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_async   Asynchronous MTD requests
+ * @ingroup     drivers_storage
+ * @brief       Queue read, program, and erase requests to an MTD device and
+ *              get notified on completion by an event
+ *
+ * All operations of the @ref drivers_mtd interface block the calling thread
+ * until the device is done, which can take hundreds of milliseconds for a
+ * sector erase. This module queues requests per device and executes them one
+ * after the other from a worker event queue, e.g. one of the
+ * `event_thread` queues. When a request is done, its event is posted to the
+ * event queue given on submission.
+ *
+ * The requests of one device are executed in order, with one exception:
+ * a read request is executed before pending program and erase requests that
+ * were submitted earlier, as long as it does not overlap any of them. So a
+ * read is not delayed by a long erase of another sector.
+ *
+ * Any MTD device can be used. Drivers like @ref drivers_mtd_spi_nor release
+ * the bus while the chip is busy, so other devices on the same bus are not
+ * blocked by an ongoing erase.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += mtd_async
+ * ```
+ *
+ * ```
+ * static mtd_async_t async;
+ * static mtd_async_req_t req = { .super.handler = _erase_done };
+ *
+ * mtd_async_init(&async, MTD_0, EVENT_PRIO_LOWEST);
+ * mtd_async_erase_sector(&async, &req, &queue, 0, 1);
+ * ```
+ *
+ * The request must not be touched until its event was handled. Its result is
+ * then stored in @ref mtd_async_req_t::res.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definitions for asynchronous MTD requests
+ */
+
+#ifndef MTD_ASYNC_H
+#define MTD_ASYNC_H
+
+#include <stdint.h>
+
+#include "event.h"
+#include "mtd.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Operations of an asynchronous MTD request
+ */
+typedef enum {
+    MTD_ASYNC_READ,         /**< read with mtd_read_page() */
+    MTD_ASYNC_WRITE,        /**< program with mtd_write_page_raw() */
+    MTD_ASYNC_ERASE,        /**< erase with mtd_erase_sector() */
+} mtd_async_op_t;
+
+/**
+ * @brief   Asynchronous MTD request
+ *
+ * Set the handler of @p super before submitting the request.
+ */
+typedef struct mtd_async_req {
+    event_t super;                  /**< event posted on completion */
+    struct mtd_async_req *next;     /**< next pending request */
+    event_queue_t *queue;           /**< queue to post @p super to */
+    void *buf;                      /**< data to read or program */
+    uint32_t page;                  /**< first page, or sector to erase */
+    uint32_t offset;                /**< offset in @p page in bytes */
+    uint32_t size;                  /**< bytes, or sectors to erase */
+    int res;                        /**< result of the request */
+    mtd_async_op_t op;              /**< operation of the request */
+} mtd_async_req_t;
+
+/**
+ * @brief   Request queue of an MTD device
+ */
+typedef struct {
+    event_t work;                   /**< executes the next pending request */
+    mtd_dev_t *mtd;                 /**< MTD device */
+    event_queue_t *worker;          /**< queue the requests are executed on */
+    mtd_async_req_t *pending;       /**< pending requests, oldest first */
+    mutex_t lock;                   /**< guards @p pending */
+} mtd_async_t;
+
+/**
+ * @brief   Initialize the request queue of an MTD device
+ *
+ * The MTD device must already be initialized.
+ *
+ * @param[out] async    Request queue to initialize
+ * @param[in] mtd       MTD device
+ * @param[in] worker    Event queue the requests are executed on. The thread
+ *                      waiting on it is blocked while a request is executed.
+ */
+void mtd_async_init(mtd_async_t *async, mtd_dev_t *mtd, event_queue_t *worker);
+
+/**
+ * @brief   Submit a request
+ *
+ * @param[in] async     Request queue of the MTD device
+ * @param[in] req       Request with all members but @p next set
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p req has no handler or no completion queue
+ */
+int mtd_async_submit(mtd_async_t *async, mtd_async_req_t *req);
+
+/**
+ * @brief   Cancel a request that was not executed yet
+ *
+ * @param[in] async     Request queue of the MTD device
+ * @param[in] req       Request to cancel
+ *
+ * @return  0 if @p req was removed from the queue, its event is not posted
+ * @return  -EALREADY if @p req is not pending anymore
+ */
+int mtd_async_cancel(mtd_async_t *async, mtd_async_req_t *req);
+
+/**
+ * @brief   Submit a read request with pagewise addressing
+ *
+ * @param[in] async     Request queue of the MTD device
+ * @param[in] req       Request, with the handler of its event set
+ * @param[in] queue     Event queue to post @p req to on completion
+ * @param[out] dest     Buffer to read to
+ * @param[in] page      Page to start reading from
+ * @param[in] offset    Byte offset from the start of the page
+ * @param[in] size      Number of bytes to read
+ *
+ * @return  See mtd_async_submit()
+ */
+static inline int mtd_async_read_page(mtd_async_t *async, mtd_async_req_t *req,
+                                      event_queue_t *queue, void *dest,
+                                      uint32_t page, uint32_t offset,
+                                      uint32_t size)
+{
+    req->op = MTD_ASYNC_READ;
+    req->queue = queue;
+    req->buf = dest;
+    req->page = page;
+    req->offset = offset;
+    req->size = size;
+    return mtd_async_submit(async, req);
+}
+
+/**
+ * @brief   Submit a raw program request with pagewise addressing
+ *
+ * @param[in] async     Request queue of the MTD device
+ * @param[in] req       Request, with the handler of its event set
+ * @param[in] queue     Event queue to post @p req to on completion
+ * @param[in] src       Data to program, must stay valid until completion
+ * @param[in] page      Page to start writing to
+ * @param[in] offset    Byte offset from the start of the page
+ * @param[in] size      Number of bytes to write
+ *
+ * @return  See mtd_async_submit()
+ */
+static inline int mtd_async_write_page_raw(mtd_async_t *async,
+                                           mtd_async_req_t *req,
+                                           event_queue_t *queue,
+                                           const void *src, uint32_t page,
+                                           uint32_t offset, uint32_t size)
+{
+    req->op = MTD_ASYNC_WRITE;
+    req->queue = queue;
+    req->buf = (void *)src;
+    req->page = page;
+    req->offset = offset;
+    req->size = size;
+    return mtd_async_submit(async, req);
+}
+
+/**
+ * @brief   Submit an erase request
+ *
+ * @param[in] async     Request queue of the MTD device
+ * @param[in] req       Request, with the handler of its event set
+ * @param[in] queue     Event queue to post @p req to on completion
+ * @param[in] sector    First sector to erase
+ * @param[in] count     Number of sectors to erase
+ *
+ * @return  See mtd_async_submit()
+ */
+static inline int mtd_async_erase_sector(mtd_async_t *async,
+                                         mtd_async_req_t *req,
+                                         event_queue_t *queue,
+                                         uint32_t sector, uint32_t count)
+{
+    req->op = MTD_ASYNC_ERASE;
+    req->queue = queue;
+    req->buf = NULL;
+    req->page = sector;
+    req->offset = 0;
+    req->size = count;
+    return mtd_async_submit(async, req);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_ASYNC_H */
+/** @} */
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache   MTD write-back sector cache
+ * @ingroup     drivers_storage
+ * @brief       Write-back sector cache on top of another MTD device
+ *
+ * Writing to a sector with `mtd_write_page()` reads, erases, and rewrites
+ * the whole sector for every write, no matter how small. This MTD module
+ * keeps the most recently written sectors of a backing MTD device in RAM,
+ * so small writes to the same sector are coalesced into a single erase and
+ * program cycle.
+ *
+ * The cache is write-back: sectors are written to the backing device when
+ * they are evicted, when the cache is flushed with mtd_cache_flush(), or on
+ * `mtd_power(dev, MTD_POWER_DOWN)`. With the `mtd_cache_autoflush` module, a
+ * dirty cache is also flushed @ref CONFIG_MTD_CACHE_FLUSH_TIMEOUT_MS after
+ * the last write, from the lowest priority event thread.
+ *
+ * Writes to the cache may set bits that were cleared before, i.e. the
+ * device can be written like RAM (@ref MTD_DRIVER_FLAG_DIRECT_WRITE). A sector
+ * is only erased on flush if it was erased explicitly, or if a page that is
+ * programmed on the backing device changed and either bits were set or the
+ * backing device lacks @ref MTD_DRIVER_FLAG_CLEARING_OVERWRITE. Otherwise
+ * only the pages that changed are programmed.
+ *
+ * @warning Data that was not yet flushed is lost on reset or power loss.
+ *
+ * ## Usage
+ *
+ * ```
+ * USEMODULE += mtd_cache
+ * ```
+ *
+ * ```
+ * mtd_cache_t cache = MTD_CACHE_INIT(MTD_0);
+ * mtd_dev_t *dev = &cache.mtd;
+ *
+ * mtd_init(dev);
+ * ```
+ *
+ * The cache needs @ref CONFIG_MTD_CACHE_SECTORS sector-sized buffers, plus a
+ * bit per page, which are allocated with `malloc()` on initialization.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definitions for the MTD sector cache
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mutex.h"
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+#include "event/timeout.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup drivers_mtd_cache_config     MTD sector cache configuration
+ * @ingroup config_drivers_storage
+ * @{
+ */
+/**
+ * @brief   Number of sectors kept in the cache
+ */
+#ifndef CONFIG_MTD_CACHE_SECTORS
+#define CONFIG_MTD_CACHE_SECTORS            (2U)
+#endif
+
+/**
+ * @brief   Time in milliseconds after the last write until the cache is
+ *          flushed (`mtd_cache_autoflush` module only)
+ */
+#ifndef CONFIG_MTD_CACHE_FLUSH_TIMEOUT_MS
+#define CONFIG_MTD_CACHE_FLUSH_TIMEOUT_MS   (1000U)
+#endif
+/** @} */
+
+/**
+ * @brief   Shortcut macro for initializing the members of an
+ *          @ref mtd_cache_t struct
+ *
+ * @param[in] _parent   The backing MTD device
+ */
+#define MTD_CACHE_INIT(_parent) \
+{ \
+    .mtd = { .driver = &mtd_cache_driver }, \
+    .parent = _parent, \
+    .lock = MUTEX_INIT, \
+}
+
+/**
+ * @brief   Statistics of an MTD sector cache
+ *
+ * The write amplification is `programmed / written`.
+ */
+typedef struct {
+    uint32_t written;       /**< bytes written to the cache */
+    uint32_t programmed;    /**< bytes programmed to the backing device */
+    uint32_t erased;        /**< sectors erased on the backing device */
+} mtd_cache_stats_t;
+
+/**
+ * @brief   A cached sector
+ */
+typedef struct {
+    uint8_t *buf;           /**< content of the sector */
+    uint8_t *programmed;    /**< bitfield of the pages that are programmed on
+                                 the backing device */
+    uint32_t sector;        /**< number of the sector in the backing device */
+    uint32_t last_use;      /**< for least recently used eviction */
+    uint16_t first_page;    /**< first changed page in the sector */
+    uint16_t last_page;     /**< last changed page in the sector */
+    bool valid;             /**< slot holds a sector */
+    bool dirty;             /**< sector needs to be written back */
+    bool erase;             /**< sector needs to be erased on write-back */
+} mtd_cache_slot_t;
+
+/**
+ * @brief   MTD sector cache
+ */
+typedef struct {
+    mtd_dev_t mtd;          /**< MTD context, geometry of the backing device */
+    mtd_dev_t *parent;      /**< backing MTD device */
+    mutex_t lock;           /**< guards the cache and the backing device */
+    uint32_t use_count;     /**< for least recently used eviction */
+    mtd_cache_stats_t stats;                        /**< statistics */
+    mtd_cache_slot_t slots[CONFIG_MTD_CACHE_SECTORS];   /**< cached sectors */
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH) || DOXYGEN
+    event_t flush_event;    /**< event to flush the cache */
+    event_timeout_t flush_timeout;  /**< timeout of @p flush_event */
+#endif
+} mtd_cache_t;
+
+/**
+ * @brief   MTD sector cache operations table
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Writes all dirty sectors back to the backing device
+ *
+ * @param[in] cache     The cache to flush
+ *
+ * @return  0 on success
+ * @return  < 0 on error of the backing device. The other sectors are still
+ *          written back, the first error is returned. Sectors that could
+ *          not be written back stay in the cache.
+ */
+int mtd_cache_flush(mtd_cache_t *cache);
+
+/**
+ * @brief   Get the statistics of a cache
+ *
+ * @param[in] cache     The cache
+ * @param[out] stats    The statistics
+ */
+void mtd_cache_get_stats(mtd_cache_t *cache, mtd_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
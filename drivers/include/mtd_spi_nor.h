@@ -30,6 +30,7 @@
 #include "periph/spi.h"
 #include "periph/gpio.h"
 #include "mtd.h"
+#include "mutex.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -150,6 +151,13 @@ typedef struct {
      * Computed by mtd_spi_nor_init, no need to touch outside the driver.
      */
     uint8_t sec_addr_shift;
+    /**
+     * @brief   serializes access to the chip, the SPI bus is released while
+     *          the chip is busy
+     *
+     * Initialized by mtd_spi_nor_init, no need to touch outside the driver.
+     */
+    mutex_t lock;
 } mtd_spi_nor_t;
 
 /**
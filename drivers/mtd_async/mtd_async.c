@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous MTD requests
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mtd_async.h"
+#include "mutex.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static uint32_t _start(const mtd_dev_t *mtd, const mtd_async_req_t *req)
+{
+    if (req->op == MTD_ASYNC_ERASE) {
+        return req->page * mtd->pages_per_sector * mtd->page_size;
+    }
+    return (req->page * mtd->page_size) + req->offset;
+}
+
+static uint32_t _end(const mtd_dev_t *mtd, const mtd_async_req_t *req)
+{
+    if (req->op == MTD_ASYNC_ERASE) {
+        return _start(mtd, req) +
+               (req->size * mtd->pages_per_sector * mtd->page_size);
+    }
+    return _start(mtd, req) + req->size;
+}
+
+static bool _overlap(const mtd_dev_t *mtd, const mtd_async_req_t *a,
+                     const mtd_async_req_t *b)
+{
+    return (_start(mtd, a) < _end(mtd, b)) && (_start(mtd, b) < _end(mtd, a));
+}
+
+/**
+ * @brief   Reads may pass earlier programs and erases they don't depend on
+ */
+static bool _may_pass(const mtd_dev_t *mtd, const mtd_async_req_t *read,
+                      const mtd_async_req_t *earlier)
+{
+    for (const mtd_async_req_t *req = earlier; req != read; req = req->next) {
+        if ((req->op != MTD_ASYNC_READ) && _overlap(mtd, req, read)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static mtd_async_req_t *_pop(mtd_async_t *async)
+{
+    mtd_async_req_t **next = &async->pending;
+
+    for (mtd_async_req_t **tmp = &async->pending; *tmp; tmp = &(*tmp)->next) {
+        if (((*tmp)->op == MTD_ASYNC_READ) &&
+            _may_pass(async->mtd, *tmp, async->pending)) {
+            next = tmp;
+            break;
+        }
+    }
+
+    mtd_async_req_t *req = *next;
+
+    if (req != NULL) {
+        *next = req->next;
+        req->next = NULL;
+    }
+    return req;
+}
+
+static int _exec(mtd_dev_t *mtd, mtd_async_req_t *req)
+{
+    switch (req->op) {
+    case MTD_ASYNC_READ:
+        return mtd_read_page(mtd, req->buf, req->page, req->offset, req->size);
+    case MTD_ASYNC_WRITE:
+        return mtd_write_page_raw(mtd, req->buf, req->page, req->offset,
+                                  req->size);
+    case MTD_ASYNC_ERASE:
+        return mtd_erase_sector(mtd, req->page, req->size);
+    }
+    return -EINVAL;
+}
+
+static void _work(event_t *event)
+{
+    mtd_async_t *async = container_of(event, mtd_async_t, work);
+
+    mutex_lock(&async->lock);
+    mtd_async_req_t *req = _pop(async);
+    bool more = (async->pending != NULL);
+    mutex_unlock(&async->lock);
+
+    if (req == NULL) {
+        return;
+    }
+
+    DEBUG("mtd_async: op %u at page %" PRIu32 "\n",
+          (unsigned)req->op, req->page);
+    req->res = _exec(async->mtd, req);
+    event_post(req->queue, &req->super);
+
+    /* one request at a time, so other events on the worker queue get their
+     * turn in between */
+    if (more) {
+        event_post(async->worker, &async->work);
+    }
+}
+
+void mtd_async_init(mtd_async_t *async, mtd_dev_t *mtd, event_queue_t *worker)
+{
+    async->work.handler = _work;
+    async->mtd = mtd;
+    async->worker = worker;
+    async->pending = NULL;
+    mutex_init(&async->lock);
+}
+
+int mtd_async_submit(mtd_async_t *async, mtd_async_req_t *req)
+{
+    if ((req->super.handler == NULL) || (req->queue == NULL)) {
+        return -EINVAL;
+    }
+
+    req->next = NULL;
+    req->res = -EINPROGRESS;
+
+    mutex_lock(&async->lock);
+    mtd_async_req_t **tail = &async->pending;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = req;
+    mutex_unlock(&async->lock);
+
+    event_post(async->worker, &async->work);
+    return 0;
+}
+
+int mtd_async_cancel(mtd_async_t *async, mtd_async_req_t *req)
+{
+    int res = -EALREADY;
+
+    mutex_lock(&async->lock);
+    for (mtd_async_req_t **tmp = &async->pending; *tmp; tmp = &(*tmp)->next) {
+        if (*tmp == req) {
+            *tmp = req->next;
+            req->next = NULL;
+            res = 0;
+            break;
+        }
+    }
+    mutex_unlock(&async->lock);
+    return res;
+}
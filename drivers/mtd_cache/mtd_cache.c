@@ -0,0 +1,435 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       Write-back sector cache for MTD devices
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "mutex.h"
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+#include "event/thread.h"
+#include "timex.h"
+#endif
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+static uint32_t _sector_size(const mtd_dev_t *mtd)
+{
+    return mtd->pages_per_sector * mtd->page_size;
+}
+
+static void _reset_range(mtd_cache_slot_t *slot)
+{
+    slot->first_page = UINT16_MAX;
+    slot->last_page = 0;
+}
+
+static bool _page_erased(const uint8_t *buf, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        if (buf[i] != 0xff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t _programmed_size(const mtd_dev_t *mtd)
+{
+    return (mtd->pages_per_sector + 7) / 8;
+}
+
+/**
+ * @brief   Checks whether writing @p data over @p old in a page requires to
+ *          erase the sector first
+ *
+ * @param[in] parent    The backing device
+ * @param[in] slot      The slot of the sector
+ * @param[in] idx       Page in the sector
+ * @param[in] old       Cached content at the position written to
+ * @param[in] data      Data written
+ * @param[in] len       Number of bytes written
+ */
+static bool _needs_erase(const mtd_dev_t *parent, mtd_cache_slot_t *slot,
+                         uint16_t idx, const uint8_t *old, const uint8_t *data,
+                         uint32_t len)
+{
+    /* a page that is erased on the device takes any data, no matter what
+     * was written to the cache since the last write-back */
+    if (!bf_isset(slot->programmed, idx)) {
+        return false;
+    }
+    /* without clearing overwrite, a page can only be programmed once */
+    if (!(parent->driver->flags & MTD_DRIVER_FLAG_CLEARING_OVERWRITE)) {
+        return true;
+    }
+    /* flash can only clear bits without erasing the sector */
+    for (uint32_t i = 0; i < len; i++) {
+        if (data[i] & ~old[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int _write_back(mtd_cache_t *cache, mtd_cache_slot_t *slot)
+{
+    mtd_dev_t *parent = cache->parent;
+    uint32_t first_page = slot->first_page;
+    uint32_t last_page = slot->last_page;
+    int res;
+
+    DEBUG("mtd_cache: write back sector %" PRIu32 "%s\n", slot->sector,
+          slot->erase ? " with erase" : "");
+    if (slot->erase) {
+        res = mtd_erase_sector(parent, slot->sector, 1);
+        if (res < 0) {
+            return res;
+        }
+        cache->stats.erased++;
+        slot->erase = false;
+        memset(slot->programmed, 0, _programmed_size(parent));
+        first_page = 0;
+        last_page = parent->pages_per_sector - 1;
+    }
+    for (uint32_t i = first_page; i <= last_page; i++) {
+        const uint8_t *buf = &slot->buf[i * parent->page_size];
+
+        /* an erased page needs no programming, neither does a page that
+         * holds 0xff without erase, as only cleared bits were written */
+        if (_page_erased(buf, parent->page_size)) {
+            continue;
+        }
+        res = mtd_write_page_raw(parent, buf,
+                                 (slot->sector * parent->pages_per_sector) + i,
+                                 0, parent->page_size);
+        if (res < 0) {
+            /* retry the remaining pages on next write-back, after an erase
+             * that includes the pages outside of the changed range */
+            slot->first_page = i;
+            slot->last_page = last_page;
+            return res;
+        }
+        bf_set(slot->programmed, i);
+        cache->stats.programmed += parent->page_size;
+    }
+    slot->dirty = false;
+    _reset_range(slot);
+    return 0;
+}
+
+static mtd_cache_slot_t *_find(mtd_cache_t *cache, uint32_t sector)
+{
+    for (unsigned i = 0; i < CONFIG_MTD_CACHE_SECTORS; i++) {
+        mtd_cache_slot_t *slot = &cache->slots[i];
+
+        if (slot->valid && (slot->sector == sector)) {
+            slot->last_use = ++cache->use_count;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief   Gets the slot of @p sector, evicts the least recently used sector
+ *          if it is not cached yet
+ *
+ * @param[in] cache     The cache
+ * @param[in] sector    Sector to get
+ * @param[in] load      Load the content of @p sector from the backing device
+ *                      if it is not cached yet
+ * @param[out] res      Error of the backing device if NULL is returned
+ */
+static mtd_cache_slot_t *_get(mtd_cache_t *cache, uint32_t sector, bool load,
+                              int *res)
+{
+    mtd_cache_slot_t *slot = _find(cache, sector);
+
+    if (slot != NULL) {
+        return slot;
+    }
+    slot = &cache->slots[0];
+    for (unsigned i = 0; i < CONFIG_MTD_CACHE_SECTORS; i++) {
+        mtd_cache_slot_t *tmp = &cache->slots[i];
+
+        if (!tmp->valid) {
+            slot = tmp;
+            break;
+        }
+        if (tmp->last_use < slot->last_use) {
+            slot = tmp;
+        }
+    }
+    if (slot->valid && slot->dirty && ((*res = _write_back(cache, slot)) < 0)) {
+        return NULL;
+    }
+    slot->valid = false;
+    memset(slot->programmed, 0, _programmed_size(cache->parent));
+    if (load) {
+        mtd_dev_t *parent = cache->parent;
+
+        *res = mtd_read_page(parent, slot->buf,
+                             sector * parent->pages_per_sector, 0,
+                             _sector_size(parent));
+        if (*res < 0) {
+            return NULL;
+        }
+        for (uint32_t i = 0; i < parent->pages_per_sector; i++) {
+            if (!_page_erased(&slot->buf[i * parent->page_size],
+                              parent->page_size)) {
+                bf_set(slot->programmed, i);
+            }
+        }
+    }
+    else {
+        memset(slot->buf, 0xff, _sector_size(cache->parent));
+    }
+    slot->sector = sector;
+    slot->last_use = ++cache->use_count;
+    slot->valid = true;
+    slot->dirty = false;
+    slot->erase = false;
+    _reset_range(slot);
+    return slot;
+}
+
+static void _schedule_flush(mtd_cache_t *cache)
+{
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+    event_timeout_set(&cache->flush_timeout,
+                      CONFIG_MTD_CACHE_FLUSH_TIMEOUT_MS * US_PER_MS);
+#else
+    (void)cache;
+#endif
+}
+
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+static void _flush_handler(event_t *event)
+{
+    mtd_cache_t *cache = container_of(event, mtd_cache_t, flush_event);
+
+    mtd_cache_flush(cache);
+}
+#endif
+
+static int _init(mtd_dev_t *mtd)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    mtd_dev_t *parent = cache->parent;
+    int res = mtd_init(parent);
+
+    if (res < 0) {
+        return res;
+    }
+    /* the dirty page range of a slot is kept in 16 bits */
+    assert(parent->pages_per_sector <= UINT16_MAX);
+    mtd->sector_count = parent->sector_count;
+    mtd->pages_per_sector = parent->pages_per_sector;
+    mtd->page_size = parent->page_size;
+    for (unsigned i = 0; i < CONFIG_MTD_CACHE_SECTORS; i++) {
+        mtd_cache_slot_t *slot = &cache->slots[i];
+
+        if (slot->buf == NULL) {
+            /* the bitfield of programmed pages follows the sector */
+            slot->buf = malloc(_sector_size(parent) + _programmed_size(parent));
+            if (slot->buf == NULL) {
+                return -ENOMEM;
+            }
+            slot->programmed = &slot->buf[_sector_size(parent)];
+        }
+        slot->valid = false;
+    }
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+    cache->flush_event.handler = _flush_handler;
+    event_timeout_init(&cache->flush_timeout, EVENT_PRIO_LOWEST,
+                       &cache->flush_event);
+#endif
+    return 0;
+}
+
+static int _read_page(mtd_dev_t *mtd, void *dest, uint32_t page,
+                      uint32_t offset, uint32_t size)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    uint32_t sector = page / mtd->pages_per_sector;
+    uint32_t sector_offset = ((page % mtd->pages_per_sector) * mtd->page_size) +
+                             offset;
+    int res = 0;
+
+    if (sector >= mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+    /* read up to the end of the sector */
+    size = MIN(size, _sector_size(mtd) - sector_offset);
+
+    mutex_lock(&cache->lock);
+    mtd_cache_slot_t *slot = _find(cache, sector);
+    if (slot != NULL) {
+        memcpy(dest, &slot->buf[sector_offset], size);
+    }
+    else {
+        res = mtd_read_page(cache->parent, dest, page, offset, size);
+    }
+    mutex_unlock(&cache->lock);
+    return (res < 0) ? res : (int)size;
+}
+
+static int _write_page(mtd_dev_t *mtd, const void *src, uint32_t page,
+                       uint32_t offset, uint32_t size)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    uint32_t sector = page / mtd->pages_per_sector;
+    uint32_t sector_offset = ((page % mtd->pages_per_sector) * mtd->page_size) +
+                             offset;
+    const uint8_t *data = src;
+    int res = 0;
+
+    if (sector >= mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+    /* write up to the end of the sector */
+    size = MIN(size, _sector_size(mtd) - sector_offset);
+
+    mutex_lock(&cache->lock);
+    mtd_cache_slot_t *slot = _get(cache, sector, true, &res);
+    if (slot == NULL) {
+        mutex_unlock(&cache->lock);
+        return res;
+    }
+
+    /* only pages that change are programmed again, as programming a page
+     * with the same data isn't possible on all flash either */
+    for (uint32_t pos = 0; pos < size;) {
+        uint32_t page_offset = (sector_offset + pos) % mtd->page_size;
+        uint32_t len = MIN(size - pos, mtd->page_size - page_offset);
+        uint16_t idx = (sector_offset + pos) / mtd->page_size;
+        uint8_t *buf = &slot->buf[sector_offset + pos];
+
+        if (memcmp(buf, &data[pos], len) != 0) {
+            if (!slot->erase &&
+                _needs_erase(cache->parent, slot, idx, buf, &data[pos], len)) {
+                slot->erase = true;
+            }
+            memcpy(buf, &data[pos], len);
+            slot->dirty = true;
+            slot->first_page = MIN(slot->first_page, idx);
+            slot->last_page = MAX(slot->last_page, idx);
+        }
+        pos += len;
+    }
+    cache->stats.written += size;
+    if (slot->dirty) {
+        _schedule_flush(cache);
+    }
+    mutex_unlock(&cache->lock);
+    return size;
+}
+
+static int _erase_sector(mtd_dev_t *mtd, uint32_t sector, uint32_t count)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    int res = 0;
+
+    if ((sector + count) > mtd->sector_count) {
+        return -EOVERFLOW;
+    }
+
+    mutex_lock(&cache->lock);
+    for (uint32_t i = 0; i < count; i++) {
+        mtd_cache_slot_t *slot = _get(cache, sector + i, false, &res);
+
+        if (slot == NULL) {
+            break;
+        }
+        /* erasing is deferred, so it can be coalesced with following
+         * writes */
+        memset(slot->buf, 0xff, _sector_size(mtd));
+        slot->dirty = true;
+        slot->erase = true;
+    }
+    if (res == 0) {
+        _schedule_flush(cache);
+    }
+    mutex_unlock(&cache->lock);
+    return res;
+}
+
+static int _power(mtd_dev_t *mtd, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = container_of(mtd, mtd_cache_t, mtd);
+    int res = 0;
+
+    if (power == MTD_POWER_DOWN) {
+        res = mtd_cache_flush(cache);
+    }
+
+    int power_res = mtd_power(cache->parent, power);
+
+    return (res < 0) ? res : power_res;
+}
+
+int mtd_cache_flush(mtd_cache_t *cache)
+{
+    int res = 0;
+
+    mutex_lock(&cache->lock);
+    for (unsigned i = 0; i < CONFIG_MTD_CACHE_SECTORS; i++) {
+        mtd_cache_slot_t *slot = &cache->slots[i];
+
+        if (slot->valid && slot->dirty) {
+            int tmp = _write_back(cache, slot);
+
+            if (res == 0) {
+                res = tmp;
+            }
+        }
+    }
+#if IS_USED(MODULE_MTD_CACHE_AUTOFLUSH)
+    event_timeout_clear(&cache->flush_timeout);
+#endif
+    mutex_unlock(&cache->lock);
+    return res;
+}
+
+void mtd_cache_get_stats(mtd_cache_t *cache, mtd_cache_stats_t *stats)
+{
+    mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    mutex_unlock(&cache->lock);
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read_page = _read_page,
+    .write_page = _write_page,
+    .erase_sector = _erase_sector,
+    .power = _power,
+    .flags = MTD_DRIVER_FLAG_DIRECT_WRITE,
+};
@@ -74,17 +74,31 @@ static inline spi_t _get_spi(const mtd_spi_nor_t *dev)
     return dev->params->spi;
 }
 
-static void mtd_spi_acquire(const mtd_spi_nor_t *dev)
+static void mtd_spi_acquire_bus(const mtd_spi_nor_t *dev)
 {
     spi_acquire(_get_spi(dev), dev->params->cs,
                 dev->params->mode, dev->params->clk);
 }
 
-static void mtd_spi_release(const mtd_spi_nor_t *dev)
+static void mtd_spi_release_bus(const mtd_spi_nor_t *dev)
 {
     spi_release(_get_spi(dev));
 }
 
+/* The chip is locked for the whole operation, the bus is released while the
+ * chip is busy, see wait_for_write_complete() */
+static void mtd_spi_acquire(mtd_spi_nor_t *dev)
+{
+    mutex_lock(&dev->lock);
+    mtd_spi_acquire_bus(dev);
+}
+
+static void mtd_spi_release(mtd_spi_nor_t *dev)
+{
+    mtd_spi_release_bus(dev);
+    mutex_unlock(&dev->lock);
+}
+
 static inline uint8_t* _be_addr(const mtd_spi_nor_t *dev, uint32_t *addr)
 {
     *addr = htonl(*addr);
@@ -308,6 +322,8 @@ static uint32_t mtd_spi_nor_get_size(const mtd_jedec_id_t *id)
     return 1 << id->device[1];
 }
 
+/* Polls the status register until the chip is done. Other devices may use the
+ * bus in between, the bus is acquired again before returning. */
 static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us)
 {
     unsigned i = 0, j = 0;
@@ -325,6 +341,7 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us
             break;
         }
         i++;
+        mtd_spi_release_bus(dev);
 #if MODULE_XTIMER
         if (us) {
             xtimer_usleep(us);
@@ -347,6 +364,7 @@ static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us
         (void) us;
         thread_yield();
 #endif
+        mtd_spi_acquire_bus(dev);
     } while (1);
     DEBUG("wait loop %u times, yield %u times", i, j);
     if (IS_ACTIVE(ENABLE_DEBUG) && IS_ACTIVE(MODULE_XTIMER)) {
@@ -395,6 +413,7 @@ static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
                 retries++;
             } while (res < 0 && retries < MTD_POWER_UP_WAIT_FOR_ID);
             if (res < 0) {
+                mtd_spi_release(dev);
                 return -EIO;
             }
 #endif
@@ -426,6 +445,8 @@ static int mtd_spi_nor_init(mtd_dev_t *mtd)
     assert(dev->params->addr_width > 0);
     assert(dev->params->addr_width <= 4);
 
+    mutex_init(&dev->lock);
+
     /* CS, WP, Hold */
     _init_pins(dev);
 
@@ -508,7 +529,7 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
 {
     DEBUG("mtd_spi_nor_read: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
           (void *)mtd, dest, addr, size);
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     uint32_t chipsize = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
 
     if (addr > chipsize) {
@@ -537,7 +558,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     if (size == 0) {
         return 0;
     }
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     if (size > mtd->page_size) {
         DEBUG("mtd_spi_nor_write: ERR: page program >1 page (%" PRIu32 ")!\n", mtd->page_size);
         return -EOVERFLOW;
@@ -570,7 +591,7 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
 static int mtd_spi_nor_write_page(mtd_dev_t *mtd, const void *src, uint32_t page, uint32_t offset,
                                   uint32_t size)
 {
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
 
     DEBUG("mtd_spi_nor_write_page: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 ", 0x%" PRIx32 "\n",
           (void *)mtd, src, page, offset, size);
@@ -679,4 +700,5 @@ const mtd_desc_t mtd_spi_nor_driver = {
     .write_page = mtd_spi_nor_write_page,
     .erase = mtd_spi_nor_erase,
     .power = mtd_spi_nor_power,
+    .flags = MTD_DRIVER_FLAG_CLEARING_OVERWRITE,
 };
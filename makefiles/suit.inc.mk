@@ -25,6 +25,23 @@ SUIT_VENDOR ?= "riot-os.org"
 SUIT_SEQNR ?= $(APP_VER)
 SUIT_CLASS ?= $(BOARD)
 
+# Set to the APP_VER of the firmware running on the device to publish the
+# update as delta patches against it (requires the riotboot_delta module).
+# The new image for each slot is diffed against the old image of the other
+# slot, which is the one running when that slot is updated.
+SUIT_DELTA_BASE_VER ?=
+
+ifneq (,$(SUIT_DELTA_BASE_VER))
+  SUIT_DELTA_BINS = $(SLOT0_RIOT_BIN).delta $(SLOT1_RIOT_BIN).delta
+  SUIT_DELTA_FLAGS = --delta
+
+$(SLOT0_RIOT_BIN).delta: $(SLOT0_RIOT_BIN) $(BINDIR_APP)-slot1.$(SUIT_DELTA_BASE_VER).riot.bin
+	$(Q)$(RIOTBASE)/dist/tools/riotboot_delta/gen_delta.py $(word 2,$^) $< $@
+
+$(SLOT1_RIOT_BIN).delta: $(SLOT1_RIOT_BIN) $(BINDIR_APP)-slot0.$(SUIT_DELTA_BASE_VER).riot.bin
+	$(Q)$(RIOTBASE)/dist/tools/riotboot_delta/gen_delta.py $(word 2,$^) $< $@
+endif
+
 #
 $(SUIT_MANIFEST): $(SLOT0_RIOT_BIN) $(SLOT1_RIOT_BIN)
 	$(Q)$(RIOTBASE)/dist/tools/suit/gen_manifest.py \
@@ -32,6 +49,7 @@ $(SUIT_MANIFEST): $(SLOT0_RIOT_BIN) $(SLOT1_RIOT_BIN)
 	  --seqnr $(SUIT_SEQNR) \
 	  --uuid-vendor $(SUIT_VENDOR) \
 	  --uuid-class $(SUIT_CLASS) \
+	  $(SUIT_DELTA_FLAGS) \
 	  -o $@.tmp \
 	  $(SLOT0_RIOT_BIN):$(SLOT0_OFFSET) \
 	  $(SLOT1_RIOT_BIN):$(SLOT1_OFFSET)
@@ -57,7 +75,7 @@ SUIT_MANIFESTS := $(SUIT_MANIFEST) \
 
 suit/manifest: $(SUIT_MANIFESTS)
 
-suit/publish: $(SUIT_MANIFESTS) $(SLOT0_RIOT_BIN) $(SLOT1_RIOT_BIN)
+suit/publish: $(SUIT_MANIFESTS) $(SLOT0_RIOT_BIN) $(SLOT1_RIOT_BIN) $(SUIT_DELTA_BINS)
 	$(Q)mkdir -p $(SUIT_COAP_FSROOT)/$(SUIT_COAP_BASEPATH)
 	$(Q)cp $^ $(SUIT_COAP_FSROOT)/$(SUIT_COAP_BASEPATH)
 	$(Q)for file in $^; do \
@@ -253,6 +253,13 @@ static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
     return fatfs_err_to_errno(res);
 }
 
+static int _fsync(vfs_file_t *filp)
+{
+    fatfs_file_desc_t *fd = (fatfs_file_desc_t *)filp->private_data.buffer;
+
+    return fatfs_err_to_errno(f_sync(&fd->file));
+}
+
 static int _fstat(vfs_file_t *filp, struct stat *buf)
 {
     fatfs_desc_t *fs_desc = (fatfs_desc_t *)filp->mp->private_data;
@@ -453,6 +460,7 @@ static const vfs_file_ops_t fatfs_file_ops = {
     .write = _write,
     .lseek = _lseek,
     .fstat = _fstat,
+    .fsync = _fsync,
 };
 
 static const vfs_dir_ops_t fatfs_dir_ops = {
@@ -573,12 +573,13 @@ int lwip_sock_recv(struct netconn *conn, uint32_t timeout, struct netbuf **buf)
 }
 #endif /* defined(MODULE_LWIP_SOCK_UDP) || defined(MODULE_LWIP_SOCK_IP) */
 
-ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
-                       int proto, const struct _sock_tl_ep *remote, int type)
+ssize_t lwip_sock_sendv(struct netconn *conn, const iolist_t *snips,
+                        int proto, const struct _sock_tl_ep *remote, int type)
 {
     ip_addr_t remote_addr;
     struct netconn *tmp;
     struct netbuf *buf;
+    size_t len = iolist_size(snips);
     int res;
     err_t err;
     u16_t remote_port = 0;
@@ -598,11 +599,21 @@ ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
     }
 
     buf = netbuf_new();
-    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL) ||
-        (netbuf_take(buf, data, len) != ERR_OK)) {
+    if ((buf == NULL) || (netbuf_alloc(buf, len) == NULL)) {
         netbuf_delete(buf);
         return -ENOMEM;
     }
+    /* gather payload chunks into the netbuf */
+    res = 0;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        if ((snip->iol_len > 0) &&
+            (pbuf_take_at(buf->p, snip->iol_base, snip->iol_len,
+                          res) != ERR_OK)) {
+            netbuf_delete(buf);
+            return -ENOMEM;
+        }
+        res += snip->iol_len;
+    }
     if ((conn == NULL) && (remote != NULL)) {
         if ((res = _create(type, proto, 0, &tmp)) < 0) {
             netbuf_delete(buf);
@@ -617,6 +628,7 @@ ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
              (remote->netif != SOCK_ADDR_ANY_NETIF) &&
              (netconn_getaddr(conn, &addr, &port, 1) == 0) &&
              (remote->netif != lwip_sock_bind_addr_to_netif(&addr)))) {
+            netbuf_delete(buf);
             return -EINVAL;
         }
         tmp = conn;
@@ -631,7 +643,19 @@ ssize_t lwip_sock_send(struct netconn *conn, const void *data, size_t len,
     }
 #if LWIP_TCP
     else if (tmp->type & NETCONN_TCP) {
-        err = netconn_write_partly(tmp, data, len, 0, (size_t *)(&res));
+        err = ERR_OK;
+        res = 0;
+        for (const iolist_t *snip = snips; (snip != NULL) && (err == ERR_OK);
+             snip = snip->iol_next) {
+            size_t written = 0;
+
+            err = netconn_write_partly(tmp, snip->iol_base, snip->iol_len, 0,
+                                       &written);
+            res += written;
+            if (written < snip->iol_len) {
+                break;
+            }
+        }
     }
 #endif /* LWIP_TCP */
     else {
@@ -163,18 +163,44 @@ ssize_t sock_udp_recv_buf_aux(sock_udp_t *sock, void **data, void **ctx,
     return (ssize_t)buf->ptr->len;
 }
 
-ssize_t sock_udp_send_aux(sock_udp_t *sock, const void *data, size_t len,
-                          const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux)
+int sock_udp_recv_multi(sock_udp_t *sock, sock_udp_msg_t *msgs, unsigned num,
+                        uint32_t timeout)
+{
+    unsigned i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (num > 0));
+    while (i < num) {
+        ssize_t res = sock_udp_recv(sock, msgs[i].data, msgs[i].max_len,
+                                    timeout, &msgs[i].remote);
+
+        if ((res < 0) && (res != -ENOBUFS)) {
+            if (i == 0) {
+                return res;
+            }
+            else if (res == -EPROTO) {
+                /* drop message from wrong remote and keep on draining */
+                continue;
+            }
+            break;
+        }
+        msgs[i++].len = res;
+        /* only wait for the first message */
+        timeout = 0;
+    }
+    return i;
+}
+
+ssize_t sock_udp_sendv_aux(sock_udp_t *sock, const iolist_t *snips,
+                           const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux)
 {
     (void)aux;
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if ((remote != NULL) && (remote->port == 0)) {
         return -EINVAL;
     }
-    return lwip_sock_send((sock) ? sock->base.conn : NULL, data, len, 0,
-                          (struct _sock_tl_ep *)remote, NETCONN_UDP);
+    return lwip_sock_sendv((sock) ? sock->base.conn : NULL, snips, 0,
+                           (struct _sock_tl_ep *)remote, NETCONN_UDP);
 }
 
 #ifdef SOCK_HAS_ASYNC
@@ -215,12 +215,13 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
     return 0;
 }
 
-ssize_t sock_udp_send_aux(sock_udp_t *sock, const void *data, size_t len,
-                          const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux)
+ssize_t sock_udp_sendv_aux(sock_udp_t *sock, const iolist_t *snips,
+                           const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux)
 {
     (void)aux;
     OpenQueueEntry_t *pkt;
     open_addr_t dst_addr, src_addr;
+    size_t len = iolist_size(snips);
 
     memset(&dst_addr, 0, sizeof(open_addr_t));
     memset(&src_addr, 0, sizeof(open_addr_t));
@@ -228,7 +229,6 @@ ssize_t sock_udp_send_aux(sock_udp_t *sock, const void *data, size_t len,
 
     /* asserts for sock_udp_send "pre" */
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     /* check remote */
     if (remote != NULL) {
@@ -307,7 +307,11 @@ ssize_t sock_udp_send_aux(sock_udp_t *sock, const void *data, size_t len,
         openqueue_freePacketBuffer(pkt);
         return -ENOMEM;
     }
-    memcpy(pkt->payload, data, len);
+    uint8_t *payload = pkt->payload;
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        memcpy(payload, snip->iol_base, snip->iol_len);
+        payload += snip->iol_len;
+    }
     pkt->l4_payload = pkt->payload;
     pkt->l4_length = pkt->length;
 
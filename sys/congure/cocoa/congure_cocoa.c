@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <inttypes.h>
+
+#include "congure/cocoa.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define STRONG_K            (4)     /**< K of the strong estimator */
+#define WEAK_K              (1)     /**< K of the weak estimator */
+#define WEAK_MAX_RESENDS    (2U)    /**< resends fed to the weak estimator */
+
+static void _snd_init(congure_snd_t *cong, void *ctx);
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs);
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs);
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack);
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time);
+
+static const congure_snd_driver_t _driver = {
+    .init = _snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = _snd_report_msg_sent,
+    .report_msg_discarded = _snd_report_msg_discarded,
+    .report_msgs_timeout = _snd_report_msgs_timeout,
+    .report_msgs_lost = _snd_report_msgs_lost,
+    .report_msg_acked = _snd_report_msg_acked,
+    .report_ecn_ce = _snd_report_ecn_ce,
+};
+
+void congure_cocoa_snd_setup(congure_cocoa_snd_t *c)
+{
+    c->super.driver = &_driver;
+}
+
+uint32_t congure_cocoa_snd_rto(congure_cocoa_snd_t *c, ztimer_now_t now)
+{
+    uint32_t idle = now - c->last_update;
+
+    /* RTO aging, draft-ietf-core-cocoa-03, section 4.2.3 */
+    if ((c->rto < 1000U) && (idle > (16U * c->rto))) {
+        c->rto *= 2;
+        c->last_update = now;
+    }
+    else if ((c->rto > 3000U) && (idle > (4U * c->rto))) {
+        c->rto = 1000U + (c->rto / 2);
+        c->last_update = now;
+    }
+    return c->rto;
+}
+
+static void _rm_in_flight(congure_cocoa_snd_t *c, unsigned num)
+{
+    c->in_flight = (c->in_flight > num) ? (c->in_flight - num) : 0;
+}
+
+static unsigned _msgs_num(congure_snd_msg_t *msgs)
+{
+    congure_snd_msg_t *msg = msgs;
+    unsigned num = 0;
+
+    /* msgs is an element of a circular clist */
+    do {
+        num++;
+        msg = (congure_snd_msg_t *)msg->super.next;
+    } while ((msg != NULL) && (msg != msgs));
+    return num;
+}
+
+/* RFC 6298, section 2, with K of the estimator */
+static uint32_t _est_update(congure_cocoa_est_t *est, int32_t rtt, int32_t k)
+{
+    if (est->srtt == 0) {
+        est->srtt = (rtt > 0) ? rtt : 1;
+        est->rttvar = rtt / 2;
+    }
+    else {
+        int32_t diff = est->srtt - rtt;
+
+        est->rttvar = ((3 * est->rttvar) + ((diff < 0) ? -diff : diff)) / 4;
+        est->srtt = ((7 * est->srtt) + rtt) / 8;
+        if (est->srtt == 0) {
+            est->srtt = 1;
+        }
+    }
+    return est->srtt + (k * est->rttvar);
+}
+
+static void _snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+
+    c->super.ctx = ctx;
+    c->super.cwnd = CONFIG_CONGURE_COCOA_NSTART;
+    c->strong.srtt = 0;
+    c->strong.rttvar = 0;
+    c->weak.srtt = 0;
+    c->weak.rttvar = 0;
+    c->rto = CONFIG_CONGURE_COCOA_INIT_RTO_MS;
+    c->last_update = 0;
+    c->in_flight = 0;
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+    /* no pacing */
+    return -1;
+}
+
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+
+    c->in_flight += msg_size;
+}
+
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size)
+{
+    _rm_in_flight((congure_cocoa_snd_t *)cong, msg_size);
+}
+
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs)
+{
+    /* the backoff is applied per message by the caller, the RTO estimate
+     * only changes with acknowledgements */
+    _rm_in_flight((congure_cocoa_snd_t *)cong, _msgs_num(msgs));
+}
+
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs)
+{
+    _rm_in_flight((congure_cocoa_snd_t *)cong, _msgs_num(msgs));
+}
+
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack)
+{
+    congure_cocoa_snd_t *c = (congure_cocoa_snd_t *)cong;
+    int32_t rtt = (int32_t)(ack->recv_time - msg->send_time);
+
+    _rm_in_flight(c, 1);
+    if (rtt < 0) {
+        return;
+    }
+    /* draft-ietf-core-cocoa-03, section 4.2.1 */
+    if (msg->resends == 0) {
+        uint32_t e = _est_update(&c->strong, rtt, STRONG_K);
+
+        c->rto = (e / 2) + (c->rto / 2);
+    }
+    else if (msg->resends <= WEAK_MAX_RESENDS) {
+        uint32_t e = _est_update(&c->weak, rtt, WEAK_K);
+
+        c->rto = (e / 4) + ((3 * c->rto) / 4);
+    }
+    else {
+        return;
+    }
+    c->last_update = ack->recv_time;
+    DEBUG("congure_cocoa: %p RTO %" PRIu32 " ms\n", (void *)c, c->rto);
+}
+
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time)
+{
+    (void)cong;
+    (void)time;
+}
+
+/** @} */
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "congure/reno.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+static void _snd_init(congure_snd_t *cong, void *ctx);
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size);
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs);
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs);
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack);
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time);
+
+static const congure_snd_driver_t _driver = {
+    .init = _snd_init,
+    .inter_msg_interval = _snd_inter_msg_interval,
+    .report_msg_sent = _snd_report_msg_sent,
+    .report_msg_discarded = _snd_report_msg_discarded,
+    .report_msgs_timeout = _snd_report_msgs_timeout,
+    .report_msgs_lost = _snd_report_msgs_lost,
+    .report_msg_acked = _snd_report_msg_acked,
+    .report_ecn_ce = _snd_report_ecn_ce,
+};
+
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_snd_consts_t *consts)
+{
+    assert(consts != NULL);
+    c->super.driver = &_driver;
+    c->consts = consts;
+    c->mss = 0;
+}
+
+static congure_wnd_size_t _wnd(uint32_t size)
+{
+    return (size > CONGURE_WND_SIZE_MAX) ? CONGURE_WND_SIZE_MAX
+                                         : (congure_wnd_size_t)size;
+}
+
+static void _rm_in_flight(congure_reno_snd_t *c, unsigned size)
+{
+    c->in_flight_size = (c->in_flight_size > size)
+                      ? (c->in_flight_size - size) : 0;
+}
+
+static void _rm_msgs_in_flight(congure_reno_snd_t *c, congure_snd_msg_t *msgs)
+{
+    congure_snd_msg_t *msg = msgs;
+
+    /* msgs is an element of a circular clist */
+    do {
+        _rm_in_flight(c, msg->size);
+        msg = (congure_snd_msg_t *)msg->super.next;
+    } while ((msg != NULL) && (msg != msgs));
+}
+
+static void _set_ssthresh(congure_reno_snd_t *c)
+{
+    /* RFC 5681, equation (4) */
+    uint32_t ssthresh = c->in_flight_size / 2;
+
+    if (ssthresh < (2U * c->mss)) {
+        ssthresh = 2U * c->mss;
+    }
+    c->ssthresh = _wnd(ssthresh);
+}
+
+static void _snd_init(congure_snd_t *cong, void *ctx)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->super.ctx = ctx;
+    if (c->mss == 0) {
+        c->mss = c->consts->init_mss;
+    }
+    /* initial window, RFC 5681, section 3.1 */
+    if (c->mss > 2190) {
+        c->super.cwnd = _wnd(2U * c->mss);
+    }
+    else if (c->mss > 1095) {
+        c->super.cwnd = _wnd(3U * c->mss);
+    }
+    else {
+        c->super.cwnd = _wnd(4U * c->mss);
+    }
+    c->ssthresh = c->consts->init_ssthresh;
+    c->in_flight_size = 0;
+    c->last_wnd = 0;
+    c->dup_acks = 0;
+    c->in_recovery = false;
+}
+
+static int32_t _snd_inter_msg_interval(congure_snd_t *cong, unsigned msg_size)
+{
+    (void)cong;
+    (void)msg_size;
+    /* no pacing */
+    return -1;
+}
+
+static void _snd_report_msg_sent(congure_snd_t *cong, unsigned msg_size)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    c->in_flight_size = _wnd((uint32_t)c->in_flight_size + msg_size);
+}
+
+static void _snd_report_msg_discarded(congure_snd_t *cong, unsigned msg_size)
+{
+    _rm_in_flight((congure_reno_snd_t *)cong, msg_size);
+}
+
+static void _snd_report_msgs_timeout(congure_snd_t *cong,
+                                     congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    DEBUG("congure_reno: %p timeout, cwnd %u\n", (void *)c, c->super.cwnd);
+    _set_ssthresh(c);
+    /* loss window, RFC 5681, section 3.1 */
+    c->super.cwnd = _wnd(c->mss);
+    c->dup_acks = 0;
+    c->in_recovery = false;
+    /* timed out messages are resent by the caller */
+    _rm_msgs_in_flight(c, msgs);
+}
+
+static void _snd_report_msgs_lost(congure_snd_t *cong, congure_snd_msg_t *msgs)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    DEBUG("congure_reno: %p loss, cwnd %u\n", (void *)c, c->super.cwnd);
+    if (!c->in_recovery) {
+        _set_ssthresh(c);
+        c->super.cwnd = c->ssthresh;
+    }
+    _rm_msgs_in_flight(c, msgs);
+}
+
+static void _dup_ack(congure_reno_snd_t *c, congure_snd_ack_t *ack)
+{
+    c->dup_acks++;
+    if (c->in_recovery) {
+        /* inflate window for every segment that left the network */
+        c->super.cwnd = _wnd((uint32_t)c->super.cwnd + c->mss);
+    }
+    else if (c->dup_acks == c->consts->frthresh) {
+        DEBUG("congure_reno: %p fast retransmit\n", (void *)c);
+        _set_ssthresh(c);
+        c->super.cwnd = _wnd(c->ssthresh +
+                             ((uint32_t)c->consts->frthresh * c->mss));
+        c->recover = ack->id + c->in_flight_size;
+        c->in_recovery = true;
+        c->consts->fr(c);
+    }
+}
+
+static void _snd_report_msg_acked(congure_snd_t *cong, congure_snd_msg_t *msg,
+                                  congure_snd_ack_t *ack)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+    bool same_wnd = (ack->wnd == c->last_wnd);
+
+    c->last_wnd = ack->wnd;
+    if (msg->size == 0) {
+        /* duplicate ACK as defined in RFC 5681, section 2 */
+        if ((ack->size == 0) && ack->clean && same_wnd &&
+            (c->in_flight_size > 0)) {
+            _dup_ack(c, ack);
+        }
+        return;
+    }
+    _rm_in_flight(c, msg->size);
+    c->dup_acks = 0;
+    if (c->in_recovery) {
+        if ((int32_t)(ack->id - c->recover) >= 0) {
+            /* full acknowledgement, RFC 6582, section 3.2, step 3 */
+            uint32_t cwnd = (uint32_t)c->in_flight_size + c->mss;
+
+            c->super.cwnd = (cwnd < c->ssthresh) ? _wnd(cwnd) : c->ssthresh;
+            c->in_recovery = false;
+        }
+        else {
+            /* partial acknowledgement, RFC 6582, section 3.2, step 4 */
+            uint32_t cwnd = (c->super.cwnd > msg->size)
+                          ? (c->super.cwnd - msg->size) : 0;
+
+            c->super.cwnd = _wnd(cwnd + c->mss);
+            c->consts->fr(c);
+        }
+    }
+    else if (c->super.cwnd < c->ssthresh) {
+        /* slow start */
+        c->super.cwnd = _wnd((uint32_t)c->super.cwnd +
+                             ((msg->size < c->mss) ? msg->size : c->mss));
+    }
+    else {
+        /* congestion avoidance, RFC 5681, equation (3) */
+        uint32_t inc = ((uint32_t)c->mss * c->mss) / c->super.cwnd;
+
+        c->super.cwnd = _wnd((uint32_t)c->super.cwnd + ((inc > 0) ? inc : 1));
+    }
+}
+
+static void _snd_report_ecn_ce(congure_snd_t *cong, ztimer_now_t time)
+{
+    congure_reno_snd_t *c = (congure_reno_snd_t *)cong;
+
+    (void)time;
+    if (!c->in_recovery) {
+        /* RFC 3168, section 6.1.2 */
+        _set_ssthresh(c);
+        c->super.cwnd = c->ssthresh;
+    }
+}
+
+/** @} */
@@ -66,15 +66,25 @@
  * Interface to the aes cipher
  */
 static const cipher_interface_t aes_interface = {
-    AES_BLOCK_SIZE,
-    aes_init,
-    aes_encrypt,
-    aes_decrypt
+    .block_size = AES_BLOCK_SIZE,
+    .init = aes_init,
+    .encrypt = aes_encrypt,
+    .decrypt = aes_decrypt,
+    .encrypt_blocks = aes_encrypt_blocks,
 };
 
 const cipher_id_t CIPHER_AES_128 = &aes_interface;
 const cipher_id_t CIPHER_AES = &aes_interface;
 
+#if !IS_USED(MODULE_CRYPTO_AES_CT)
+/* AES-NI is used on capable hosts, with the same key schedule */
+#if defined(CPU_NATIVE) && (defined(__i386__) || defined(__x86_64__)) && \
+    defined(__GNUC__) && !defined(__clang__)
+#define AES_NI          (1)
+#else
+#define AES_NI          (0)
+#endif
+
 static const u32 Te0[256] = {
     0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU,
     0xfff2f20dU, 0xd66b6bbdU, 0xde6f6fb1U, 0x91c5c554U,
@@ -817,6 +827,7 @@ static const u32 rcon[] = {
     0x10000000, 0x20000000, 0x40000000, 0x80000000,
     0x1B000000, 0x36000000,
 };
+#endif /* !MODULE_CRYPTO_AES_CT */
 
 int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
 {
@@ -857,6 +868,7 @@ int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize)
     return CIPHER_INIT_SUCCESS;
 }
 
+#if !IS_USED(MODULE_CRYPTO_AES_CT)
 /**
  * Expand the cipher key into the encryption key schedule.
  */
@@ -1054,24 +1066,77 @@ static int aes_set_decrypt_key(const unsigned char *userKey, const int bits,
 }
 
 #ifndef AES_ASM
+#if AES_NI
+typedef long long _aes_ni_block_t __attribute__((vector_size(16)));
+
+static inline _aes_ni_block_t _aes_ni_round_key(const u32 *rk)
+{
+    _aes_ni_block_t res;
+    uint8_t bytes[AES_BLOCK_SIZE];
+
+    PUTU32(bytes, rk[0]);
+    PUTU32(bytes + 4, rk[1]);
+    PUTU32(bytes + 8, rk[2]);
+    PUTU32(bytes + 12, rk[3]);
+    memcpy(&res, bytes, sizeof(res));
+    return res;
+}
+
 /*
- * Encrypt a single block
- * in and out can overlap
+ * Encrypt blocks with AES-NI, using the key schedule of aes_set_encrypt_key()
  */
-int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
-                uint8_t *cipherBlock)
+__attribute__((target("aes,sse2")))
+static void _aes_ni_encrypt(const AES_KEY *key, const uint8_t *in,
+                            uint8_t *out, size_t nblocks)
 {
-    /* setup AES_KEY */
-    int res;
-    AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
+    _aes_ni_block_t rk[AES_MAXNR + 1];
 
-    res = aes_set_encrypt_key((unsigned char *)context->context,
-                              AES_KEY_SIZE(context) * 8, &aeskey);
-    if (res < 0) {
-        return res;
+    for (int r = 0; r <= key->rounds; r++) {
+        rk[r] = _aes_ni_round_key(&key->rd_key[4 * r]);
+    }
+
+    for (size_t i = 0; i < nblocks; i++) {
+        _aes_ni_block_t s;
+
+        memcpy(&s, in + i * AES_BLOCK_SIZE, sizeof(s));
+        s ^= rk[0];
+        for (int r = 1; r < key->rounds; r++) {
+            s = __builtin_ia32_aesenc128(s, rk[r]);
+        }
+        s = __builtin_ia32_aesenclast128(s, rk[key->rounds]);
+        memcpy(out + i * AES_BLOCK_SIZE, &s, sizeof(s));
+    }
+}
+
+/*
+ * Decrypt a block with AES-NI. The key schedule of aes_set_decrypt_key() is
+ * the one of the equivalent inverse cipher, as expected by AESDEC.
+ */
+__attribute__((target("aes,sse2")))
+static void _aes_ni_decrypt(const AES_KEY *key, const uint8_t *in,
+                            uint8_t *out)
+{
+    _aes_ni_block_t s;
+    const u32 *rk = key->rd_key;
+
+    memcpy(&s, in, sizeof(s));
+    s ^= _aes_ni_round_key(rk);
+    for (int r = 1; r < key->rounds; r++) {
+        s = __builtin_ia32_aesdec128(s, _aes_ni_round_key(&rk[4 * r]));
     }
+    s = __builtin_ia32_aesdeclast128(s,
+                                     _aes_ni_round_key(&rk[4 * key->rounds]));
+    memcpy(out, &s, sizeof(s));
+}
+#endif /* AES_NI */
 
+/*
+ * Encrypt a single block with an expanded key
+ * in and out can overlap
+ */
+static void _aes_encrypt_block(const AES_KEY *key, const uint8_t *plainBlock,
+                               uint8_t *cipherBlock)
+{
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 
@@ -1320,28 +1385,51 @@ int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
         (Te4((t2) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(cipherBlock + 12, s3);
-    return 1;
+}
+
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
 }
 
 /*
- * Decrypt a single block
- * in and out can overlap
+ * Encrypt consecutive blocks, the key is only expanded once
  */
-int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
-                uint8_t *plainBlock)
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                       uint8_t *cipher, size_t nblocks)
 {
     /* setup AES_KEY */
     int res;
     AES_KEY aeskey;
-    const AES_KEY *key = &aeskey;
 
-    res = aes_set_decrypt_key((unsigned char *)context->context,
+    res = aes_set_encrypt_key((unsigned char *)context->context,
                               AES_KEY_SIZE(context) * 8, &aeskey);
-
     if (res < 0) {
         return res;
     }
 
+#if AES_NI
+    if (__builtin_cpu_supports("aes")) {
+        _aes_ni_encrypt(&aeskey, plain, cipher, nblocks);
+        return 1;
+    }
+#endif
+
+    for (size_t i = 0; i < nblocks; i++) {
+        _aes_encrypt_block(&aeskey, plain + i * AES_BLOCK_SIZE,
+                           cipher + i * AES_BLOCK_SIZE);
+    }
+    return 1;
+}
+
+/*
+ * Decrypt a single block with an expanded key
+ * in and out can overlap
+ */
+static void _aes_decrypt_block(const AES_KEY *key, const uint8_t *cipherBlock,
+                               uint8_t *plainBlock)
+{
     const u32 *rk;
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
 
@@ -1582,7 +1670,36 @@ int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
         (Td4((t0) & 0xff)       & 0x000000ff) ^
         rk[3];
     PUTU32(plainBlock + 12, s3);
+}
+
+/*
+ * Decrypt a single block
+ * in and out can overlap
+ */
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    /* setup AES_KEY */
+    int res;
+    AES_KEY aeskey;
+
+    res = aes_set_decrypt_key((unsigned char *)context->context,
+                              AES_KEY_SIZE(context) * 8, &aeskey);
+
+    if (res < 0) {
+        return res;
+    }
+
+#if AES_NI
+    if (__builtin_cpu_supports("aes")) {
+        _aes_ni_decrypt(&aeskey, cipherBlock, plainBlock);
+        return 1;
+    }
+#endif
+
+    _aes_decrypt_block(&aeskey, cipherBlock, plainBlock);
     return 1;
 }
 
 #endif /* AES_ASM */
+#endif /* !MODULE_CRYPTO_AES_CT */
@@ -0,0 +1,453 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Constant-time bitsliced implementation of the AES cipher
+ *
+ * Two blocks are processed at once. The state is kept in eight 32 bit words,
+ * word i holds bit i of every byte of both blocks, byte k of block b is at
+ * bit 16 * b + k. So each column is a nibble of a word, and the row is the
+ * bit within the nibble. All operations are done with logic operations and
+ * shifts by constant amounts, there are no lookups indexed by secret data.
+ *
+ * The S-box is the circuit of J. Boyar and R. Peralta, "A new combinational
+ * logic minimization technique with applications to cryptology", 2010.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+
+/**
+ * @brief   Expanded key, with the round keys in bitsliced form
+ */
+typedef struct {
+    uint32_t sk[(AES_MAXNR + 1) * 8];   /**< round keys for both blocks */
+    unsigned rounds;                    /**< number of rounds */
+} _aes_ct_key_t;
+
+/* row r of a column gets row r + n, for each nibble */
+#define ROT1(x) ((((x) >> 1) & 0x77777777) | (((x) << 3) & 0x88888888))
+#define ROT2(x) ((((x) >> 2) & 0x33333333) | (((x) << 2) & 0xcccccccc))
+#define ROT3(x) ((((x) >> 3) & 0x11111111) | (((x) << 1) & 0xeeeeeeee))
+
+static void _sbox(uint32_t *q)
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32_t y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    uint32_t y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    uint32_t y20, y21;
+    uint32_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    uint32_t z10, z11, z12, z13, z14, z15, z16, z17;
+    uint32_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    uint32_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    uint32_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    uint32_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    uint32_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    uint32_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    uint32_t t60, t61, t62, t63, t64, t65, t66, t67;
+    uint32_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    /* top linear transformation */
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    /* non-linear section */
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    /* bottom linear transformation */
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/* inverse of the affine transformation of the S-box */
+static void _inv_affine(uint32_t *q)
+{
+    uint32_t t[8];
+
+    for (unsigned i = 0; i < 8; i++) {
+        t[i] = q[(i + 2) & 7] ^ q[(i + 5) & 7] ^ q[(i + 7) & 7];
+    }
+    for (unsigned i = 0; i < 8; i++) {
+        q[i] = t[i];
+    }
+    q[0] = ~q[0];
+    q[2] = ~q[2];
+}
+
+/* the inversion in GF(2^8) is its own inverse, so the S-box can be reused */
+static void _inv_sbox(uint32_t *q)
+{
+    _inv_affine(q);
+    _sbox(q);
+    _inv_affine(q);
+}
+
+static void _shift_rows(uint32_t *q)
+{
+    for (unsigned i = 0; i < 8; i++) {
+        uint32_t x = q[i];
+
+        q[i] = (x & 0x11111111)
+             | ((x >> 4) & 0x02220222) | ((x << 12) & 0x20002000)
+             | ((x >> 8) & 0x00440044) | ((x << 8) & 0x44004400)
+             | ((x >> 12) & 0x00080008) | ((x << 4) & 0x88808880);
+    }
+}
+
+static void _inv_shift_rows(uint32_t *q)
+{
+    for (unsigned i = 0; i < 8; i++) {
+        uint32_t x = q[i];
+
+        q[i] = (x & 0x11111111)
+             | ((x << 4) & 0x22202220) | ((x >> 12) & 0x00020002)
+             | ((x >> 8) & 0x00440044) | ((x << 8) & 0x44004400)
+             | ((x >> 4) & 0x08880888) | ((x << 12) & 0x80008000);
+    }
+}
+
+/* multiplication by x in GF(2^8) */
+static void _xtime(uint32_t *q)
+{
+    uint32_t hi = q[7];
+
+    q[7] = q[6];
+    q[6] = q[5];
+    q[5] = q[4];
+    q[4] = q[3] ^ hi;
+    q[3] = q[2] ^ hi;
+    q[2] = q[1];
+    q[1] = q[0] ^ hi;
+    q[0] = hi;
+}
+
+static void _mix_columns(uint32_t *q)
+{
+    uint32_t r[8], t[8];
+
+    /* 2 * a[r] + 3 * a[r + 1] + a[r + 2] + a[r + 3] */
+    for (unsigned i = 0; i < 8; i++) {
+        r[i] = ROT1(q[i]);
+        t[i] = q[i] ^ r[i];
+    }
+    _xtime(t);
+    for (unsigned i = 0; i < 8; i++) {
+        q[i] = t[i] ^ r[i] ^ ROT2(q[i]) ^ ROT3(q[i]);
+    }
+}
+
+static void _inv_mix_columns(uint32_t *q)
+{
+    uint32_t t[8];
+
+    /* InvMixColumns is MixColumns after adding 4 * (a[r] + a[r + 2]) */
+    for (unsigned i = 0; i < 8; i++) {
+        t[i] = q[i] ^ ROT2(q[i]);
+    }
+    _xtime(t);
+    _xtime(t);
+    for (unsigned i = 0; i < 8; i++) {
+        q[i] ^= t[i];
+    }
+    _mix_columns(q);
+}
+
+static void _add_round_key(uint32_t *q, const uint32_t *sk)
+{
+    for (unsigned i = 0; i < 8; i++) {
+        q[i] ^= sk[i];
+    }
+}
+
+/* bitslice len bytes, to bit offset + k for byte k */
+static void _load(uint32_t *q, const uint8_t *in, unsigned len,
+                  unsigned offset)
+{
+    for (unsigned k = 0; k < len; k++) {
+        for (unsigned i = 0; i < 8; i++) {
+            q[i] |= (uint32_t)((in[k] >> i) & 1) << (offset + k);
+        }
+    }
+}
+
+static void _store(const uint32_t *q, uint8_t *out, unsigned len,
+                   unsigned offset)
+{
+    for (unsigned k = 0; k < len; k++) {
+        uint8_t b = 0;
+
+        for (unsigned i = 0; i < 8; i++) {
+            b |= ((q[i] >> (offset + k)) & 1) << i;
+        }
+        out[k] = b;
+    }
+}
+
+static uint32_t _sub_word(uint32_t w)
+{
+    uint32_t q[8] = { 0 };
+    uint8_t b[4];
+
+    for (unsigned j = 0; j < 4; j++) {
+        b[j] = w >> (8 * j);
+    }
+    _load(q, b, 4, 0);
+    _sbox(q);
+    _store(q, b, 4, 0);
+    return b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static void _set_key(_aes_ct_key_t *key, const cipher_context_t *context)
+{
+    /* words of the key schedule, with the first byte in the lowest bits */
+    uint32_t w[4 * (AES_MAXNR + 1)];
+    unsigned nk = context->key_size / 4;
+    unsigned nw = 4 * (nk + 7);
+    uint8_t rcon = 1;
+
+    key->rounds = nk + 6;
+    for (unsigned i = 0; i < nk; i++) {
+        const uint8_t *k = &context->context[4 * i];
+
+        w[i] = k[0] | (k[1] << 8) | (k[2] << 16) | ((uint32_t)k[3] << 24);
+    }
+    for (unsigned i = nk; i < nw; i++) {
+        uint32_t tmp = w[i - 1];
+
+        if (i % nk == 0) {
+            tmp = _sub_word((tmp >> 8) | (tmp << 24)) ^ rcon;
+            rcon = (rcon << 1) ^ ((rcon >> 7) * 0x1b);
+        }
+        else if ((nk > 6) && (i % nk == 4)) {
+            tmp = _sub_word(tmp);
+        }
+        w[i] = w[i - nk] ^ tmp;
+    }
+
+    memset(key->sk, 0, sizeof(key->sk));
+    for (unsigned r = 0; r <= key->rounds; r++) {
+        uint8_t rk[AES_BLOCK_SIZE];
+
+        for (unsigned k = 0; k < AES_BLOCK_SIZE; k++) {
+            rk[k] = w[4 * r + k / 4] >> (8 * (k % 4));
+        }
+        /* the same round key for both blocks */
+        _load(&key->sk[8 * r], rk, AES_BLOCK_SIZE, 0);
+        _load(&key->sk[8 * r], rk, AES_BLOCK_SIZE, 16);
+    }
+}
+
+static void _encrypt(const _aes_ct_key_t *key, uint32_t *q)
+{
+    _add_round_key(q, key->sk);
+    for (unsigned r = 1; r < key->rounds; r++) {
+        _sbox(q);
+        _shift_rows(q);
+        _mix_columns(q);
+        _add_round_key(q, &key->sk[8 * r]);
+    }
+    _sbox(q);
+    _shift_rows(q);
+    _add_round_key(q, &key->sk[8 * key->rounds]);
+}
+
+static void _decrypt(const _aes_ct_key_t *key, uint32_t *q)
+{
+    _add_round_key(q, &key->sk[8 * key->rounds]);
+    for (unsigned r = key->rounds - 1; r > 0; r--) {
+        _inv_shift_rows(q);
+        _inv_sbox(q);
+        _add_round_key(q, &key->sk[8 * r]);
+        _inv_mix_columns(q);
+    }
+    _inv_shift_rows(q);
+    _inv_sbox(q);
+    _add_round_key(q, key->sk);
+}
+
+int aes_encrypt(const cipher_context_t *context, const uint8_t *plainBlock,
+                uint8_t *cipherBlock)
+{
+    return aes_encrypt_blocks(context, plainBlock, cipherBlock, 1);
+}
+
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                       uint8_t *cipher, size_t nblocks)
+{
+    _aes_ct_key_t key;
+
+    _set_key(&key, context);
+    while (nblocks) {
+        uint32_t q[8] = { 0 };
+        unsigned n = (nblocks > 1) ? 2 : 1;
+
+        for (unsigned b = 0; b < n; b++) {
+            _load(q, plain + b * AES_BLOCK_SIZE, AES_BLOCK_SIZE, 16 * b);
+        }
+        _encrypt(&key, q);
+        for (unsigned b = 0; b < n; b++) {
+            _store(q, cipher + b * AES_BLOCK_SIZE, AES_BLOCK_SIZE, 16 * b);
+        }
+        plain += n * AES_BLOCK_SIZE;
+        cipher += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+    return 1;
+}
+
+int aes_decrypt(const cipher_context_t *context, const uint8_t *cipherBlock,
+                uint8_t *plainBlock)
+{
+    _aes_ct_key_t key;
+    uint32_t q[8] = { 0 };
+
+    _set_key(&key, context);
+    _load(q, cipherBlock, AES_BLOCK_SIZE, 0);
+    _decrypt(&key, q);
+    _store(q, plainBlock, AES_BLOCK_SIZE, 0);
+    return 1;
+}
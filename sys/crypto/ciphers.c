@@ -31,6 +31,25 @@ int cipher_encrypt(const cipher_t *cipher, const uint8_t *input,
     return cipher->interface->encrypt(&cipher->context, input, output);
 }
 
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t nblocks)
+{
+    uint8_t block_size = cipher->interface->block_size;
+    int res = 1;
+
+    if (cipher->interface->encrypt_blocks) {
+        return cipher->interface->encrypt_blocks(&cipher->context, input,
+                                                 output, nblocks);
+    }
+
+    for (size_t i = 0; (i < nblocks) && (res == 1); i++) {
+        res = cipher->interface->encrypt(&cipher->context,
+                                         input + i * block_size,
+                                         output + i * block_size);
+    }
+    return res;
+}
+
 int cipher_decrypt(const cipher_t *cipher, const uint8_t *input,
                    uint8_t *output)
 {
@@ -22,7 +22,6 @@
 #include <string.h>
 #include "debug.h"
 #include "crypto/helper.h"
-#include "crypto/modes/ctr.h"
 #include "crypto/modes/ccm.h"
 
 static inline int min(int a, int b)
@@ -70,8 +69,8 @@ static int ccm_compute_cbc_mac(const cipher_t *cipher, const uint8_t iv[16],
     return offset;
 }
 
-static int ccm_create_mac_iv(const cipher_t *cipher, uint8_t auth_data_len, uint8_t M,
-                             uint8_t L, const uint8_t *nonce, uint8_t nonce_len,
+static int ccm_create_mac_iv(uint8_t auth_data_len, uint8_t M, uint8_t L,
+                             const uint8_t *nonce, uint8_t nonce_len,
                              size_t plaintext_len, uint8_t X1[16])
 {
     uint8_t M_, L_;
@@ -100,12 +99,17 @@ static int ccm_create_mac_iv(const cipher_t *cipher, uint8_t auth_data_len, uint
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
-    if (cipher_encrypt(cipher, X1, X1) != 1) {
-        return CIPHER_ERR_ENC_FAILED;
-    }
     return 0;
 }
 
+static void ccm_create_ctr(uint8_t L, const uint8_t *nonce, size_t nonce_len,
+                           uint8_t A0[16])
+{
+    memset(A0, 0, 16);
+    A0[0] = L - 1;
+    memcpy(&A0[1], nonce, min(nonce_len, (size_t)15 - L));
+}
+
 static int ccm_compute_adata_mac(const cipher_t *cipher, const uint8_t *auth_data,
                                  uint32_t auth_data_len, uint8_t X1[16])
 {
@@ -180,8 +184,8 @@ int cipher_encrypt_ccm(const cipher_t *cipher,
                        uint8_t *output)
 {
     int len = -1;
-    uint8_t nonce_counter[16] = { 0 }, mac_iv[16] = { 0 }, mac[16] = { 0 },
-            stream_block[16] = { 0 }, zero_block[16] = { 0 }, block_size;
+    uint8_t nonce_counter[16] = { 0 }, stream_block[16] = { 0 },
+            blocks[2 * CCM_BLOCK_SIZE], block_size;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
@@ -192,49 +196,53 @@ int cipher_encrypt_ccm(const cipher_t *cipher,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
+    /* Create B0 and encrypt it (X1) together with the first counter block */
     block_size = cipher_get_block_size(cipher);
     assert(block_size == CCM_BLOCK_SIZE);
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, input_len, mac_iv) < 0) {
+    if (ccm_create_mac_iv(auth_data_len, mac_length, length_encoding,
+                          nonce, nonce_len, input_len, blocks) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
-
-    /* MAC calculation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    if (len < 0) {
-        return len;
+    ccm_create_ctr(length_encoding, nonce, nonce_len, nonce_counter);
+    memcpy(&blocks[CCM_BLOCK_SIZE], nonce_counter, CCM_BLOCK_SIZE);
+    if (cipher_encrypt_blocks(cipher, blocks, blocks, 2) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
     }
+    memcpy(stream_block, &blocks[CCM_BLOCK_SIZE], CCM_BLOCK_SIZE);
 
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
+    /* MAC calculation (T) with additional data */
+    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, blocks);
     if (len < 0) {
         return len;
     }
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    memcpy(&nonce_counter[1], nonce,
-           min(nonce_len, (size_t)15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
-    if (len < 0) {
-        return len;
-    }
+    /* MAC calculation with the plaintext and encryption in counter mode in a
+     * single pass: each block of plaintext is added to the MAC, which is then
+     * encrypted together with the counter block for the plaintext */
+    for (size_t offset = 0; offset < input_len; offset += block_size) {
+        uint8_t block_size_input = (input_len - offset > block_size) ?
+                                   block_size : input_len - offset;
 
-    /* Encrypt message in counter mode  */
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
-    if (len < 0) {
-        return len;
+        for (uint8_t i = 0; i < block_size_input; ++i) {
+            blocks[i] ^= input[offset + i];
+        }
+        crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        memcpy(&blocks[CCM_BLOCK_SIZE], nonce_counter, CCM_BLOCK_SIZE);
+        if (cipher_encrypt_blocks(cipher, blocks, blocks, 2) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        for (uint8_t i = 0; i < block_size_input; ++i) {
+            output[offset + i] = input[offset + i] ^
+                                 blocks[CCM_BLOCK_SIZE + i];
+        }
     }
 
     /* auth value: mac ^ first stream block */
     for (uint8_t i = 0; i < mac_length; ++i) {
-        output[len + i] = mac[i] ^ stream_block[i];
+        output[input_len + i] = blocks[i] ^ stream_block[i];
     }
 
-    return len + mac_length;
+    return input_len + mac_length;
 }
 
 int cipher_decrypt_ccm(const cipher_t *cipher,
@@ -245,10 +253,8 @@ int cipher_decrypt_ccm(const cipher_t *cipher,
                        uint8_t *plain)
 {
     int len = -1;
-    uint8_t nonce_counter[16] = { 0 }, mac_iv[16] = { 0 }, mac[16] = { 0 },
-            mac_recv[16] = { 0 }, stream_block[16] = { 0 },
-            zero_block[16] = { 0 },
-            block_size;
+    uint8_t nonce_counter[16] = { 0 }, mac_recv[16] = { 0 },
+            blocks[3 * CCM_BLOCK_SIZE], block_size;
     size_t plain_len;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
@@ -260,49 +266,63 @@ int cipher_decrypt_ccm(const cipher_t *cipher,
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    block_size = cipher_get_block_size(cipher);
-    assert(block_size == CCM_BLOCK_SIZE);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len,
-                                         (size_t)15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
-    if (len < 0) {
-        return len;
+    if (input_len < mac_length) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* Decrypt message in counter mode */
+    /* Create B0 and encrypt it (X1) together with the counter blocks for the
+     * first block of plaintext and the MAC: blocks = [ X1, S1, S0 ] */
     plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
-    if (len < 0) {
-        return len;
-    }
-
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, plain_len, mac_iv) < 0) {
+    block_size = cipher_get_block_size(cipher);
+    assert(block_size == CCM_BLOCK_SIZE);
+    if (ccm_create_mac_iv(auth_data_len, mac_length, length_encoding,
+                          nonce, nonce_len, plain_len, blocks) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
+    ccm_create_ctr(length_encoding, nonce, nonce_len, nonce_counter);
+    memcpy(&blocks[2 * CCM_BLOCK_SIZE], nonce_counter, CCM_BLOCK_SIZE);
+    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+    memcpy(&blocks[CCM_BLOCK_SIZE], nonce_counter, CCM_BLOCK_SIZE);
+    if (cipher_encrypt_blocks(cipher, blocks, blocks, 3) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
 
-    /* MAC calculation (T) with additional data and plaintext */
-    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
+    /* MAC calculation (T) with additional data */
+    len = ccm_compute_adata_mac(cipher, auth_data, auth_data_len, blocks);
     if (len < 0) {
         return len;
     }
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
-    if (len < 0) {
-        return len;
+
+    /* Decryption in counter mode and MAC calculation with the plaintext in a
+     * single pass: after a block is decrypted and added to the MAC, the MAC
+     * is encrypted together with the counter block for the next block */
+    for (size_t offset = 0; offset < plain_len; offset += block_size) {
+        uint8_t block_size_input = (plain_len - offset > block_size) ?
+                                   block_size : plain_len - offset;
+        size_t nblocks = 1;
+
+        for (uint8_t i = 0; i < block_size_input; ++i) {
+            uint8_t p = input[offset + i] ^ blocks[CCM_BLOCK_SIZE + i];
+
+            plain[offset + i] = p;
+            blocks[i] ^= p;
+        }
+        if (offset + block_size_input < plain_len) {
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+            memcpy(&blocks[CCM_BLOCK_SIZE], nonce_counter, CCM_BLOCK_SIZE);
+            nblocks = 2;
+        }
+        if (cipher_encrypt_blocks(cipher, blocks, blocks, nblocks) != 1) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
     }
 
     /* mac = input[plain_len...plain_len+mac_length] ^ first stream block */
     for (uint8_t i = 0; i < mac_length; ++i) {
-        mac_recv[i] = input[len + i] ^ stream_block[i];
+        mac_recv[i] = input[plain_len + i] ^ blocks[2 * CCM_BLOCK_SIZE + i];
     }
 
-    if (!crypto_equals(mac_recv, mac, mac_length)) {
+    if (!crypto_equals(mac_recv, blocks, mac_length)) {
         return CCM_ERR_INVALID_CBC_MAC;
     }
 
@@ -26,7 +26,6 @@
 int cipher_encrypt_ecb(const cipher_t *cipher, const uint8_t *input,
                        size_t length, uint8_t *output)
 {
-    size_t offset;
     uint8_t block_size;
 
     block_size = cipher_get_block_size(cipher);
@@ -34,16 +33,13 @@ int cipher_encrypt_ecb(const cipher_t *cipher, const uint8_t *input,
         return CIPHER_ERR_INVALID_LENGTH;
     }
 
-    offset = 0;
-    do {
-        if (cipher_encrypt(cipher, input + offset, output + offset) != 1) {
-            return CIPHER_ERR_ENC_FAILED;
-        }
-
-        offset += block_size;
-    } while (offset < length);
+    /* the blocks are independent, so all are passed to the cipher at once */
+    if (cipher_encrypt_blocks(cipher, input, output,
+                              length / block_size) != 1) {
+        return CIPHER_ERR_ENC_FAILED;
+    }
 
-    return offset;
+    return length;
 }
 
 int cipher_decrypt_ecb(const cipher_t *cipher, const uint8_t *input,
@@ -20,6 +20,7 @@
 
 #include <string.h>
 
+#include "byteorder.h"
 #include "hashes/sha256.h"
 #include "hashes/pbkdf2.h"
 #include "crypto/helper.h"
@@ -43,6 +44,13 @@ static void inplace_xor_digests(uint8_t *d1, const uint8_t *d2)
     }
 }
 
+static void _encode_digest(uint8_t *digest, const uint32_t *state)
+{
+    for (unsigned i = 0; i < SHA256_DIGEST_LENGTH / sizeof(uint32_t); i++) {
+        byteorder_htobebufl(&digest[i * sizeof(uint32_t)], state[i]);
+    }
+}
+
 void pbkdf2_sha256(const uint8_t *password, size_t password_len,
                    const uint8_t *salt, size_t salt_len,
                    int iterations,
@@ -50,8 +58,10 @@ void pbkdf2_sha256(const uint8_t *password, size_t password_len,
 {
     sha256_context_t inner;
     sha256_context_t outer;
-    uint8_t tmp_digest[SHA256_DIGEST_LENGTH];
-    int first_iter = 1;
+    uint8_t block[SHA256_INTERNAL_BLOCK_SIZE];
+    uint32_t inner_state[8];
+    uint32_t outer_state[8];
+    uint32_t state[8];
 
     {
         uint8_t processed_pass[SHA256_INTERNAL_BLOCK_SIZE] = {0};
@@ -80,33 +90,49 @@ void pbkdf2_sha256(const uint8_t *password, size_t password_len,
         crypto_secure_wipe(&processed_pass, sizeof(processed_pass));
     }
 
-    memset(output, 0, SHA256_DIGEST_LENGTH);
-
-    while (iterations--) {
-        sha256_context_t inner_copy = inner, outer_copy = outer;
+    /* the state after the key block is the start of all iterations */
+    memcpy(inner_state, inner.state, sizeof(inner_state));
+    memcpy(outer_state, outer.state, sizeof(outer_state));
 
-        if (first_iter) {
-            sha256_update(&inner_copy, salt, salt_len);
-            sha256_update(&inner_copy, "\x00\x00\x00\x01", 4);
-            first_iter = 0;
-        } else {
-            sha256_update(&inner_copy, tmp_digest, sizeof(tmp_digest));
-        }
+    memset(output, 0, SHA256_DIGEST_LENGTH);
 
-        sha256_final(&inner_copy, tmp_digest);
+    if (iterations-- > 0) {
+        sha256_update(&inner, salt, salt_len);
+        sha256_update(&inner, "\x00\x00\x00\x01", 4);
+        sha256_final(&inner, block);
 
-        sha256_update(&outer_copy, tmp_digest, sizeof(tmp_digest));
-        sha256_final(&outer_copy, tmp_digest);
+        sha256_update(&outer, block, SHA256_DIGEST_LENGTH);
+        sha256_final(&outer, block);
 
-        inplace_xor_digests(output, tmp_digest);
+        inplace_xor_digests(output, block);
+    }
 
-        if (iterations == 0) {
-            crypto_secure_wipe(&inner_copy, sizeof(inner_copy));
-            crypto_secure_wipe(&outer_copy, sizeof(outer_copy));
-        }
+    /* All further iterations hash a single digest after the key block, so
+     * both hashes are a single compression of the same padded block, which
+     * starts from the state after the key block. The padding is only written
+     * once and the digest is encoded in place. */
+    block[SHA256_DIGEST_LENGTH] = 0x80;
+    memset(&block[SHA256_DIGEST_LENGTH + 1], 0,
+           sizeof(block) - SHA256_DIGEST_LENGTH - 1);
+    byteorder_htobebufll(&block[sizeof(block) - 8],
+                         (SHA256_INTERNAL_BLOCK_SIZE + SHA256_DIGEST_LENGTH) * 8);
+
+    while (iterations-- > 0) {
+        memcpy(state, inner_state, sizeof(state));
+        sha2xx_transform(state, block, 1);
+        _encode_digest(block, state);
+
+        memcpy(state, outer_state, sizeof(state));
+        sha2xx_transform(state, block, 1);
+        _encode_digest(block, state);
+
+        inplace_xor_digests(output, block);
     }
 
+    crypto_secure_wipe(state, sizeof(state));
+    crypto_secure_wipe(inner_state, sizeof(inner_state));
+    crypto_secure_wipe(outer_state, sizeof(outer_state));
+    crypto_secure_wipe(block, sizeof(block));
     crypto_secure_wipe(&inner, sizeof(inner));
     crypto_secure_wipe(&outer, sizeof(outer));
-    crypto_secure_wipe(&tmp_digest, sizeof(tmp_digest));
 }
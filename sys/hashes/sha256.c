@@ -84,6 +84,15 @@ void *sha256(const void *data, size_t len, void *digest)
     return digest;
 }
 
+void sha256_multi(const void *const data[], size_t len, size_t n,
+                  void *const digest[])
+{
+    sha256_context_t c;
+
+    sha256_init(&c);
+    sha2xx_multi(c.state, data, len, n, digest, SHA256_DIGEST_LENGTH);
+}
+
 void hmac_sha256_init(hmac_context_t *ctx, const void *key, size_t key_length)
 {
     unsigned char k[SHA256_INTERNAL_BLOCK_SIZE];
@@ -46,11 +46,26 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 
 #include "hashes/sha2xx_common.h"
 
+/* The SHA extensions are used on capable hosts */
+#if defined(CPU_NATIVE) && (defined(__i386__) || defined(__x86_64__)) && \
+    defined(__GNUC__) && !defined(__clang__)
+#define SHA2XX_SHA_NI   (1)
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define SHA2XX_SHA_NI   (0)
+#endif
+
+/* Number of messages hashed in lockstep by sha2xx_multi() */
+#define SHA2XX_LANES    (2U)
+
 #ifdef __BIG_ENDIAN__
 /* Copy a vector of big-endian uint32_t into a vector of bytes */
 #define be32enc_vect memcpy
@@ -96,69 +111,218 @@ static void be32enc_vect(void *dst_, const void *src_, size_t len)
 
 #endif /* __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__ */
 
+/* Message schedule for round i >= 16, in a ring buffer of 16 words */
+#define SCHEDULE(W, i) \
+    (W[(i) & 15] += s1(W[((i) - 2) & 15]) + W[((i) - 7) & 15] + \
+                    s0(W[((i) - 15) & 15]))
+
+/* One round, the roles of the working variables rotate by one per round */
+#define ROUND(W, a, b, c, d, e, f, g, h, i) do { \
+        uint32_t t0 = h + S1(e) + Ch(e, f, g) + K[i] + W[(i) & 15]; \
+        d += t0; \
+        h = t0 + S0(a) + Maj(a, b, c); \
+    } while (0)
+
+/* The same round for each lane of arrays of working variables */
+#define ROUND_LANES(W, a, b, c, d, e, f, g, h, i) do { \
+        for (unsigned l = 0; l < SHA2XX_LANES; l++) { \
+            ROUND(W[l], a[l], b[l], c[l], d[l], e[l], f[l], g[l], h[l], i); \
+        } \
+    } while (0)
+
+/* Eight rounds, after which the working variables are in place again */
+#define ROUNDS8(R, W, a, b, c, d, e, f, g, h, i) do { \
+        R(W, a, b, c, d, e, f, g, h, (i) + 0); \
+        R(W, h, a, b, c, d, e, f, g, (i) + 1); \
+        R(W, g, h, a, b, c, d, e, f, (i) + 2); \
+        R(W, f, g, h, a, b, c, d, e, (i) + 3); \
+        R(W, e, f, g, h, a, b, c, d, (i) + 4); \
+        R(W, d, e, f, g, h, a, b, c, (i) + 5); \
+        R(W, c, d, e, f, g, h, a, b, (i) + 6); \
+        R(W, b, c, d, e, f, g, h, a, (i) + 7); \
+    } while (0)
+
 /*
  * SHA256 block compression function.  The 256-bit state is transformed via
  * the 512-bit input block to produce a new state.
  */
-static void sha2xx_transform(uint32_t *state, const unsigned char block[64])
+static void _transform(uint32_t *state, const unsigned char block[64])
 {
-    uint32_t W[64];
-    uint32_t S[8];
+    uint32_t W[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
 
-    /* 1. Prepare message schedule W. */
     be32dec_vect(W, block, 64);
-    for (int i = 16; i < 64; i++) {
-        W[i] = s1(W[i - 2]) + W[i - 7] + s0(W[i - 15]) + W[i - 16];
+    for (unsigned i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            for (unsigned j = i; j < i + 8; j++) {
+                SCHEDULE(W, j);
+            }
+        }
+        ROUNDS8(ROUND, W, a, b, c, d, e, f, g, h, i);
     }
 
-    /* 2. Initialize working variables. */
-    memcpy(S, state, 32);
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
 
-    /* 3. Mix. */
-    for (int i = 0; i < 64; ++i) {
-        uint32_t e = S[(68 - i) % 8], f = S[(69 - i) % 8];
-        uint32_t g = S[(70 - i) % 8], h = S[(71 - i) % 8];
-        uint32_t t0 = h + S1(e) + Ch(e, f, g) + W[i] + K[i];
+/*
+ * The same as _transform() for SHA2XX_LANES independent states and blocks.
+ * Interleaving the rounds gives superscalar cores independent instructions
+ * to issue in parallel.
+ */
+static void _transform_lanes(uint32_t state[SHA2XX_LANES][8],
+                             const unsigned char *block[SHA2XX_LANES])
+{
+    uint32_t W[SHA2XX_LANES][16];
+    uint32_t a[SHA2XX_LANES], b[SHA2XX_LANES], c[SHA2XX_LANES];
+    uint32_t d[SHA2XX_LANES], e[SHA2XX_LANES], f[SHA2XX_LANES];
+    uint32_t g[SHA2XX_LANES], h[SHA2XX_LANES];
+
+    for (unsigned l = 0; l < SHA2XX_LANES; l++) {
+        be32dec_vect(W[l], block[l], 64);
+        a[l] = state[l][0];
+        b[l] = state[l][1];
+        c[l] = state[l][2];
+        d[l] = state[l][3];
+        e[l] = state[l][4];
+        f[l] = state[l][5];
+        g[l] = state[l][6];
+        h[l] = state[l][7];
+    }
 
-        uint32_t a = S[(64 - i) % 8], b = S[(65 - i) % 8];
-        uint32_t c = S[(66 - i) % 8], d = S[(67 - i) % 8];
-        uint32_t t1 = S0(a) + Maj(a, b, c);
+    for (unsigned i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            for (unsigned j = i; j < i + 8; j++) {
+                for (unsigned l = 0; l < SHA2XX_LANES; l++) {
+                    SCHEDULE(W[l], j);
+                }
+            }
+        }
+        ROUNDS8(ROUND_LANES, W, a, b, c, d, e, f, g, h, i);
+    }
 
-        S[(67 - i) % 8] = d + t0;
-        S[(71 - i) % 8] = t0 + t1;
+    for (unsigned l = 0; l < SHA2XX_LANES; l++) {
+        state[l][0] += a[l];
+        state[l][1] += b[l];
+        state[l][2] += c[l];
+        state[l][3] += d[l];
+        state[l][4] += e[l];
+        state[l][5] += f[l];
+        state[l][6] += g[l];
+        state[l][7] += h[l];
     }
+}
+
+#if SHA2XX_SHA_NI
+static bool _sha_ni_supported(void)
+{
+    static int supported = -1;
+
+    if (supported < 0) {
+        unsigned a, b, c, d;
 
-    /* 4. Mix local working variables into global state */
-    for (int i = 0; i < 8; i++) {
-        state[i] += S[i];
+        supported = __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & bit_SHA);
     }
+    return supported;
 }
 
-static unsigned char PAD[64] = {
-    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-};
+/*
+ * Block compression with the SHA extensions. The state is kept in the
+ * order ABEF and CDGH, as the SHA256RNDS2 instruction expects it.
+ */
+__attribute__((target("sha,sse4.1")))
+static void _transform_sha_ni(uint32_t *state, const unsigned char *blocks,
+                              size_t nblocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                        0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+    __m128i state0;
+
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    for (; nblocks; nblocks--, blocks += 64) {
+        __m128i abef = state0, cdgh = state1;
+        __m128i msg[4];
+
+        for (unsigned i = 0; i < 16; i++) {
+            __m128i w;
+
+            if (i < 4) {
+                w = _mm_loadu_si128((const __m128i *)&blocks[16 * i]);
+                w = _mm_shuffle_epi8(w, mask);
+            }
+            else {
+                w = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                w = _mm_add_epi32(w, _mm_alignr_epi8(msg[(i + 3) & 3],
+                                                     msg[(i + 2) & 3], 4));
+                w = _mm_sha256msg2_epu32(w, msg[(i + 3) & 3]);
+            }
+            msg[i & 3] = w;
+            w = _mm_add_epi32(w, _mm_loadu_si128((const __m128i *)&K[4 * i]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, w);
+            w = _mm_shuffle_epi32(w, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, w);
+        }
 
-/* Add padding and terminating bit-count. */
-void sha2xx_pad(sha2xx_context_t *ctx)
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+#endif /* SHA2XX_SHA_NI */
+
+void sha2xx_transform(uint32_t *state, const void *blocks, size_t nblocks)
 {
-    /*
-     * Convert length to a vector of bytes -- we do this now rather
-     * than later because the length will change after we pad.
-     */
-    unsigned char len[8];
+    const unsigned char *block = blocks;
 
-    be32enc_vect(len, ctx->count, 8);
+#if SHA2XX_SHA_NI
+    if (_sha_ni_supported()) {
+        _transform_sha_ni(state, block, nblocks);
+        return;
+    }
+#endif
+
+    for (; nblocks; nblocks--, block += 64) {
+        _transform(state, block);
+    }
+}
 
-    /* Add 1--64 bytes so that the resulting length is 56 mod 64 */
+/* Add padding and terminating bit-count. */
+void sha2xx_pad(sha2xx_context_t *ctx)
+{
+    /* Number of bytes left in the buffer from previous updates */
     uint32_t r = (ctx->count[1] >> 3) & 0x3f;
-    uint32_t plen = (r < 56) ? (56 - r) : (120 - r);
-    sha2xx_update(ctx, PAD, (size_t) plen);
+
+    /* Add a 1 bit and 0 bits until the length is 56 mod 64 */
+    ctx->buf[r++] = 0x80;
+    if (r > 56) {
+        memset(&ctx->buf[r], 0, 64 - r);
+        sha2xx_transform(ctx->state, ctx->buf, 1);
+        r = 0;
+    }
+    memset(&ctx->buf[r], 0, 56 - r);
 
     /* Add the terminating bit-count */
-    sha2xx_update(ctx, len, 8);
+    be32enc_vect(&ctx->buf[56], ctx->count, 8);
+    sha2xx_transform(ctx->state, ctx->buf, 1);
 }
 
 /* Add bytes into the hash */
@@ -190,16 +354,14 @@ void sha2xx_update(sha2xx_context_t *ctx, const void *data, size_t len)
     const unsigned char *src = data;
 
     memcpy(&ctx->buf[r], src, 64 - r);
-    sha2xx_transform(ctx->state, ctx->buf);
+    sha2xx_transform(ctx->state, ctx->buf, 1);
     src += 64 - r;
     len -= 64 - r;
 
-    /* Perform complete blocks */
-    while (len >= 64) {
-        sha2xx_transform(ctx->state, src);
-        src += 64;
-        len -= 64;
-    }
+    /* Perform complete blocks directly from the input */
+    sha2xx_transform(ctx->state, src, len / 64);
+    src += len & ~(size_t)0x3f;
+    len &= 0x3f;
 
     /* Copy left over data into buffer */
     memcpy(ctx->buf, src, len);
@@ -220,3 +382,68 @@ void sha2xx_final(sha2xx_context_t *ctx, void *dst, size_t dig_len)
     /* Clear the context state */
     memset((void *) ctx, 0, sizeof(*ctx));
 }
+
+static void _transform_multi(uint32_t state[SHA2XX_LANES][8],
+                             const unsigned char *block[SHA2XX_LANES],
+                             unsigned lanes)
+{
+#if SHA2XX_SHA_NI
+    if (_sha_ni_supported()) {
+        for (unsigned l = 0; l < lanes; l++) {
+            _transform_sha_ni(state[l], block[l], 1);
+        }
+        return;
+    }
+#endif
+
+    if (lanes == SHA2XX_LANES) {
+        _transform_lanes(state, block);
+    }
+    else {
+        for (unsigned l = 0; l < lanes; l++) {
+            _transform(state[l], block[l]);
+        }
+    }
+}
+
+void sha2xx_multi(const uint32_t *iv, const void *const data[], size_t len,
+                  size_t n, void *const digest[], size_t dig_len)
+{
+    /* all messages have the same length, so they are padded the same way */
+    size_t full = len / 64;
+    size_t rest = len % 64;
+    size_t nblocks = full + ((rest < 56) ? 1 : 2);
+    uint64_t bits = (uint64_t)len << 3;
+
+    for (size_t first = 0; first < n; first += SHA2XX_LANES) {
+        uint32_t state[SHA2XX_LANES][8];
+        unsigned char tail[SHA2XX_LANES][128];
+        const unsigned char *block[SHA2XX_LANES];
+        unsigned lanes = (n - first < SHA2XX_LANES) ? n - first : SHA2XX_LANES;
+
+        for (unsigned l = 0; l < lanes; l++) {
+            const unsigned char *msg = data[first + l];
+
+            memcpy(state[l], iv, sizeof(state[l]));
+            memset(tail[l], 0, sizeof(tail[l]));
+            memcpy(tail[l], &msg[64 * full], rest);
+            tail[l][rest] = 0x80;
+            for (unsigned i = 0; i < 8; i++) {
+                tail[l][64 * (nblocks - full) - 1 - i] = bits >> (8 * i);
+            }
+        }
+
+        for (size_t i = 0; i < nblocks; i++) {
+            for (unsigned l = 0; l < lanes; l++) {
+                const unsigned char *msg = data[first + l];
+
+                block[l] = (i < full) ? &msg[64 * i] : &tail[l][64 * (i - full)];
+            }
+            _transform_multi(state, block, lanes);
+        }
+
+        for (unsigned l = 0; l < lanes; l++) {
+            be32enc_vect(digest[first + l], state[l], dig_len);
+        }
+    }
+}
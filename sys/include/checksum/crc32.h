@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32  CRC32
+ * @ingroup     sys_checksum
+ *
+ * @brief       CRC32 and CRC32C checksum algorithms
+ * @details     CRC32 is the checksum of IEEE 802.3, zlib, and PNG (reflected
+ *              polynomial 0xedb88320), CRC32C the Castagnoli variant of
+ *              iSCSI, SCTP, and ext4 (reflected polynomial 0x82f63b78).
+ *
+ *              Both are calculated with look-up tables. With
+ *              @ref CONFIG_CHECKSUM_CRC32_SLICES set to 4 or 8, 4 or 8 bytes
+ *              are processed per iteration ("slicing-by-N"). This trades
+ *              1 KiB of ROM per slice and polynomial for speed. Only the
+ *              tables of the functions in use are linked.
+ *
+ *              On `native`, CRC32C uses the SSE4.2 `crc32` instruction and
+ *              CRC32 folds inputs of 64 bytes and more with carry-less
+ *              multiplication (PCLMUL), if the host supports it.
+ *
+ * @{
+ * @file
+ */
+
+#ifndef CHECKSUM_CRC32_H
+#define CHECKSUM_CRC32_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup    sys_checksum_crc32_conf CRC32 compile configurations
+ * @ingroup     config
+ * @{
+ */
+/**
+ * @brief   Bytes processed per table look-up iteration
+ *
+ * Must be 1, 4, or 8. Each slice needs a table of 1 KiB per polynomial.
+ */
+#ifndef CONFIG_CHECKSUM_CRC32_SLICES
+#define CONFIG_CHECKSUM_CRC32_SLICES    (4)
+#endif
+/** @} */
+
+/**
+ * @brief           Update CRC32
+ *
+ * @param[in]  crc  The CRC of the preceding data, as returned by
+ *                  crc32_calc() or crc32_update(), or 0 for the first chunk
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC32 of the preceding data and the specified memory area
+ */
+uint32_t crc32_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC32 of the specified memory area
+ */
+static inline uint32_t crc32_calc(const void *buf, size_t len)
+{
+    return crc32_update(0, buf, len);
+}
+
+/**
+ * @brief           Update CRC32C
+ *
+ * @param[in]  crc  The CRC of the preceding data, as returned by
+ *                  crc32c_calc() or crc32c_update(), or 0 for the first chunk
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC32C of the preceding data and the specified memory area
+ */
+uint32_t crc32c_update(uint32_t crc, const void *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32C
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          CRC32C of the specified memory area
+ */
+static inline uint32_t crc32c_calc(const void *buf, size_t len)
+{
+    return crc32c_update(0, buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHECKSUM_CRC32_H */
+
+/** @} */
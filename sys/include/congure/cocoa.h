@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_cocoa   CongURE implementation of CoCoA
+ * @ingroup     sys_congure
+ * @brief       Implementation of the CoCoA retransmission timeout estimator
+ *              for CoAP for @ref sys_congure
+ *
+ * Implements the RTO estimation of
+ * [CoCoA](https://tools.ietf.org/html/draft-ietf-core-cocoa-03): a strong
+ * estimator fed by round-trip times of messages acknowledged without
+ * retransmission and a weak estimator fed by messages acknowledged after one
+ * or two retransmissions, both blended into an overall RTO that ages towards
+ * 1 to 3 seconds when not updated. The congestion window is
+ * @ref CONFIG_CONGURE_COCOA_NSTART messages.
+ *
+ * Sizes are in messages, so congure_snd_driver_t::report_msg_sent() is called
+ * with 1 for every message. congure_snd_msg_t::send_time must be the time of
+ * the first transmission of a message and congure_snd_msg_t::resends its
+ * number of retransmissions. The retransmissions themselves are left to the
+ * caller, which gets the timeouts from congure_cocoa_snd_rto() and
+ * congure_cocoa_backoff().
+ *
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_COCOA_H
+#define CONGURE_COCOA_H
+
+#include <stdint.h>
+
+#include "congure.h"
+#include "congure/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   RTO estimator
+ */
+typedef struct {
+    int32_t srtt;       /**< smoothed round-trip time in ms, 0 if unset */
+    int32_t rttvar;     /**< round-trip time variation in ms */
+} congure_cocoa_est_t;
+
+/**
+ * @brief   CoCoA state object
+ *
+ * @extends congure_snd_t
+ */
+typedef struct {
+    congure_snd_t super;            /**< see @ref congure_snd_t */
+    congure_cocoa_est_t strong;     /**< strong RTO estimator */
+    congure_cocoa_est_t weak;       /**< weak RTO estimator */
+    uint32_t rto;                   /**< overall RTO in ms */
+    ztimer_now_t last_update;       /**< time of the last RTO update in ms */
+    congure_wnd_size_t in_flight;   /**< messages in flight */
+} congure_cocoa_snd_t;
+
+/**
+ * @brief   Set-up CoCoA state object
+ *
+ * congure_snd_driver_t::init() still needs to be called on @p c.
+ *
+ * @param[out] c    The state object
+ */
+void congure_cocoa_snd_setup(congure_cocoa_snd_t *c);
+
+/**
+ * @brief   Get the initial retransmission timeout for a new message
+ *
+ * Ages the overall RTO, if it was not updated for a while.
+ *
+ * @param[in,out] c The state object
+ * @param[in] now   The current time in milliseconds
+ *
+ * @return  The retransmission timeout in milliseconds
+ */
+uint32_t congure_cocoa_snd_rto(congure_cocoa_snd_t *c, ztimer_now_t now);
+
+/**
+ * @brief   Get the timeout of the next retransmission of a message
+ *
+ * Applies the variable backoff factor of CoCoA.
+ *
+ * @param[in] init_rto  Initial timeout of the message, as returned by
+ *                      congure_cocoa_snd_rto()
+ * @param[in] timeout   Timeout of the last transmission of the message
+ *
+ * @return  The timeout for the next retransmission in milliseconds
+ */
+static inline uint32_t congure_cocoa_backoff(uint32_t init_rto,
+                                             uint32_t timeout)
+{
+    if (init_rto < 1000U) {
+        return timeout * 3;
+    }
+    if (init_rto > 3000U) {
+        return timeout + (timeout / 2);
+    }
+    return timeout * 2;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_COCOA_H */
+/** @} */
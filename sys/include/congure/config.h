@@ -24,6 +24,23 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of messages allowed in flight with @ref sys_congure_cocoa
+ *
+ * See NSTART in [RFC 7252](https://tools.ietf.org/html/rfc7252#section-4.7)
+ */
+#ifndef CONFIG_CONGURE_COCOA_NSTART
+#define CONFIG_CONGURE_COCOA_NSTART         1
+#endif
+
+/**
+ * @brief   Initial retransmission timeout in milliseconds with
+ *          @ref sys_congure_cocoa
+ */
+#ifndef CONFIG_CONGURE_COCOA_INIT_RTO_MS
+#define CONFIG_CONGURE_COCOA_INIT_RTO_MS    2000
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_congure_reno    CongURE implementation of TCP Reno
+ * @ingroup     sys_congure
+ * @brief       Implementation of the TCP Reno congestion control mechanism
+ *              for @ref sys_congure
+ *
+ * Implements slow start, congestion avoidance, fast retransmit and fast
+ * recovery as specified in [RFC 5681](https://tools.ietf.org/html/rfc5681),
+ * with the NewReno handling of partial acknowledgements during fast recovery
+ * from [RFC 6582](https://tools.ietf.org/html/rfc6582).
+ *
+ * All sizes are in bytes. Every received ACK must be reported with
+ * congure_snd_driver_t::report_msg_acked():
+ *
+ * - congure_snd_ack_t::id is the cumulative acknowledgement, e.g. the TCP
+ *   acknowledgement number,
+ * - congure_snd_ack_t::size is the payload carried by the ACK, and
+ * - congure_snd_msg_t::size is the number of bytes newly acknowledged by the
+ *   ACK, i.e. 0 for duplicate ACKs.
+ *
+ * The retransmissions triggered by the mechanism are left to the caller, see
+ * congure_reno_snd_consts_t::fr. They must not be reported with
+ * congure_snd_driver_t::report_msg_sent(), as the resent bytes are already
+ * in flight. Messages resent after a timeout, however, must be reported again,
+ * as congure_snd_driver_t::report_msgs_timeout() removes them from the flight.
+ *
+ * @{
+ *
+ * @file
+ */
+#ifndef CONGURE_RENO_H
+#define CONGURE_RENO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "congure.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forward declaration of the TCP Reno state object
+ */
+typedef struct congure_reno_snd congure_reno_snd_t;
+
+/**
+ * @brief   Constants for the congestion control
+ *
+ * Can be shared between several state objects.
+ */
+typedef struct {
+    /**
+     * @brief   Resend the oldest unacknowledged message
+     *
+     * Called on fast retransmit and, during fast recovery, for every partial
+     * acknowledgement.
+     *
+     * @param[in] c The state object, congure_snd_t::ctx is the context given
+     *              on initialization.
+     */
+    void (*fr)(congure_reno_snd_t *c);
+    unsigned init_mss;                  /**< initial maximum segment size */
+    congure_wnd_size_t init_ssthresh;   /**< initial slow start threshold */
+    /**
+     * @brief   Number of duplicate ACKs to trigger fast retransmit
+     */
+    uint8_t frthresh;
+} congure_reno_snd_consts_t;
+
+/**
+ * @brief   TCP Reno state object
+ *
+ * @extends congure_snd_t
+ */
+struct congure_reno_snd {
+    congure_snd_t super;                /**< see @ref congure_snd_t */
+    const congure_reno_snd_consts_t *consts;    /**< constants */
+    /**
+     * @brief   Cumulative acknowledgement ending fast recovery
+     */
+    uint32_t recover;
+    unsigned mss;                       /**< maximum segment size */
+    congure_wnd_size_t ssthresh;        /**< slow start threshold */
+    congure_wnd_size_t in_flight_size;  /**< bytes sent, but not acknowledged */
+    congure_wnd_size_t last_wnd;        /**< peer window of the last ACK */
+    uint8_t dup_acks;                   /**< number of duplicate ACKs in a row */
+    bool in_recovery;                   /**< fast recovery is in progress */
+};
+
+/**
+ * @brief   Set-up TCP Reno state object
+ *
+ * congure_snd_driver_t::init() still needs to be called on @p c.
+ *
+ * @param[out] c        The state object
+ * @param[in] consts    The constants for @p c
+ */
+void congure_reno_snd_setup(congure_reno_snd_t *c,
+                            const congure_reno_snd_consts_t *consts);
+
+/**
+ * @brief   Set the maximum segment size, e.g. after it was negotiated
+ *
+ * When called between congure_reno_snd_setup() and
+ * congure_snd_driver_t::init(), @p mss replaces
+ * congure_reno_snd_consts_t::init_mss for the initial window.
+ *
+ * @param[in,out] c The state object
+ * @param[in] mss   The new maximum segment size
+ */
+static inline void congure_reno_set_mss(congure_reno_snd_t *c, unsigned mss)
+{
+    c->mss = mss;
+}
+
+/**
+ * @brief   Get the part of the congestion window not in use by messages in
+ *          flight
+ *
+ * @param[in] c The state object
+ *
+ * @return  Bytes that may still be sent
+ */
+static inline unsigned congure_reno_usable_wnd(const congure_reno_snd_t *c)
+{
+    return (c->super.cwnd > c->in_flight_size)
+           ? (unsigned)(c->super.cwnd - c->in_flight_size) : 0U;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONGURE_RENO_H */
+/** @} */
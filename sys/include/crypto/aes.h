@@ -120,6 +120,26 @@ int aes_init(cipher_context_t *context, const uint8_t *key, uint8_t keySize);
 int aes_encrypt(const cipher_context_t *context, const uint8_t *plain_block,
                 uint8_t *cipher_block);
 
+/**
+ * @brief   encrypts multiple consecutive blocks
+ *
+ * Does the same as calling aes_encrypt() for each block, but expands the
+ * key only once.
+ *
+ * @param       context       the cipher_context_t-struct to use for this
+ *                            encryption
+ * @param       plain         the plaintext blocks
+ * @param       cipher        where the ciphertext blocks will be stored, may
+ *                            be the same as @p plain
+ * @param       nblocks       the number of blocks
+ *
+ * @return  1 on success
+ * @return  A negative value if the cipher key cannot be expanded with the
+ *          AES key schedule
+ */
+int aes_encrypt_blocks(const cipher_context_t *context, const uint8_t *plain,
+                       uint8_t *cipher, size_t nblocks);
+
 /**
  * @brief   decrypts one cipher-block and saves the plain-block in plainBlock.
  *          decrypts one blocksize long block of ciphertext pointed to by
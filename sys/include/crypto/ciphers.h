@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H
 #define CRYPTO_CIPHERS_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include "kernel_defines.h"
 
@@ -102,6 +103,15 @@ typedef struct cipher_interface_st {
     /** @brief the decrypt function */
     int (*decrypt)(const cipher_context_t *ctx, const uint8_t *cipher_block,
                    uint8_t *plain_block);
+
+    /**
+     * @brief the multi-block encrypt function (optional)
+     *
+     * Encrypts @p nblocks consecutive blocks with a single key setup. If it
+     * is NULL, @ref cipher_encrypt_blocks calls @p encrypt for each block.
+     */
+    int (*encrypt_blocks)(const cipher_context_t *ctx, const uint8_t *plain,
+                          uint8_t *cipher, size_t nblocks);
 } cipher_interface_t;
 
 typedef const cipher_interface_t *cipher_id_t;
@@ -164,6 +174,26 @@ int cipher_init(cipher_t *cipher, cipher_id_t cipher_id, const uint8_t *key,
 int cipher_encrypt(const cipher_t *cipher, const uint8_t *input,
                    uint8_t *output);
 
+/**
+ * @brief Encrypt multiple consecutive blocks of data
+ *
+ * This is equivalent to calling @ref cipher_encrypt for each block, but the
+ * key setup is done only once, if the cipher supports it.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to @p nblocks blocks of input data to encrypt
+ * @param output     pointer to allocated memory for the encrypted data. It
+ *                   has to be of size @p nblocks * BLOCK_SIZE and may be the
+ *                   same as @p input.
+ * @param nblocks    number of blocks to encrypt
+ *
+ * @return           The result of the encrypt operation of the underlying
+ *                   cipher, which is always 1 in case of success
+ * @return           A negative value for an error
+ */
+int cipher_encrypt_blocks(const cipher_t *cipher, const uint8_t *input,
+                          uint8_t *output, size_t nblocks);
+
 /**
  * @brief Decrypt data of BLOCK_SIZE length
  * *
@@ -134,6 +134,21 @@ static inline void sha256_final(sha256_context_t *ctx, void *digest)
  */
 void *sha256(const void *data, size_t len, void *digest);
 
+/**
+ * @brief Generate the hashes of several messages of the same length
+ *
+ * The messages are processed in lockstep, which is faster than hashing them
+ * one after the other with @ref sha256.
+ *
+ * @param[in] data    @p n messages of @p len bytes each
+ * @param[in] len     length of each message
+ * @param[in] n       number of messages
+ * @param[out] digest @p n buffers for the results, each of
+ *                    SHA256_DIGEST_LENGTH bytes
+ */
+void sha256_multi(const void *const data[], size_t len, size_t n,
+                  void *const digest[]);
+
 /**
  * @brief hmac_sha256_init HMAC SHA-256 calculation. Initiate calculation of a HMAC
  * @param[in] ctx hmac_context_t handle to use
@@ -102,6 +102,15 @@ static const uint32_t K[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
 };
 
+/**
+ * @brief SHA-2XX block compression function
+ *
+ * @param state     state to update
+ * @param[in] blocks  @p nblocks blocks of 64 bytes each
+ * @param nblocks   Number of blocks
+ */
+void sha2xx_transform(uint32_t *state, const void *blocks, size_t nblocks);
+
 /**
  * @brief SHA-2XX initialization.  Begins a SHA-2XX operation.
  *
@@ -128,6 +137,19 @@ void sha2xx_update(sha2xx_context_t *ctx, const void *data, size_t len);
  */
 void sha2xx_final(sha2xx_context_t *ctx, void *digest, size_t dig_len);
 
+/**
+ * @brief Hash several independent messages of the same length in lockstep
+ *
+ * @param iv        initial state of the hash function
+ * @param[in] data  @p n messages of @p len bytes each
+ * @param len       Length of each message
+ * @param n         Number of messages
+ * @param digest    @p n buffers for the resulting digests
+ * @param dig_len   Length of each digest
+ */
+void sha2xx_multi(const uint32_t *iv, const void *const data[], size_t len,
+                  size_t n, void *const digest[], size_t dig_len);
+
 #ifdef __cplusplus
 }
 #endif
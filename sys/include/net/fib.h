@@ -11,6 +11,18 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * By default, every look-up scans all entries of a single hop table. With
+ * `USEMODULE += fib_radix`, a table additionally keeps its entries in a
+ * path-compressed binary radix tree keyed by the address size and the
+ * destination prefix, so the longest matching prefix is found in time linear
+ * in the address length instead of the table size. The tree is embedded in
+ * @ref fib_entry_t and @ref fib_table_t and is set up by @ref fib_init().
+ *
+ * In contrast to the scan, which ranks prefixes by the bits they happen to
+ * share with the destination, the tree always returns the longest prefix that
+ * covers it. Expired entries are only removed when a look-up hits them or a
+ * new entry needs their slot.
+ *
  * @{
  *
  * @file
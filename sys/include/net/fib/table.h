@@ -35,10 +35,30 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief Node of the radix tree over the entries of a single hop FIB table
+ *
+ * Only used with the `fib_radix` module. A node either represents the
+ * destination prefix of an entry or is a glue node joining two sub-trees
+ * that branch at fib_radix_node_t::len.
+ */
+typedef struct fib_radix_node {
+    /** parent node, or the next unused glue node */
+    struct fib_radix_node *parent;
+    /** sub-trees continuing with bit fib_radix_node_t::len 0 or 1 */
+    struct fib_radix_node *child[2];
+    /** next entry with the same prefix, not linked into the tree itself */
+    struct fib_radix_node *next;
+    /** the entry of this node, NULL for glue nodes */
+    struct fib_entry *entry;
+    /** prefix length in bits (including the address size), 0 if unused */
+    uint16_t len;
+} fib_radix_node_t;
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,6 +71,10 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /** radix tree node of this entry and a glue node for the tree */
+    fib_radix_node_t radix[2];
+#endif
 } fib_entry_t;
 
 /**
@@ -133,6 +157,12 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /** root of the radix tree over `data.entries` (single hop tables only) */
+    fib_radix_node_t *radix_root;
+    /** unused glue nodes of the radix tree */
+    fib_radix_node_t *radix_free;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -81,6 +81,10 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_NIB_DNS                      1
 #endif
 
+#ifdef MODULE_GNRC_IPV6_NIB_IDX
+#define CONFIG_GNRC_IPV6_NIB_IDX                      1
+#endif
+
 /**
  * @name    Compile flags
  * @brief   Compile flags to (de-)activate certain features for NIB
@@ -225,6 +229,19 @@ extern "C" {
 #ifndef CONFIG_GNRC_IPV6_NIB_MULTIHOP_DAD
 #define CONFIG_GNRC_IPV6_NIB_MULTIHOP_DAD             0
 #endif
+
+/**
+ * @brief   Use a lookup index for the NIB
+ *
+ * Neighbor lookups by address are resolved through a hash table and
+ * longest-prefix matches on off-link entries through a path-compressed
+ * binary trie instead of a linear scan over all entries. Only worth the
+ * additional RAM with large @ref CONFIG_GNRC_IPV6_NIB_NUMOF and
+ * @ref CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_IDX
+#define CONFIG_GNRC_IPV6_NIB_IDX                      0
+#endif
 /** @} */
 
 /**
@@ -282,6 +299,15 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF              (8)
 #endif
 
+/**
+ * @brief   Number of hash buckets for the neighbor index
+ *
+ * @note    Only used if @ref CONFIG_GNRC_IPV6_NIB_IDX is set.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_IDX_ONL_BUCKETS
+#define CONFIG_GNRC_IPV6_NIB_IDX_ONL_BUCKETS         (16)
+#endif
+
 #if CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
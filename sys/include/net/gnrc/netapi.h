@@ -54,6 +54,36 @@
  * USEMODULE += gnrc_netapi_callbacks
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * @}
+ *
+ * @defgroup    net_gnrc_netapi_batch   Batched dispatch extension
+ * @ingroup     net_gnrc_netapi
+ * @brief       Pass several packets to a module with one message
+ * @{
+ * @details The submodule `gnrc_netapi_batch` allows to pass several packets
+ *          to a subscribed thread with one @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH
+ *          or @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message, saving one
+ *          message and possibly one context switch per packet.
+ *
+ * A thread opens a batch with @ref gnrc_netapi_batch_begin(). Until the batch
+ * is closed with @ref gnrc_netapi_batch_end(), the packets it dispatches with
+ * @ref gnrc_netapi_dispatch() are collected and passed on in batches of up to
+ * @ref CONFIG_GNRC_NETAPI_BATCH_SIZE packets with the same type, demultiplex
+ * context and command. Subscribers receive a batch only on netreg entries they
+ * marked with @ref gnrc_netapi_batch_accept(), all others still receive one
+ * message per packet.
+ *
+ * `gnrc_netif` opens a batch while handling the events of its device, so all
+ * frames received per device interrupt are passed up in one message.
+ * `gnrc_sixlowpan`, `gnrc_ipv6` and `gnrc_udp` accept batches and keep the
+ * batch open while handling them, so it is passed up the stack as a whole.
+ *
+ * To use, add the module `gnrc_netapi_batch` to the `USEMODULE` macro in your
+ * application's Makefile:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_netapi_batch
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * @}
  */
 
 #ifndef NET_GNRC_NETAPI_H
@@ -63,6 +93,7 @@
 #include "net/netopt.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/netreg.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -93,6 +124,56 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt up the
+ *          network stack
+ *
+ * The content is a packet snip holding the packets, see
+ * @ref gnrc_netapi_batch_numof() and @ref gnrc_netapi_batch_get(). The
+ * receiver owns both the packets and the batch snip and needs to release
+ * the latter with @ref gnrc_pktbuf_release() when done.
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_BATCH  (0x0206)
+
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt down
+ *          the network stack
+ *
+ * Same content as @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH.
+ */
+#define GNRC_NETAPI_MSG_TYPE_SND_BATCH  (0x0207)
+
+/**
+ * @defgroup net_gnrc_netapi_batch_conf  Batched dispatch compile configurations
+ * @ingroup  net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Maximum number of packets passed with one batch message
+ */
+#ifndef CONFIG_GNRC_NETAPI_BATCH_SIZE
+#define CONFIG_GNRC_NETAPI_BATCH_SIZE   (8U)
+#endif
+/** @} */
+
+/**
+ * @brief   Context of a thread collecting dispatched packets into batches
+ *
+ * @see     @ref gnrc_netapi_batch_begin()
+ */
+typedef struct gnrc_netapi_batch {
+    struct gnrc_netapi_batch *prev;     /**< batch opened before */
+    /**
+     * @brief   The collected packets
+     */
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_NETAPI_BATCH_SIZE];
+    uint32_t demux_ctx;                 /**< demultiplex context of pkts */
+    gnrc_nettype_t type;                /**< type of pkts */
+    uint16_t cmd;                       /**< command to dispatch pkts with */
+    uint8_t numof;                      /**< number of pkts */
+    uint8_t refs;                       /**< references held per packet */
+} gnrc_netapi_batch_t;
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -261,6 +342,115 @@ static inline int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt,
                                 GNRC_NETAPI_MSG_TYPE_SET);
 }
 
+/**
+ * @brief   Sends a command to all subscribers, passing several packets with
+ *          one message to those accepting batches
+ *
+ * @note    Only available with module `gnrc_netapi_batch`.
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] cmd       command for all subscribers, @ref
+ *                      GNRC_NETAPI_MSG_TYPE_RCV or @ref
+ *                      GNRC_NETAPI_MSG_TYPE_SND
+ * @param[in] pkts      pointers to the packets to send
+ * @param[in] numof     number of packets in @p pkts, at most
+ *                      @ref CONFIG_GNRC_NETAPI_BATCH_SIZE
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx), the packets are
+ *         not released if there are none.
+ */
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               uint16_t cmd, gnrc_pktsnip_t **pkts,
+                               unsigned numof);
+
+/**
+ * @brief   Declare that the thread of a netreg entry handles
+ *          @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH and
+ *          @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH messages
+ *
+ * Packets are only passed as a batch to the subscription of @p entry, so
+ * the declaration ends with @ref gnrc_netreg_unregister().
+ *
+ * @note    Only available with module `gnrc_netapi_batch`.
+ *
+ * @pre     @p entry was initialized with a PID as target
+ *
+ * @param[in,out] entry netreg entry of the calling thread
+ */
+void gnrc_netapi_batch_accept(gnrc_netreg_entry_t *entry);
+
+/**
+ * @brief   Start collecting the packets dispatched by the calling thread
+ *
+ * Packets passed to @ref gnrc_netapi_dispatch() by the calling thread are
+ * held back until the batch is full, a packet for another (type, demux
+ * context, command) is dispatched or @ref gnrc_netapi_batch_end() is called.
+ * Batches may be nested, the innermost one collects the packets.
+ *
+ * @note    Only available with module `gnrc_netapi_batch`.
+ *
+ * @param[out] batch    batch context, must stay valid until
+ *                      @ref gnrc_netapi_batch_end()
+ */
+void gnrc_netapi_batch_begin(gnrc_netapi_batch_t *batch);
+
+/**
+ * @brief   Dispatch the collected packets and stop collecting
+ *
+ * @note    Only available with module `gnrc_netapi_batch`.
+ *
+ * @param[in,out] batch the batch context given to
+ *                      @ref gnrc_netapi_batch_begin()
+ */
+void gnrc_netapi_batch_end(gnrc_netapi_batch_t *batch);
+
+/**
+ * @brief   Handle all packets of a received batch
+ *
+ * Calls @p handler for each packet in @p batch, with a batch opened by
+ * @ref gnrc_netapi_batch_begin(), and releases @p batch.
+ *
+ * @note    Only available with module `gnrc_netapi_batch`.
+ *
+ * @param[in] batch     content of a @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *                      @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message
+ * @param[in] handler   handler for a single packet, as for
+ *                      @ref GNRC_NETAPI_MSG_TYPE_RCV or
+ *                      @ref GNRC_NETAPI_MSG_TYPE_SND respectively
+ */
+void gnrc_netapi_batch_handle(gnrc_pktsnip_t *batch,
+                              void (*handler)(gnrc_pktsnip_t *pkt));
+
+/**
+ * @brief   Get the number of packets in a received batch
+ *
+ * @param[in] batch     content of a @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *                      @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message
+ *
+ * @return  number of packets in @p batch
+ */
+static inline unsigned gnrc_netapi_batch_numof(const gnrc_pktsnip_t *batch)
+{
+    return batch->size / sizeof(gnrc_pktsnip_t *);
+}
+
+/**
+ * @brief   Get a packet from a received batch
+ *
+ * @param[in] batch     content of a @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH or
+ *                      @ref GNRC_NETAPI_MSG_TYPE_SND_BATCH message
+ * @param[in] idx       index of the packet, less than
+ *                      @ref gnrc_netapi_batch_numof()
+ *
+ * @return  the packet
+ */
+static inline gnrc_pktsnip_t *gnrc_netapi_batch_get(const gnrc_pktsnip_t *batch,
+                                                    unsigned idx)
+{
+    return ((gnrc_pktsnip_t **)batch->data)[idx];
+}
+
 #ifdef __cplusplus
 }
 #endif
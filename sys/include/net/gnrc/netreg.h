@@ -22,6 +22,7 @@
 #define NET_GNRC_NETREG_H
 
 #include <inttypes.h>
+#include <stdbool.h>
 
 #include "sched.h"
 #include "net/gnrc/nettype.h"
@@ -87,52 +88,57 @@ typedef enum {
 /**
  * @brief   Initializes a netreg entry statically with PID
  *
- * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
- *                      for the netreg entry
- * @param[in] pid       The PID of the registering thread
+ * @param[in] _demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                       for the netreg entry
+ * @param[in] _pid       The PID of the registering thread
  *
  * @return  An initialized netreg entry
  */
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
-                                                      GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(_demux_ctx, _pid)  { .next = NULL, \
+                                                        .demux_ctx = _demux_ctx, \
+                                                        .type = GNRC_NETREG_TYPE_DEFAULT, \
+                                                        .target = { .pid = _pid } }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(_demux_ctx, _pid)  { .next = NULL, \
+                                                        .demux_ctx = _demux_ctx, \
+                                                        .target = { .pid = _pid } }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
 /**
  * @brief   Initializes a netreg entry statically with mbox
  *
- * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
- *                      for the netreg entry
+ * @param[in] _demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                       for the netreg entry
  * @param[in] _mbox      Target @ref core_mbox "mailbox" for the registry entry
  *
  * @note    Only available with @ref net_gnrc_netapi_mbox.
  *
  * @return  An initialized netreg entry
  */
-#define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, _mbox) { NULL, demux_ctx, \
-                                                       GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = _mbox } }
+#define GNRC_NETREG_ENTRY_INIT_MBOX(_demux_ctx, _mbox) { .next = NULL, \
+                                                         .demux_ctx = _demux_ctx, \
+                                                         .type = GNRC_NETREG_TYPE_MBOX, \
+                                                         .target = { .mbox = _mbox } }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
 /**
  * @brief   Initializes a netreg entry statically with callback
  *
- * @param[in] demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
- *                      for the netreg entry
+ * @param[in] _demux_ctx The @ref gnrc_netreg_entry_t::demux_ctx "demux context"
+ *                       for the netreg entry
  * @param[in] _cbd       Target callback for the registry entry
  *
  * @note    Only available with @ref net_gnrc_netapi_callbacks.
  *
  * @return  An initialized netreg entry
  */
-#define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)   { NULL, demux_ctx, \
-                                                      GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = _cbd } }
+#define GNRC_NETREG_ENTRY_INIT_CB(_demux_ctx, _cbd)   { .next = NULL, \
+                                                        .demux_ctx = _demux_ctx, \
+                                                        .type = GNRC_NETREG_TYPE_CB, \
+                                                        .target = { .cbd = _cbd } }
 /** @} */
 
 /**
@@ -210,6 +216,15 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+#if defined(MODULE_GNRC_NETAPI_BATCH) || defined(DOXYGEN)
+    /**
+     * @brief   The target handles batch messages
+     *
+     * @note    Only available with @ref net_gnrc_netapi_batch. Set with
+     *          @ref gnrc_netapi_batch_accept().
+     */
+    bool batch;
+#endif
 } gnrc_netreg_entry_t;
 
 /**
@@ -241,6 +256,9 @@ static inline void gnrc_netreg_entry_init_pid(gnrc_netreg_entry_t *entry,
     entry->type = GNRC_NETREG_TYPE_DEFAULT;
 #endif
     entry->target.pid = pid;
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    entry->batch = false;
+#endif
 }
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -262,6 +280,9 @@ static inline void gnrc_netreg_entry_init_mbox(gnrc_netreg_entry_t *entry,
     entry->demux_ctx = demux_ctx;
     entry->type = GNRC_NETREG_TYPE_MBOX;
     entry->target.mbox = mbox;
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    entry->batch = false;
+#endif
 }
 #endif
 
@@ -284,6 +305,9 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
     entry->demux_ctx = demux_ctx;
     entry->type = GNRC_NETREG_TYPE_CB;
     entry->target.cbd = cbd;
+#ifdef MODULE_GNRC_NETAPI_BATCH
+    entry->batch = false;
+#endif
 }
 #endif
 /** @} */
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktbuf_sizeclass   Size-class packet buffer
+ * @ingroup     net_gnrc_pktbuf
+ * @brief       Packet buffer backend with segregated size classes
+ *
+ * This implementation of @ref net_gnrc_pktbuf splits its static arena into
+ * pools of fixed-size blocks: one for packet snip descriptors and three for
+ * payload data of increasing size. Every pool keeps its own free list, so
+ * allocating and freeing are constant-time operations and the arena can not
+ * fragment into unusable holes, as it can happen with the first-fit free list
+ * of `gnrc_pktbuf_static` under sustained load. An allocation that does not
+ * find a free block in its own class falls back to the next larger class.
+ *
+ * To use it, add `USEMODULE += gnrc_pktbuf_sizeclass` to your application's
+ * Makefile.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Size-class packet buffer definitions
+ */
+#ifndef NET_GNRC_PKTBUF_SIZECLASS_H
+#define NET_GNRC_PKTBUF_SIZECLASS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_gnrc_pktbuf_sizeclass_conf GNRC size-class packet buffer compile configurations
+ * @ingroup net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of blocks for packet snip descriptors
+ *
+ * Blocks of this class are also used for payloads that fit a snip descriptor.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SIZECLASS_SNIP_NUMOF
+#define CONFIG_GNRC_PKTBUF_SIZECLASS_SNIP_NUMOF     (32)
+#endif
+
+/**
+ * @brief   Block size of the small payload class (e.g. headers)
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_SIZE
+#define CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_SIZE     (64)
+#endif
+
+/**
+ * @brief   Number of blocks in the small payload class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_NUMOF
+#define CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_NUMOF    (24)
+#endif
+
+/**
+ * @brief   Block size of the medium payload class (e.g. link-layer frames)
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_SIZE
+#define CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_SIZE    (256)
+#endif
+
+/**
+ * @brief   Number of blocks in the medium payload class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_NUMOF
+#define CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_NUMOF   (8)
+#endif
+
+/**
+ * @brief   Block size of the large payload class
+ *
+ * This is the maximum size of a single payload. The default fits an
+ * Ethernet frame, so full-MTU IPv6 packets can be received.
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_SIZE
+#define CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_SIZE     (1536)
+#endif
+
+/**
+ * @brief   Number of blocks in the large payload class
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_NUMOF
+#define CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_NUMOF    (4)
+#endif
+/** @} */
+
+/**
+ * @brief   Number of size classes
+ */
+#define GNRC_PKTBUF_SIZECLASS_NUMOF     (4U)
+
+/**
+ * @brief   Rounds @p size up to the alignment of blocks
+ */
+#define GNRC_PKTBUF_SIZECLASS_ALIGN(size) \
+    (((size) + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1))
+
+/**
+ * @brief   Size of the arena in bytes
+ */
+#define GNRC_PKTBUF_SIZECLASS_SIZE \
+    ((GNRC_PKTBUF_SIZECLASS_ALIGN(sizeof(gnrc_pktsnip_t)) * \
+      CONFIG_GNRC_PKTBUF_SIZECLASS_SNIP_NUMOF) + \
+     (GNRC_PKTBUF_SIZECLASS_ALIGN(CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_NUMOF) + \
+     (GNRC_PKTBUF_SIZECLASS_ALIGN(CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_NUMOF) + \
+     (GNRC_PKTBUF_SIZECLASS_ALIGN(CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_SIZE) * \
+      CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_NUMOF))
+
+/**
+ * @brief   Usage counters of a single size class
+ */
+typedef struct {
+    uint16_t size;          /**< block size in bytes */
+    uint16_t numof;         /**< number of blocks */
+    uint16_t used;          /**< blocks currently in use */
+    uint16_t max_used;      /**< high-water mark of
+                             *   gnrc_pktbuf_sizeclass_class_stats_t::used */
+    uint32_t fallbacks;     /**< allocations served from this class because
+                             *   the best fitting class was exhausted */
+} gnrc_pktbuf_sizeclass_class_stats_t;
+
+/**
+ * @brief   Usage counters of the packet buffer
+ */
+typedef struct {
+    /**
+     * @brief   Per-class counters, ordered by ascending block size
+     */
+    gnrc_pktbuf_sizeclass_class_stats_t classes[GNRC_PKTBUF_SIZECLASS_NUMOF];
+    size_t used;            /**< bytes of the arena currently in use */
+    size_t max_used;        /**< high-water mark of
+                             *   gnrc_pktbuf_sizeclass_stats_t::used */
+    uint32_t failed;        /**< failed allocations */
+    /**
+     * @brief   Failed allocations for which enough bytes were free in total
+     *
+     * A measure for the fragmentation of the arena: the request failed only
+     * because the free bytes were spread over blocks that were too small.
+     */
+    uint32_t failed_frag;
+} gnrc_pktbuf_sizeclass_stats_t;
+
+/**
+ * @brief   Gets the usage counters of the packet buffer
+ *
+ * @param[out] stats    The usage counters. Must not be NULL.
+ */
+void gnrc_pktbuf_sizeclass_get_stats(gnrc_pktbuf_sizeclass_stats_t *stats);
+
+/**
+ * @brief   Resets the high-water marks and failure counters
+ */
+void gnrc_pktbuf_sizeclass_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTBUF_SIZECLASS_H */
+/** @} */
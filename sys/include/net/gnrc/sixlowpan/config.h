@@ -53,6 +53,23 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_MSG_QUEUE_SIZE_EXP   (3U)
 #endif
 
+/**
+ * @brief   Number of flows in the compressed header cache of IPHC
+ *
+ * The IPHC encoder keeps the compressed headers of recently sent flows, keyed
+ * by interface, link-layer destination, IPv6 addresses, traffic class, flow
+ * label, next header, hop limit and UDP ports. Further packets of a cached
+ * flow then skip the context look-ups and address compression. The cache is
+ * invalidated when a context or the link-layer address of an interface
+ * changes. Set to 0 to disable the cache.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_iphc](@ref net_gnrc_sixlowpan_iphc) module
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE      (0U)
+#endif
+
 /**
  * @brief   Number of datagrams that can be fragmented simultaneously
  *
@@ -45,6 +45,10 @@ extern "C" {
  * @note    Fragments MUST NOT overlap and overlapping fragments are to be
  *          discarded
  *
+ * The intervals of a reassembly buffer entry are sorted by descending
+ * gnrc_sixlowpan_frag_rb_int_t::start, so the overlap check for a fragment
+ * that arrives in order only looks at the interval received last.
+ *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
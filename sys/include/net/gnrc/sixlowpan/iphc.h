@@ -23,6 +23,7 @@
 #include <stdbool.h>
 
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/config.h"
 #include "net/sixlowpan.h"
 
 #ifdef __cplusplus
@@ -63,6 +64,23 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
  */
 void gnrc_sixlowpan_iphc_send(gnrc_pktsnip_t *pkt, void *ctx, unsigned page);
 
+#if (CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE > 0) || defined(DOXYGEN)
+/**
+ * @brief   Invalidates all entries of the compressed header cache
+ *
+ * Needs to be called when an input to the compression other than the packet
+ * itself changes, e.g. the link-layer address of an interface. Changes of
+ * the context buffer are detected by the cache itself.
+ *
+ * @note    Only available with @ref CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE > 0
+ */
+void gnrc_sixlowpan_iphc_cache_invalidate(void);
+#else
+static inline void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,11 @@
  * @ingroup     net_gnrc
  * @brief       RIOT's TCP implementation for the GNRC network stack.
  *
+ * With the `gnrc_tcp_congure_reno` module, the segments sent are limited by
+ * the congestion window of @ref sys_congure_reno and duplicate
+ * acknowledgments trigger a fast retransmit. As GNRC TCP only keeps one
+ * segment in flight, this mostly affects recovery after losses.
+ *
  * @{
  *
  * @file
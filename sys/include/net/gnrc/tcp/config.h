@@ -101,6 +101,39 @@ extern "C" {
 #define CONFIG_GNRC_TCP_RCV_BUFFERS (1U)
 #endif
 
+/**
+ * @brief Number of out-of-order segments kept per connection for reassembly
+ *
+ * Segments that arrive ahead of the next expected sequence number are held in
+ * the packet buffer until the gap before them is filled. If zero, these
+ * segments are dropped and have to be retransmitted by the peer. Useful with
+ * a receive window of several segments, see
+ * @ref CONFIG_GNRC_TCP_MSS_MULTIPLICATOR.
+ */
+#ifndef CONFIG_GNRC_TCP_REASS_QUEUE_SIZE
+#define CONFIG_GNRC_TCP_REASS_QUEUE_SIZE (0U)
+#endif
+
+/**
+ * @brief Enable selective acknowledgments (SACK, RFC 2018). Disabled by default.
+ *
+ * SACK is offered to peers, and the out-of-order segments kept for
+ * reassembly are reported in acknowledgments if the peer permits SACK.
+ */
+#ifndef CONFIG_GNRC_TCP_SACK_EN
+#define CONFIG_GNRC_TCP_SACK_EN 0
+#endif
+
+/**
+ * @brief Window scale shift count offered to peers (RFC 7323)
+ *
+ * Window scaling is disabled if zero. Only needed for receive windows larger
+ * than 65535 bytes, but also enables scaled send windows from peers.
+ */
+#ifndef CONFIG_GNRC_TCP_WND_SCALE
+#define CONFIG_GNRC_TCP_WND_SCALE (0U)
+#endif
+
 /**
  * @brief Default receive buffer size
  */
@@ -34,6 +34,10 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_TCP_CONGURE_RENO
+#include "congure/reno.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,14 +58,16 @@ typedef struct sock_tcp {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
+    uint8_t snd_wnd_scale; /**< Window scale shift count of the peer */
+    uint8_t rcv_wnd_scale; /**< Window scale shift count of the receive window */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
@@ -71,6 +77,16 @@ typedef struct sock_tcp {
     evtimer_msg_event_t event_timeout;    /**< Timeout event */
     evtimer_mbox_event_t event_misc;      /**< General purpose event */
     gnrc_pktsnip_t *pkt_retransmit;       /**< Pointer to packet in "retransmit queue" */
+#if (CONFIG_GNRC_TCP_REASS_QUEUE_SIZE > 0) || defined(DOXYGEN)
+    /**
+     * @brief Out-of-order segments, ordered by sequence number
+     */
+    gnrc_pktsnip_t *reass[CONFIG_GNRC_TCP_REASS_QUEUE_SIZE];
+    uint32_t reass_last;   /**< Sequence number of the last segment queued */
+#endif
+#ifdef MODULE_GNRC_TCP_CONGURE_RENO
+    congure_reno_snd_t cong;              /**< Congestion control state */
+#endif
     mbox_t *mbox;            /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
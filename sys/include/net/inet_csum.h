@@ -73,6 +73,60 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates an Internet Checksum after a 16-bit word of its domain was
+ *          changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Other than inet_csum_slice() this function works on the
+ *          normalized checksum, as it is found in the header, e.g. after a
+ *          header field was rewritten on forwarding. As for the
+ *          calculation from scratch, a resulting checksum of 0 is not
+ *          mapped to 0xffff for UDP.
+ *
+ * @param[in] csum      The (normalized) checksum in host byte order.
+ * @param[in] old_val   The old value of the word in host byte order.
+ * @param[in] new_val   The new value of the word in host byte order.
+ *
+ * @return  The updated (normalized) checksum in host byte order.
+ */
+static inline uint16_t inet_csum_update16(uint16_t csum, uint16_t old_val,
+                                          uint16_t new_val)
+{
+    /* RFC 1624, equation 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_val + (uint32_t)new_val;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
+/**
+ * @brief   Updates an Internet Checksum after a field of its domain was
+ *          changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Like inet_csum_update16(), but for longer fields, e.g. an address
+ *          in the pseudo header.
+ *
+ * @pre The field starts at an even offset in the checksum domain.
+ *
+ * @param[in] csum      The (normalized) checksum in host byte order.
+ * @param[in] old_val   The old value of the field.
+ * @param[in] new_val   The new value of the field.
+ * @param[in] len       Length of the field in byte.
+ *
+ * @return  The updated (normalized) checksum in host byte order.
+ */
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_val,
+                          const uint8_t *new_val, uint16_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -64,6 +64,14 @@
  * and exact matching should be register, and then a second one with the path
  * `/resource01/` and subtree matching.
  *
+ * Resources must be sorted by their path. The resource for a request is then
+ * found by a binary search in the resource array, so a static, sorted array of
+ * resources already is the look-up table for dispatching requests and no
+ * further index has to be built at run time. If several resources match, the
+ * first of them in the array is used. Set
+ * @ref CONFIG_NANOCOAP_RESOURCE_LINEAR to scan the resources one by one
+ * instead.
+ *
  * @{
  *
  * @file
@@ -148,6 +156,16 @@ extern "C" {
 #ifndef CONFIG_NANOCOAP_QS_MAX
 #define CONFIG_NANOCOAP_QS_MAX             (64)
 #endif
+
+/**
+ * @brief   Find the resource for a request by scanning all resources
+ *
+ * By default, the resource is found by a binary search in the sorted array of
+ * resources, see @ref net_nanocoap "Server path matching".
+ */
+#ifndef CONFIG_NANOCOAP_RESOURCE_LINEAR
+#define CONFIG_NANOCOAP_RESOURCE_LINEAR    0
+#endif
 /** @} */
 
 /**
@@ -1620,6 +1638,24 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
                           const coap_resource_t *resources,
                           size_t resources_numof);
 
+/**
+ * @brief   Find the resource for a request
+ *
+ * @pre     @p resources are sorted by coap_resource_t::path
+ *
+ * @param[in]   resources       Array of coap endpoint resources
+ * @param[in]   resources_numof length of the coap endpoint resources
+ * @param[in]   uri             Null-terminated URI path of the request
+ * @param[in]   method_flag     method of the request, see coap_method2flag()
+ *
+ * @returns     index of the first resource in @p resources matching @p uri
+ *              and @p method_flag
+ * @returns     -EPERM if a resource matches @p uri, but not @p method_flag
+ * @returns     -ENOENT if no resource matches @p uri
+ */
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const uint8_t *uri, coap_method_flags_t method_flag);
+
 /**
  * @brief   Convert message code (request method) into a corresponding bit field
  *
@@ -68,6 +68,10 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+    uint32_t rx_batches;        /**< device events that received packets,
+                                     drivers receiving several frames per
+                                     event have less than rx_count */
+    uint32_t rx_batch_max;      /**< most packets received in one event */
 } netstats_t;
 
 /**
@@ -268,10 +268,13 @@
 #ifndef NET_SOCK_UDP_H
 #define NET_SOCK_UDP_H
 
+#include <assert.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <sys/types.h>
 
+#include "iolist.h"
+
 /* net/sock/async/types.h included by net/sock.h needs to re-typedef the
  * `sock_ip_t` to prevent cyclic includes */
 #if defined (__clang__)
@@ -352,6 +355,16 @@ typedef struct {
     sock_aux_flags_t flags; /**< Flags used request information */
 } sock_udp_aux_tx_t;
 
+/**
+ * @brief   Message slot for sock_udp_recv_multi()
+ */
+typedef struct {
+    void *data;             /**< Buffer to store the payload in */
+    size_t max_len;         /**< Maximum space available at sock_udp_msg_t::data */
+    ssize_t len;            /**< Length of the received payload or -ENOBUFS */
+    sock_udp_ep_t remote;   /**< Remote end point of the message */
+} sock_udp_msg_t;
+
 /**
  * @brief   Creates a new UDP sock object
  *
@@ -604,6 +617,91 @@ static inline ssize_t sock_udp_recv_buf(sock_udp_t *sock,
     return sock_udp_recv_buf_aux(sock, data, buf_ctx, timeout, remote, NULL);
 }
 
+/**
+ * @brief   Receives multiple UDP messages in one call
+ *
+ * Waits up to @p timeout for the first message. After that, all messages
+ * already queued for @p sock are received without blocking, until either
+ * @p num messages were received or no message is left.
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (num > 0)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Array of @p num message slots. sock_udp_msg_t::data
+ *                      and sock_udp_msg_t::max_len must be set by the caller.
+ * @param[in] num       Number of slots in @p msgs.
+ * @param[in] timeout   Timeout for receiving the first message in
+ *                      microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ *
+ * @note    Messages from a remote other than the remote of @p sock are
+ *          dropped silently, except for the first one.
+ *
+ * @return  The number of slots filled in @p msgs on success. The
+ *          sock_udp_msg_t::len of a slot is -ENOBUFS, if its buffer was too
+ *          small for the message.
+ * @return  any error sock_udp_recv() returns for the first message.
+ */
+int sock_udp_recv_multi(sock_udp_t *sock, sock_udp_msg_t *msgs, unsigned num,
+                        uint32_t timeout);
+
+/**
+ * @brief   Sends a UDP message to remote end point, gathering the payload from
+ *          a list of buffers
+ *
+ * The payload is assembled from @p snips directly within the stack's packet
+ * buffer, so header and payload need not be copied into a staging buffer.
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of payload chunks, sent in order.
+ *                      May be `NULL` for an empty payload.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_udp_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *                      sock_udp_ep_t::port may not be 0.
+ * @param[out] aux      Auxiliary data about the transmission.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  any error sock_udp_send_aux() returns.
+ */
+ssize_t sock_udp_sendv_aux(sock_udp_t *sock, const iolist_t *snips,
+                           const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux);
+
+/**
+ * @brief   Sends a UDP message to remote end point, gathering the payload from
+ *          a list of buffers
+ *
+ * @pre `((sock != NULL || remote != NULL))`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`.
+ *                      A sensible local end point should be selected by the
+ *                      implementation in that case.
+ * @param[in] snips     List of payload chunks, sent in order.
+ *                      May be `NULL` for an empty payload.
+ * @param[in] remote    Remote end point for the sent data.
+ *                      May be `NULL`, if @p sock has a remote end point.
+ *                      sock_udp_ep_t::family may be AF_UNSPEC, if local
+ *                      end point of @p sock provides this information.
+ *                      sock_udp_ep_t::port may not be 0.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  any error sock_udp_send_aux() returns.
+ */
+static inline ssize_t sock_udp_sendv(sock_udp_t *sock, const iolist_t *snips,
+                                     const sock_udp_ep_t *remote)
+{
+    return sock_udp_sendv_aux(sock, snips, remote, NULL);
+}
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -639,8 +737,16 @@ static inline ssize_t sock_udp_recv_buf(sock_udp_t *sock,
  * @return  -ENOMEM, if no memory was available to send @p data.
  * @return  -ENOTCONN, if `remote == NULL`, but @p sock has no remote end point.
  */
-ssize_t sock_udp_send_aux(sock_udp_t *sock, const void *data, size_t len,
-                          const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux);
+static inline ssize_t sock_udp_send_aux(sock_udp_t *sock,
+                                        const void *data, size_t len,
+                                        const sock_udp_ep_t *remote,
+                                        sock_udp_aux_tx_t *aux)
+{
+    const iolist_t snip = { NULL, (void *)data, len };
+
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return sock_udp_sendv_aux(sock, &snip, remote, aux);
+}
 
 /**
  * @brief   Sends a UDP message to remote end point
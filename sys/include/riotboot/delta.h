@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_riotboot_delta riotboot delta updates
+ * @ingroup     sys
+ * @{
+ *
+ * @file
+ * @brief       Streaming application of delta patches to firmware images
+ *
+ * A delta patch describes a new firmware image in terms of the image that is
+ * currently installed, the base image. It is created on the host with
+ * `dist/tools/riotboot_delta/gen_delta.py`. As a small change to the firmware
+ * leaves most of the image unchanged, the patch is a lot smaller than the new
+ * image, which saves airtime on constrained networks.
+ *
+ * The patch is applied while it is received: the data passed to
+ * riotboot_delta_putbytes() can be split at arbitrary positions, and the
+ * bytes of the new image are passed to a callback as soon as they are known,
+ * e.g. to riotboot_flashwrite_putbytes(). The base image is read in place,
+ * so no RAM besides the @ref riotboot_delta_t state is needed.
+ *
+ * All integers in the patch are little endian. The patch starts with a
+ * header:
+ *
+ * | Field        | Size | Description                                  |
+ * |--------------|------|----------------------------------------------|
+ * | magic        | 4    | "RDLT"                                       |
+ * | base_len     | 4    | length of the base image                     |
+ * | new_len      | 4    | length of the new image                      |
+ * | base_digest  | 32   | SHA-256 digest of the base image             |
+ *
+ * The header is followed by commands until the new image is complete. Each
+ * command starts with an unsigned LEB128 number, the lowest bit of which is
+ * the type of the command and the remaining bits are its length:
+ *
+ * - copy (0): a signed (zigzag encoded) LEB128 number follows, which is
+ *   added to the current position in the base image. Then length bytes are
+ *   copied from that position of the base image to the new image, and the
+ *   position is advanced past them.
+ * - insert (1): length bytes of the new image follow in the patch.
+ *
+ * The patch is checked against the base image before it is applied, the
+ * result has to be verified by the caller, e.g. with the digest in the SUIT
+ * manifest.
+ */
+
+#ifndef RIOTBOOT_DELTA_H
+#define RIOTBOOT_DELTA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hashes/sha256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number at the start of a delta patch
+ */
+#define RIOTBOOT_DELTA_MAGIC        "RDLT"
+
+/**
+ * @brief   Length of the delta patch header
+ */
+#define RIOTBOOT_DELTA_HDR_LEN      (12U + SHA256_DIGEST_LENGTH)
+
+/**
+ * @brief   Callback that receives the bytes of the new image in order
+ *
+ * @param[in]   arg     Argument passed to riotboot_delta_init()
+ * @param[in]   buf     Bytes of the new image
+ * @param[in]   len     Number of bytes
+ *
+ * @returns     0 on success, negative on error
+ */
+typedef int (*riotboot_delta_write_t)(void *arg, const uint8_t *buf,
+                                      size_t len);
+
+/**
+ * @brief   State of a delta patch that is applied
+ */
+typedef struct {
+    riotboot_delta_write_t write;   /**< receives the new image */
+    void *arg;                      /**< argument of @ref write */
+    const uint8_t *base;            /**< base image */
+    size_t base_len;                /**< length of the base image */
+    size_t base_pos;                /**< current position in the base image */
+    size_t new_len;                 /**< length of the new image */
+    size_t new_pos;                 /**< bytes of the new image written */
+    size_t patch_pos;               /**< bytes of the patch processed */
+    size_t remaining;               /**< bytes left in the current field */
+    uint32_t value;                 /**< number being decoded */
+    uint8_t shift;                  /**< bits of the number decoded so far */
+    uint8_t state;                  /**< current field of the patch */
+    uint8_t hdr[RIOTBOOT_DELTA_HDR_LEN];    /**< header of the patch */
+} riotboot_delta_t;
+
+/**
+ * @brief   Check whether a payload is a delta patch
+ *
+ * @param[in]   buf     Start of the payload
+ * @param[in]   len     Number of bytes available at @p buf
+ *
+ * @returns     true if @p buf starts with @ref RIOTBOOT_DELTA_MAGIC
+ */
+bool riotboot_delta_is_patch(const uint8_t *buf, size_t len);
+
+/**
+ * @brief   Start to apply a delta patch
+ *
+ * @param[out]  delta       State to initialize
+ * @param[in]   base        Base image, e.g. the running slot
+ * @param[in]   base_max    Maximum length of the base image, e.g. the slot
+ *                          size
+ * @param[in]   write       Callback that receives the new image
+ * @param[in]   arg         Argument for @p write
+ */
+void riotboot_delta_init(riotboot_delta_t *delta, const void *base,
+                         size_t base_max, riotboot_delta_write_t write,
+                         void *arg);
+
+/**
+ * @brief   Apply the next part of a delta patch
+ *
+ * @param[in,out]   delta   State of the patch
+ * @param[in]       buf     Next bytes of the patch
+ * @param[in]       len     Number of bytes
+ *
+ * @returns     0 on success
+ * @returns     -EINVAL if the patch is malformed
+ * @returns     -ENOENT if the patch doesn't apply to the base image
+ * @returns     any negative error returned by the write callback
+ */
+int riotboot_delta_putbytes(riotboot_delta_t *delta, const uint8_t *buf,
+                            size_t len);
+
+/**
+ * @brief   Check that the whole patch was applied
+ *
+ * @param[in]   delta   State of the patch
+ *
+ * @returns     0 if the new image is complete
+ * @returns     -EINVAL otherwise
+ */
+int riotboot_delta_finish(const riotboot_delta_t *delta);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RIOTBOOT_DELTA_H */
+/** @} */
@@ -14,6 +14,25 @@
  *              (@ref schedstat_t) for a thread will be updated on every
  *              @ref sched_run().
  *
+ * Besides the runtime of each thread, the module records
+ *
+ * - the latency from a thread becoming ready (see
+ *   @ref sched_register_ready_cb()) until it runs, as maximum per thread and
+ *   as histogram per priority (@ref sched_latency),
+ * - the time spent in ISRs per IRQ line (@ref sched_isrlist), for CPUs
+ *   calling @ref schedstat_isr_enter() and @ref schedstat_isr_exit() from
+ *   their interrupt dispatcher: `native` (keyed by signal number), RISC-V
+ *   (keyed by PLIC/CLIC ID, the core timer is accounted to 0) and Cortex-M
+ *   cores with VTOR (keyed by IRQn, through a vector table copied to RAM),
+ * - with `USEMODULE += schedstatistics_irq_off`, the longest window with
+ *   interrupts disabled and the program counter of the `irq_disable()` call
+ *   that started it (@ref sched_irq_off), for CPUs calling
+ *   @ref schedstat_irq_off_begin() and @ref schedstat_irq_off_end() from
+ *   their IRQ API (currently `native` and Cortex-M).
+ *
+ * All times are in xtimer ticks. `ps` shows the maximum latency per thread,
+ * the `schedstat` shell command prints everything else.
+ *
  * @note        If auto_init is disabled `init_schedstatistics()` needs to be
  *              called as well as xtimer_init().
  * @{
@@ -29,12 +48,40 @@
 #ifndef SCHEDSTATISTICS_H
 #define SCHEDSTATISTICS_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
+#include "sched.h"
+
 #ifdef __cplusplus
  extern "C" {
 #endif
 
+/**
+ * @defgroup    schedstatistics_conf Schedstatistics compile configurations
+ * @ingroup     config
+ * @{
+ */
+/**
+ * @brief   Number of IRQ lines to record ISR times for
+ *
+ * ISRs of higher IRQ lines are accounted to the last entry.
+ */
+#ifndef CONFIG_SCHEDSTATISTICS_ISR_NUMOF
+#define CONFIG_SCHEDSTATISTICS_ISR_NUMOF        (32U)
+#endif
+
+/**
+ * @brief   Number of buckets of the latency histograms
+ *
+ * Bucket 0 counts latencies of 0 ticks, bucket `i` latencies in
+ * `[2 ** (i - 1), 2 ** i)` and the last bucket all longer latencies.
+ */
+#ifndef CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS
+#define CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS  (8U)
+#endif
+/** @} */
+
 /**
  *  Scheduler statistics
  */
@@ -43,13 +90,99 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+    uint32_t readystart;     /**< Time stamp of the last time this thread
+                                  became ready to run */
+    uint32_t latency_max;    /**< Longest time in ticks from becoming ready
+                                  to running */
+    bool ready;              /**< Thread became ready, but did not run yet */
 } schedstat_t;
 
+/**
+ *  ISR statistics
+ */
+typedef struct {
+    uint64_t runtime_ticks;  /**< The total runtime of the ISR in ticks */
+    uint32_t max_ticks;      /**< Longest runtime of the ISR in ticks */
+    unsigned int count;      /**< How often the ISR ran */
+} schedstat_isr_t;
+
+/**
+ *  IRQ-disabled window statistics
+ */
+typedef struct {
+    uint32_t max_ticks;      /**< Longest window with IRQs disabled in ticks */
+    const void *pc;          /**< Program counter where that window started */
+} schedstat_irq_off_t;
+
 /**
  *  Thread statistics table
  */
 extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+/**
+ *  ISR statistics table, indexed by IRQ line
+ */
+extern schedstat_isr_t sched_isrlist[CONFIG_SCHEDSTATISTICS_ISR_NUMOF];
+
+/**
+ *  Ready-to-running latency histograms, indexed by priority
+ */
+extern unsigned int sched_latency[SCHED_PRIO_LEVELS]
+                                 [CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS];
+
+/**
+ *  Longest window with IRQs disabled
+ */
+extern schedstat_irq_off_t sched_irq_off;
+
+/**
+ * @brief   Get the lower bound of a latency histogram bucket
+ *
+ * @param[in] bucket    bucket of @ref sched_latency
+ *
+ * @return  smallest latency in ticks counted in @p bucket
+ */
+static inline uint32_t schedstat_latency_bucket_min(unsigned bucket)
+{
+    return (bucket == 0) ? 0 : (UINT32_C(1) << (bucket - 1));
+}
+
+/**
+ * @brief   Call on entry of an ISR
+ *
+ * @return  time stamp to pass to @ref schedstat_isr_exit()
+ */
+uint32_t schedstat_isr_enter(void);
+
+/**
+ * @brief   Call on exit of an ISR
+ *
+ * @param[in] irq       IRQ line the ISR served
+ * @param[in] start     return value of @ref schedstat_isr_enter()
+ */
+void schedstat_isr_exit(unsigned irq, uint32_t start);
+
+/**
+ * @brief   Call when interrupts were enabled and got disabled
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param[in] pc        program counter of the caller disabling interrupts
+ */
+void schedstat_irq_off_begin(const void *pc);
+
+/**
+ * @brief   Call right before interrupts are enabled again
+ *
+ * Must be called with interrupts disabled.
+ */
+void schedstat_irq_off_end(void);
+
+/**
+ * @brief   Reset the latency, ISR and IRQ-disabled window statistics
+ */
+void schedstat_reset(void);
+
 /**
  *  @brief  Registers the sched statistics callback and sets laststart for
  *          caller thread
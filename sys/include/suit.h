@@ -30,13 +30,19 @@
 #ifndef SUIT_H
 #define SUIT_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include "cose/sign.h"
+#include "hashes/sha256.h"
 #include "nanocbor/nanocbor.h"
 #include "uuid.h"
 
+#ifdef MODULE_RIOTBOOT_DELTA
+#include "riotboot/delta.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -197,6 +203,8 @@ typedef struct {
 #define SUIT_COMPONENT_STATE_FETCH_FAILED  (1 << 1) /**< Component fetched but failed */
 #define SUIT_COMPONENT_STATE_VERIFIED      (1 << 2) /**< Component is verified */
 #define SUIT_COMPONENT_STATE_FINALIZED     (1 << 3) /**< Component successfully installed */
+#define SUIT_COMPONENT_STATE_DIGESTED      (1 << 4) /**< Digest computed while fetching */
+#define SUIT_COMPONENT_STATE_DELTA         (1 << 5) /**< Payload is a delta patch */
 /** @} */
 
 /**
@@ -225,6 +233,12 @@ typedef struct {
      * @brief Component offset inside the device memory.
      */
     suit_param_ref_t param_component_offset;
+
+    /**
+     * @brief SHA-256 digest of the payload, valid if the
+     *        @ref SUIT_COMPONENT_STATE_DIGESTED flag is set
+     */
+    uint8_t digest[SHA256_DIGEST_LENGTH];
 } suit_component_t;
 
 /**
@@ -245,6 +259,14 @@ typedef struct {
     uint8_t validation_buf[SUIT_COSE_BUF_SIZE];
     char *urlbuf;                   /**< Buffer containing the manifest url */
     size_t urlbuf_len;              /**< Length of the manifest url */
+    /** Digest of the payload being fetched */
+    sha256_context_t fetch_digest;
+    /** Number of payload bytes fetched in order, SIZE_MAX if out of order */
+    size_t fetch_offset;
+#if defined(MODULE_RIOTBOOT_DELTA) || defined(DOXYGEN)
+    /** Delta patch being applied to the payload being fetched */
+    riotboot_delta_t fetch_delta;
+#endif
 } suit_manifest_t;
 
 /**
@@ -298,6 +320,18 @@ static inline void suit_component_set_flag(suit_component_t *component,
     component->state |= flag;
 }
 
+/**
+ * @brief Clear a component flag
+ *
+ * @param   component   Component to clear flag for
+ * @param   flag        Flag to clear
+ */
+static inline void suit_component_clear_flag(suit_component_t *component,
+                                             uint16_t flag)
+{
+    component->state &= ~flag;
+}
+
 /**
  * @brief Check a component flag
  *
@@ -324,6 +358,32 @@ int suit_component_name_to_string(const suit_manifest_t *manifest,
                                   const suit_component_t *component,
                                   char separator, char *buf, size_t buf_len);
 
+/**
+ * @brief Write a chunk of the payload of the current component to storage
+ *
+ * The SHA-256 digest of the payload is computed while it is written, so it
+ * doesn't have to be read back from storage to verify it. This requires the
+ * chunks to be written in order, without gaps.
+ *
+ * With the `riotboot_delta` module, the payload can also be a delta patch
+ * against the payload installed at the location (see @ref sys_riotboot_delta),
+ * if the storage backend implements @ref suit_storage_read_base_ptr. The
+ * patch is applied while it is written, the size and digest in the manifest
+ * refer to the resulting payload. The chunks of a patch must be written in
+ * order.
+ *
+ * @param[in]   manifest    SUIT manifest context
+ * @param[in]   buf         Chunk of the payload
+ * @param[in]   offset      Offset of the chunk in the payload
+ * @param[in]   len         Length of the chunk
+ * @param[in]   more        Whether more chunks follow
+ *
+ * @return              SUIT_OK on success
+ * @return              <0 on error
+ */
+int suit_payload_write(suit_manifest_t *manifest, const uint8_t *buf,
+                       size_t offset, size_t len, bool more);
+
 /**
  * @brief Helper function for writing bytes on flash a specified offset
  *
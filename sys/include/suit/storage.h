@@ -61,6 +61,11 @@
  * suit_storage_driver_t::read_ptr is optional to implement, it can provide
  * direct read access on memory-mapped storage.
  *
+ * @ref suit_storage_driver_t::read_base_ptr is optional as well. It provides
+ * direct read access to the currently installed payload of the location, which
+ * allows the payload to be sent as a delta patch against it (see @ref
+ * sys_riotboot_delta).
+ *
  * As the storage backend provides a mechanism to store persistent data,
  * functions are added to set and retrieve the manifest sequence number. While
  * not strictly required to implement, a firmware without a mechanism to
@@ -189,6 +194,22 @@ typedef struct suit_storage_driver {
     int (*read_ptr)(suit_storage_t *storage,
                     const uint8_t **buf, size_t *len);
 
+    /**
+     * @brief retrieve a direct read pointer to the currently installed payload
+     *        of the active location, the base of a delta patch
+     *
+     * @note Optional to implement
+     *
+     * @param[in]   storage     Storage context
+     * @param[out]  buf         Pointer to the installed payload
+     * @param[out]  len         Maximum length of the installed payload
+     *
+     * @returns     @ref SUIT_OK on successfully providing the region
+     * @returns     @ref suit_error_t on error
+     */
+    int (*read_base_ptr)(suit_storage_t *storage,
+                         const uint8_t **buf, size_t *len);
+
     /**
      * @brief Install the payload or mark the payload as valid
      *
@@ -376,6 +397,20 @@ static inline bool suit_storage_has_readptr(const suit_storage_t *storage)
     return (storage->driver->read_ptr);
 }
 
+/**
+ * @brief Check if the storage backend implements the @ref
+ * suit_storage_driver_t::read_base_ptr function
+ *
+ * @param[in]   storage     Storage context
+ *
+ * @returns     True if the function is implemented,
+ * @returns     False otherwise
+ */
+static inline bool suit_storage_has_base_ptr(const suit_storage_t *storage)
+{
+    return (storage->driver->read_base_ptr);
+}
+
 /**
  * @brief Check if the storage backend implements the @ref
  * suit_storage_driver_t::match_offset function
@@ -487,6 +522,25 @@ static inline int suit_storage_read_ptr(suit_storage_t *storage, const uint8_t
     return storage->driver->read_ptr(storage, buf, len);
 }
 
+/**
+ * @brief retrieve a direct read pointer to the currently installed payload of
+ *        the active location
+ *
+ * @note Optional to implement, check with @ref suit_storage_has_base_ptr
+ *
+ * @param[in]   storage     Storage context
+ * @param[out]  buf         Pointer to the installed payload
+ * @param[out]  len         Maximum length of the installed payload
+ *
+ * @returns     @ref SUIT_OK on successfully providing the region
+ * @returns     @ref suit_error_t on error
+ */
+static inline int suit_storage_read_base_ptr(suit_storage_t *storage,
+                                             const uint8_t **buf, size_t *len)
+{
+    return storage->driver->read_base_ptr(storage, buf, len);
+}
+
 /**
  * @brief Install the payload or mark the payload as valid
  *
@@ -40,6 +40,14 @@ typedef struct {
     size_t len;         /**< Length of the payload in bytes */
 } suit_transport_mock_payload_t;
 
+/**
+ * @brief Size of the chunks the payloads are written in
+ *
+ * With 0 (default), each payload is written at once. Otherwise the first two
+ * chunks are written in swapped order, to test writes out of order.
+ */
+extern size_t suit_transport_mock_chunk_len;
+
 /**
  * @brief 'fetch' a payload
  *
@@ -51,7 +59,7 @@ typedef struct {
  * @returns     SUIT_OK if valid
  * @returns     negative otherwise
  */
-int suit_transport_mock_fetch(const suit_manifest_t *manifest);
+int suit_transport_mock_fetch(suit_manifest_t *manifest);
 
 #ifdef __cplusplus
 }
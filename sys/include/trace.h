@@ -28,6 +28,25 @@
  *
  * Tracing is made thread safe by disabling interrupts for critical sections.
  *
+ * Typed events
+ * ============
+ *
+ * Besides the user values, the buffer records typed events with
+ * `trace_event()`. With `USEMODULE += trace_events`, RIOT itself records
+ * events for context switches, messages, mutex contention, packet buffer
+ * allocations and network interface TX/RX (see @ref trace_event_type_t). Each
+ * entry is a compact 12 byte record. The event types to be recorded can be
+ * selected at runtime with `trace_set_mask()`, so it is cheap enough to leave
+ * the module enabled in a deployed application and look at the buffer only
+ * when needed.
+ *
+ * `trace_drain()` moves all entries recorded since the last drain out of the
+ * buffer in a binary format (see @ref trace_hdr_t), either to stdio
+ * (`trace_drain_stdio()`, as hex encoded lines prefixed by `TRACE:`) or to a
+ * VFS file (`trace_drain_vfs()`). `dist/tools/trace/trace2json.py` decodes
+ * both into the Chrome trace event JSON format for `chrome://tracing` or
+ * https://ui.perfetto.dev.
+ *
  * It does incur some overhead (at least a function call, getting the current
  * time, a pair of enable/disable interrupts and a couple of memory accesses).
  *
@@ -53,12 +72,115 @@
 #ifndef TRACE_H
 #define TRACE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @defgroup sys_trace_conf  Trace compile configurations
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Number of entries in the trace buffer
+ */
+#ifndef CONFIG_TRACE_BUFSIZE
+#define CONFIG_TRACE_BUFSIZE        (512)
+#endif
+
+/**
+ * @brief   Event types recorded after boot, as bit mask of
+ *          `(1 << @ref trace_event_type_t)`
+ */
+#ifndef CONFIG_TRACE_EVENTS_MASK
+#define CONFIG_TRACE_EVENTS_MASK    (0xffffffffUL)
+#endif
+/** @} */
+
+/**
+ * @brief   Magic number at the start of each drained chunk ("RTRC" when
+ *          stored in little endian)
+ *
+ * The decoder uses its byte order to detect the endianness of the records.
+ */
+#define TRACE_MAGIC                 (0x43525452UL)
+
+/**
+ * @brief   Version of the binary format
+ */
+#define TRACE_VERSION               (1U)
+
+/**
+ * @brief   Value of trace_entry_t::pid for events recorded in interrupt
+ *          context
+ */
+#define TRACE_PID_ISR               (0xffU)
+
+/**
+ * @brief   Types of trace events
+ *
+ * The values are part of the binary format and must not be changed.
+ */
+typedef enum {
+    TRACE_USER = 0,         /**< `trace()`, arg: user value */
+    TRACE_SCHED_SWITCH,     /**< context switch, arg16: previous thread,
+                                 arg: next thread */
+    TRACE_MSG_SEND,         /**< message sent, arg16: target thread,
+                                 arg: message type */
+    TRACE_MSG_RECV,         /**< message received, arg16: sender,
+                                 arg: message type */
+    TRACE_MUTEX_CONTEND,    /**< thread blocks on a locked mutex,
+                                 arg: mutex address */
+    TRACE_PKTBUF_ALLOC,     /**< packet snip allocated, arg16: data size,
+                                 arg: snip address */
+    TRACE_PKTBUF_FREE,      /**< packet snip freed, arg16: data size,
+                                 arg: snip address */
+    TRACE_NETIF_TX,         /**< packet handed to a device, arg16: netif
+                                 thread, arg: packet address */
+    TRACE_NETIF_RX,         /**< packet received from a device, arg16: netif
+                                 thread, arg: packet address */
+    TRACE_EVENT_NUMOF,      /**< number of event types */
+} trace_event_type_t;
+
+/**
+ * @brief   Trace buffer entry
+ */
+typedef struct {
+    uint32_t time;          /**< time stamp in microseconds */
+    uint8_t type;           /**< event type, see @ref trace_event_type_t */
+    uint8_t pid;            /**< active thread or @ref TRACE_PID_ISR */
+    uint16_t arg16;         /**< type dependent argument */
+    uint32_t arg;           /**< type dependent argument */
+} trace_entry_t;
+
+/**
+ * @brief   Header of a chunk of drained entries
+ *
+ * All fields are in the byte order of the device.
+ */
+typedef struct {
+    uint32_t magic;         /**< @ref TRACE_MAGIC */
+    uint8_t version;        /**< @ref TRACE_VERSION */
+    uint8_t entry_size;     /**< `sizeof(trace_entry_t)` */
+    uint16_t count;         /**< number of entries following the header */
+    uint32_t lost;          /**< entries overwritten before being drained */
+} trace_hdr_t;
+
+/**
+ * @brief   Output function for `trace_drain()`
+ *
+ * @param[in]   arg     argument given to `trace_drain()`
+ * @param[in]   data    data to write
+ * @param[in]   len     length of @p data
+ *
+ * @return  0 on success
+ * @return  <0 on error, draining is aborted
+ */
+typedef int (*trace_write_t)(void *arg, const void *data, size_t len);
+
 /**
  * @brief   Add entry to trace buffer
  *
@@ -73,6 +195,24 @@ extern "C" {
  */
 void trace(uint32_t val);
 
+/**
+ * @brief   Add typed event to trace buffer
+ *
+ * Is a no-op if @p type is masked out by `trace_set_mask()`.
+ *
+ * @param[in]   type    event type
+ * @param[in]   arg16   type dependent argument
+ * @param[in]   arg     type dependent argument
+ */
+void trace_event(trace_event_type_t type, uint16_t arg16, uint32_t arg);
+
+/**
+ * @brief   Select the event types to record
+ *
+ * @param[in]   mask    bit mask of `(1 << @ref trace_event_type_t)`
+ */
+void trace_set_mask(uint32_t mask);
+
 /**
  * @brief   Print the current trace buffer
  *
@@ -84,9 +224,49 @@ void trace(uint32_t val);
  *
  *     n=   0 t=  1815312 v=0x00000000
  *     n=   1 t=+       3 v=0x00000001
+ *
+ * Typed events additionally show their type and arguments.
  */
 void trace_dump(void);
 
+/**
+ * @brief   Write all entries recorded since the last drain
+ *
+ * The entries are written in chunks of a @ref trace_hdr_t followed by up to
+ * `trace_hdr_t::count` entries, with one call to @p write per chunk. Drained
+ * entries are no longer written by the following drains, but still shown by
+ * `trace_dump()`.
+ *
+ * @param[in]   write   output function
+ * @param[in]   arg     argument to @p write
+ *
+ * @return  number of drained entries
+ * @return  <0 on error of @p write
+ */
+int trace_drain(trace_write_t write, void *arg);
+
+/**
+ * @brief   Drain the trace buffer to stdio
+ *
+ * Each chunk is printed as line of `TRACE:` followed by the hex encoded
+ * chunk.
+ *
+ * @return  number of drained entries
+ */
+int trace_drain_stdio(void);
+
+/**
+ * @brief   Drain the trace buffer to a file
+ *
+ * @note    Only available with `USEMODULE += vfs`
+ *
+ * @param[in]   fd      VFS file descriptor opened for writing
+ *
+ * @return  number of drained entries
+ * @return  <0 on write error
+ */
+int trace_drain_vfs(int fd);
+
 /**
  * @brief   Empty the trace buffer
  */
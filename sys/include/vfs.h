@@ -223,6 +223,50 @@ extern "C" {
 #define VFS_NAME_MAX (31)
 #endif
 
+#ifndef VFS_STAT_CACHE_SIZE
+/**
+ * @brief Number of entries in the stat cache (`vfs_stat_cache` module only)
+ *
+ * The `vfs_stat_cache` module keeps the results of the last vfs_stat() calls,
+ * so repeated calls for the same path neither resolve the mount point nor call
+ * the file system driver. Entries of a mount are dropped on any modification
+ * through the VFS, so this suits read-mostly file systems like ConstFS.
+ * Modifications that bypass the VFS are not noticed.
+ */
+#define VFS_STAT_CACHE_SIZE (4)
+#endif
+
+#ifndef VFS_STAT_CACHE_PATH_MAX
+/**
+ * @brief Size of the path buffer of a stat cache entry, including the
+ *        terminating null byte. Longer paths are not cached.
+ */
+#define VFS_STAT_CACHE_PATH_MAX (32)
+#endif
+
+#ifndef VFS_BUFFERED_FILES
+/**
+ * @brief Number of file buffers (`vfs_buffered` module only)
+ *
+ * The `vfs_buffered` module attaches one of these buffers to a file on
+ * vfs_open() while there is a free one. Files opened when all buffers are in
+ * use, and fds bound with vfs_bind(), are not buffered.
+ */
+#define VFS_BUFFERED_FILES (2)
+#endif
+
+#ifndef VFS_BUFFERED_SIZE
+/**
+ * @brief Size of a file buffer in bytes (`vfs_buffered` module only)
+ *
+ * Sequential writes smaller than this are collected in the buffer and passed
+ * to the file system driver in one call when it is full, on vfs_fsync(),
+ * vfs_close(), vfs_lseek(), or when reading from the file. Sequential reads
+ * smaller than this read ahead a full buffer.
+ */
+#define VFS_BUFFERED_SIZE (256)
+#endif
+
 /**
  * @brief Used with vfs_bind to bind to any available fd number
  */
@@ -440,6 +484,19 @@ struct vfs_file_ops {
      * @return <0 on error
      */
     ssize_t (*write) (vfs_file_t *filp, const void *src, size_t nbytes);
+
+    /**
+     * @brief Synchronize the state of an open file with the storage device
+     *
+     * Writes back all data and metadata the file system driver holds in its
+     * internal buffers for @p filp.
+     *
+     * @param[in]  filp     pointer to open file
+     *
+     * @return 0 on success
+     * @return <0 on error
+     */
+    int (*fsync) (vfs_file_t *filp);
 };
 
 /**
@@ -684,6 +741,19 @@ int vfs_fstat(int fd, struct stat *buf);
  */
 int vfs_fstatvfs(int fd, struct statvfs *buf);
 
+/**
+ * @brief Synchronize an open file with the storage device
+ *
+ * Passes data held in the buffer of the `vfs_buffered` module to the file
+ * system driver, then lets the driver write back its internal buffers.
+ *
+ * @param[in]  fd       fd number obtained from vfs_open
+ *
+ * @return 0 on success
+ * @return <0 on error
+ */
+int vfs_fsync(int fd);
+
 /**
  * @brief Seek to position in file
  *
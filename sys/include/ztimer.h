@@ -140,6 +140,10 @@
  * to be shown whether the increased complexity would lead to better
  * performance for any reasonable amount of active timers.
  *
+ * For clocks that carry hundreds of timers, the optional `ztimer_wheel`
+ * module provides a hierarchical timer wheel with constant time insertion
+ * and removal (see @ref sys_ztimer_wheel).
+ *
  *
  * ## Clock extension
  *
@@ -266,12 +270,21 @@ typedef struct ztimer_base ztimer_base_t;
  */
 typedef struct ztimer_clock ztimer_clock_t;
 
+/**
+ * @brief ztimer_wheel_t forward declaration
+ */
+typedef struct ztimer_wheel ztimer_wheel_t;
+
 /**
  * @brief   Minimum information for each timer
  */
 struct ztimer_base {
     ztimer_base_t *next;        /**< next timer in list */
     uint32_t offset;            /**< offset from last timer in list */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_base_t **pprev;      /**< link pointing to this timer, if filed
+                                     in a timer wheel                   */
+#endif
 };
 
 #if MODULE_ZTIMER_NOW64
@@ -339,6 +352,9 @@ struct ztimer_clock {
 #if MODULE_PM_LAYERED || DOXYGEN
     uint8_t block_pm_mode;          /**< min. pm mode to block for the clock to run */
 #endif
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_wheel_t *wheel;          /**< timer wheel, NULL for list mode    */
+#endif
 };
 
 /**
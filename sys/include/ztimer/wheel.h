@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_ztimer_wheel  ztimer timer wheel
+ * @ingroup     sys_ztimer
+ * @brief       Hierarchical timer wheel for ztimer clocks
+ *
+ * By default, a ztimer clock keeps its timers in a sorted linked list, so
+ * setting and removing a timer takes time linear in the number of active
+ * timers, spent with interrupts disabled. A clock with a timer wheel instead
+ * files each timer into one of @ref ZTIMER_WHEEL_SLOTS slots of one of
+ * @ref ZTIMER_WHEEL_LEVELS levels, based on its absolute target time. Level
+ * `n` has a granularity of `ZTIMER_WHEEL_SLOTS ** n` ticks, so a timer far in
+ * the future is filed coarsely and moved ("cascaded") to a lower level when
+ * its slot comes up. Setting and removing timers is then O(1), and each timer
+ * is cascaded at most @ref ZTIMER_WHEEL_LEVELS - 1 times.
+ *
+ * The backend timer is still only set to the next event, i.e., the next
+ * expiry or cascade. Cascading may thus cause a few additional interrupts per
+ * timer, which makes the wheel a good fit for clocks carrying many long
+ * timeouts (e.g. `ZTIMER_MSEC` on a router) rather than for short, precise
+ * ones. In contrast to the list, the order in which timers expiring at the
+ * same tick are fired is unspecified.
+ *
+ * To use it, add `USEMODULE += ztimer_wheel`. The wheel is then enabled for
+ * the clocks selected by @ref CONFIG_ZTIMER_USEC_WHEEL,
+ * @ref CONFIG_ZTIMER_MSEC_WHEEL and @ref CONFIG_ZTIMER_SEC_WHEEL, or for
+ * any other clock with @ref ztimer_wheel_init().
+ *
+ * @{
+ *
+ * @file
+ * @brief       ztimer timer wheel API
+ */
+
+#ifndef ZTIMER_WHEEL_H
+#define ZTIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ztimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup sys_ztimer_wheel_conf  ztimer timer wheel compile configurations
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   log2 of the number of slots per level (1, 2 or 4)
+ *
+ * 32 must be a multiple of this, so the highest level covers the remaining
+ * bits of the clock with all of its slots.
+ *
+ * More slots mean fewer levels and cascades, but more memory per wheel:
+ * the default of 4 needs 128 slot pointers for 8 levels.
+ */
+#ifndef CONFIG_ZTIMER_WHEEL_LEVEL_BITS
+#define CONFIG_ZTIMER_WHEEL_LEVEL_BITS  (4)
+#endif
+
+/**
+ * @brief   Use a timer wheel for `ZTIMER_USEC`
+ */
+#ifndef CONFIG_ZTIMER_USEC_WHEEL
+#define CONFIG_ZTIMER_USEC_WHEEL        (0)
+#endif
+
+/**
+ * @brief   Use a timer wheel for `ZTIMER_MSEC`
+ */
+#ifndef CONFIG_ZTIMER_MSEC_WHEEL
+#define CONFIG_ZTIMER_MSEC_WHEEL        (1)
+#endif
+
+/**
+ * @brief   Use a timer wheel for `ZTIMER_SEC`
+ */
+#ifndef CONFIG_ZTIMER_SEC_WHEEL
+#define CONFIG_ZTIMER_SEC_WHEEL         (1)
+#endif
+/** @} */
+
+/**
+ * @brief   Number of slots per level
+ */
+#define ZTIMER_WHEEL_SLOTS      (1U << CONFIG_ZTIMER_WHEEL_LEVEL_BITS)
+
+/**
+ * @brief   Number of levels needed to cover 32 bit offsets
+ */
+#define ZTIMER_WHEEL_LEVELS     ((32 + CONFIG_ZTIMER_WHEEL_LEVEL_BITS - 1) / \
+                                 CONFIG_ZTIMER_WHEEL_LEVEL_BITS)
+
+/**
+ * @brief   Timer wheel structure
+ */
+struct ztimer_wheel {
+    /**
+     * @brief   Timers per slot, linked via ztimer_base_t::next
+     */
+    ztimer_base_t *slots[ZTIMER_WHEEL_LEVELS][ZTIMER_WHEEL_SLOTS];
+    uint32_t map[ZTIMER_WHEEL_LEVELS];  /**< non-empty slots per level */
+};
+
+/**
+ * @brief   Switch a clock to timer wheel mode
+ *
+ * Timers already set on @p clock are moved to the wheel.
+ *
+ * @param[in,out]   clock   clock to use the timer wheel for
+ * @param[out]      wheel   timer wheel to use, must stay valid as long as
+ *                          @p clock is used
+ */
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel);
+
+/**
+ * @brief   Add a timer to the wheel of a clock
+ *
+ * @internal
+ *
+ * @param[in,out]   clock   clock in timer wheel mode
+ * @param[in,out]   entry   timer to add, ztimer_base_t::offset holds the
+ *                          target relative to `clock->list.offset` and is
+ *                          converted to an absolute target
+ */
+void ztimer_wheel_add(ztimer_clock_t *clock, ztimer_base_t *entry);
+
+/**
+ * @brief   Remove a timer from the wheel or the expired timers of a clock
+ *
+ * @internal
+ *
+ * @param[in,out]   clock   clock in timer wheel mode
+ * @param[in,out]   entry   timer to remove
+ */
+void ztimer_wheel_del(ztimer_clock_t *clock, ztimer_base_t *entry);
+
+/**
+ * @brief   Advance the wheel of a clock to @p now
+ *
+ * Timers reaching their target are moved to the list of expired timers at
+ * `clock->list.next`, `clock->list.offset` is set to @p now.
+ *
+ * @internal
+ *
+ * @param[in,out]   clock   clock in timer wheel mode
+ * @param[in]       now     current time of the clock
+ */
+void ztimer_wheel_update(ztimer_clock_t *clock, uint32_t now);
+
+/**
+ * @brief   Get the time until the next event of the clock
+ *
+ * Events are the expiry of a timer or the cascade of a slot.
+ *
+ * @internal
+ *
+ * @param[in]   clock   clock in timer wheel mode
+ * @param[out]  offset  ticks from `clock->list.offset` until the next event,
+ *                      0 if there are expired timers
+ *
+ * @return  true, if there is an event pending
+ * @return  false, if no timer is set on @p clock
+ */
+bool ztimer_wheel_next(const ztimer_clock_t *clock, uint32_t *offset);
+
+/**
+ * @brief   Check if no timer is set on a clock in timer wheel mode
+ *
+ * @internal
+ *
+ * @param[in]   clock   clock in timer wheel mode
+ *
+ * @return  true, if neither the wheel nor the expired timers hold a timer
+ */
+bool ztimer_wheel_is_empty(const ztimer_clock_t *clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_WHEEL_H */
+/** @} */
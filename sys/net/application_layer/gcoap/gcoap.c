@@ -74,6 +74,19 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
 
+#ifdef DEVELHELP
+static bool _resources_sorted(const coap_resource_t *resources, size_t numof)
+{
+    for (size_t i = 1; i < numof; i++) {
+        if (strcmp(resources[i - 1].path, resources[i].path) > 0) {
+            DEBUG("gcoap: resource %s not sorted\n", resources[i].path);
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 static int _request_matcher_default(gcoap_listener_t *listener,
                                     const coap_resource_t **resource,
                                     const coap_pkt_t *pdu);
@@ -601,7 +614,6 @@ static int _request_matcher_default(gcoap_listener_t *listener,
                                     const coap_pkt_t *pdu)
 {
     uint8_t uri[CONFIG_NANOCOAP_URI_MAX];
-    int ret = GCOAP_RESOURCE_NO_PATH;
 
     if (coap_get_uri_path(pdu, uri) <= 0) {
         /* The Uri-Path options are longer than
@@ -613,34 +625,17 @@ static int _request_matcher_default(gcoap_listener_t *listener,
     coap_method_flags_t method_flag = coap_method2flag(
         coap_get_code_detail(pdu));
 
-    for (size_t i = 0; i < listener->resources_len; i++) {
-        *resource = &listener->resources[i];
-
-        int res = coap_match_path(*resource, uri);
-
-        /* URI mismatch */
-        if (res > 0) {
-            continue;
-        }
-        /* resources expected in alphabetical order */
-        else if (res < 0) {
-            break;
-        }
-
-        /* potential match, check for method */
-        if (! ((*resource)->methods & method_flag)) {
-            /* record wrong method error for next iteration, in case
-             * another resource with the same URI and correct method
-             * exists */
-            ret = GCOAP_RESOURCE_WRONG_METHOD;
-            continue;
-        }
-        else {
-            return GCOAP_RESOURCE_FOUND;
-        }
+    /* resources expected in alphabetical order */
+    int res = coap_find_resource(listener->resources, listener->resources_len,
+                                 uri, method_flag);
+    if (res >= 0) {
+        *resource = &listener->resources[res];
+        return GCOAP_RESOURCE_FOUND;
     }
-
-    return ret;
+    /* a resource with the same URI but the wrong method is recorded, as
+     * another listener may provide the correct method */
+    return (res == -EPERM) ? GCOAP_RESOURCE_WRONG_METHOD
+                           : GCOAP_RESOURCE_NO_PATH;
 }
 
 /*
@@ -1018,6 +1013,9 @@ void gcoap_register_listener(gcoap_listener_t *listener)
     }
 
     if (!listener->request_matcher) {
+#ifdef DEVELHELP
+        assert(_resources_sorted(listener->resources, listener->resources_len));
+#endif
         listener->request_matcher = _request_matcher_default;
     }
 }
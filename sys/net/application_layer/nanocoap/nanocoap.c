@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include "bitarithm.h"
+#include "kernel_defines.h"
 #include "net/nanocoap.h"
 
 #define ENABLE_DEBUG 0
@@ -176,6 +177,96 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
     return res;
 }
 
+static int _find_resource_linear(const coap_resource_t *resources,
+                                 size_t resources_numof, uint8_t *uri,
+                                 coap_method_flags_t method_flag)
+{
+    int res = -ENOENT;
+
+    for (unsigned i = 0; i < resources_numof; i++) {
+        int cmp = coap_match_path(&resources[i], uri);
+        if (cmp > 0) {
+            continue;
+        }
+        else if (cmp < 0) {
+            break;
+        }
+        else if (resources[i].methods & method_flag) {
+            return i;
+        }
+        res = -EPERM;
+    }
+    return res;
+}
+
+/* compares path to the first len characters of uri */
+static int _cmp_prefix(const char *path, const uint8_t *uri, size_t len)
+{
+    int res = strncmp(path, (const char *)uri, len);
+
+    if ((res == 0) && (path[len] != '\0')) {
+        return 1;
+    }
+    return res;
+}
+
+int coap_find_resource(const coap_resource_t *resources, size_t resources_numof,
+                       const uint8_t *uri, coap_method_flags_t method_flag)
+{
+    size_t len = strlen((const char *)uri);
+    size_t end = resources_numof;
+    int res = -ENOENT;
+
+    if (IS_ACTIVE(CONFIG_NANOCOAP_RESOURCE_LINEAR)) {
+        return _find_resource_linear(resources, resources_numof, (uint8_t *)uri,
+                                     method_flag);
+    }
+    /* Only resources with the URI or, for subtree matching, a prefix of it
+     * as path can match. Look them up from the longest to the shortest. */
+    while (1) {
+        size_t lo = 0, hi = end;
+        const char *prev;
+        size_t common = 0;
+
+        /* find the first resource sorting after the prefix ... */
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (_cmp_prefix(resources[mid].path, uri, len) > 0) {
+                hi = mid;
+            }
+            else {
+                lo = mid + 1;
+            }
+        }
+        /* ... and go back over the resources with the prefix as path, so the
+         * first matching resource in the array is found */
+        while ((lo > 0) && (_cmp_prefix(resources[lo - 1].path, uri, len) == 0)) {
+            lo--;
+            if ((uri[len] != '\0') &&
+                !(resources[lo].methods & COAP_MATCH_SUBTREE)) {
+                continue;
+            }
+            if (resources[lo].methods & method_flag) {
+                res = lo;
+            }
+            else if (res == -ENOENT) {
+                res = -EPERM;
+            }
+        }
+        if ((lo == 0) || (len == 0)) {
+            return res;
+        }
+        /* any shorter prefix of the URI sorts before the resource sorting
+         * right before this prefix and shares its first characters with it */
+        prev = resources[lo - 1].path;
+        while ((common < len) && (prev[common] == (char)uri[common])) {
+            common++;
+        }
+        end = lo;
+        len = common;
+    }
+}
+
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
     const coap_optpos_t *optpos = pkt->options;
@@ -419,22 +510,10 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
     }
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < resources_numof; i++) {
+    int i = coap_find_resource(resources, resources_numof, uri, method_flag);
+    if (i >= 0) {
         const coap_resource_t *resource = &resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
-
-        int res = coap_match_path(resource, uri);
-        if (res > 0) {
-            continue;
-        }
-        else if (res < 0) {
-            break;
-        }
-        else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
-        }
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
     }
 
     return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
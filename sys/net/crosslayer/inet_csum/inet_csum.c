@@ -14,12 +14,91 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "architecture.h"
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+#if ARCHITECTURE_WORD_BITS == 32
+/* sum up 32-bit words, the carries are collected in the upper half */
+typedef uint64_t _acc_t;
+#else
+typedef uint32_t _acc_t;
+#endif
+
+static uint16_t _fold(_acc_t acc)
+{
+#if ARCHITECTURE_WORD_BITS == 32
+    acc = (acc & 0xffffffff) + (acc >> 32);
+    acc = (acc & 0xffffffff) + (acc >> 32);
+#endif
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    return acc;
+}
+
+/**
+ * @brief   Sums up @p buf in host byte order
+ *
+ * The one's complement sum is independent of byte order, so the result only
+ * needs to be converted to network byte order once (RFC 1071, section 2(B)).
+ * A trailing byte is padded with zero.
+ *
+ * @pre `buf` is 2-byte aligned
+ */
+static uint16_t _sum_aligned(const uint8_t *buf, uint16_t len)
+{
+    _acc_t acc = 0;
+    uint16_t word;
+
+#if ARCHITECTURE_WORD_BITS == 32
+    uint32_t w[8];
+
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        memcpy(&word, buf, sizeof(word));
+        acc += word;
+        buf += 2;
+        len -= 2;
+    }
+    buf = __builtin_assume_aligned(buf, sizeof(uint32_t));
+    for (; len >= sizeof(w); buf += sizeof(w), len -= sizeof(w)) {
+        memcpy(w, buf, sizeof(w));
+        acc += (_acc_t)w[0] + w[1] + w[2] + w[3];
+        acc += (_acc_t)w[4] + w[5] + w[6] + w[7];
+    }
+    for (; len >= sizeof(w[0]); buf += sizeof(w[0]), len -= sizeof(w[0])) {
+        memcpy(w, buf, sizeof(w[0]));
+        acc += w[0];
+    }
+#endif
+    for (; len >= sizeof(word); buf += sizeof(word), len -= sizeof(word)) {
+        memcpy(&word, buf, sizeof(word));
+        acc += word;
+    }
+    if (len) {
+        word = 0;
+        memcpy(&word, buf, 1);
+        acc += word;
+    }
+    return _fold(acc);
+}
+
+/* sums up buf in network byte order, a trailing byte is padded with zero */
+static uint16_t _sum(const uint8_t *buf, uint16_t len)
+{
+    if ((uintptr_t)buf & 1) {
+        /* the words following the first byte are all swapped */
+        return _fold(((_acc_t)buf[0] << 8) +
+                     byteorder_swaps(ntohs(_sum_aligned(buf + 1, len - 1))));
+    }
+    return ntohs(_sum_aligned(buf, len));
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -42,16 +121,10 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
-    }
-
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    if (len > 0)
+        csum += _sum(buf, len);   /* pads last byte as top half of 16-bit word */
 
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
@@ -63,4 +136,17 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     return csum;
 }
 
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_val,
+                          const uint8_t *new_val, uint16_t len)
+{
+    /* RFC 1624, equation 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum;
+
+    if (len > 0) {
+        sum += (uint16_t)~_sum(old_val, len);
+        sum += _sum(new_val, len);
+    }
+    return (uint16_t)~_fold(sum);
+}
+
 /** @} */
@@ -21,6 +21,7 @@
 #include <assert.h>
 #include <errno.h>
 
+#include "irq.h"
 #include "mbox.h"
 #include "msg.h"
 #include "net/gnrc/netreg.h"
@@ -82,9 +83,222 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+static void _dispatch_one(gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                          gnrc_pktsnip_t *pkt)
+{
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    uint32_t status = 0;
+    switch (sendto->type) {
+        case GNRC_NETREG_TYPE_DEFAULT:
+            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+                /* unable to dispatch packet */
+                status = EIO;
+            }
+            break;
+#ifdef MODULE_GNRC_NETAPI_MBOX
+        case GNRC_NETREG_TYPE_MBOX:
+            if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                status = EIO;
+            }
+            break;
+#endif
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            break;
+#endif
+        default:
+            /* unknown dispatch type */
+            status = ECANCELED;
+            break;
+    }
+    if (status != 0) {
+        gnrc_pktbuf_release_error(pkt, status);
+    }
+#else
+    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+        /* unable to dispatch packet */
+        gnrc_pktbuf_release_error(pkt, EIO);
+    }
+#endif
+}
+
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+/* open batch per thread */
+static gnrc_netapi_batch_t *_batches[MAXTHREADS];
+
+static inline gnrc_netapi_batch_t **_batch_of_active(void)
+{
+    return &_batches[thread_getpid() - KERNEL_PID_FIRST];
+}
+
+static bool _accepts_batch(const gnrc_netreg_entry_t *sendto)
+{
+    return sendto->batch;
+}
+
+/* dispatches packets of which @p refs references each are owned by the
+ * caller */
+static int _dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                           uint16_t cmd, gnrc_pktsnip_t **pkts,
+                           unsigned numof, unsigned refs)
+{
+    unsigned subs = gnrc_netreg_num(type, demux_ctx);
+    unsigned batch_subs = 0;
+    gnrc_pktsnip_t *batch = NULL;
+
+    /* the subscribers may have changed since the references were taken */
+    for (unsigned i = 0; i < numof; i++) {
+        if (subs > refs) {
+            gnrc_pktbuf_hold(pkts[i], subs - refs);
+        }
+        for (unsigned r = subs; r < refs; r++) {
+            gnrc_pktbuf_release(pkts[i]);
+        }
+    }
+    if (subs == 0) {
+        return 0;
+    }
+
+    for (gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+         sendto && (numof > 1); sendto = gnrc_netreg_getnext(sendto)) {
+        batch_subs += _accepts_batch(sendto);
+    }
+    if (batch_subs > 0) {
+        /* one allocation instead of one message per packet and subscriber,
+         * fall back to the latter if the packet buffer is full */
+        batch = gnrc_pktbuf_add(NULL, pkts, numof * sizeof(*pkts),
+                                GNRC_NETTYPE_UNDEF);
+        if (batch != NULL) {
+            gnrc_pktbuf_hold(batch, batch_subs - 1);
+        }
+    }
+
+    for (gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+         sendto; sendto = gnrc_netreg_getnext(sendto)) {
+        if ((batch != NULL) && _accepts_batch(sendto)) {
+            uint16_t batch_cmd = (cmd == GNRC_NETAPI_MSG_TYPE_SND)
+                               ? GNRC_NETAPI_MSG_TYPE_SND_BATCH
+                               : GNRC_NETAPI_MSG_TYPE_RCV_BATCH;
+
+            if (_gnrc_netapi_send_recv(sendto->target.pid, batch,
+                                       batch_cmd) < 1) {
+                /* unable to dispatch packets */
+                for (unsigned i = 0; i < numof; i++) {
+                    gnrc_pktbuf_release_error(pkts[i], EIO);
+                }
+                gnrc_pktbuf_release(batch);
+            }
+        }
+        else {
+            for (unsigned i = 0; i < numof; i++) {
+                _dispatch_one(sendto, cmd, pkts[i]);
+            }
+        }
+    }
+
+    return subs;
+}
+
+static void _flush(gnrc_netapi_batch_t *batch)
+{
+    gnrc_netapi_batch_t **open = _batch_of_active();
+    unsigned numof = batch->numof;
+
+    if (numof == 0) {
+        return;
+    }
+    batch->numof = 0;
+    /* callbacks might dispatch themselves, don't collect those */
+    *open = NULL;
+    _dispatch_batch(batch->type, batch->demux_ctx, batch->cmd, batch->pkts,
+                    numof, batch->refs);
+    *open = batch;
+}
+
+static int _collect(gnrc_netapi_batch_t *batch, gnrc_nettype_t type,
+                    uint32_t demux_ctx, uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    int numof = gnrc_netreg_num(type, demux_ctx);
+
+    if (numof == 0) {
+        return 0;
+    }
+    if ((batch->numof == CONFIG_GNRC_NETAPI_BATCH_SIZE) ||
+        ((batch->numof > 0) &&
+         ((batch->type != type) || (batch->demux_ctx != demux_ctx) ||
+          (batch->cmd != cmd) || (batch->refs != numof)))) {
+        _flush(batch);
+    }
+    /* take the references now, so the dispatcher does not consider the
+     * packet as exclusively owned anymore (see gnrc_pktbuf_start_write()) */
+    gnrc_pktbuf_hold(pkt, numof - 1);
+    batch->type = type;
+    batch->demux_ctx = demux_ctx;
+    batch->cmd = cmd;
+    batch->refs = numof;
+    batch->pkts[batch->numof++] = pkt;
+    return numof;
+}
+
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               uint16_t cmd, gnrc_pktsnip_t **pkts,
+                               unsigned numof)
+{
+    assert(numof <= CONFIG_GNRC_NETAPI_BATCH_SIZE);
+    if (gnrc_netreg_num(type, demux_ctx) == 0) {
+        return 0;
+    }
+    return _dispatch_batch(type, demux_ctx, cmd, pkts, numof, 1);
+}
+
+void gnrc_netapi_batch_accept(gnrc_netreg_entry_t *entry)
+{
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    assert(entry->type == GNRC_NETREG_TYPE_DEFAULT);
+#endif
+    entry->batch = true;
+}
+
+void gnrc_netapi_batch_begin(gnrc_netapi_batch_t *batch)
+{
+    gnrc_netapi_batch_t **open = _batch_of_active();
+
+    batch->numof = 0;
+    batch->prev = *open;
+    *open = batch;
+}
+
+void gnrc_netapi_batch_end(gnrc_netapi_batch_t *batch)
+{
+    _flush(batch);
+    *_batch_of_active() = batch->prev;
+}
+
+void gnrc_netapi_batch_handle(gnrc_pktsnip_t *batch,
+                              void (*handler)(gnrc_pktsnip_t *pkt))
+{
+    gnrc_netapi_batch_t ctx;
+
+    gnrc_netapi_batch_begin(&ctx);
+    for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+        handler(gnrc_netapi_batch_get(batch, i));
+    }
+    gnrc_netapi_batch_end(&ctx);
+    gnrc_pktbuf_release(batch);
+}
+#endif
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    if (!irq_is_in() && (*_batch_of_active() != NULL)) {
+        return _collect(*_batch_of_active(), type, demux_ctx, cmd, pkt);
+    }
+#endif
+
     int numof = gnrc_netreg_num(type, demux_ctx);
 
     if (numof != 0) {
@@ -93,43 +307,7 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            uint32_t status = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt,
-                                               cmd) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
-#ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
-#endif
-#ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
-#endif
-                default:
-                    /* unknown dispatch type */
-                    status = ECANCELED;
-                    break;
-            }
-            if (status != 0) {
-                gnrc_pktbuf_release_error(pkt, status);
-            }
-#else
-            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
-                /* unable to dispatch packet */
-                gnrc_pktbuf_release_error(pkt, EIO);
-            }
-#endif
+            _dispatch_one(sendto, cmd, pkt);
             sendto = gnrc_netreg_getnext(sendto);
         }
     }
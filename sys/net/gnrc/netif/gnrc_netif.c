@@ -33,6 +33,9 @@
 #include "net/gnrc/netif/pktq.h"
 #endif /* IS_USED(MODULE_GNRC_NETIF_PKTQ) */
 #include "net/gnrc/sixlowpan/ctx.h"
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC)
+#include "net/gnrc/sixlowpan/iphc.h"
+#endif /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC) */
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
 #include "net/gnrc/sixlowpan/frag/sfr.h"
 #endif /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) */
@@ -41,6 +44,7 @@
 #include "fmt.h"
 #include "log.h"
 #include "sched.h"
+#include "trace.h"
 #if IS_USED(MODULE_XTIMER) || IS_USED(MODULE_ZTIMER_XTIMER_COMPAT)
 #include "xtimer.h"
 #endif
@@ -1418,6 +1422,10 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif)
     if (res > 0) {
         netif->l2addr_len = res;
     }
+#if IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC)
+    /* compressed headers might derive from the old address */
+    gnrc_sixlowpan_iphc_cache_invalidate();
+#endif /* IS_USED(MODULE_GNRC_SIXLOWPAN_IPHC) */
 }
 
 static void _init_from_device(gnrc_netif_t *netif)
@@ -1593,6 +1601,33 @@ void gnrc_netif_default_init(gnrc_netif_t *netif)
 
 static void _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool push_back);
 
+static inline void _isr(gnrc_netif_t *netif)
+{
+#ifdef MODULE_NETSTATS_L2
+    uint32_t rx_count = netif->stats.rx_count;
+#endif
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    /* pass all frames received per device event up in one message */
+    gnrc_netapi_batch_t batch;
+
+    gnrc_netapi_batch_begin(&batch);
+    netif->dev->driver->isr(netif->dev);
+    gnrc_netapi_batch_end(&batch);
+#else
+    netif->dev->driver->isr(netif->dev);
+#endif
+#ifdef MODULE_NETSTATS_L2
+    /* count the frames the event actually delivered */
+    rx_count = netif->stats.rx_count - rx_count;
+    if (rx_count) {
+        netif->stats.rx_batches++;
+        if (rx_count > netif->stats.rx_batch_max) {
+            netif->stats.rx_batch_max = rx_count;
+        }
+    }
+#endif
+}
+
 #if IS_USED(MODULE_GNRC_NETIF_EVENTS)
 /**
  * @brief   Call the ISR handler from an event
@@ -1602,7 +1637,7 @@ static void _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool push_back);
 static void _event_handler_isr(event_t *evp)
 {
     gnrc_netif_t *netif = container_of(evp, gnrc_netif_t, event_isr);
-    netif->dev->driver->isr(netif->dev);
+    _isr(netif);
 }
 #endif
 
@@ -1758,6 +1793,9 @@ static void _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt, bool push_back)
     /* Split off the TX sync snip */
     gnrc_pktsnip_t *tx_sync = IS_USED(MODULE_GNRC_TX_SYNC)
                             ? gnrc_tx_sync_split(pkt) : NULL;
+    if (IS_USED(MODULE_TRACE_EVENTS)) {
+        trace_event(TRACE_NETIF_TX, netif->pid, (uintptr_t)pkt);
+    }
     res = netif->ops->send(netif, pkt);
     if (tx_sync != NULL) {
         uint32_t err = (res < 0) ? -res : GNRC_NETERR_SUCCESS;
@@ -1881,7 +1919,7 @@ static void *_gnrc_netif_thread(void *args)
 #endif  /* IS_USED(MODULE_GNRC_NETIF_PKTQ) */
             case NETDEV_MSG_TYPE_EVENT:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
-                dev->driver->isr(dev);
+                _isr(netif);
                 break;
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netif: GNRC_NETDEV_MSG_TYPE_SND received\n");
@@ -1982,6 +2020,9 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
                  * Further packets will be sent on later TX_COMPLETE */
                 _send_queued_pkt(netif);
                 if (pkt) {
+                    if (IS_USED(MODULE_TRACE_EVENTS)) {
+                        trace_event(TRACE_NETIF_RX, netif->pid, (uintptr_t)pkt);
+                    }
                     _process_receive_stats(netif, pkt);
                     _pass_on_packet(pkt);
                 }
@@ -74,6 +74,14 @@ static void _receive(gnrc_pktsnip_t *pkt);
  * assume it is already prepared */
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr);
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+/* handles the packets of GNRC_NETAPI_MSG_TYPE_SND_BATCH commands */
+static void _send_with_hdr(gnrc_pktsnip_t *pkt)
+{
+    _send(pkt, true);
+}
+#endif
+
 #ifdef MODULE_GNRC_IPV6_EXT_FRAG
 static void _send_by_netif_hdr(gnrc_pktsnip_t *pkt);
 #endif  /* MODULE_GNRC_IPV6_EXT_FRAG */
@@ -183,6 +191,9 @@ static void *_event_loop(void *args)
 #ifdef MODULE_GNRC_IPV6_EXT_FRAG
     gnrc_ipv6_ext_frag_init();
 #endif  /* MODULE_GNRC_IPV6_EXT_FRAG */
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    gnrc_netapi_batch_accept(&me_reg);
+#endif
     /* register interest in all IPv6 packets */
     gnrc_netreg_register(GNRC_NETTYPE_IPV6, &me_reg);
 
@@ -205,6 +216,18 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr, true);
                 break;
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _receive);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _send_with_hdr);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#include "_nib-idx.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+
+static_assert(CONFIG_GNRC_IPV6_NIB_NUMOF < _NIB_IDX_NONE,
+              "CONFIG_GNRC_IPV6_NIB_NUMOF too large for NIB index");
+static_assert((2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF) < _NIB_IDX_NONE,
+              "CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF too large for NIB index");
+
+/**
+ * @brief   Node of the path-compressed prefix trie
+ *
+ * A node either represents a prefix of at least one off-link entry or is a
+ * glue node that joins two sub-tries branching at _trie_node_t::len.
+ */
+typedef struct {
+    ipv6_addr_t key;        /**< prefix of the node (bits beyond len are 0) */
+    uint16_t parent;        /**< parent node (next free node, if unused) */
+    uint16_t child[2];      /**< sub-tries with bit _trie_node_t::len 0 or 1 */
+    uint16_t entries;       /**< first off-link entry with this prefix */
+    uint8_t len;            /**< length of _trie_node_t::key in bits */
+} _trie_node_t;
+
+/* every off-link entry needs at most one node and one glue node */
+#define _TRIE_NUMOF     (2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF)
+
+static uint16_t _onl_buckets[CONFIG_GNRC_IPV6_NIB_IDX_ONL_BUCKETS];
+static uint16_t _onl_next[CONFIG_GNRC_IPV6_NIB_NUMOF];
+static uint16_t _onl_bucket[CONFIG_GNRC_IPV6_NIB_NUMOF];
+
+static _trie_node_t _trie[_TRIE_NUMOF];
+static uint16_t _trie_root;
+static uint16_t _trie_free;
+static uint16_t _offl_next[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
+static uint16_t _offl_node[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
+
+void _nib_idx_init(void)
+{
+    memset(_onl_buckets, 0xff, sizeof(_onl_buckets));
+    memset(_onl_next, 0xff, sizeof(_onl_next));
+    memset(_onl_bucket, 0xff, sizeof(_onl_bucket));
+    memset(_offl_next, 0xff, sizeof(_offl_next));
+    memset(_offl_node, 0xff, sizeof(_offl_node));
+    for (unsigned i = 0; i < _TRIE_NUMOF; i++) {
+        _trie[i].parent = (i + 1 < _TRIE_NUMOF) ? (i + 1) : _NIB_IDX_NONE;
+    }
+    _trie_root = _NIB_IDX_NONE;
+    _trie_free = 0;
+}
+
+static unsigned _hash(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                 addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    /* spread the bits so low-entropy interface identifiers (e.g. ::1, ::2)
+     * still land in different buckets */
+    h ^= h >> 16;
+    h *= 0x45d9f3bU;
+    h ^= h >> 16;
+    return h % CONFIG_GNRC_IPV6_NIB_IDX_ONL_BUCKETS;
+}
+
+static void _onl_unlink(unsigned idx)
+{
+    uint16_t *ptr;
+
+    if (_onl_bucket[idx] == _NIB_IDX_NONE) {
+        return;
+    }
+    for (ptr = &_onl_buckets[_onl_bucket[idx]]; *ptr != idx;
+         ptr = &_onl_next[*ptr]) {
+        assert(*ptr != _NIB_IDX_NONE);
+    }
+    *ptr = _onl_next[idx];
+    _onl_next[idx] = _NIB_IDX_NONE;
+    _onl_bucket[idx] = _NIB_IDX_NONE;
+}
+
+void _nib_idx_onl_update(unsigned idx, const ipv6_addr_t *addr)
+{
+    uint16_t *ptr;
+    unsigned bucket;
+
+    assert(idx < CONFIG_GNRC_IPV6_NIB_NUMOF);
+    _onl_unlink(idx);
+    if ((addr == NULL) || ipv6_addr_is_unspecified(addr)) {
+        return;
+    }
+    bucket = _hash(addr);
+    /* keep chain sorted, so look-ups find the same entry as a linear scan */
+    for (ptr = &_onl_buckets[bucket]; (*ptr != _NIB_IDX_NONE) && (*ptr < idx);
+         ptr = &_onl_next[*ptr]) {}
+    _onl_next[idx] = *ptr;
+    *ptr = idx;
+    _onl_bucket[idx] = bucket;
+    DEBUG("nib idx: filed on-link entry %u in bucket %u\n", idx, bucket);
+}
+
+unsigned _nib_idx_onl_first(const ipv6_addr_t *addr)
+{
+    assert(addr != NULL);
+    return _onl_buckets[_hash(addr)];
+}
+
+unsigned _nib_idx_onl_next(unsigned idx)
+{
+    assert(idx < CONFIG_GNRC_IPV6_NIB_NUMOF);
+    return _onl_next[idx];
+}
+
+static inline unsigned _bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return (addr->u8[pos / 8] >> (7 - (pos % 8))) & 1;
+}
+
+static uint16_t _node_new(const ipv6_addr_t *pfx, unsigned len,
+                          uint16_t parent)
+{
+    uint16_t n = _trie_free;
+    _trie_node_t *node;
+
+    /* pool is sized so it can never run out */
+    assert(n != _NIB_IDX_NONE);
+    node = &_trie[n];
+    _trie_free = node->parent;
+    memset(&node->key, 0, sizeof(node->key));
+    ipv6_addr_init_prefix(&node->key, pfx, len);
+    node->parent = parent;
+    node->child[0] = _NIB_IDX_NONE;
+    node->child[1] = _NIB_IDX_NONE;
+    node->entries = _NIB_IDX_NONE;
+    node->len = len;
+    return n;
+}
+
+static void _node_free(uint16_t n)
+{
+    _trie[n].parent = _trie_free;
+    _trie_free = n;
+}
+
+static uint16_t *_node_link(uint16_t n)
+{
+    uint16_t parent = _trie[n].parent;
+
+    if (parent == _NIB_IDX_NONE) {
+        return &_trie_root;
+    }
+    return (_trie[parent].child[0] == n) ? &_trie[parent].child[0]
+                                         : &_trie[parent].child[1];
+}
+
+static void _entry_link(uint16_t n, unsigned idx)
+{
+    uint16_t *ptr;
+
+    for (ptr = &_trie[n].entries; (*ptr != _NIB_IDX_NONE) && (*ptr < idx);
+         ptr = &_offl_next[*ptr]) {}
+    _offl_next[idx] = *ptr;
+    *ptr = idx;
+    _offl_node[idx] = n;
+}
+
+void _nib_idx_offl_add(unsigned idx, const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    uint16_t *link = &_trie_root;
+    uint16_t parent = _NIB_IDX_NONE;
+    uint16_t leaf;
+
+    assert((idx < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF) && (pfx != NULL) &&
+           (pfx_len <= IPV6_ADDR_BIT_LEN));
+    assert(_offl_node[idx] == _NIB_IDX_NONE);
+    while (*link != _NIB_IDX_NONE) {
+        uint16_t n = *link;
+        _trie_node_t *cur = &_trie[n];
+        unsigned common = ipv6_addr_match_prefix(&cur->key, pfx);
+
+        common = (common > cur->len) ? cur->len : common;
+        common = (common > pfx_len) ? pfx_len : common;
+        if (common < cur->len) {
+            /* new prefix is shorter than the current node or branches off
+             * from it => split the edge to the current node */
+            uint16_t split = _node_new(pfx, common, parent);
+
+            *link = split;
+            cur->parent = split;
+            _trie[split].child[_bit(&cur->key, common)] = n;
+            if (common == pfx_len) {
+                _entry_link(split, idx);
+                return;
+            }
+            leaf = _node_new(pfx, pfx_len, split);
+            _trie[split].child[_bit(pfx, common)] = leaf;
+            _entry_link(leaf, idx);
+            return;
+        }
+        if (cur->len == pfx_len) {
+            _entry_link(n, idx);
+            return;
+        }
+        parent = n;
+        link = &cur->child[_bit(pfx, cur->len)];
+    }
+    leaf = _node_new(pfx, pfx_len, parent);
+    *link = leaf;
+    _entry_link(leaf, idx);
+}
+
+void _nib_idx_offl_remove(unsigned idx)
+{
+    uint16_t n, *ptr;
+
+    assert(idx < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF);
+    n = _offl_node[idx];
+    if (n == _NIB_IDX_NONE) {
+        return;
+    }
+    for (ptr = &_trie[n].entries; *ptr != idx; ptr = &_offl_next[*ptr]) {
+        assert(*ptr != _NIB_IDX_NONE);
+    }
+    *ptr = _offl_next[idx];
+    _offl_next[idx] = _NIB_IDX_NONE;
+    _offl_node[idx] = _NIB_IDX_NONE;
+    /* remove nodes that neither carry entries nor join two sub-tries */
+    while ((n != _NIB_IDX_NONE) && (_trie[n].entries == _NIB_IDX_NONE)) {
+        _trie_node_t *node = &_trie[n];
+        uint16_t parent = node->parent;
+        uint16_t child;
+
+        if ((node->child[0] != _NIB_IDX_NONE) &&
+            (node->child[1] != _NIB_IDX_NONE)) {
+            return;
+        }
+        child = (node->child[0] != _NIB_IDX_NONE) ? node->child[0]
+                                                  : node->child[1];
+        *_node_link(n) = child;
+        _node_free(n);
+        if (child != _NIB_IDX_NONE) {
+            _trie[child].parent = parent;
+            return;
+        }
+        /* parent lost a child and might now be a superfluous glue node */
+        n = parent;
+    }
+}
+
+unsigned _nib_idx_offl_get_match(const ipv6_addr_t *dst,
+                                 bool (*valid)(unsigned idx))
+{
+    unsigned res = _NIB_IDX_NONE;
+    uint16_t n = _trie_root;
+
+    assert((dst != NULL) && (valid != NULL));
+    while (n != _NIB_IDX_NONE) {
+        const _trie_node_t *node = &_trie[n];
+
+        if (ipv6_addr_match_prefix(&node->key, dst) < node->len) {
+            break;
+        }
+        for (unsigned e = node->entries; e != _NIB_IDX_NONE;
+             e = _offl_next[e]) {
+            if (valid(e)) {
+                res = e;
+                break;
+            }
+        }
+        if (node->len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        n = node->child[_bit(dst, node->len)];
+    }
+    return res;
+}
+#else   /* CONFIG_GNRC_IPV6_NIB_IDX */
+typedef int dont_be_pedantic;
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
+
+/** @} */
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  net_gnrc_ipv6_nib
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief       Lookup index for on-link and off-link NIB entries
+ *
+ * The index only stores entry numbers (positions within the internal
+ * on-link and off-link entry arrays of the NIB). It is kept in sync by
+ * @ref _nib-internal.c whenever the address of an on-link entry or the
+ * prefix of an off-link entry changes. Entries found via the index still
+ * need to be checked by the caller, as the index is not updated when an
+ * on-link entry is cleared.
+ *
+ * @note    Only available if @ref CONFIG_GNRC_IPV6_NIB_IDX != 0.
+ */
+#ifndef PRIV_NIB_IDX_H
+#define PRIV_NIB_IDX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <kernel_defines.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Marks the end of an index chain or an unused slot
+ */
+#define _NIB_IDX_NONE       (UINT16_MAX)
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX) || defined(DOXYGEN)
+/**
+ * @brief   Resets the index
+ */
+void _nib_idx_init(void);
+
+/**
+ * @brief   (Re-)files on-link entry @p idx under address @p addr
+ *
+ * @param[in] idx   Number of the on-link entry.
+ * @param[in] addr  The new address of the entry. May be NULL or the
+ *                  unspecified address to remove the entry from the index.
+ */
+void _nib_idx_onl_update(unsigned idx, const ipv6_addr_t *addr);
+
+/**
+ * @brief   Gets the first on-link entry candidate for @p addr
+ *
+ * Candidates are returned in ascending order of their entry number.
+ *
+ * @pre     `(addr != NULL)`
+ *
+ * @param[in] addr  An IPv6 address.
+ *
+ * @return  Number of the first candidate.
+ * @return  @ref _NIB_IDX_NONE, if there is no candidate.
+ */
+unsigned _nib_idx_onl_first(const ipv6_addr_t *addr);
+
+/**
+ * @brief   Gets the on-link entry candidate following @p idx
+ *
+ * @param[in] idx   Number of the previous candidate.
+ *
+ * @return  Number of the next candidate.
+ * @return  @ref _NIB_IDX_NONE, if there is no further candidate.
+ */
+unsigned _nib_idx_onl_next(unsigned idx);
+
+/**
+ * @brief   Adds off-link entry @p idx to the prefix trie
+ *
+ * @pre     `(pfx != NULL) && (pfx_len <= IPV6_ADDR_BIT_LEN)`
+ * @pre     Entry @p idx is not in the trie yet.
+ *
+ * @param[in] idx       Number of the off-link entry.
+ * @param[in] pfx       Prefix of the entry.
+ * @param[in] pfx_len   Length of @p pfx in bits.
+ */
+void _nib_idx_offl_add(unsigned idx, const ipv6_addr_t *pfx, unsigned pfx_len);
+
+/**
+ * @brief   Removes off-link entry @p idx from the prefix trie
+ *
+ * Does nothing if @p idx is not in the trie.
+ *
+ * @param[in] idx   Number of the off-link entry.
+ */
+void _nib_idx_offl_remove(unsigned idx);
+
+/**
+ * @brief   Gets the first off-link entry of the longest prefix in the trie
+ *          that covers @p dst and for which @p valid returns true
+ *
+ * If several entries share the same prefix, they are offered to @p valid in
+ * ascending order of their entry number.
+ *
+ * @pre     `(dst != NULL) && (valid != NULL)`
+ *
+ * @param[in] dst   Destination address.
+ * @param[in] valid Predicate on the entry number to skip unused entries.
+ *
+ * @return  Number of the best matching entry.
+ * @return  @ref _NIB_IDX_NONE, if no entry matches.
+ */
+unsigned _nib_idx_offl_get_match(const ipv6_addr_t *dst,
+                                 bool (*valid)(unsigned idx));
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRIV_NIB_IDX_H */
+/** @} */
@@ -27,6 +27,7 @@
 #include "net/gnrc/netif/internal.h"
 #include "random.h"
 
+#include "_nib-idx.h"
 #include "_nib-internal.h"
 #include "_nib-router.h"
 
@@ -66,6 +67,9 @@ void _nib_init(void)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+    _nib_idx_init();
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -214,20 +218,42 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
     return NULL;
 }
 
+static inline bool _onl_matches(const _nib_onl_entry_t *node,
+                                const ipv6_addr_t *addr, unsigned iface)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+    /* entries without address are not indexed */
+    if (!ipv6_addr_is_unspecified(addr)) {
+        for (unsigned i = _nib_idx_onl_first(addr); i != _NIB_IDX_NONE;
+             i = _nib_idx_onl_next(i)) {
+            _nib_onl_entry_t *node = &_nodes[i];
+
+            if (_onl_matches(node, addr, iface)) {
+                DEBUG("  Found %p\n", (void *)node);
+                return node;
+            }
+        }
+        DEBUG("  No suitable entry found\n");
+        return NULL;
+    }
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(node, addr, iface)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
@@ -494,6 +520,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+                _nib_idx_onl_update(tmp_node - _nodes, &tmp_node->ipv6);
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -514,6 +543,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+        _nib_idx_offl_add(dst - _dsts, &dst->pfx, pfx_len);
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
     }
     return dst;
 }
@@ -550,6 +582,11 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+        if (_nib_offl_is_entry(dst)) {
+            _nib_idx_offl_remove(dst - _dsts);
+        }
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -573,6 +610,28 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+static bool _offl_in_use(unsigned idx)
+{
+    return _dsts[idx].mode != _EMPTY;
+}
+
+static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
+{
+    unsigned idx;
+
+    DEBUG("nib: get match for destination %s from NIB index\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    idx = _nib_idx_offl_get_match(dst, _offl_in_use);
+    if (idx == _NIB_IDX_NONE) {
+        return NULL;
+    }
+    DEBUG("nib: best match %s/%u\n",
+          ipv6_addr_to_str(addr_str, &_dsts[idx].pfx, sizeof(addr_str)),
+          _dsts[idx].pfx_len);
+    return &_dsts[idx];
+}
+#else   /* CONFIG_GNRC_IPV6_NIB_IDX */
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
@@ -601,6 +660,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
     }
     return res;
 }
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
 {
@@ -861,6 +921,9 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX)
+    _nib_idx_onl_update(node - _nodes, &node->ipv6);
+#endif  /* CONFIG_GNRC_IPV6_NIB_IDX */
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
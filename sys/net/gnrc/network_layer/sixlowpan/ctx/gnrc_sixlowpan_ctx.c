@@ -30,9 +30,12 @@
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
+static uint32_t _next_inval_time = UINT32_MAX;
+static unsigned _gen;
 
 static uint32_t _current_minute(void);
 static void _update_lifetime(uint8_t id);
+static void _update_next_inval_time(void);
 
 static char ipv6str[IPV6_ADDR_MAX_STR_LEN];
 
@@ -129,11 +132,44 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _update_next_inval_time();
+    _gen++;
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return;
+    }
+    mutex_lock(&_ctx_mutex);
+    _ctxs[id].prefix_len = 0;
+    _update_next_inval_time();
+    _gen++;
+    mutex_unlock(&_ctx_mutex);
+}
+
+unsigned gnrc_sixlowpan_ctx_gen(void)
+{
+    unsigned gen;
+
+    mutex_lock(&_ctx_mutex);
+    if ((_next_inval_time != UINT32_MAX) &&
+        (_current_minute() >= _next_inval_time)) {
+        /* a context stopped being valid for compression */
+        for (unsigned id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+            _update_lifetime(id);
+        }
+        _update_next_inval_time();
+        _gen++;
+    }
+    gen = _gen;
+    mutex_unlock(&_ctx_mutex);
+    return gen;
+}
+
 static uint32_t _current_minute(void)
 {
 #if IS_USED(MODULE_ZTIMER_MSEC)
@@ -143,6 +179,18 @@ static uint32_t _current_minute(void)
 #endif
 }
 
+static void _update_next_inval_time(void)
+{
+    _next_inval_time = UINT32_MAX;
+    for (unsigned id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
+        if ((_ctxs[id].prefix_len > 0) && (_ctxs[id].ltime > 0) &&
+            (_ctxs[id].flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
+            (_ctx_inval_times[id] < _next_inval_time)) {
+            _next_inval_time = _ctx_inval_times[id];
+        }
+    }
+}
+
 static void _update_lifetime(uint8_t id)
 {
     uint32_t now;
@@ -170,6 +218,8 @@ static void _update_lifetime(uint8_t id)
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _next_inval_time = UINT32_MAX;
+    _gen++;
 }
 #endif
 
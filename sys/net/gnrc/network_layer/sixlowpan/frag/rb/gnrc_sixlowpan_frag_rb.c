@@ -32,7 +32,6 @@
 #include "net/sixlowpan/sfr.h"
 #include "thread.h"
 #include "xtimer.h"
-#include "utlist.h"
 
 #include "net/gnrc/sixlowpan/frag/rb.h"
 
@@ -59,9 +58,23 @@
 #endif  /* IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_MINFWD) */
 #endif
 
+#ifndef RBUF_HASH_SIZE
+/* number of buckets to look up reassembly buffer entries by their datagram */
+#define RBUF_HASH_SIZE (2 * CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+#endif
+
+static_assert(CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE < UINT8_MAX,
+              "entries of the reassembly buffer must be indexable by uint8_t");
+
 static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
+/* where to start looking for a free interval in rbuf_int */
+static unsigned rbuf_int_next;
 
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+/* index + 1 of the first entry in a bucket or of the next entry in the same
+ * bucket as the entry, 0 if there is none */
+static uint8_t rbuf_bucket[RBUF_HASH_SIZE];
+static uint8_t rbuf_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
@@ -110,15 +123,28 @@ static int _forward_uncomp(gnrc_pktsnip_t *pkt,
                            unsigned page);
 static int _rbuf_resize_for_reassembly(gnrc_sixlowpan_frag_rb_t *rbuf);
 
+/* The intervals of a datagram are kept in a list, not in a search tree: VRB
+ * takes them over by concatenating lists, SFR frees them in place, and a
+ * datagram has at most IPV6_MIN_MTU / fragment size of them anyway. The list
+ * of a reassembly buffer entry is sorted by descending start (see
+ * _rbuf_update_ints()), so the walk stops at the first interval in front of
+ * the fragment. For fragments arriving in order that is the first one. */
 static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
                             size_t frag_size, size_t offset)
 {
     gnrc_sixlowpan_frag_rb_int_t *ptr = entry->ints;
+    /* the list of a VRB entry may be a concatenation of sorted lists */
+    bool sorted = ((uintptr_t)entry - (uintptr_t)rbuf) < sizeof(rbuf);
 
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
     while (ptr != NULL) {
+        if (sorted && (ptr->end < offset)) {
+            /* intervals don't overlap, so all following ones end even
+             * earlier */
+            break;
+        }
         if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
 
             /* "A fresh reassembly may be commenced with the most recently
@@ -180,6 +206,65 @@ void gnrc_sixlowpan_frag_rb_rm_by_datagram(const gnrc_netif_hdr_t *netif_hdr,
     }
 }
 
+static unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                           const uint8_t *dst, size_t dst_len, uint16_t tag)
+{
+    uint32_t hash = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
+    }
+    for (unsigned i = 0; i < dst_len; i++) {
+        hash = (hash * 31) + dst[i];
+    }
+    return hash % RBUF_HASH_SIZE;
+}
+
+static bool _rbuf_equal(const gnrc_sixlowpan_frag_rb_t *e,
+                        const uint8_t *src, size_t src_len,
+                        const uint8_t *dst, size_t dst_len, uint16_t tag)
+{
+    return (e->pkt != NULL) && (e->super.tag == tag) &&
+           (e->super.src_len == src_len) &&
+           (e->super.dst_len == dst_len) &&
+           (memcmp(e->super.src, src, src_len) == 0) &&
+           (memcmp(e->super.dst, dst, dst_len) == 0);
+}
+
+static uint8_t *_rbuf_bucket(const gnrc_sixlowpan_frag_rb_t *e)
+{
+    return &rbuf_bucket[_rbuf_hash(e->super.src, e->super.src_len,
+                                   e->super.dst, e->super.dst_len,
+                                   e->super.tag)];
+}
+
+static void _rbuf_hash_add(unsigned idx)
+{
+    uint8_t *ptr = _rbuf_bucket(&rbuf[idx]);
+
+    /* keep buckets sorted by index, so look-ups find the same entry as a
+     * scan over the whole reassembly buffer would */
+    while ((*ptr != 0) && (*ptr <= idx)) {
+        ptr = &rbuf_next[*ptr - 1];
+    }
+    rbuf_next[idx] = *ptr;
+    *ptr = idx + 1;
+}
+
+static void _rbuf_hash_rm(unsigned idx)
+{
+    uint8_t *ptr = _rbuf_bucket(&rbuf[idx]);
+
+    while (*ptr != 0) {
+        if (*ptr == (idx + 1)) {
+            *ptr = rbuf_next[idx];
+            rbuf_next[idx] = 0;
+            return;
+        }
+        ptr = &rbuf_next[*ptr - 1];
+    }
+}
+
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag)
 {
@@ -188,15 +273,12 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
     const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
     const uint8_t src_len = netif_hdr->src_l2addr_len;
     const uint8_t dst_len = netif_hdr->dst_l2addr_len;
+    unsigned i = rbuf_bucket[_rbuf_hash(src, src_len, dst, dst_len, tag)];
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
+    for (; i != 0; i = rbuf_next[i - 1]) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
 
-        if ((e->pkt != NULL) && (e->super.tag == tag) &&
-            (e->super.src_len == src_len) &&
-            (e->super.dst_len == dst_len) &&
-            (memcmp(e->super.src, src, src_len) == 0) &&
-            (memcmp(e->super.dst, dst, dst_len) == 0)) {
+        if (_rbuf_equal(e, src, src_len, dst, dst_len, tag)) {
             return e;
         }
     }
@@ -490,8 +572,13 @@ static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
 
 static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
+    /* intervals are mostly freed in the order they were taken, so start
+     * looking right after the interval taken last */
+    for (unsigned int n = 0; n < RBUF_INT_SIZE; n++) {
+        unsigned int i = (rbuf_int_next + n) % RBUF_INT_SIZE;
+
         if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
+            rbuf_int_next = (i + 1) % RBUF_INT_SIZE;
             return rbuf_int + i;
         }
     }
@@ -536,7 +623,15 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                                                   l2addr_str),
           entry->datagram_size, entry->tag);
 
-    LL_PREPEND(entry->ints, new);
+    /* keep the list sorted by descending start, so fragments arriving in
+     * order are prepended */
+    gnrc_sixlowpan_frag_rb_int_t **pos = &entry->ints;
+
+    while ((*pos != NULL) && ((*pos)->start > new->start)) {
+        pos = &(*pos)->next;
+    }
+    new->next = *pos;
+    *pos = new;
 
     return true;
 }
@@ -595,42 +690,41 @@ static int _rbuf_get(const void *src, size_t src_len,
 {
     gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
+    unsigned int i = rbuf_bucket[_rbuf_hash(src, src_len, dst, dst_len, tag)];
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.tag == tag) &&
+    /* check first if entry already available */
+    for (; i != 0; i = rbuf_next[i - 1]) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i - 1];
+
+        if (_rbuf_equal(e, src, src_len, dst, dst_len, tag) &&
             ((IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
               /* not all SFR fragments carry the datagram size, so make 0 a
                * legal value to not compare datagram size */
-              ((size == 0) || (rbuf[i].super.datagram_size == size))) ||
+              ((size == 0) || (e->super.datagram_size == size))) ||
              (!IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) &&
-              (rbuf[i].super.datagram_size == size))) &&
-            (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
+              (e->super.datagram_size == size)))) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)e,
+                  gnrc_netif_addr_to_str(e->super.src, e->super.src_len,
                                          l2addr_str));
             DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
+                  gnrc_netif_addr_to_str(e->super.dst, e->super.dst_len,
                                          l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+                  (unsigned)e->super.datagram_size, e->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
+            if (e->super.current_size == 0) {
                 /* ensure that only empty reassembly buffer entries and entries
                  * scheduled for deletion have `current_size == 0` */
                 DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
                 return -1;
             }
 #endif
-            rbuf[i].super.arrival = now_usec;
+            e->super.arrival = now_usec;
             _set_rbuf_timeout();
-            return i;
+            return i - 1;
         }
+    }
 
+    for (i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
         if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
@@ -718,6 +812,7 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    _rbuf_hash_add(res - &(rbuf[0]));
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
     res->offset_diff = 0U;
     memset(res->received, 0U, sizeof(res->received));
@@ -741,6 +836,7 @@ void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
     memset(rbuf_int, 0, sizeof(rbuf_int));
+    rbuf_int_next = 0;
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -748,6 +844,8 @@ void gnrc_sixlowpan_frag_rb_reset(void)
         }
     }
     memset(rbuf, 0, sizeof(rbuf));
+    memset(rbuf_bucket, 0, sizeof(rbuf_bucket));
+    memset(rbuf_next, 0, sizeof(rbuf_next));
 }
 
 const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
@@ -758,6 +856,12 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
 {
+    uintptr_t offset = (uintptr_t)entry - (uintptr_t)rbuf;
+
+    /* entry may also be the base of a VRB entry */
+    if (offset < sizeof(rbuf)) {
+        _rbuf_hash_rm(offset / sizeof(rbuf[0]));
+    }
     while (entry->ints != NULL) {
         gnrc_sixlowpan_frag_rb_int_t *next = entry->ints->next;
 
@@ -392,6 +392,9 @@ static void *_event_loop(void *args)
     (void)args;
     msg_init_queue(msg_q, GNRC_SIXLOWPAN_MSG_QUEUE_SIZE);
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    gnrc_netapi_batch_accept(&me_reg);
+#endif
     /* register interest in all 6LoWPAN packets */
     gnrc_netreg_register(GNRC_NETTYPE_SIXLOWPAN, &me_reg);
 
@@ -418,6 +421,18 @@ static void *_event_loop(void *args)
                 _send(msg.content.ptr);
                 break;
 
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _receive);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("6lo: GNRC_NETAPI_MSG_TYPE_SND_BATCH received\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _send);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_GET:
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
@@ -1560,6 +1560,168 @@ static inline bool _compressible(gnrc_pktsnip_t *hdr)
     }
 }
 
+#if CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE > 0
+#if defined(MODULE_GNRC_SIXLOWPAN_IPHC_NHC) && defined(MODULE_GNRC_UDP)
+#define IPHC_CACHE_UDP              (1)
+#else
+#define IPHC_CACHE_UDP              (0)
+#endif
+
+/* IPHC header with all fields carried inline + UDP NHC without checksum */
+#define IPHC_CACHE_HDR_LEN          (SIXLOWPAN_IPHC_HDR_LEN + \
+                                     SIXLOWPAN_IPHC_CID_EXT_LEN + \
+                                     4U /* TF */ + 1U /* NH */ + 1U /* HL */ + \
+                                     (2U * sizeof(ipv6_addr_t)) + \
+                                     5U /* UDP NHC */)
+
+/**
+ * @brief   Everything that goes into the compressed headers apart from the
+ *          context buffer and the link-layer address of the interface
+ */
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    gnrc_netif_t *iface;
+    network_uint32_t v_tc_fl;
+    network_uint16_t src_port;
+    network_uint16_t dst_port;
+    uint8_t nh;
+    uint8_t hl;
+    uint8_t dst_l2addr_len;
+    uint8_t dst_l2addr[GNRC_NETIF_L2ADDR_MAXLEN];
+} _iphc_cache_key_t;
+
+typedef struct {
+    _iphc_cache_key_t key;
+    unsigned ctx_gen;           /**< generation of the context buffer */
+    unsigned gen;               /**< generation of the cache */
+    uint8_t hdr_len;            /**< length of iphc_hdr, 0 if unused */
+    uint8_t iphc_hdr[IPHC_CACHE_HDR_LEN];
+} _iphc_cache_entry_t;
+
+static _iphc_cache_entry_t _iphc_cache[CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _iphc_cache_next;
+static volatile unsigned _iphc_cache_gen;
+
+void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+    _iphc_cache_gen++;
+}
+
+static inline bool _iphc_cache_has_udp(const _iphc_cache_key_t *key)
+{
+    return IPHC_CACHE_UDP && (key->nh == PROTNUM_UDP);
+}
+
+static bool _iphc_cache_key(const gnrc_pktsnip_t *pkt,
+                            const gnrc_netif_hdr_t *netif_hdr,
+                            gnrc_netif_t *iface, _iphc_cache_key_t *key)
+{
+    const gnrc_pktsnip_t *ipv6 = pkt->next;
+    const ipv6_hdr_t *ipv6_hdr = ipv6->data;
+
+    /* forwarded packets and packets with extension headers are not cached */
+    if ((ipv6->type != GNRC_NETTYPE_IPV6) ||
+        (ipv6->size != sizeof(ipv6_hdr_t)) ||
+        (netif_hdr->dst_l2addr_len > sizeof(key->dst_l2addr))) {
+        return false;
+    }
+    /* zero padding, so keys can be compared with memcmp() */
+    memset(key, 0, sizeof(*key));
+    if (_compressible_nh(ipv6_hdr->nh)) {
+#if IPHC_CACHE_UDP
+        const gnrc_pktsnip_t *udp = ipv6->next;
+
+        if ((ipv6_hdr->nh != PROTNUM_UDP) || (udp == NULL) ||
+            (udp->type != GNRC_NETTYPE_UDP) ||
+            (udp->size != sizeof(udp_hdr_t))) {
+            return false;
+        }
+        key->src_port = ((udp_hdr_t *)udp->data)->src_port;
+        key->dst_port = ((udp_hdr_t *)udp->data)->dst_port;
+#else
+        return false;
+#endif
+    }
+    key->src = ipv6_hdr->src;
+    key->dst = ipv6_hdr->dst;
+    key->iface = iface;
+    key->v_tc_fl = ipv6_hdr->v_tc_fl;
+    key->nh = ipv6_hdr->nh;
+    key->hl = ipv6_hdr->hl;
+    key->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+    memcpy(key->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           netif_hdr->dst_l2addr_len);
+    return true;
+}
+
+static _iphc_cache_entry_t *_iphc_cache_get(const _iphc_cache_key_t *key,
+                                            unsigned ctx_gen)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        _iphc_cache_entry_t *entry = &_iphc_cache[i];
+
+        if ((entry->hdr_len > 0) && (entry->gen == _iphc_cache_gen) &&
+            (entry->ctx_gen == ctx_gen) &&
+            (memcmp(&entry->key, key, sizeof(*key)) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void _iphc_cache_set(const _iphc_cache_key_t *key, unsigned ctx_gen,
+                            unsigned gen, const uint8_t *iphc_hdr,
+                            size_t hdr_len)
+{
+    _iphc_cache_entry_t *entry = &_iphc_cache[_iphc_cache_next];
+
+    if (_iphc_cache_has_udp(key)) {
+        /* the checksum is copied from each packet */
+        hdr_len -= sizeof(network_uint16_t);
+    }
+    assert(hdr_len <= sizeof(entry->iphc_hdr));
+    entry->key = *key;
+    entry->ctx_gen = ctx_gen;
+    entry->gen = gen;
+    entry->hdr_len = hdr_len;
+    memcpy(entry->iphc_hdr, iphc_hdr, hdr_len);
+    _iphc_cache_next = (_iphc_cache_next + 1) %
+                       CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+}
+
+static gnrc_pktsnip_t *_iphc_cache_encode(gnrc_pktsnip_t *pkt,
+                                          const _iphc_cache_entry_t *entry)
+{
+    gnrc_pktsnip_t *dispatch;
+    bool udp = _iphc_cache_has_udp(&entry->key);
+
+    dispatch = gnrc_pktbuf_add(NULL, entry->iphc_hdr,
+                               entry->hdr_len +
+                               (udp ? sizeof(network_uint16_t) : 0),
+                               GNRC_NETTYPE_SIXLOWPAN);
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        return NULL;
+    }
+    if (udp) {
+        gnrc_pktsnip_t *hdr = pkt->next->next;
+
+        memcpy((uint8_t *)dispatch->data + entry->hdr_len,
+               &((udp_hdr_t *)hdr->data)->checksum, sizeof(network_uint16_t));
+        /* remove UDP header */
+        gnrc_pktbuf_remove_snip(pkt, hdr);
+    }
+    /* remove IPv6 header */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+
+    /* insert dispatch into packet */
+    dispatch->next = pkt->next;
+    pkt->next = dispatch;
+    return pkt;
+}
+#endif  /* CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE > 0 */
+
 static gnrc_pktsnip_t *_iphc_encode(gnrc_pktsnip_t *pkt,
                                     const gnrc_netif_hdr_t *netif_hdr,
                                     gnrc_netif_t *iface)
@@ -1606,6 +1768,21 @@ static gnrc_pktsnip_t *_iphc_encode(gnrc_pktsnip_t *pkt,
     /* there should be at least one compressible header in `pkt`, otherwise this
      * function should not be called */
     assert(dispatch_size > 0);
+#if CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE > 0
+    _iphc_cache_key_t key;
+    unsigned ctx_gen = 0, gen = _iphc_cache_gen;
+    bool cacheable = _iphc_cache_key(pkt, netif_hdr, iface, &key);
+
+    if (cacheable) {
+        _iphc_cache_entry_t *entry;
+
+        ctx_gen = gnrc_sixlowpan_ctx_gen();
+        if ((entry = _iphc_cache_get(&key, ctx_gen)) != NULL) {
+            DEBUG("6lo iphc: using cached header\n");
+            return _iphc_cache_encode(pkt, entry);
+        }
+    }
+#endif
     dispatch = gnrc_pktbuf_add(NULL, NULL, dispatch_size + 1,
                                GNRC_NETTYPE_SIXLOWPAN);
 
@@ -1666,6 +1843,12 @@ static gnrc_pktsnip_t *_iphc_encode(gnrc_pktsnip_t *pkt,
     }
 #endif
 
+#if CONFIG_GNRC_SIXLOWPAN_IPHC_CACHE_SIZE > 0
+    if (cacheable) {
+        _iphc_cache_set(&key, ctx_gen, gen, iphc_hdr, inline_pos);
+    }
+#endif
+
     /* shrink dispatch allocation to final size */
     /* NOTE: Since this only shrinks the data nothing bad SHOULD happen ;-) */
     gnrc_pktbuf_realloc_data(dispatch, (size_t)inline_pos);
@@ -102,7 +102,7 @@ void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
             else {
                 gnrc_tx_complete(pkt);
             }
-            gnrc_pktbuf_free_internal(pkt, sizeof(gnrc_pktsnip_t));
+            gnrc_pktbuf_free_snip(pkt);
         }
         else {
             pkt->users--;
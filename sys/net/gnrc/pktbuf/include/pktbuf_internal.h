@@ -26,7 +26,15 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+#include "kernel_defines.h"
 #include "mutex.h"
+#include "net/gnrc/pkt.h"
+#if IS_USED(MODULE_TRACE)
+#include "trace.h"
+#endif
+#if IS_USED(MODULE_GNRC_PKTBUF_SIZECLASS)
+#include "net/gnrc/pktbuf/sizeclass.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +58,15 @@ extern mutex_t gnrc_pktbuf_mutex;
 extern uint8_t *gnrc_pktbuf_static_buf;
 #endif
 
+#if IS_USED(MODULE_GNRC_PKTBUF_SIZECLASS) || DOXYGEN
+/**
+ * @brief   The arena used when module gnrc_pktbuf_sizeclass is used
+ *
+ * @warning This is an internal buffer and should not be touched by external code
+ */
+extern uint8_t *gnrc_pktbuf_sizeclass_buf;
+#endif
+
 /**
  * @brief   Check if the given pointer is indeed part of the packet buffer
  *
@@ -65,6 +82,9 @@ static inline bool gnrc_pktbuf_contains(void *ptr)
 {
 #if IS_USED(MODULE_GNRC_PKTBUF_STATIC)
     return (unsigned)((uint8_t *)ptr - gnrc_pktbuf_static_buf) < CONFIG_GNRC_PKTBUF_SIZE;
+#elif IS_USED(MODULE_GNRC_PKTBUF_SIZECLASS)
+    return (uintptr_t)((uint8_t *)ptr - gnrc_pktbuf_sizeclass_buf) <
+           GNRC_PKTBUF_SIZECLASS_SIZE;
 #else
     (void)ptr;
     return true;
@@ -82,6 +102,43 @@ static inline bool gnrc_pktbuf_contains(void *ptr)
  */
 void gnrc_pktbuf_free_internal(void *data, size_t size);
 
+/**
+ * @brief   Record the allocation of a packet snip in the trace buffer, if
+ *          module `trace_events` is used
+ *
+ * @warning This function is ***internal***.
+ *
+ * @param   pkt     the new packet snip
+ */
+static inline void gnrc_pktbuf_trace_alloc(const gnrc_pktsnip_t *pkt)
+{
+#if IS_USED(MODULE_TRACE_EVENTS)
+    trace_event(TRACE_PKTBUF_ALLOC,
+                (pkt->size > UINT16_MAX) ? UINT16_MAX : pkt->size,
+                (uintptr_t)pkt);
+#else
+    (void)pkt;
+#endif
+}
+
+/**
+ * @brief   Release the descriptor of a packet snip and record it in the
+ *          trace buffer, if module `trace_events` is used
+ *
+ * @warning This function is ***internal***.
+ *
+ * @param   pkt     the packet snip, its data must be released separately
+ */
+static inline void gnrc_pktbuf_free_snip(gnrc_pktsnip_t *pkt)
+{
+#if IS_USED(MODULE_TRACE_EVENTS)
+    trace_event(TRACE_PKTBUF_FREE,
+                (pkt->size > UINT16_MAX) ? UINT16_MAX : pkt->size,
+                (uintptr_t)pkt);
+#endif
+    gnrc_pktbuf_free_internal(pkt, sizeof(gnrc_pktsnip_t));
+}
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
@@ -133,6 +133,7 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
     if (pkt->size == size) {
         _set_pktsnip(header, pkt->next, pkt->data, size, type);
         _set_pktsnip(pkt, header, NULL, 0, pkt->type);
+        gnrc_pktbuf_trace_alloc(header);
         return header;
     }
     /* we can not just "snip off" something from the end of a malloc'd section
@@ -155,6 +156,7 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
     pkt->size -= size;
     _set_pktsnip(header, pkt->next, header_data, size, type);
     pkt->next = header;
+    gnrc_pktbuf_trace_alloc(header);
     return header;
 }
 
@@ -279,6 +281,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
     if (data != NULL) {
         memcpy(_data, data, size);
     }
+    gnrc_pktbuf_trace_alloc(pkt);
     return pkt;
 }
 
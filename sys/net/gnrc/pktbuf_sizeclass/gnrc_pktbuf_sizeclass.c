@@ -0,0 +1,432 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf_sizeclass
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf/sizeclass.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#include "pktbuf_internal.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define _SNIP_SIZE      GNRC_PKTBUF_SIZECLASS_ALIGN(sizeof(gnrc_pktsnip_t))
+
+/**
+ * @brief   Marks a free block, linked into the free list of its class
+ */
+typedef struct _free_block {
+    struct _free_block *next;   /**< next free block of the same class */
+} _free_block_t;
+
+static const uint16_t _block_size[GNRC_PKTBUF_SIZECLASS_NUMOF] = {
+    _SNIP_SIZE,
+    GNRC_PKTBUF_SIZECLASS_ALIGN(CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_SIZE),
+    GNRC_PKTBUF_SIZECLASS_ALIGN(CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_SIZE),
+    GNRC_PKTBUF_SIZECLASS_ALIGN(CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_SIZE),
+};
+
+static const uint16_t _block_numof[GNRC_PKTBUF_SIZECLASS_NUMOF] = {
+    CONFIG_GNRC_PKTBUF_SIZECLASS_SNIP_NUMOF,
+    CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_NUMOF,
+    CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_NUMOF,
+    CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_NUMOF,
+};
+
+/* word-aligned arena, see gnrc_pktbuf_static */
+static uintptr_t _pktbuf_buf[GNRC_PKTBUF_SIZECLASS_SIZE / sizeof(uintptr_t)];
+uint8_t *gnrc_pktbuf_sizeclass_buf = (uint8_t *)_pktbuf_buf;
+
+/* first byte after the blocks of each class */
+static uint8_t *_class_end[GNRC_PKTBUF_SIZECLASS_NUMOF];
+static _free_block_t *_free_list[GNRC_PKTBUF_SIZECLASS_NUMOF];
+static gnrc_pktbuf_sizeclass_stats_t _stats;
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static inline uint8_t *_class_start(unsigned c)
+{
+    return (c == 0) ? gnrc_pktbuf_sizeclass_buf : _class_end[c - 1];
+}
+
+static unsigned _class_of(const void *ptr)
+{
+    unsigned c = 0;
+
+    while ((const uint8_t *)ptr >= _class_end[c]) {
+        c++;
+    }
+    assert(c < GNRC_PKTBUF_SIZECLASS_NUMOF);
+    return c;
+}
+
+static uint8_t *_block_of(const void *ptr, unsigned c)
+{
+    uint8_t *start = _class_start(c);
+    size_t offset = (const uint8_t *)ptr - start;
+
+    return start + (offset - (offset % _block_size[c]));
+}
+
+static size_t _block_capacity(const void *data)
+{
+    unsigned c = _class_of(data);
+
+    return (_block_of(data, c) + _block_size[c]) - (const uint8_t *)data;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    uint8_t *ptr = gnrc_pktbuf_sizeclass_buf;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    memset(&_stats, 0, sizeof(_stats));
+    for (unsigned c = 0; c < GNRC_PKTBUF_SIZECLASS_NUMOF; c++) {
+        _free_list[c] = NULL;
+        /* push in reverse, so blocks are handed out in address order */
+        for (unsigned i = _block_numof[c]; i > 0; i--) {
+            _free_block_t *block = (_free_block_t *)(uintptr_t)
+                                   (ptr + ((i - 1) * _block_size[c]));
+
+            block->next = _free_list[c];
+            _free_list[c] = block;
+        }
+        ptr += _block_numof[c] * _block_size[c];
+        _class_end[c] = ptr;
+        _stats.classes[c].size = _block_size[c];
+        _stats.classes[c].numof = _block_numof[c];
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+static size_t _free_bytes(void)
+{
+    size_t res = 0;
+
+    for (unsigned c = 0; c < GNRC_PKTBUF_SIZECLASS_NUMOF; c++) {
+        res += (_block_numof[c] - _stats.classes[c].used) * _block_size[c];
+    }
+    return res;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    unsigned best = 0;
+
+    while ((best < GNRC_PKTBUF_SIZECLASS_NUMOF) && (size > _block_size[best])) {
+        best++;
+    }
+    for (unsigned c = best; c < GNRC_PKTBUF_SIZECLASS_NUMOF; c++) {
+        _free_block_t *block = _free_list[c];
+        gnrc_pktbuf_sizeclass_class_stats_t *stats = &_stats.classes[c];
+
+        if (block == NULL) {
+            continue;
+        }
+        _free_list[c] = block->next;
+        if (++stats->used > stats->max_used) {
+            stats->max_used = stats->used;
+        }
+        if (c != best) {
+            stats->fallbacks++;
+        }
+        _stats.used += _block_size[c];
+        if (_stats.used > _stats.max_used) {
+            _stats.max_used = _stats.used;
+        }
+        return block;
+    }
+    DEBUG("pktbuf: no block of size >= %u left\n", (unsigned)size);
+    _stats.failed++;
+    if ((best < GNRC_PKTBUF_SIZECLASS_NUMOF) && (_free_bytes() >= size)) {
+        _stats.failed_frag++;
+    }
+    return NULL;
+}
+
+void gnrc_pktbuf_free_internal(void *data, size_t size)
+{
+    _free_block_t *block;
+    unsigned c;
+
+    (void)size;
+    if ((data == NULL) || !gnrc_pktbuf_contains(data)) {
+        return;
+    }
+    /* data may point into a block after gnrc_pktbuf_mark() */
+    c = _class_of(data);
+    block = (_free_block_t *)(uintptr_t)_block_of(data, c);
+    block->next = _free_list[c];
+    _free_list[c] = block;
+    assert(_stats.classes[c].used > 0);
+    _stats.classes[c].used--;
+    _stats.used -= _block_size[c];
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _block_size[GNRC_PKTBUF_SIZECLASS_NUMOF - 1]) {
+        DEBUG("pktbuf: size (%u) > CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_SIZE (%u)\n",
+              (unsigned)size, CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_SIZE);
+        return NULL;
+    }
+    mutex_lock(&gnrc_pktbuf_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    if (pkt->size == size) {
+        new_data_marked = pkt->data;
+        pkt->data = NULL;
+    }
+    else {
+        /* a block can only be owned by one snip => copy the (typically small)
+         * marked header into its own block and keep the remainder in place */
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            gnrc_pktbuf_free_internal(marked_snip, sizeof(gnrc_pktsnip_t));
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    gnrc_pktbuf_trace_alloc(marked_snip);
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && gnrc_pktbuf_contains(pkt->data)));
+    if ((size == 0) && (pkt->data != NULL)) {
+        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    /* grow beyond the current block */
+    else if ((size > pkt->size) &&
+             ((pkt->data == NULL) || (size > _block_capacity(pkt->data)))) {
+        void *new_data = _pktbuf_alloc(size);
+
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&gnrc_pktbuf_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {
+            memcpy(new_data, pkt->data, pkt->size);
+        }
+        gnrc_pktbuf_free_internal(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    /* otherwise the data stays in its block */
+    pkt->size = size;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&gnrc_pktbuf_mutex);
+        return new;
+    }
+    mutex_unlock(&gnrc_pktbuf_mutex);
+    return pkt;
+}
+
+void gnrc_pktbuf_sizeclass_get_stats(gnrc_pktbuf_sizeclass_stats_t *stats)
+{
+    assert(stats != NULL);
+    mutex_lock(&gnrc_pktbuf_mutex);
+    memcpy(stats, &_stats, sizeof(_stats));
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+void gnrc_pktbuf_sizeclass_reset_stats(void)
+{
+    mutex_lock(&gnrc_pktbuf_mutex);
+    for (unsigned c = 0; c < GNRC_PKTBUF_SIZECLASS_NUMOF; c++) {
+        _stats.classes[c].max_used = _stats.classes[c].used;
+        _stats.classes[c].fallbacks = 0;
+    }
+    _stats.max_used = _stats.used;
+    _stats.failed = 0;
+    _stats.failed_frag = 0;
+    mutex_unlock(&gnrc_pktbuf_mutex);
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    gnrc_pktbuf_sizeclass_stats_t stats;
+
+    gnrc_pktbuf_sizeclass_get_stats(&stats);
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&gnrc_pktbuf_sizeclass_buf[0],
+           (void *)&gnrc_pktbuf_sizeclass_buf[GNRC_PKTBUF_SIZECLASS_SIZE],
+           (unsigned)GNRC_PKTBUF_SIZECLASS_SIZE);
+    printf("  bytes in use: %u (max: %u)\n", (unsigned)stats.used,
+           (unsigned)stats.max_used);
+    printf("  failed allocations: %" PRIu32 " (due to fragmentation: %"
+           PRIu32 ")\n", stats.failed, stats.failed_frag);
+    for (unsigned c = 0; c < GNRC_PKTBUF_SIZECLASS_NUMOF; c++) {
+        printf("  class %u: block size: %4u, used: %3u/%3u (max: %3u), "
+               "fallbacks: %" PRIu32 "\n", c,
+               stats.classes[c].size, stats.classes[c].used,
+               stats.classes[c].numof, stats.classes[c].max_used,
+               stats.classes[c].fallbacks);
+    }
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    return _stats.used == 0;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    size_t used = 0;
+
+    /* Invariants of this implementation:
+     *  - every block in the free list of a class lies within the region of
+     *    that class and starts at a block boundary
+     *  - the free list of a class holds exactly numof - used blocks
+     *  - _stats.used is the sum of the used blocks' sizes
+     */
+    for (unsigned c = 0; c < GNRC_PKTBUF_SIZECLASS_NUMOF; c++) {
+        unsigned free_blocks = 0;
+
+        for (_free_block_t *ptr = _free_list[c]; ptr != NULL; ptr = ptr->next) {
+            uint8_t *block = (uint8_t *)ptr;
+
+            if ((block < _class_start(c)) || (block >= _class_end[c]) ||
+                (_block_of(block, c) != block) ||
+                (++free_blocks > _block_numof[c])) {
+                return false;
+            }
+        }
+        if (free_blocks != (unsigned)(_block_numof[c] - _stats.classes[c].used)) {
+            return false;
+        }
+        used += _stats.classes[c].used * _block_size[c];
+    }
+    return used == _stats.used;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            gnrc_pktbuf_free_internal(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    gnrc_pktbuf_trace_alloc(pkt);
+    return pkt;
+}
+
+/** @} */
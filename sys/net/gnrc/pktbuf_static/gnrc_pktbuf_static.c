@@ -148,6 +148,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
     pkt->size -= size;
     _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
     pkt->next = marked_snip;
+    gnrc_pktbuf_trace_alloc(marked_snip);
     mutex_unlock(&gnrc_pktbuf_mutex);
     return marked_snip;
 }
@@ -362,6 +363,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
+    gnrc_pktbuf_trace_alloc(pkt);
     return pkt;
 }
 
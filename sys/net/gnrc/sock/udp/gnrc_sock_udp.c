@@ -278,19 +278,45 @@ ssize_t sock_udp_recv_buf_aux(sock_udp_t *sock, void **data, void **buf_ctx,
     return res;
 }
 
-ssize_t sock_udp_send_aux(sock_udp_t *sock, const void *data, size_t len,
-                          const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux)
+int sock_udp_recv_multi(sock_udp_t *sock, sock_udp_msg_t *msgs, unsigned num,
+                        uint32_t timeout)
+{
+    unsigned i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (num > 0));
+    while (i < num) {
+        ssize_t res = sock_udp_recv(sock, msgs[i].data, msgs[i].max_len,
+                                    timeout, &msgs[i].remote);
+
+        if ((res < 0) && (res != -ENOBUFS)) {
+            if (i == 0) {
+                return res;
+            }
+            else if (res == -EPROTO) {
+                /* drop message from wrong remote and keep on draining */
+                continue;
+            }
+            break;
+        }
+        msgs[i++].len = res;
+        /* only wait for the first message */
+        timeout = 0;
+    }
+    return i;
+}
+
+ssize_t sock_udp_sendv_aux(sock_udp_t *sock, const iolist_t *snips,
+                           const sock_udp_ep_t *remote, sock_udp_aux_tx_t *aux)
 {
     (void)aux;
     int res;
-    gnrc_pktsnip_t *payload, *pkt;
+    gnrc_pktsnip_t *payload = NULL, *pkt;
     uint16_t src_port = 0, dst_port;
     sock_ip_ep_t local;
     sock_udp_ep_t remote_cpy;
     sock_ip_ep_t *rem;
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
 
     if (remote != NULL) {
         if (remote->port == 0) {
@@ -362,11 +388,28 @@ ssize_t sock_udp_send_aux(sock_udp_t *sock, const void *data, size_t len,
     else if (local.family != rem->family) {
         return -EINVAL;
     }
-    /* generate payload and header snips */
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
-    if (payload == NULL) {
+    /* generate payload snips in order, one for each chunk */
+    for (const iolist_t *snip = snips; snip != NULL; snip = snip->iol_next) {
+        gnrc_pktsnip_t *tmp;
+
+        if (snip->iol_len == 0) {
+            continue;
+        }
+        tmp = gnrc_pktbuf_add(NULL, snip->iol_base, snip->iol_len,
+                              GNRC_NETTYPE_UNDEF);
+        if (tmp == NULL) {
+            if (payload != NULL) {
+                gnrc_pktbuf_release(payload);
+            }
+            return -ENOMEM;
+        }
+        payload = gnrc_pkt_append(payload, tmp);
+    }
+    if ((payload == NULL) &&
+        ((payload = gnrc_pktbuf_add(NULL, NULL, 0, GNRC_NETTYPE_UNDEF)) == NULL)) {
         return -ENOMEM;
     }
+    /* generate header snip */
     pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
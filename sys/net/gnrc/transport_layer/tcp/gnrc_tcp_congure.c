@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/congure.h
+ * @}
+ */
+
+#include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_fsm.h"
+#include "include/gnrc_tcp_pkt.h"
+#include "include/gnrc_tcp_congure.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#ifdef MODULE_GNRC_TCP_CONGURE_RENO
+static void _fast_retransmit(congure_reno_snd_t *c)
+{
+    gnrc_tcp_tcb_t *tcb = c->super.ctx;
+
+    if (tcb->pkt_retransmit != NULL) {
+        TCP_DEBUG_INFO("Fast retransmit.");
+        _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
+        _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    }
+}
+
+static const congure_reno_snd_consts_t _consts = {
+    .fr = _fast_retransmit,
+    .init_mss = CONFIG_GNRC_TCP_MSS,
+    .init_ssthresh = CONGURE_WND_SIZE_MAX,
+    .frthresh = 3,
+};
+
+void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb)
+{
+    congure_reno_snd_setup(&tcb->cong, &_consts);
+    if (tcb->mss < CONFIG_GNRC_TCP_MSS) {
+        congure_reno_set_mss(&tcb->cong, tcb->mss);
+    }
+    tcb->cong.super.driver->init(&tcb->cong.super, tcb);
+    /* the first ACK after the handshake may already be a duplicate one */
+    tcb->cong.last_wnd = (tcb->snd_wnd > CONGURE_WND_SIZE_MAX)
+                       ? CONGURE_WND_SIZE_MAX : tcb->snd_wnd;
+}
+
+size_t _gnrc_tcp_congure_usable_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    return congure_reno_usable_wnd(&tcb->cong);
+}
+
+void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, size_t size)
+{
+    tcb->cong.super.driver->report_msg_sent(&tcb->cong.super, size);
+}
+
+void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb, uint32_t acked,
+                             uint32_t seg_ack, uint32_t pay_len,
+                             uint32_t seg_wnd, bool clean)
+{
+    congure_snd_msg_t msg = { .size = (acked > CONGURE_WND_SIZE_MAX)
+                                     ? CONGURE_WND_SIZE_MAX : acked };
+    congure_snd_ack_t ack = {
+        .recv_time = evtimer_now_msec(),
+        .id = seg_ack,
+        .size = pay_len,
+        .clean = clean,
+        .wnd = (seg_wnd > CONGURE_WND_SIZE_MAX) ? CONGURE_WND_SIZE_MAX : seg_wnd,
+    };
+
+    if (tcb->state < FSM_STATE_ESTABLISHED) {
+        return;
+    }
+    tcb->cong.super.driver->report_msg_acked(&tcb->cong.super, &msg, &ack);
+}
+
+void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    congure_snd_msg_t msg = { 0 };
+
+    if ((tcb->state < FSM_STATE_ESTABLISHED) || (tcb->pkt_retransmit == NULL)) {
+        return;
+    }
+    msg.super.next = &msg.super;
+    msg.size = _gnrc_tcp_pkt_get_pay_len(tcb->pkt_retransmit);
+    tcb->cong.super.driver->report_msgs_timeout(&tcb->cong.super, &msg);
+    /* the segment is sent again right away */
+    tcb->cong.super.driver->report_msg_sent(&tcb->cong.super, msg.size);
+}
+#else   /* MODULE_GNRC_TCP_CONGURE_RENO */
+typedef int dont_be_pedantic;
+#endif  /* MODULE_GNRC_TCP_CONGURE_RENO */
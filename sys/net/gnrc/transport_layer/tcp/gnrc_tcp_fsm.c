@@ -25,10 +25,12 @@
 #include "evtimer.h"
 #include "evtimer_msg.h"
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_congure.h"
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_pkt.h"
 #include "include/gnrc_tcp_option.h"
 #include "include/gnrc_tcp_rcvbuf.h"
+#include "include/gnrc_tcp_reass.h"
 #include "include/gnrc_tcp_fsm.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -148,8 +150,9 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
 
     switch (state) {
         case FSM_STATE_CLOSED:
-            /* Clear retransmit queue */
+            /* Clear retransmit and reassembly queue */
             _clear_retransmit(tcb);
+            _gnrc_tcp_reass_clear(tcb);
 
             /* Close connection if not listenng */
             if (!(tcb->status & STATUS_LISTENING))
@@ -232,6 +235,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, _gnrc_tcp_fsm_state_t state)
             break;
 
         case FSM_STATE_ESTABLISHED:
+            _gnrc_tcp_congure_init(tcb);
+            /* intentionally falls through */
         case FSM_STATE_CLOSE_WAIT:
             /* Stop timeout for listening TCBs */
             if (tcb->status & STATUS_LISTENING) {
@@ -326,6 +331,10 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
         payload = (payload < tcb->mss) ? payload : tcb->mss;
         payload = (payload < len) ? payload : len;
 
+        /* Limit segment size by congestion window */
+        size_t usable = _gnrc_tcp_congure_usable_wnd(tcb);
+        payload = (payload < usable) ? payload : usable;
+
         /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
@@ -333,6 +342,7 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
                             tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
         _gnrc_tcp_pkt_setup_retransmit(tcb, out_pkt, false);
         _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
+        _gnrc_tcp_congure_sent(tcb, payload);
         TCP_DEBUG_LEAVE;
         return payload;
     }
@@ -480,6 +490,10 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_seq = byteorder_ntohl(tcp_hdr->seq_num);
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
+    /* The window field of a SYN is never scaled (RFC 7323, section 2.2) */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_scale;
+    }
 
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
@@ -628,6 +642,10 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             return 0;
 #endif
 
+            tcb->snd_wnd = seg_wnd;
+            tcb->snd_wl1 = seg_seq;
+            tcb->snd_wl2 = seg_ack;
+
             /* SYN has been ACKed. Send ACK, T: SYN_SENT -> ESTABLISHED */
             if (tcb->snd_una > tcb->iss) {
                 _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK,
@@ -643,9 +661,6 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
                 _transition_to(tcb, FSM_STATE_SYN_RCVD);
             }
-            tcb->snd_wnd = seg_wnd;
-            tcb->snd_wl1 = seg_seq;
-            tcb->snd_wl2 = seg_ack;
         }
         TCP_DEBUG_LEAVE;
         return 0;
@@ -712,8 +727,17 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _gnrc_tcp_pkt_acknowledge(tcb, seg_ack);
+                    _gnrc_tcp_congure_acked(tcb, acked, seg_ack, pay_len, seg_wnd,
+                                            !(ctl & (MSK_SYN | MSK_FIN)));
+                }
+                /* Report duplicate ACKs for fast retransmit */
+                else if (seg_ack == tcb->snd_una) {
+                    _gnrc_tcp_congure_acked(tcb, 0, seg_ack, pay_len, seg_wnd,
+                                            !(ctl & (MSK_SYN | MSK_FIN)));
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -772,21 +796,9 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                snp = gnrc_pktsnip_search_type(in_pkt, GNRC_NETTYPE_UNDEF);
-
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
-                    /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
-                    /* Notify owner because new data is available */
-                    tcb->status |= STATUS_NOTIFY_USER;
-                }
+                /* Copy expected data into receive buffer, queue data received out of order */
+                _gnrc_tcp_reass_recv(tcb, in_pkt, seg_seq, pay_len);
+
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
@@ -803,6 +815,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 TCP_DEBUG_LEAVE;
                 return 0;
             }
+            /* Ignore FIN until all data in front of it was received, acknowledge instead */
+            if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
+                                    tcb->rcv_nxt, NULL, 0);
+                _gnrc_tcp_pkt_send(tcb, out_pkt, seq_con, false);
+                TCP_DEBUG_LEAVE;
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _gnrc_tcp_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt,
@@ -858,6 +878,7 @@ static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     TCP_DEBUG_ENTER;
     if (tcb->pkt_retransmit != NULL) {
+        _gnrc_tcp_congure_timeout(tcb);
         _gnrc_tcp_pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
         _gnrc_tcp_pkt_send(tcb, tcb->pkt_retransmit, 0, true);
     }
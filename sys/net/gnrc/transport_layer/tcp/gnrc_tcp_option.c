@@ -17,6 +17,7 @@
  * @}
  */
 #include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_fsm.h"
 #include "include/gnrc_tcp_option.h"
 
 #define ENABLE_DEBUG 0
@@ -25,8 +26,18 @@
 int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
     TCP_DEBUG_ENTER;
+    /* Window scale and SACK are negotiated on the SYN of a connection attempt */
+    uint16_t off_ctl = byteorder_ntohs(hdr->off_ctl);
+    bool syn = (off_ctl & MSK_SYN) &&
+               ((tcb->state == FSM_STATE_LISTEN) || (tcb->state == FSM_STATE_SYN_SENT));
+    if (syn) {
+        tcb->status &= ~(STATUS_WND_SCALE | STATUS_SACK);
+        tcb->snd_wnd_scale = 0;
+        tcb->rcv_wnd_scale = 0;
+    }
+
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t offset = GET_OFFSET(off_ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         TCP_DEBUG_LEAVE;
         return 0;
@@ -64,6 +75,48 @@ int _gnrc_tcp_option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                 tcb->mss = (option->value[0] << 8) | option->value[1];
                 break;
 
+            case TCP_OPTION_KIND_WS:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_WS) {
+                    TCP_DEBUG_ERROR("Invalid WS option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("WS option found.");
+                if ((CONFIG_GNRC_TCP_WND_SCALE > 0) && syn) {
+                    /* RFC 7323, section 2.3: shift counts above 14 are treated as 14 */
+                    tcb->snd_wnd_scale = (option->value[0] < 14) ? option->value[0] : 14;
+                    tcb->rcv_wnd_scale = CONFIG_GNRC_TCP_WND_SCALE;
+                    tcb->status |= STATUS_WND_SCALE;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+                    TCP_DEBUG_ERROR("Invalid SACK permitted option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                TCP_DEBUG_INFO("SACK permitted option found.");
+                if (CONFIG_GNRC_TCP_SACK_EN && syn) {
+                    tcb->status |= STATUS_SACK;
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < (TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK) ||
+                    ((option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK)) {
+                    TCP_DEBUG_ERROR("Invalid SACK option length.");
+                    TCP_DEBUG_LEAVE;
+                    return -1;
+                }
+                /* Only a single segment is in flight at any time, so selective
+                 * acknowledgements carry nothing beyond the cumulative ACK */
+                TCP_DEBUG_INFO("SACK option found.");
+                break;
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     TCP_DEBUG_INFO("Valid, unsupported option found.");
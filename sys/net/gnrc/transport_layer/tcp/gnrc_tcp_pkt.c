@@ -28,6 +28,7 @@
 #include "include/gnrc_tcp_eventloop.h"
 #include "include/gnrc_tcp_option.h"
 #include "include/gnrc_tcp_pkt.h"
+#include "include/gnrc_tcp_reass.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -155,6 +156,14 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     gnrc_pktsnip_t *tcp_snp = NULL;
     tcp_hdr_t tcp_hdr;
     uint8_t offset = TCP_HDR_OFFSET_MIN;
+    uint32_t wnd = tcb->rcv_wnd;
+    uint32_t sack[2 * GNRC_TCP_REASS_SACK_BLOCKS_MAX];
+    unsigned sack_blocks = 0;
+    /* Window scale and SACK permitted are sent on a SYN-ACK only if the peer offered them */
+    bool add_ws = (CONFIG_GNRC_TCP_WND_SCALE > 0) &&
+                  (!(ctl & MSK_ACK) || (tcb->status & STATUS_WND_SCALE));
+    bool add_sack_perm = CONFIG_GNRC_TCP_SACK_EN &&
+                         (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK));
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -173,13 +182,24 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
+    /* The window field of a SYN is never scaled (RFC 7323, section 2.2) */
+    if (!(ctl & MSK_SYN)) {
+        wnd >>= tcb->rcv_wnd_scale;
+    }
+    tcp_hdr.window = byteorder_htons((wnd < UINT16_MAX) ? wnd : UINT16_MAX);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
     /* Calculate option field size. */
-    /* Add MSS option if SYN is sent */
+    /* Add MSS and, if negotiated, window scale and SACK permitted options if SYN is sent */
     if (ctl & MSK_SYN) {
-        offset += 1;
+        offset += 1 + add_ws + add_sack_perm;
+    }
+    /* Add SACK option if out-of-order data is queued */
+    else if ((ctl & MSK_ACK) && (tcb->status & STATUS_SACK)) {
+        sack_blocks = _gnrc_tcp_reass_sack_blocks(tcb, sack, GNRC_TCP_REASS_SACK_BLOCKS_MAX);
+        if (sack_blocks > 0) {
+            offset += 1 + (2 * sack_blocks);
+        }
     }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(
@@ -217,9 +237,38 @@ int _gnrc_tcp_pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt,
                     _gnrc_tcp_option_build_mss(CONFIG_GNRC_TCP_MSS));
 
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+
+                if (add_ws) {
+                    network_uint32_t ws_option = byteorder_htonl(
+                        _gnrc_tcp_option_build_ws(CONFIG_GNRC_TCP_WND_SCALE));
+
+                    memcpy(opt_ptr, &ws_option, sizeof(ws_option));
+                    opt_ptr += sizeof(ws_option);
+                }
+                if (add_sack_perm) {
+                    network_uint32_t sack_perm_option = byteorder_htonl(
+                        _gnrc_tcp_option_build_sack_perm());
+
+                    memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                    opt_ptr += sizeof(sack_perm_option);
+                }
+            }
+            /* Add SACK option: two NOPs, kind, length and the block edges */
+            else if (sack_blocks > 0) {
+                opt_ptr[0] = TCP_OPTION_KIND_NOP;
+                opt_ptr[1] = TCP_OPTION_KIND_NOP;
+                opt_ptr[2] = TCP_OPTION_KIND_SACK;
+                opt_ptr[3] = TCP_OPTION_LENGTH_MIN + (sack_blocks * TCP_OPTION_LENGTH_SACK_BLOCK);
+                opt_ptr += sizeof(network_uint32_t);
+
+                for (unsigned i = 0; i < (2 * sack_blocks); i++) {
+                    network_uint32_t edge = byteorder_htonl(sack[i]);
+
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    opt_ptr += sizeof(edge);
+                }
             }
-            /* Increase opt_ptr and decrease opt_left, if other options are added */
-            /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
     }
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/reass.h
+ * @}
+ */
+
+#include <string.h>
+#include "net/gnrc.h"
+#include "net/tcp.h"
+#include "include/gnrc_tcp_common.h"
+#include "include/gnrc_tcp_pkt.h"
+#include "include/gnrc_tcp_reass.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define REASS_SIZE  (CONFIG_GNRC_TCP_REASS_QUEUE_SIZE)
+
+/**
+ * @brief Copies payload of @p pkt from tcb->rcv_nxt on into the receive buffer.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     pkt       Packet to copy from.
+ * @param[in]     seg_seq   Sequence number of @p pkt, not after tcb->rcv_nxt.
+ */
+static void _copy(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seg_seq)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UNDEF);
+    uint32_t skip = tcb->rcv_nxt - seg_seq;
+
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (skip >= snp->size) {
+            skip -= snp->size;
+        }
+        else {
+            unsigned len = snp->size - skip;
+            unsigned added = ringbuffer_add(&(tcb->rcv_buf),
+                                            (char *)snp->data + skip, len);
+
+            tcb->rcv_nxt += added;
+            skip = 0;
+            if (added < len) {
+                /* Receive buffer is full */
+                break;
+            }
+        }
+        snp = snp->next;
+    }
+}
+
+#if REASS_SIZE > 0
+static uint32_t _seq(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *snp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP);
+
+    return byteorder_ntohl(((tcp_hdr_t *)snp->data)->seq_num);
+}
+
+static unsigned _num(const gnrc_tcp_tcb_t *tcb)
+{
+    unsigned num = 0;
+
+    while ((num < REASS_SIZE) && (tcb->reass[num] != NULL)) {
+        num++;
+    }
+    return num;
+}
+
+static void _keep(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seg_seq,
+                  uint32_t pay_len)
+{
+    unsigned num = _num(tcb);
+    unsigned i;
+
+    for (i = 0; i < num; i++) {
+        uint32_t seq = _seq(tcb->reass[i]);
+
+        if (seq == seg_seq) {
+            if (_gnrc_tcp_pkt_get_pay_len(tcb->reass[i]) >= pay_len) {
+                TCP_DEBUG_INFO("Segment already kept.");
+                return;
+            }
+            /* Replace with the longer segment */
+            gnrc_pktbuf_release(tcb->reass[i]);
+            gnrc_pktbuf_hold(pkt, 1);
+            tcb->reass[i] = pkt;
+            tcb->reass_last = seg_seq;
+            return;
+        }
+        if (LSS_32_BIT(seg_seq, seq)) {
+            break;
+        }
+    }
+    if (num == REASS_SIZE) {
+        if (i == num) {
+            TCP_DEBUG_INFO("Reassembly queue is full.");
+            return;
+        }
+        /* Make room by dropping the segment furthest ahead */
+        gnrc_pktbuf_release(tcb->reass[--num]);
+    }
+    memmove(&tcb->reass[i + 1], &tcb->reass[i], (num - i) * sizeof(tcb->reass[0]));
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->reass[i] = pkt;
+    tcb->reass_last = seg_seq;
+}
+
+static void _drain(gnrc_tcp_tcb_t *tcb)
+{
+    while (tcb->reass[0] != NULL) {
+        gnrc_pktsnip_t *pkt = tcb->reass[0];
+        uint32_t seq = _seq(pkt);
+
+        if (LSS_32_BIT(tcb->rcv_nxt, seq)) {
+            break;
+        }
+        if (LSS_32_BIT(tcb->rcv_nxt, seq + _gnrc_tcp_pkt_get_pay_len(pkt))) {
+            _copy(tcb, pkt, seq);
+        }
+        gnrc_pktbuf_release(pkt);
+        memmove(&tcb->reass[0], &tcb->reass[1],
+                (REASS_SIZE - 1) * sizeof(tcb->reass[0]));
+        tcb->reass[REASS_SIZE - 1] = NULL;
+    }
+}
+#endif
+
+void _gnrc_tcp_reass_recv(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          uint32_t seg_seq, uint32_t pay_len)
+{
+    TCP_DEBUG_ENTER;
+    if (LEQ_32_BIT(seg_seq, tcb->rcv_nxt) &&
+        LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+        _copy(tcb, pkt, seg_seq);
+#if REASS_SIZE > 0
+        _drain(tcb);
+#endif
+        /* Shrink receive window */
+        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+        /* Notify owner because new data is available */
+        tcb->status |= STATUS_NOTIFY_USER;
+    }
+#if REASS_SIZE > 0
+    else if (LSS_32_BIT(tcb->rcv_nxt, seg_seq)) {
+        _keep(tcb, pkt, seg_seq, pay_len);
+    }
+#endif
+    TCP_DEBUG_LEAVE;
+}
+
+void _gnrc_tcp_reass_clear(gnrc_tcp_tcb_t *tcb)
+{
+#if REASS_SIZE > 0
+    for (unsigned i = 0; i < REASS_SIZE; i++) {
+        if (tcb->reass[i] != NULL) {
+            gnrc_pktbuf_release(tcb->reass[i]);
+            tcb->reass[i] = NULL;
+        }
+    }
+#else
+    (void)tcb;
+#endif
+}
+
+unsigned _gnrc_tcp_reass_sack_blocks(const gnrc_tcp_tcb_t *tcb, uint32_t *edges,
+                                     unsigned max)
+{
+    unsigned num = 0;
+
+#if REASS_SIZE > 0
+    unsigned last = 0;
+
+    for (unsigned i = 0; (i < REASS_SIZE) && (tcb->reass[i] != NULL); i++) {
+        gnrc_pktsnip_t *pkt = tcb->reass[i];
+        uint32_t left = _seq(pkt);
+        uint32_t right = left + _gnrc_tcp_pkt_get_pay_len(pkt);
+
+        if ((num > 0) && LEQ_32_BIT(left, edges[(2 * num) - 1])) {
+            /* Contiguous with or overlapping the previous block */
+            if (LSS_32_BIT(edges[(2 * num) - 1], right)) {
+                edges[(2 * num) - 1] = right;
+            }
+        }
+        else if (num < max) {
+            edges[2 * num] = left;
+            edges[(2 * num) + 1] = right;
+            num++;
+        }
+        else if ((num > 0) && (left == tcb->reass_last)) {
+            /* Out of blocks, but the last segment kept must be reported */
+            edges[(2 * num) - 2] = left;
+            edges[(2 * num) - 1] = right;
+        }
+        else {
+            continue;
+        }
+        if (left == tcb->reass_last) {
+            last = num - 1;
+        }
+    }
+    if (last > 0) {
+        /* Report the block of the last segment kept first */
+        uint32_t tmp[2] = { edges[0], edges[1] };
+
+        edges[0] = edges[2 * last];
+        edges[1] = edges[(2 * last) + 1];
+        edges[2 * last] = tmp[0];
+        edges[(2 * last) + 1] = tmp[1];
+    }
+#else
+    (void)tcb;
+    (void)edges;
+    (void)max;
+#endif
+    return num;
+}
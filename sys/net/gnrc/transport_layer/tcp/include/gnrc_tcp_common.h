@@ -47,6 +47,8 @@ extern "C" {
 #define STATUS_NOTIFY_USER    (1 << 2) /**< Internal: Status bitmask NOTIFY_USER */
 #define STATUS_ACCEPTED       (1 << 3) /**< Internal: Status bitmask ACCEPTED */
 #define STATUS_LOCKED         (1 << 4) /**< Internal: Status bitmask LOCKED */
+#define STATUS_WND_SCALE      (1 << 5) /**< Internal: Status bitmask peer offered WND_SCALE */
+#define STATUS_SACK           (1 << 6) /**< Internal: Status bitmask peer permitted SACK */
 /** @} */
 
 /**
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Congestion control of GNRC TCP via @ref sys_congure_reno
+ *
+ * All functions are no-ops without the `gnrc_tcp_congure_reno` module.
+ */
+
+#ifndef GNRC_TCP_CONGURE_H
+#define GNRC_TCP_CONGURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(MODULE_GNRC_TCP_CONGURE_RENO) || defined(DOXYGEN)
+/**
+ * @brief Initializes congestion control of a connection.
+ *
+ * @param[in,out] tcb   TCB of a connection that just got established.
+ */
+void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Get number of bytes the congestion window allows to be sent.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of bytes that may be sent.
+ */
+size_t _gnrc_tcp_congure_usable_wnd(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Reports a new data segment to congestion control.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     size  Payload size of the segment.
+ */
+void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, size_t size);
+
+/**
+ * @brief Reports a received acknowledgment to congestion control.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     acked     Number of newly acknowledged sequence numbers,
+ *                          0 for a duplicate acknowledgment.
+ * @param[in]     seg_ack   Acknowledgment number of the segment.
+ * @param[in]     pay_len   Payload length of the segment.
+ * @param[in]     seg_wnd   Receive window of the segment.
+ * @param[in]     clean     True, if the segment carries neither SYN nor FIN.
+ */
+void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb, uint32_t acked,
+                             uint32_t seg_ack, uint32_t pay_len,
+                             uint32_t seg_wnd, bool clean);
+
+/**
+ * @brief Reports a retransmission timeout to congestion control.
+ *
+ * Must be called before tcb->pkt_retransmit is sent again.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb);
+#else
+static inline void _gnrc_tcp_congure_init(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static inline size_t _gnrc_tcp_congure_usable_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+    return SIZE_MAX;
+}
+
+static inline void _gnrc_tcp_congure_sent(gnrc_tcp_tcb_t *tcb, size_t size)
+{
+    (void)tcb;
+    (void)size;
+}
+
+static inline void _gnrc_tcp_congure_acked(gnrc_tcp_tcb_t *tcb, uint32_t acked,
+                                           uint32_t seg_ack, uint32_t pay_len,
+                                           uint32_t seg_wnd, bool clean)
+{
+    (void)tcb;
+    (void)acked;
+    (void)seg_ack;
+    (void)pay_len;
+    (void)seg_wnd;
+    (void)clean;
+}
+
+static inline void _gnrc_tcp_congure_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TCP_CONGURE_H */
+/** @} */
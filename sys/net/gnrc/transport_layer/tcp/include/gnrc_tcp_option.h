@@ -42,6 +42,33 @@ static inline uint32_t _gnrc_tcp_option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the Window Scale option, preceded by a NOP.
+ *
+ * @param[in] shift   Window scale shift count that should be set.
+ *
+ * @returns   Window Scale option value.
+ */
+static inline uint32_t _gnrc_tcp_option_build_ws(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_WS << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WS << 8) | shift);
+}
+
+/**
+ * @brief Helper function to build the SACK Permitted option, preceded by two NOPs.
+ *
+ * @returns   SACK Permitted option value.
+ */
+static inline uint32_t _gnrc_tcp_option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) |
+            TCP_OPTION_LENGTH_SACK_PERM);
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
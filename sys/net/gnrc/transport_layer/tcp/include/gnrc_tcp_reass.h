@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Functions for receiving payload and reassembling out-of-order
+ *              segments.
+ *
+ * Out-of-order segments are only kept if
+ * @ref CONFIG_GNRC_TCP_REASS_QUEUE_SIZE is not zero.
+ */
+
+#ifndef GNRC_TCP_REASS_H
+#define GNRC_TCP_REASS_H
+
+#include <stdint.h>
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum number of blocks in a SACK option.
+ */
+#define GNRC_TCP_REASS_SACK_BLOCKS_MAX (4U)
+
+/**
+ * @brief Receives the payload of a segment.
+ *
+ * Payload starting at tcb->rcv_nxt is copied into the receive buffer, followed
+ * by all kept segments that became contiguous with it. Payload after
+ * tcb->rcv_nxt is kept for later, if possible.
+ *
+ * @param[in,out] tcb       TCB holding the connection information.
+ * @param[in]     pkt       Received packet. Gets held if kept.
+ * @param[in]     seg_seq   Sequence number of @p pkt.
+ * @param[in]     pay_len   Payload length of @p pkt.
+ */
+void _gnrc_tcp_reass_recv(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          uint32_t seg_seq, uint32_t pay_len);
+
+/**
+ * @brief Releases all kept out-of-order segments.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _gnrc_tcp_reass_clear(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Get the blocks of kept out-of-order segments for a SACK option.
+ *
+ * The block containing the segment kept last comes first.
+ *
+ * @param[in]  tcb      TCB holding the connection information.
+ * @param[out] edges    Left and right edge of each block.
+ * @param[in]  max      Maximum number of blocks to write to @p edges.
+ *
+ * @returns   Number of blocks written to @p edges.
+ */
+unsigned _gnrc_tcp_reass_sack_blocks(const gnrc_tcp_tcb_t *tcb, uint32_t *edges,
+                                     unsigned max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TCP_REASS_H */
+/** @} */
@@ -228,6 +228,9 @@ static void *_event_loop(void *arg)
     reply.content.value = (uint32_t)-ENOTSUP;
     /* initialize message queue */
     msg_init_queue(msg_queue, GNRC_UDP_MSG_QUEUE_SIZE);
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    gnrc_netapi_batch_accept(&netreg);
+#endif
     /* register UPD at netreg */
     gnrc_netreg_register(GNRC_NETTYPE_UDP, &netreg);
 
@@ -243,6 +246,16 @@ static void *_event_loop(void *arg)
                 DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
                 _send(msg.content.ptr);
                 break;
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV_BATCH\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _receive);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND_BATCH:
+                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND_BATCH\n");
+                gnrc_netapi_batch_handle(msg.content.ptr, _send);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
             case GNRC_NETAPI_MSG_TYPE_GET:
                 msg_reply(&msg, &reply);
@@ -303,6 +303,26 @@ static const uint8_t *_get_decryption_key(const ieee802154_sec_context_t *ctx,
     return ctx->cipher.context.context;
 }
 
+/**
+ * @brief   Number of counter blocks encrypted with a single ECB call in CTR
+ */
+#define IEEE802154_SEC_CTR_BLOCKS   (4U)
+
+/**
+ * @brief   Perform ECB on @p nblocks blocks with the device or the fallback
+ */
+static void _ecb_blocks(ieee802154_sec_context_t *ctx,
+                        uint8_t *cipher, const uint8_t *plain,
+                        uint8_t nblocks)
+{
+    if (ctx->dev.cipher_ops->ecb) {
+        ctx->dev.cipher_ops->ecb(&ctx->dev, cipher, plain, nblocks);
+    }
+    else {
+        _sec_ecb(&ctx->dev, cipher, plain, nblocks);
+    }
+}
+
 /**
  * @brief   Perform ECB on one block of data and and add padding if necessary
  */
@@ -311,12 +331,7 @@ static uint8_t _ecb(ieee802154_sec_context_t *ctx,
                     const uint8_t *Ai, uint16_t size)
 {
     uint16_t s = _min(IEEE802154_SEC_BLOCK_SIZE, size);
-    if (ctx->dev.cipher_ops->ecb) {
-        ctx->dev.cipher_ops->ecb(&ctx->dev, tmp2, Ai, 1);
-    }
-    else {
-        _sec_ecb(&ctx->dev, tmp2, Ai, 1);
-    }
+    _ecb_blocks(ctx, tmp2, Ai, 1);
     memcpy(tmp1, data, s);
     memset(tmp1 + s, 0, IEEE802154_SEC_BLOCK_SIZE - s);
     _memxor(tmp1, tmp2, IEEE802154_SEC_BLOCK_SIZE);
@@ -369,13 +384,25 @@ static void _ctr(ieee802154_sec_context_t *ctx,
                  ieee802154_sec_ccm_block_t *A0,
                  const void *m, uint16_t m_len)
 {
-    uint8_t tmp1[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
-    uint8_t tmp2[IEEE802154_SEC_BLOCK_SIZE] = { 0 };
+    uint8_t Ai[IEEE802154_SEC_CTR_BLOCKS * IEEE802154_SEC_BLOCK_SIZE];
+    uint8_t stream[IEEE802154_SEC_CTR_BLOCKS * IEEE802154_SEC_BLOCK_SIZE];
 
+    /* the key stream for several blocks is computed with one ECB call */
     for (uint16_t off = 0; off < m_len;) {
-        _advance_ctr_Ai(A0);
-        off += _ecb(ctx, tmp1, tmp2,
-                    &(((uint8_t *)m)[off]), (uint8_t *)A0, m_len - off);
+        uint8_t nblocks = 0;
+        uint16_t s;
+
+        do {
+            _advance_ctr_Ai(A0);
+            memcpy(&Ai[nblocks * IEEE802154_SEC_BLOCK_SIZE], A0,
+                   IEEE802154_SEC_BLOCK_SIZE);
+            nblocks++;
+        } while ((nblocks < IEEE802154_SEC_CTR_BLOCKS) &&
+                 (off + nblocks * IEEE802154_SEC_BLOCK_SIZE < m_len));
+        _ecb_blocks(ctx, stream, Ai, nblocks);
+        s = _min(nblocks * IEEE802154_SEC_BLOCK_SIZE, m_len - off);
+        _memxor(&(((uint8_t *)m)[off]), stream, s);
+        off += s;
     }
 }
 
@@ -37,6 +37,8 @@
 #include "net/fib.h"
 #include "net/fib/table.h"
 
+#include "fib_radix.h"
+
 #ifdef MODULE_IPV6_ADDR
 #include "net/ipv6/addr.h"
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
@@ -65,6 +67,35 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief radix tree variant of fib_find_entry(), removes expired entries
+ *        it hits on the way
+ */
+static int fib_find_entry_radix(fib_table_t *table, uint8_t *dst,
+                                size_t dst_size, uint64_t now,
+                                fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    fib_entry_t *entry;
+    bool exact;
+
+    while ((entry = fib_radix_get_match(table, dst, dst_size, &exact))) {
+        if ((entry->lifetime == FIB_LIFETIME_NO_EXPIRE) ||
+            (entry->lifetime >= now)) {
+            DEBUG("[fib_find_entry_radix] found %s match on interface %d\n",
+                  exact ? "exact" : "prefix", entry->iface_id);
+            entry_arr[0] = entry;
+            *entry_arr_size = 1;
+            return exact;
+        }
+        fib_remove(table, entry);
+    }
+
+    *entry_arr_size = 0;
+    return -EHOSTUNREACH;
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -83,6 +114,11 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
     uint64_t now = xtimer_now_usec64();
 
+    if (IS_USED(MODULE_FIB_RADIX)) {
+        return fib_find_entry_radix(table, dst, dst_size, now,
+                                    entry_arr, entry_arr_size);
+    }
+
     size_t count = 0;
     size_t prefix_size = 0;
     size_t match_size = dst_size << 3;
@@ -246,7 +282,18 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t
                             next_hop_flags, uint32_t lifetime)
 {
+    uint64_t now = xtimer_now_usec64();
+
     for (size_t i = 0; i < table->size; ++i) {
+        /* the radix tree look-up does not visit all entries, so expired ones
+         * are only freed here */
+        if (IS_USED(MODULE_FIB_RADIX) &&
+            (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) &&
+            (table->data.entries[i].lifetime != 0) &&
+            (table->data.entries[i].lifetime < now)) {
+            fib_remove(table, &table->data.entries[i]);
+        }
+
         if (table->data.entries[i].lifetime == 0) {
 
             table->data.entries[i].global = universal_address_add(dst, dst_size);
@@ -268,6 +315,10 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+                if (IS_USED(MODULE_FIB_RADIX)) {
+                    fib_radix_add(table, &table->data.entries[i]);
+                }
+
                 return 0;
             }
         }
@@ -279,12 +330,17 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+    if (IS_USED(MODULE_FIB_RADIX)) {
+        fib_radix_del(table, entry);
+    }
+
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -457,7 +513,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +533,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -597,6 +653,9 @@ void fib_init(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    if (IS_USED(MODULE_FIB_RADIX)) {
+        fib_radix_init(table);
+    }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -622,6 +681,9 @@ void fib_deinit(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+    if (IS_USED(MODULE_FIB_RADIX)) {
+        fib_radix_init(table);
+    }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <kernel_defines.h>
+
+#include "bitarithm.h"
+#include "net/fib.h"
+#include "net/fib/table.h"
+
+#include "fib_radix.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if IS_USED(MODULE_FIB_RADIX)
+
+static inline unsigned _byte(const uint8_t *addr, size_t size, unsigned i)
+{
+    /* the address size is prepended to the key, so addresses of different
+     * sizes end up in different sub-trees */
+    return (i == 0) ? (uint8_t)size : addr[i - 1];
+}
+
+static inline unsigned _bit(const uint8_t *addr, size_t size, unsigned pos)
+{
+    return (_byte(addr, size, pos / 8) >> (7 - (pos % 8))) & 1;
+}
+
+/* returns the first bit in [from, to) in which the keys differ, or to */
+static unsigned _diff(const uint8_t *a, size_t a_size,
+                      const uint8_t *b, size_t b_size,
+                      unsigned from, unsigned to)
+{
+    for (unsigned i = from / 8; (i * 8) < to; i++) {
+        unsigned x = _byte(a, a_size, i) ^ _byte(b, b_size, i);
+
+        if (i == (from / 8)) {
+            x &= 0xff >> (from % 8);
+        }
+        if (x) {
+            unsigned pos = (i * 8) + 7 - bitarithm_msb(x);
+
+            return (pos < to) ? pos : to;
+        }
+    }
+    return to;
+}
+
+static unsigned _len(const fib_entry_t *entry)
+{
+    const universal_address_container_t *global = entry->global;
+    unsigned bits = global->address_size * 8;
+    unsigned pfx_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                       >> FIB_FLAG_NET_PREFIX_SHIFT;
+    unsigned i;
+
+    for (i = 0; (i < global->address_size) && (global->address[i] == 0); i++) {}
+    if (i == global->address_size) {
+        /* default route */
+        return 8;
+    }
+    if ((pfx_len == 0) || (pfx_len > bits)) {
+        pfx_len = bits;
+    }
+    return 8 + pfx_len;
+}
+
+/* any entry in the sub-tree of node, all of them share node->len bits */
+static const universal_address_container_t *_key(const fib_radix_node_t *node)
+{
+    while (node->entry == NULL) {
+        /* glue nodes always have two children */
+        node = node->child[0];
+    }
+    return node->entry->global;
+}
+
+static fib_radix_node_t **_link(fib_table_t *table, fib_radix_node_t *node)
+{
+    fib_radix_node_t *parent = node->parent;
+
+    if (parent == NULL) {
+        return &table->radix_root;
+    }
+    return (parent->child[0] == node) ? &parent->child[0] : &parent->child[1];
+}
+
+static fib_radix_node_t *_glue_new(fib_table_t *table, fib_radix_node_t *parent,
+                                   unsigned len)
+{
+    fib_radix_node_t *glue = table->radix_free;
+
+    /* there are never more glue nodes than entries in the tree */
+    assert(glue != NULL);
+    table->radix_free = glue->parent;
+    memset(glue, 0, sizeof(*glue));
+    glue->parent = parent;
+    glue->len = len;
+    return glue;
+}
+
+static void _glue_free(fib_table_t *table, fib_radix_node_t *glue)
+{
+    glue->parent = table->radix_free;
+    table->radix_free = glue;
+}
+
+void fib_radix_init(fib_table_t *table)
+{
+    table->radix_root = NULL;
+    table->radix_free = NULL;
+    if (table->table_type != FIB_TABLE_TYPE_SH) {
+        return;
+    }
+    for (size_t i = 0; i < table->size; i++) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        memset(entry->radix, 0, sizeof(entry->radix));
+        _glue_free(table, &entry->radix[1]);
+    }
+}
+
+void fib_radix_add(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_radix_node_t *node = &entry->radix[0];
+    fib_radix_node_t **link = &table->radix_root;
+    fib_radix_node_t *parent = NULL, *cur = table->radix_root;
+    const universal_address_container_t *key = entry->global;
+    const universal_address_container_t *other;
+    unsigned len = _len(entry), d;
+
+    assert(node->len == 0);
+    memset(node, 0, sizeof(*node));
+    node->entry = entry;
+    node->len = len;
+    if (cur == NULL) {
+        table->radix_root = node;
+        return;
+    }
+    /* find where the key leaves the tree ... */
+    while ((cur->len < len) &&
+           (cur->child[_bit(key->address, key->address_size, cur->len)] != NULL)) {
+        cur = cur->child[_bit(key->address, key->address_size, cur->len)];
+    }
+    other = _key(cur);
+    d = _diff(other->address, other->address_size,
+              key->address, key->address_size, 0,
+              (cur->len < len) ? cur->len : len);
+    /* ... and insert it right before the first node beyond that bit */
+    while ((*link != NULL) && ((*link)->len <= d) && ((*link)->len < len)) {
+        parent = *link;
+        link = &parent->child[_bit(key->address, key->address_size,
+                                   parent->len)];
+    }
+    cur = *link;
+    node->parent = parent;
+    if (cur == NULL) {
+        *link = node;
+    }
+    else if ((cur->len == len) && (d == len)) {
+        if (cur->entry != NULL) {
+            /* same prefix as another entry */
+            DEBUG("fib_radix: %p shares prefix with %p\n", (void *)entry,
+                  (void *)cur->entry);
+            node->parent = cur;
+            node->next = cur->next;
+            cur->next = node;
+            return;
+        }
+        node->child[0] = cur->child[0];
+        node->child[1] = cur->child[1];
+        node->child[0]->parent = node;
+        node->child[1]->parent = node;
+        *link = node;
+        _glue_free(table, cur);
+    }
+    else if (d == len) {
+        /* the entry is a prefix of cur */
+        other = _key(cur);
+        node->child[_bit(other->address, other->address_size, len)] = cur;
+        cur->parent = node;
+        *link = node;
+    }
+    else {
+        fib_radix_node_t *glue = _glue_new(table, parent, d);
+        unsigned bit = _bit(key->address, key->address_size, d);
+
+        glue->child[bit] = node;
+        glue->child[!bit] = cur;
+        node->parent = glue;
+        cur->parent = glue;
+        *link = glue;
+    }
+}
+
+void fib_radix_del(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_radix_node_t *node = &entry->radix[0];
+    fib_radix_node_t *parent = node->parent;
+    fib_radix_node_t **link;
+
+    if (node->len == 0) {
+        return;
+    }
+    if ((parent != NULL) && (parent->child[0] != node) &&
+        (parent->child[1] != node)) {
+        /* only chained to an entry with the same prefix */
+        fib_radix_node_t *prev = parent;
+
+        while (prev->next != node) {
+            prev = prev->next;
+        }
+        prev->next = node->next;
+        goto out;
+    }
+    link = _link(table, node);
+    if (node->next != NULL) {
+        /* hand the position over to the next entry with the same prefix */
+        fib_radix_node_t *next = node->next;
+
+        next->parent = parent;
+        next->child[0] = node->child[0];
+        next->child[1] = node->child[1];
+        for (unsigned i = 0; i < 2; i++) {
+            if (next->child[i] != NULL) {
+                next->child[i]->parent = next;
+            }
+        }
+        for (fib_radix_node_t *n = next->next; n != NULL; n = n->next) {
+            n->parent = next;
+        }
+        *link = next;
+    }
+    else if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        fib_radix_node_t *glue = _glue_new(table, parent, node->len);
+
+        glue->child[0] = node->child[0];
+        glue->child[1] = node->child[1];
+        glue->child[0]->parent = glue;
+        glue->child[1]->parent = glue;
+        *link = glue;
+    }
+    else {
+        fib_radix_node_t *child = (node->child[0] != NULL) ? node->child[0]
+                                                           : node->child[1];
+
+        *link = child;
+        if (child != NULL) {
+            child->parent = parent;
+        }
+        else if ((parent != NULL) && (parent->entry == NULL)) {
+            /* a glue node with a single child is superfluous */
+            child = (parent->child[0] != NULL) ? parent->child[0]
+                                               : parent->child[1];
+            *_link(table, parent) = child;
+            child->parent = parent->parent;
+            _glue_free(table, parent);
+        }
+    }
+out:
+    memset(node, 0, sizeof(*node));
+}
+
+fib_entry_t *fib_radix_get_match(fib_table_t *table, const uint8_t *dst,
+                                 size_t dst_size, bool *exact)
+{
+    const unsigned bits = 8 + (dst_size * 8);
+    const fib_radix_node_t *node = table->radix_root;
+    fib_entry_t *res = NULL;
+    unsigned checked = 0;
+
+    *exact = false;
+    while (node != NULL) {
+        if (node->entry != NULL) {
+            const universal_address_container_t *key = node->entry->global;
+
+            /* glue nodes are skipped without looking at their bits, so
+             * compare everything from the last matching entry on */
+            if (_diff(key->address, key->address_size, dst, dst_size,
+                      checked, node->len) < node->len) {
+                break;
+            }
+            checked = node->len;
+            for (const fib_radix_node_t *n = node; n != NULL; n = n->next) {
+                key = n->entry->global;
+                if (_diff(key->address, key->address_size, dst, dst_size,
+                          checked, bits) == bits) {
+                    *exact = true;
+                    return n->entry;
+                }
+            }
+            res = node->entry;
+        }
+        if (node->len >= bits) {
+            break;
+        }
+        node = node->child[_bit(dst, dst_size, node->len)];
+    }
+    return res;
+}
+#else   /* MODULE_FIB_RADIX */
+typedef int dont_be_pedantic;
+#endif  /* MODULE_FIB_RADIX */
+
+/** @} */
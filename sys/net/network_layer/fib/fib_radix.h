@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  net_fib
+ * @internal
+ * @{
+ *
+ * @file
+ * @brief       Radix tree over the entries of a single hop FIB table
+ *
+ * Keys are the address size (one byte) followed by the destination address
+ * of an entry. An entry covers the address size and the first bits of its
+ * destination given by @ref FIB_FLAG_NET_PREFIX_MASK, all bits if no prefix
+ * length is set and none if the destination is all zero (default route).
+ * Entries with the same address size and prefix share a tree node.
+ *
+ * All functions must be called with fib_table_t::mtx_access held.
+ *
+ * @note    Only available with the `fib_radix` module.
+ */
+#ifndef FIB_RADIX_H
+#define FIB_RADIX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "net/fib/table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Resets the radix tree of @p table
+ *
+ * @param[in,out] table the FIB table
+ */
+void fib_radix_init(fib_table_t *table);
+
+/**
+ * @brief   Adds @p entry to the radix tree of @p table
+ *
+ * @pre     fib_entry_t::global of @p entry is set.
+ *
+ * @param[in,out] table the FIB table
+ * @param[in,out] entry an entry of @p table that is not in the tree yet
+ */
+void fib_radix_add(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief   Removes @p entry from the radix tree of @p table
+ *
+ * Does nothing if @p entry is not in the tree.
+ *
+ * @param[in,out] table the FIB table
+ * @param[in,out] entry an entry of @p table
+ */
+void fib_radix_del(fib_table_t *table, fib_entry_t *entry);
+
+/**
+ * @brief   Finds the entry for @p dst
+ *
+ * An entry with exactly @p dst as destination is preferred over any prefix,
+ * as in the linear scan of the FIB. Lifetimes are not checked.
+ *
+ * @param[in] table     the FIB table
+ * @param[in] dst       the destination address
+ * @param[in] dst_size  the size of @p dst in bytes
+ * @param[out] exact    true, if the destination of the result is @p dst
+ *
+ * @return  the entry with the longest prefix covering @p dst
+ * @return  NULL, if no entry covers @p dst
+ */
+fib_entry_t *fib_radix_get_match(fib_table_t *table, const uint8_t *dst,
+                                 size_t dst_size, bool *exact);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIB_RADIX_H */
+/** @} */
@@ -494,6 +494,27 @@ int _unlink_r(struct _reent *r, const char *path)
     return 0;
 }
 
+/**
+ * @brief Synchronize a file with the storage device
+ *
+ * This is a wrapper around @c vfs_fsync
+ *
+ * @param[in]  fd       fd of the file
+ *
+ * @return 0 on success
+ * @return -1 on error, @c errno set to a constant from errno.h to indicate the error
+ */
+int fsync(int fd)
+{
+    int res = vfs_fsync(fd);
+    if (res < 0) {
+        /* vfs returns negative error codes */
+        errno = -res;
+        return -1;
+    }
+    return 0;
+}
+
 #else /* MODULE_VFS */
 
 /* Fallback stdio_uart wrappers for when VFS is not used, does not allow any
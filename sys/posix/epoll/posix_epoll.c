@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @file
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <sys/epoll.h>
+
+#include "irq.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#if IS_USED(MODULE_POSIX_SOCKETS)
+extern bool posix_socket_is(int fd);
+extern uint32_t posix_socket_poll(int fd);
+extern void **posix_socket_epoll(int fd);
+#else   /* MODULE_POSIX_SOCKETS */
+static inline bool posix_socket_is(int fd)
+{
+    (void)fd;
+    return false;
+}
+
+static inline uint32_t posix_socket_poll(int fd)
+{
+    (void)fd;
+    return 0;
+}
+
+static inline void **posix_socket_epoll(int fd)
+{
+    (void)fd;
+    return NULL;
+}
+#endif  /* IS_USED(MODULE_POSIX_SOCKETS) */
+
+/* events that are reported regardless of the interest set */
+#define _ALWAYS_EVENTS      (EPOLLERR | EPOLLHUP)
+#define _INPUT_FLAGS        (EPOLLET | EPOLLONESHOT)
+
+typedef struct _epoll _epoll_t;
+
+/**
+ * @brief   A file descriptor registered with an epoll instance
+ */
+typedef struct _item {
+    struct _item *next;         /**< next item registered for the same fd */
+    struct _item *ready_next;   /**< next item in the ready list */
+    struct _item **list;        /**< list of the fd, NULL if item is unused */
+    _epoll_t *ep;               /**< epoll instance of the item */
+    int fd;                     /**< registered file descriptor */
+    uint32_t events;            /**< events of interest and input flags */
+    uint32_t revents;           /**< pending events, != 0 if in ready list */
+    epoll_data_t data;          /**< user data */
+} _item_t;
+
+struct _epoll {
+    _item_t items[CONFIG_POSIX_EPOLL_ITEMS_NUMOF];
+    _item_t *ready;             /**< head of the ready list */
+    _item_t *ready_tail;        /**< tail of the ready list */
+    thread_t *waiter;           /**< thread waiting in epoll_wait() */
+    bool used;                  /**< instance is in use */
+};
+
+static int _epoll_close(vfs_file_t *filp);
+
+static const vfs_file_ops_t _epoll_ops = {
+    .close = _epoll_close,
+};
+
+static _epoll_t _epolls[CONFIG_POSIX_EPOLL_NUMOF];
+
+static _epoll_t *_get_epoll(int epfd)
+{
+    const vfs_file_t *file = vfs_file_get(epfd);
+
+    if (file == NULL) {
+        errno = EBADF;
+        return NULL;
+    }
+    if (file->f_op != &_epoll_ops) {
+        errno = EINVAL;
+        return NULL;
+    }
+    return file->private_data.ptr;
+}
+
+/* must be called with interrupts disabled */
+static void _ready_push(_epoll_t *ep, _item_t *item, uint32_t revents)
+{
+    if (item->revents == 0) {
+        item->ready_next = NULL;
+        if (ep->ready_tail == NULL) {
+            ep->ready = item;
+        }
+        else {
+            ep->ready_tail->ready_next = item;
+        }
+        ep->ready_tail = item;
+    }
+    item->revents |= revents;
+}
+
+/* must be called with interrupts disabled */
+static void _ready_remove(_epoll_t *ep, _item_t *item)
+{
+    _item_t *prev = NULL;
+
+    if (item->revents == 0) {
+        return;
+    }
+    for (_item_t *i = ep->ready; i != NULL; prev = i, i = i->ready_next) {
+        if (i == item) {
+            if (prev == NULL) {
+                ep->ready = item->ready_next;
+            }
+            else {
+                prev->ready_next = item->ready_next;
+            }
+            if (ep->ready_tail == item) {
+                ep->ready_tail = prev;
+            }
+            break;
+        }
+    }
+    item->revents = 0;
+}
+
+/* must be called with interrupts disabled */
+static void _unlink(_item_t *item)
+{
+    for (_item_t **i = item->list; *i != NULL; i = &(*i)->next) {
+        if (*i == item) {
+            *i = item->next;
+            break;
+        }
+    }
+    _ready_remove(item->ep, item);
+    item->list = NULL;
+}
+
+static uint32_t _poll(const _item_t *item)
+{
+    /* disabled items (EPOLLONESHOT) have no events of interest left */
+    if ((item->events & ~_INPUT_FLAGS) == 0) {
+        return 0;
+    }
+    /* the state of the socket, e.g. pending connections or a closed
+     * connection, not only the events notified since it was registered */
+    return posix_socket_poll(item->fd) & (item->events | _ALWAYS_EVENTS);
+}
+
+static void _notify(_epoll_t *ep, _item_t *item, uint32_t revents)
+{
+    _ready_push(ep, item, revents);
+    if (ep->waiter != NULL) {
+        thread_flags_set(ep->waiter, POSIX_EPOLL_THREAD_FLAG);
+    }
+}
+
+void posix_epoll_notify(void *items, uint32_t events)
+{
+    unsigned state = irq_disable();
+
+    for (_item_t *item = items; item != NULL; item = item->next) {
+        uint32_t revents = events & (item->events | _ALWAYS_EVENTS);
+
+        /* disabled items (EPOLLONESHOT) have no events of interest left */
+        if ((revents != 0) && ((item->events & ~_INPUT_FLAGS) != 0)) {
+            _notify(item->ep, item, revents);
+        }
+    }
+    irq_restore(state);
+}
+
+void posix_epoll_forget(void **items)
+{
+    unsigned state = irq_disable();
+
+    while (*items != NULL) {
+        _unlink(*items);
+    }
+    irq_restore(state);
+}
+
+static int _epoll_close(vfs_file_t *filp)
+{
+    _epoll_t *ep = filp->private_data.ptr;
+    unsigned state = irq_disable();
+
+    for (unsigned i = 0; i < CONFIG_POSIX_EPOLL_ITEMS_NUMOF; i++) {
+        if (ep->items[i].list != NULL) {
+            _unlink(&ep->items[i]);
+        }
+    }
+    ep->used = false;
+    irq_restore(state);
+    return 0;
+}
+
+int epoll_create1(int flags)
+{
+    if (flags != 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    for (unsigned i = 0; i < CONFIG_POSIX_EPOLL_NUMOF; i++) {
+        _epoll_t *ep = &_epolls[i];
+        unsigned state = irq_disable();
+
+        if (ep->used) {
+            irq_restore(state);
+            continue;
+        }
+        ep->used = true;
+        irq_restore(state);
+        ep->ready = NULL;
+        ep->ready_tail = NULL;
+        ep->waiter = NULL;
+        for (unsigned j = 0; j < CONFIG_POSIX_EPOLL_ITEMS_NUMOF; j++) {
+            ep->items[j].list = NULL;
+        }
+        int fd = vfs_bind(VFS_ANY_FD, O_RDWR, &_epoll_ops, ep);
+        if (fd < 0) {
+            ep->used = false;
+            errno = -fd;
+            return -1;
+        }
+        DEBUG("epoll: created instance %d\n", fd);
+        return fd;
+    }
+    errno = EMFILE;
+    return -1;
+}
+
+static _item_t *_find(_epoll_t *ep, void **items)
+{
+    for (_item_t *item = *items; item != NULL; item = item->next) {
+        if (item->ep == ep) {
+            return item;
+        }
+    }
+    return NULL;
+}
+
+static _item_t *_alloc(_epoll_t *ep)
+{
+    for (unsigned i = 0; i < CONFIG_POSIX_EPOLL_ITEMS_NUMOF; i++) {
+        if (ep->items[i].list == NULL) {
+            return &ep->items[i];
+        }
+    }
+    return NULL;
+}
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+    _epoll_t *ep = _get_epoll(epfd);
+    _item_t *item;
+    void **items;
+    unsigned state;
+
+    if (ep == NULL) {
+        return -1;
+    }
+    if (epfd == fd) {
+        errno = EINVAL;
+        return -1;
+    }
+    if ((op != EPOLL_CTL_DEL) && (event == NULL)) {
+        errno = EFAULT;
+        return -1;
+    }
+    if (vfs_file_get(fd) == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+    if (!posix_socket_is(fd)) {
+        errno = EPERM;
+        return -1;
+    }
+    /* binds the socket implicitly, so it gets notified on receive */
+    if ((items = posix_socket_epoll(fd)) == NULL) {
+        return -1;
+    }
+    state = irq_disable();
+    item = _find(ep, items);
+    switch (op) {
+        case EPOLL_CTL_ADD:
+            if (item != NULL) {
+                irq_restore(state);
+                errno = EEXIST;
+                return -1;
+            }
+            if ((item = _alloc(ep)) == NULL) {
+                irq_restore(state);
+                errno = ENOSPC;
+                return -1;
+            }
+            item->ep = ep;
+            item->fd = fd;
+            item->revents = 0;
+            item->list = (_item_t **)items;
+            item->next = *items;
+            *items = item;
+            break;
+        case EPOLL_CTL_MOD:
+        case EPOLL_CTL_DEL:
+            if (item == NULL) {
+                irq_restore(state);
+                errno = ENOENT;
+                return -1;
+            }
+            if (op == EPOLL_CTL_DEL) {
+                _unlink(item);
+                irq_restore(state);
+                return 0;
+            }
+            _ready_remove(ep, item);
+            break;
+        default:
+            irq_restore(state);
+            errno = EINVAL;
+            return -1;
+    }
+    item->events = event->events;
+    item->data = event->data;
+    /* report readiness the file descriptor already has */
+    uint32_t revents = _poll(item);
+    if (revents != 0) {
+        _notify(ep, item, revents);
+    }
+    irq_restore(state);
+    return 0;
+}
+
+static int _collect(_epoll_t *ep, struct epoll_event *events, int maxevents)
+{
+    unsigned state = irq_disable();
+    _item_t *item = ep->ready;
+    int num = 0;
+
+    while ((item != NULL) && (num < maxevents)) {
+        events[num].events = item->revents;
+        events[num].data = item->data;
+        item = item->ready_next;
+        num++;
+    }
+    /* detach reported items from the ready list */
+    item = ep->ready;
+    for (int i = 0; i < num; i++) {
+        _item_t *next = item->ready_next;
+
+        if (ep->ready_tail == item) {
+            ep->ready_tail = NULL;
+        }
+        ep->ready = next;
+        item->revents = 0;
+        if (item->events & EPOLLONESHOT) {
+            /* disable item until re-armed with EPOLL_CTL_MOD */
+            item->events &= _INPUT_FLAGS;
+        }
+        else if (!(item->events & EPOLLET)) {
+            /* level-triggered: stays in the ready list while still ready */
+            uint32_t revents = _poll(item);
+
+            if (revents != 0) {
+                _ready_push(ep, item, revents);
+            }
+        }
+        item = next;
+    }
+    irq_restore(state);
+    return num;
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+               int timeout)
+{
+    _epoll_t *ep = _get_epoll(epfd);
+    xtimer_t timeout_timer = { .callback = NULL };
+    bool timed_out = false;
+    int num;
+
+    if (ep == NULL) {
+        return -1;
+    }
+    if ((maxevents <= 0) || (events == NULL)) {
+        errno = EINVAL;
+        return -1;
+    }
+    if ((num = _collect(ep, events, maxevents)) > 0) {
+        return num;
+    }
+    if (timeout == 0) {
+        return 0;
+    }
+    ep->waiter = thread_get_active();
+    if (timeout > 0) {
+        uint32_t t = ((unsigned)timeout > (UINT32_MAX / US_PER_MS))
+                   ? UINT32_MAX : ((uint32_t)timeout * US_PER_MS);
+
+        xtimer_set_timeout_flag(&timeout_timer, t);
+    }
+    while (true) {
+        /* drop a stale wake-up, anything notified after is in the list */
+        thread_flags_clear(POSIX_EPOLL_THREAD_FLAG);
+        if (((num = _collect(ep, events, maxevents)) > 0) || timed_out) {
+            break;
+        }
+        timed_out = thread_flags_wait_any(POSIX_EPOLL_THREAD_FLAG |
+                                          THREAD_FLAG_TIMEOUT) &
+                    THREAD_FLAG_TIMEOUT;
+    }
+    ep->waiter = NULL;
+    if (timeout > 0) {
+        xtimer_remove(&timeout_timer);
+        thread_flags_clear(THREAD_FLAG_TIMEOUT);
+    }
+    return num;
+}
+
+/** @} */
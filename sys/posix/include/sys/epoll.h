@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup posix_epoll    POSIX epoll
+ * @ingroup  posix
+ * @brief   Linux-compatible epoll implementation for RIOT
+ *
+ * In contrast to @ref posix_select, which has to check every file descriptor
+ * up to `nfds` on each call and each wake-up, an epoll instance keeps a
+ * registered interest set and a ready list. The ready list is fed directly
+ * from the @ref net_sock_async callbacks of the [sockets](@ref posix_sockets),
+ * so the cost of @ref epoll_wait() only depends on the number of ready file
+ * descriptors.
+ *
+ * Both level-triggered (default) and edge-triggered (@ref EPOLLET) mode as
+ * well as @ref EPOLLONESHOT are supported. A file descriptor that is closed
+ * is removed from all interest sets it is registered in.
+ *
+ * On registration and for level-triggered items after each report, the state
+ * of the socket is checked: a listening TCP socket is readable while
+ * connections wait to be accepted, a TCP connection closed by the peer
+ * reports @ref EPOLLHUP and @ref EPOLLIN until the socket is closed.
+ *
+ * @note    Only one thread may wait on an epoll instance at a time.
+ * @todo    Currently, only [sockets](@ref posix_sockets) are supported
+ * @{
+ *
+ * @file
+ * @brief   epoll types and functions
+ * @see     [epoll(7)](https://man7.org/linux/man-pages/man7/epoll.7.html)
+ */
+
+#ifndef SYS_EPOLL_H
+#define SYS_EPOLL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup  config_posix
+ * @{
+ */
+/**
+ * @brief   Maximum number of epoll instances
+ */
+#ifndef CONFIG_POSIX_EPOLL_NUMOF
+#define CONFIG_POSIX_EPOLL_NUMOF        (1)
+#endif
+
+/**
+ * @brief   Maximum number of file descriptors registered with one epoll
+ *          instance
+ */
+#ifndef CONFIG_POSIX_EPOLL_ITEMS_NUMOF
+#define CONFIG_POSIX_EPOLL_ITEMS_NUMOF  (8)
+#endif
+/** @} */
+
+/**
+ * @brief   @ref core_thread_flags for POSIX epoll
+ */
+#define POSIX_EPOLL_THREAD_FLAG     (1U << 4)
+
+/**
+ * @name    Event types
+ * @{
+ */
+#define EPOLLIN         (0x001U)    /**< data available for reading */
+#define EPOLLOUT        (0x004U)    /**< writing is possible */
+#define EPOLLERR        (0x008U)    /**< error condition, always reported */
+#define EPOLLHUP        (0x010U)    /**< peer hung up, always reported */
+/** @} */
+
+/**
+ * @name    Input flags
+ * @{
+ */
+#define EPOLLONESHOT    (1U << 30)  /**< disable after one event was reported */
+#define EPOLLET         (1U << 31)  /**< edge-triggered notification */
+/** @} */
+
+/**
+ * @name    Operations for @ref epoll_ctl()
+ * @{
+ */
+#define EPOLL_CTL_ADD   (1)         /**< register file descriptor */
+#define EPOLL_CTL_DEL   (2)         /**< deregister file descriptor */
+#define EPOLL_CTL_MOD   (3)         /**< change registered events */
+/** @} */
+
+/**
+ * @brief   User data associated with a registered file descriptor
+ */
+typedef union epoll_data {
+    void *ptr;          /**< pointer */
+    int fd;             /**< file descriptor */
+    uint32_t u32;       /**< 32-bit value */
+    uint64_t u64;       /**< 64-bit value */
+} epoll_data_t;
+
+/**
+ * @brief   Event description
+ */
+struct epoll_event {
+    uint32_t events;    /**< events and input flags */
+    epoll_data_t data;  /**< user data */
+};
+
+/**
+ * @brief   Creates an epoll instance
+ *
+ * @param[in] flags     Must be 0.
+ *
+ * @return  File descriptor of the new epoll instance on success.
+ * @return  -1 on error, `errno` is set to
+ *          - `EINVAL`, if @p flags is not 0.
+ *          - `EMFILE`, if @ref CONFIG_POSIX_EPOLL_NUMOF instances or
+ *            `VFS_MAX_OPEN_FILES` file descriptors are already in use.
+ */
+int epoll_create1(int flags);
+
+/**
+ * @brief   Creates an epoll instance
+ *
+ * @param[in] size      Ignored, but must be greater than 0.
+ *
+ * @return  see @ref epoll_create1()
+ */
+static inline int epoll_create(int size)
+{
+    return (size > 0) ? epoll_create1(0) : epoll_create1(-1);
+}
+
+/**
+ * @brief   Changes the interest set of an epoll instance
+ *
+ * @param[in] epfd      An epoll instance.
+ * @param[in] op        The operation (`EPOLL_CTL_*`).
+ * @param[in] fd        The file descriptor to register, change, or
+ *                      deregister.
+ * @param[in] event     Events of interest and user data. May be NULL for
+ *                      @ref EPOLL_CTL_DEL.
+ *
+ * @return  0 on success.
+ * @return  -1 on error, `errno` is set to
+ *          - `EBADF`, if @p epfd or @p fd is not a valid file descriptor.
+ *          - `EEXIST`, if @p fd is already registered with @p epfd for
+ *            @ref EPOLL_CTL_ADD.
+ *          - `EINVAL`, if @p epfd is no epoll instance or @p op is not
+ *            supported.
+ *          - `ENOENT`, if @p fd is not registered with @p epfd for
+ *            @ref EPOLL_CTL_MOD or @ref EPOLL_CTL_DEL.
+ *          - `ENOSPC`, if @ref CONFIG_POSIX_EPOLL_ITEMS_NUMOF file
+ *            descriptors are already registered with @p epfd.
+ *          - `EPERM`, if @p fd does not support epoll.
+ */
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+
+/**
+ * @brief   Waits for events on an epoll instance
+ *
+ * @param[in] epfd      An epoll instance.
+ * @param[out] events   Ready events.
+ * @param[in] maxevents Maximum number of events returned in @p events.
+ * @param[in] timeout   Timeout in milliseconds. 0 to return immediately,
+ *                      -1 to wait indefinitely.
+ *
+ * @return  Number of events in @p events, 0 on timeout.
+ * @return  -1 on error, `errno` is set to
+ *          - `EBADF`, if @p epfd is not a valid file descriptor.
+ *          - `EINVAL`, if @p epfd is no epoll instance or @p maxevents is not
+ *            greater than 0.
+ */
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+               int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_EPOLL_H */
+/** @} */
@@ -18,6 +18,7 @@
  *          - `pselect()` as it uses `sigset_t` from `<signal.h>`
  *          - handling of the `writefds` and `errorfds` parameters of `select()`
  * @todo    Currently, only [sockets](@ref posix_sockets) are supported
+ * @see     @ref posix_epoll for applications handling many file descriptors
  * @{
  *
  * @file
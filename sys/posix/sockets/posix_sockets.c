@@ -47,6 +47,12 @@
 #include "thread.h"
 #include "thread_flags.h"
 #endif
+#if IS_USED(MODULE_POSIX_EPOLL)
+#include <sys/epoll.h>
+
+extern void posix_epoll_notify(void *items, uint32_t events);
+extern void posix_epoll_forget(void **items);
+#endif
 
 /* enough to create sockets both with socket() and accept() */
 #define _ACTUAL_SOCKET_POOL_SIZE   (SOCKET_POOL_SIZE + \
@@ -92,9 +98,14 @@ typedef struct {
 #endif
 #if IS_USED(MODULE_SOCK_ASYNC)
     atomic_uint available;
+    atomic_bool conn_pending;   /* connections wait in the accept queue */
+    atomic_bool conn_fin;       /* connection was closed by the peer */
 #endif
 #if IS_USED(MODULE_POSIX_SELECT)
     thread_t *selecting_thread;
+#endif
+#if IS_USED(MODULE_POSIX_EPOLL)
+    void *epoll_items;          /* epoll instances the socket is registered in */
 #endif
     sock_tcp_ep_t local;        /* to store bind before connect/listen */
 } socket_t;
@@ -124,9 +135,14 @@ static socket_t *_get_free_socket(void)
         if (_socket_pool[i].domain == AF_UNSPEC) {
 #if IS_USED(MODULE_SOCK_ASYNC)
             atomic_init(&_socket_pool[i].available, 0U);
+            atomic_init(&_socket_pool[i].conn_pending, false);
+            atomic_init(&_socket_pool[i].conn_fin, false);
 #endif
 #if IS_USED(MODULE_POSIX_SELECT)
             _socket_pool[i].selecting_thread = NULL;
+#endif
+#if IS_USED(MODULE_POSIX_EPOLL)
+            _socket_pool[i].epoll_items = NULL;
 #endif
             return &_socket_pool[i];
         }
@@ -320,6 +336,9 @@ static int socket_close(vfs_file_t *filp)
         }
     }
     mutex_unlock(&_socket_pool_mutex);
+#if IS_USED(MODULE_POSIX_EPOLL)
+    posix_epoll_forget(&s->epoll_items);
+#endif
     s->sock = NULL;
     s->domain = AF_UNSPEC;
     return res;
@@ -377,6 +396,30 @@ static void _async_cb(void *sock, sock_async_flags_t type,
         }
 #endif
     }
+    /* the stack signals pending connections again after an accept that
+     * left some in the queue */
+    if (type & SOCK_ASYNC_CONN_RECV) {
+        atomic_store(&socket->conn_pending, true);
+    }
+    if (type & SOCK_ASYNC_CONN_FIN) {
+        atomic_store(&socket->conn_fin, true);
+    }
+#if IS_USED(MODULE_POSIX_EPOLL)
+    uint32_t events = 0;
+
+    if (type & (SOCK_ASYNC_MSG_RECV | SOCK_ASYNC_CONN_RECV)) {
+        events |= EPOLLIN;
+    }
+    if (type & SOCK_ASYNC_MSG_SENT) {
+        events |= EPOLLOUT;
+    }
+    if (type & SOCK_ASYNC_CONN_FIN) {
+        events |= EPOLLHUP;
+    }
+    if (events != 0) {
+        posix_epoll_notify(socket->epoll_items, events);
+    }
+#endif
 }
 
 static void _sock_set_cb(socket_t *socket)
@@ -519,6 +562,9 @@ int accept(int socket, struct sockaddr *restrict address,
                 break;
             }
             sock = (sock_tcp_t *)new_s->sock;
+#if IS_USED(MODULE_SOCK_ASYNC)
+            atomic_store(&s->conn_pending, false);
+#endif
             if ((res = sock_tcp_accept(&s->sock->tcp.queue, &sock,
                                        recv_timeout)) < 0) {
                 errno = -res;
@@ -973,10 +1019,17 @@ static ssize_t socket_recvfrom(socket_t *s, void *restrict buffer,
             res = -EOPNOTSUPP;
             break;
     }
-    if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
 #ifdef MODULE_SOCK_ASYNC
-        atomic_fetch_sub(&s->available, 1);
+    if (res >= 0) {
+        unsigned available = atomic_load(&s->available);
+
+        /* read() and recv() consume a message as well */
+        while ((available > 0) &&
+               !atomic_compare_exchange_weak(&s->available, &available,
+                                             available - 1)) {}
+    }
 #endif
+    if ((res >= 0) && (address != NULL) && (address_len != NULL)) {
         switch (s->type) {
 #ifdef MODULE_SOCK_TCP
             case SOCK_STREAM:
@@ -1182,6 +1235,43 @@ unsigned posix_socket_avail(int fd)
 #endif
 }
 
+uint32_t posix_socket_poll(int fd)
+{
+#if IS_USED(MODULE_POSIX_EPOLL)
+    socket_t *socket = _get_socket(fd);
+    uint32_t events = 0;
+
+    if (socket == NULL) {
+        return 0;
+    }
+#ifdef MODULE_SOCK_TCP
+    if (socket->type == SOCK_STREAM) {
+        if (socket->queue_array != NULL) {
+            /* a listening socket is only readable with connections to
+             * accept */
+            return atomic_load(&socket->conn_pending) ? EPOLLIN : 0;
+        }
+        if (socket->sock == NULL) {
+            /* neither connected nor listening */
+            return EPOLLHUP;
+        }
+        if (atomic_load(&socket->conn_fin)) {
+            /* reading returns the end of the stream without blocking */
+            events |= EPOLLIN | EPOLLHUP;
+        }
+    }
+#endif
+    if (atomic_load(&socket->available) > 0) {
+        events |= EPOLLIN;
+    }
+    /* sockets never signal back pressure, so they are always writable */
+    return events | EPOLLOUT;
+#else
+    (void)fd;
+    return 0;
+#endif
+}
+
 int posix_socket_select(int fd)
 {
 #if IS_USED(MODULE_POSIX_SELECT)
@@ -1206,6 +1296,27 @@ int posix_socket_select(int fd)
     return -1;
 }
 
+void **posix_socket_epoll(int fd)
+{
+#if IS_USED(MODULE_POSIX_EPOLL)
+    socket_t *socket = _get_socket(fd);
+
+    if (socket != NULL) {
+        /* bind implicitly, TCP sockets get their callback set once they
+         * are connected or listening */
+        if ((socket->sock == NULL) && (socket->type != SOCK_STREAM) &&
+            (_bind_connect(socket, NULL, 0) < 0)) {
+            return NULL;
+        }
+        return &socket->epoll_items;
+    }
+#else
+    (void)fd;
+#endif
+    errno = ENOTSUP;
+    return NULL;
+}
+
 /**
  * @}
  */
@@ -52,7 +52,7 @@ void ps(void)
            "| stack  ( used) ( free) | base addr  | current     "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-           "| runtime  | switches  | runtime_usec "
+           "| runtime  | switches  | runtime_usec | latency_usec "
 #endif
            "\n",
 #ifdef CONFIG_THREAD_NAMES
@@ -108,6 +108,7 @@ void ps(void)
             unsigned runtime_major = runtime_ticks / rt_sum;
             unsigned runtime_minor = ((runtime_ticks % rt_sum) * 1000) / rt_sum;
             unsigned switches = sched_pidlist[i].schedules;
+            xtimer_ticks32_t latency_ticks = {sched_pidlist[i].latency_max};
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef CONFIG_THREAD_NAMES
@@ -118,7 +119,7 @@ void ps(void)
                    " | %6" PRIu32 " (%5i) (%5i) | %10p | %10p "
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-                   " | %2d.%03d%% |  %8u  | %10"PRIu32" "
+                   " | %2d.%03d%% |  %8u  | %10"PRIu32"   | %10"PRIu32"  "
 #endif
                    "\n",
                    thread_getpid_of(p),
@@ -132,6 +133,7 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches, xtimer_usec_from_ticks(xtimer_ticks)
+                   , xtimer_usec_from_ticks(latency_ticks)
 #endif
                   );
         }
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_riotboot_delta
+ * @{
+ *
+ * @file
+ * @brief       Streaming application of delta patches to firmware images
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "riotboot/delta.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+enum {
+    STATE_HDR,          /**< receiving the header */
+    STATE_CMD,          /**< decoding the type and length of a command */
+    STATE_OFFSET,       /**< decoding the offset of a copy */
+    STATE_INSERT,       /**< passing on inserted bytes */
+    STATE_DONE,         /**< new image is complete */
+    STATE_ERROR,        /**< patch was rejected */
+};
+
+#define HDR_OFF_BASE_LEN    (4U)
+#define HDR_OFF_NEW_LEN     (8U)
+#define HDR_OFF_DIGEST      (12U)
+
+bool riotboot_delta_is_patch(const uint8_t *buf, size_t len)
+{
+    return (len >= sizeof(RIOTBOOT_DELTA_MAGIC) - 1) &&
+           (memcmp(buf, RIOTBOOT_DELTA_MAGIC,
+                   sizeof(RIOTBOOT_DELTA_MAGIC) - 1) == 0);
+}
+
+void riotboot_delta_init(riotboot_delta_t *delta, const void *base,
+                         size_t base_max, riotboot_delta_write_t write,
+                         void *arg)
+{
+    memset(delta, 0, sizeof(*delta));
+    delta->write = write;
+    delta->arg = arg;
+    delta->base = base;
+    delta->base_len = base_max;
+    delta->remaining = RIOTBOOT_DELTA_HDR_LEN;
+    delta->state = STATE_HDR;
+}
+
+static int _check_hdr(riotboot_delta_t *delta)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    uint32_t base_len = byteorder_lebuftohl(&delta->hdr[HDR_OFF_BASE_LEN]);
+
+    if (!riotboot_delta_is_patch(delta->hdr, sizeof(delta->hdr))) {
+        DEBUG("riotboot_delta: not a patch\n");
+        return -EINVAL;
+    }
+    if (base_len > delta->base_len) {
+        DEBUG("riotboot_delta: base image too long\n");
+        return -ENOENT;
+    }
+    /* a patch against another image would produce garbage, that is only
+     * noticed after the whole image is written */
+    sha256(delta->base, base_len, digest);
+    if (memcmp(digest, &delta->hdr[HDR_OFF_DIGEST], sizeof(digest)) != 0) {
+        DEBUG("riotboot_delta: base image digest mismatch\n");
+        return -ENOENT;
+    }
+
+    delta->base_len = base_len;
+    delta->new_len = byteorder_lebuftohl(&delta->hdr[HDR_OFF_NEW_LEN]);
+    return 0;
+}
+
+/* decodes the next byte of a LEB128 number, returns 1 when it is complete */
+static int _decode_varint(riotboot_delta_t *delta, uint8_t byte)
+{
+    if ((delta->shift > 28) ||
+        ((delta->shift == 28) && (byte & 0x70))) {
+        DEBUG("riotboot_delta: number too large\n");
+        return -EINVAL;
+    }
+    delta->value |= (uint32_t)(byte & 0x7f) << delta->shift;
+    delta->shift += 7;
+    if (byte & 0x80) {
+        return 0;
+    }
+    delta->shift = 0;
+    return 1;
+}
+
+static int _write(riotboot_delta_t *delta, const uint8_t *buf, size_t len)
+{
+    int res = delta->write(delta->arg, buf, len);
+
+    if (res < 0) {
+        return res;
+    }
+    delta->new_pos += len;
+    if (delta->new_pos == delta->new_len) {
+        delta->state = STATE_DONE;
+    }
+    return 0;
+}
+
+static int _start_cmd(riotboot_delta_t *delta)
+{
+    size_t len = delta->value >> 1;
+
+    if ((len == 0) || (len > delta->new_len - delta->new_pos)) {
+        DEBUG("riotboot_delta: invalid command length %u\n", (unsigned)len);
+        return -EINVAL;
+    }
+    delta->remaining = len;
+    delta->state = (delta->value & 1) ? STATE_INSERT : STATE_OFFSET;
+    delta->value = 0;
+    return 0;
+}
+
+static int _copy(riotboot_delta_t *delta)
+{
+    /* zigzag encoding: even numbers seek forward, odd numbers backward */
+    uint32_t dist = delta->value >> 1;
+    size_t pos;
+
+    if (delta->value & 1) {
+        dist++;
+        if (dist > delta->base_pos) {
+            DEBUG("riotboot_delta: copy out of bounds\n");
+            return -EINVAL;
+        }
+        pos = delta->base_pos - dist;
+    }
+    else {
+        if (dist > delta->base_len - delta->base_pos) {
+            DEBUG("riotboot_delta: copy out of bounds\n");
+            return -EINVAL;
+        }
+        pos = delta->base_pos + dist;
+    }
+    delta->value = 0;
+
+    if (delta->remaining > delta->base_len - pos) {
+        DEBUG("riotboot_delta: copy out of bounds\n");
+        return -EINVAL;
+    }
+    delta->base_pos = pos + delta->remaining;
+    delta->state = STATE_CMD;
+    return _write(delta, &delta->base[pos], delta->remaining);
+}
+
+static int _putbytes(riotboot_delta_t *delta, const uint8_t *buf, size_t len)
+{
+    while (len) {
+        size_t n = 1;
+        int res = 0;
+
+        switch (delta->state) {
+        case STATE_HDR:
+            n = (len < delta->remaining) ? len : delta->remaining;
+            memcpy(&delta->hdr[sizeof(delta->hdr) - delta->remaining], buf, n);
+            delta->remaining -= n;
+            if (delta->remaining == 0) {
+                res = _check_hdr(delta);
+                delta->state = (delta->new_len) ? STATE_CMD : STATE_DONE;
+            }
+            break;
+        case STATE_CMD:
+            res = _decode_varint(delta, *buf);
+            if (res > 0) {
+                res = _start_cmd(delta);
+            }
+            break;
+        case STATE_OFFSET:
+            res = _decode_varint(delta, *buf);
+            if (res > 0) {
+                res = _copy(delta);
+            }
+            break;
+        case STATE_INSERT:
+            n = (len < delta->remaining) ? len : delta->remaining;
+            delta->remaining -= n;
+            if (delta->remaining == 0) {
+                delta->state = STATE_CMD;
+            }
+            res = _write(delta, buf, n);
+            break;
+        default:
+            DEBUG("riotboot_delta: data after the end of the patch\n");
+            return -EINVAL;
+        }
+
+        if (res < 0) {
+            return res;
+        }
+        delta->patch_pos += n;
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+int riotboot_delta_putbytes(riotboot_delta_t *delta, const uint8_t *buf,
+                            size_t len)
+{
+    int res = _putbytes(delta, buf, len);
+
+    if (res < 0) {
+        delta->state = STATE_ERROR;
+    }
+    return res;
+}
+
+int riotboot_delta_finish(const riotboot_delta_t *delta)
+{
+    return (delta->state == STATE_DONE) ? 0 : -EINVAL;
+}
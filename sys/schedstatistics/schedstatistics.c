@@ -21,6 +21,10 @@
  * @}
  */
 
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
 #include "sched.h"
 #include "schedstatistics.h"
 #include "thread.h"
@@ -31,6 +35,33 @@
  * the idle time
  */
 schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
+schedstat_isr_t sched_isrlist[CONFIG_SCHEDSTATISTICS_ISR_NUMOF];
+unsigned int sched_latency[SCHED_PRIO_LEVELS]
+                          [CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS];
+schedstat_irq_off_t sched_irq_off;
+
+/* the hooks are called before xtimer is initialized */
+static bool _started;
+static uint32_t _irq_off_start;
+static const void *_irq_off_pc;
+
+static unsigned _latency_bucket(uint32_t ticks)
+{
+    unsigned bucket = (ticks == 0) ? 0 : bitarithm_msb(ticks) + 1;
+
+    if (bucket >= CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS) {
+        bucket = CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS - 1;
+    }
+    return bucket;
+}
+
+static void _ready_cb(kernel_pid_t pid)
+{
+    schedstat_t *stat = &sched_pidlist[pid];
+
+    stat->readystart = xtimer_now().ticks32;
+    stat->ready = true;
+}
 
 void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
 {
@@ -47,7 +78,79 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
         schedstat_t *next_stat = &sched_pidlist[next_thread];
         next_stat->laststart = now;
         next_stat->schedules++;
+
+        if (next_stat->ready) {
+            uint32_t latency = now - next_stat->readystart;
+            thread_t *next = thread_get(next_thread);
+
+            next_stat->ready = false;
+            if (latency > next_stat->latency_max) {
+                next_stat->latency_max = latency;
+            }
+            if (next) {
+                sched_latency[next->priority][_latency_bucket(latency)]++;
+            }
+        }
+    }
+}
+
+uint32_t schedstat_isr_enter(void)
+{
+    return _started ? xtimer_now().ticks32 : 0;
+}
+
+void schedstat_isr_exit(unsigned irq, uint32_t start)
+{
+    if (!_started) {
+        return;
+    }
+
+    uint32_t ticks = xtimer_now().ticks32 - start;
+    schedstat_isr_t *stat;
+
+    if (irq >= CONFIG_SCHEDSTATISTICS_ISR_NUMOF) {
+        irq = CONFIG_SCHEDSTATISTICS_ISR_NUMOF - 1;
+    }
+    stat = &sched_isrlist[irq];
+    stat->runtime_ticks += ticks;
+    stat->count++;
+    if (ticks > stat->max_ticks) {
+        stat->max_ticks = ticks;
+    }
+}
+
+void schedstat_irq_off_begin(const void *pc)
+{
+    if (_started) {
+        _irq_off_pc = pc;
+        _irq_off_start = xtimer_now().ticks32;
+    }
+}
+
+void schedstat_irq_off_end(void)
+{
+    if (_irq_off_pc) {
+        uint32_t ticks = xtimer_now().ticks32 - _irq_off_start;
+
+        if (ticks > sched_irq_off.max_ticks) {
+            sched_irq_off.max_ticks = ticks;
+            sched_irq_off.pc = _irq_off_pc;
+        }
+        _irq_off_pc = NULL;
+    }
+}
+
+void schedstat_reset(void)
+{
+    unsigned state = irq_disable();
+
+    for (kernel_pid_t i = 0; i <= KERNEL_PID_LAST; i++) {
+        sched_pidlist[i].latency_max = 0;
     }
+    memset(sched_isrlist, 0, sizeof(sched_isrlist));
+    memset(sched_latency, 0, sizeof(sched_latency));
+    memset(&sched_irq_off, 0, sizeof(sched_irq_off));
+    irq_restore(state);
 }
 
 void init_schedstatistics(void)
@@ -58,4 +161,6 @@ void init_schedstatistics(void)
     active_stat->laststart = xtimer_now().ticks32;
     active_stat->schedules = 1;
     sched_register_cb(sched_statistics_cb);
+    sched_register_ready_cb(_ready_cb);
+    _started = true;
 }
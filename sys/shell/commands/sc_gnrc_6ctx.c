@@ -122,8 +122,9 @@ int _gnrc_6ctx_del(char *cmd_str, char *ctx_str)
     if (del_timer[cid].callback == NULL) {
         ctx = gnrc_sixlowpan_ctx_lookup_id(cid);
         if (ctx != NULL) {
-            ctx->flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
-            ctx->ltime = 0;
+            /* stop using context for compression */
+            ctx = gnrc_sixlowpan_ctx_update(cid, &ctx->prefix, ctx->prefix_len,
+                                            0, false);
             del_timer[cid].callback = _del_cb;
             del_timer[cid].arg = ctx;
 #if IS_USED(MODULE_ZTIMER_MSEC)
@@ -175,6 +175,11 @@ static int _netif_stats(netif_t *iface, unsigned module, bool reset)
                (unsigned) stats->tx_bytes,
                (unsigned) stats->tx_success,
                (unsigned) stats->tx_failed);
+        if (stats->rx_batches) {
+            printf("            RX events %u (max. packets per event: %u)\n",
+                   (unsigned) stats->rx_batches,
+                   (unsigned) stats->rx_batch_max);
+        }
         res = 0;
     }
     return res;
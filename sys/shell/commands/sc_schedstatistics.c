@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the schedstatistics module
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "schedstatistics.h"
+#include "xtimer.h"
+
+static uint32_t _usec(uint32_t ticks)
+{
+    xtimer_ticks32_t t = { ticks };
+
+    return xtimer_usec_from_ticks(t);
+}
+
+static void _print_isrs(void)
+{
+    puts("ISRs:\n  irq |      count |  total_usec |   max_usec");
+    for (unsigned i = 0; i < CONFIG_SCHEDSTATISTICS_ISR_NUMOF; i++) {
+        schedstat_isr_t *stat = &sched_isrlist[i];
+        xtimer_ticks64_t total = { stat->runtime_ticks };
+
+        if (stat->count == 0) {
+            continue;
+        }
+        printf("  %3u | %10u | %11" PRIu32 " | %10" PRIu32 "\n", i,
+               stat->count, (uint32_t)xtimer_usec_from_ticks64(total),
+               _usec(stat->max_ticks));
+    }
+}
+
+static void _print_latency(void)
+{
+    printf("Ready-to-running latency (histogram, buckets by usec):\n  pri |");
+    for (unsigned i = 0; i < CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS; i++) {
+        printf(" >=%6" PRIu32, _usec(schedstat_latency_bucket_min(i)));
+    }
+    puts("");
+    for (unsigned prio = 0; prio < SCHED_PRIO_LEVELS; prio++) {
+        unsigned sum = 0;
+
+        for (unsigned i = 0; i < CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS; i++) {
+            sum += sched_latency[prio][i];
+        }
+        if (sum == 0) {
+            continue;
+        }
+        printf("  %3u |", prio);
+        for (unsigned i = 0; i < CONFIG_SCHEDSTATISTICS_LATENCY_BUCKETS; i++) {
+            printf(" %8u", sched_latency[prio][i]);
+        }
+        puts("");
+    }
+}
+
+int _schedstat_handler(int argc, char **argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        schedstat_reset();
+        return 0;
+    }
+    if (argc > 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+    _print_isrs();
+#ifdef MODULE_SCHEDSTATISTICS_IRQ_OFF
+    printf("IRQs disabled: max %" PRIu32 " usec from %p\n",
+           _usec(sched_irq_off.max_ticks), sched_irq_off.pc);
+#endif
+    _print_latency();
+
+    return 0;
+}
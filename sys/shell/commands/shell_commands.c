@@ -49,6 +49,10 @@ extern int _pm_handler(int argc, char **argv);
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_SCHEDSTATISTICS
+extern int _schedstat_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT1X
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -228,6 +232,10 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
+#ifdef MODULE_SCHEDSTATISTICS
+    {"schedstat", "Prints ISR, IRQ-off and latency statistics.",
+     _schedstat_handler},
+#endif
 #ifdef MODULE_SHT1X
     {"temp", "Prints measured temperature.", _get_temperature_handler},
     {"hum", "Prints measured humidity.", _get_humidity_handler},
@@ -25,6 +25,8 @@
 #include <inttypes.h>
 #include <nanocbor/nanocbor.h>
 #include <assert.h>
+#include <errno.h>
+#include <stdint.h>
 
 #include "hashes/sha256.h"
 
@@ -353,6 +355,12 @@ static int _dtv_fetch(suit_manifest_t *manifest, int key,
         return SUIT_ERR_STORAGE;
     }
 
+    sha256_init(&manifest->fetch_digest);
+    manifest->fetch_offset = 0;
+    /* state of a previous fetch of the component */
+    suit_component_clear_flag(comp, SUIT_COMPONENT_STATE_DIGESTED |
+                                    SUIT_COMPONENT_STATE_DELTA);
+
     res = -1;
 
     if (0) {}
@@ -387,6 +395,130 @@ static int _dtv_fetch(suit_manifest_t *manifest, int key,
     return SUIT_OK;
 }
 
+/* Stores a chunk of the payload, receives the output of a delta patch */
+static int _payload_store(suit_manifest_t *manifest, const uint8_t *buf,
+                          size_t offset, size_t len)
+{
+    suit_component_t *comp = _get_component(manifest);
+    uint32_t img_size;
+
+    if (_get_component_size(manifest, comp, &img_size) < 0) {
+        return SUIT_ERR_INVALID_MANIFEST;
+    }
+    if ((offset > img_size) || (len > img_size - offset)) {
+        LOG_ERROR("Payload beyond size, offset + len=%u, size=%u\n",
+                  (unsigned)(offset + len), (unsigned)img_size);
+        return SUIT_ERR_STORAGE_EXCEEDED;
+    }
+
+    /* Hash the payload while it streams through, as long as it arrives in
+     * order. A chunk written out of order could overwrite data that is
+     * already hashed, so the digest has to be computed from storage then. */
+    if (offset == manifest->fetch_offset) {
+        sha256_update(&manifest->fetch_digest, buf, len);
+        manifest->fetch_offset += len;
+    }
+    else {
+        manifest->fetch_offset = SIZE_MAX;
+    }
+
+    return suit_storage_write(comp->storage_backend, manifest, buf, offset,
+                              len);
+}
+
+#if IS_USED(MODULE_RIOTBOOT_DELTA)
+static int _delta_write(void *arg, const uint8_t *buf, size_t len)
+{
+    suit_manifest_t *manifest = arg;
+
+    return _payload_store(manifest, buf, manifest->fetch_offset, len);
+}
+
+static int _delta_start(suit_manifest_t *manifest, suit_component_t *comp)
+{
+    const uint8_t *base;
+    size_t base_len;
+
+    if (suit_storage_read_base_ptr(comp->storage_backend, &base,
+                                   &base_len) < 0) {
+        return SUIT_ERR_STORAGE;
+    }
+    LOG_INFO("Applying delta patch\n");
+    riotboot_delta_init(&manifest->fetch_delta, base, base_len, _delta_write,
+                        manifest);
+    suit_component_set_flag(comp, SUIT_COMPONENT_STATE_DELTA);
+    return SUIT_OK;
+}
+
+static int _delta_write_patch(suit_manifest_t *manifest, const uint8_t *buf,
+                              size_t offset, size_t len, bool more)
+{
+    riotboot_delta_t *delta = &manifest->fetch_delta;
+
+    if (offset != delta->patch_pos) {
+        LOG_ERROR("Delta patch received out of order\n");
+        return SUIT_ERR_STORAGE;
+    }
+    int res = riotboot_delta_putbytes(delta, buf, len);
+    if ((res == 0) && !more) {
+        res = riotboot_delta_finish(delta);
+    }
+    if (res < 0) {
+        LOG_ERROR("Unable to apply delta patch: %d\n", res);
+        /* errors of the storage backend are passed on */
+        return ((res == -EINVAL) || (res == -ENOENT)) ? SUIT_ERR_STORAGE : res;
+    }
+    return SUIT_OK;
+}
+#endif
+
+int suit_payload_write(suit_manifest_t *manifest, const uint8_t *buf,
+                       size_t offset, size_t len, bool more)
+{
+    suit_component_t *comp = _get_component(manifest);
+    int res;
+
+#if IS_USED(MODULE_RIOTBOOT_DELTA)
+    if ((offset == 0) && riotboot_delta_is_patch(buf, len) &&
+            suit_storage_has_base_ptr(comp->storage_backend)) {
+        res = _delta_start(manifest, comp);
+        if (res < 0) {
+            return res;
+        }
+    }
+    if (suit_component_check_flag(comp, SUIT_COMPONENT_STATE_DELTA)) {
+        res = _delta_write_patch(manifest, buf, offset, len, more);
+    }
+    else
+#endif
+    {
+        res = _payload_store(manifest, buf, offset, len);
+    }
+    if ((res < 0) || more) {
+        return res;
+    }
+
+    uint32_t img_size;
+    if (_get_component_size(manifest, comp, &img_size) < 0) {
+        return SUIT_ERR_INVALID_MANIFEST;
+    }
+    /* the output of a patch is always in order */
+    size_t total = (manifest->fetch_offset == SIZE_MAX) ? offset + len
+                                                       : manifest->fetch_offset;
+    if (total != img_size) {
+        LOG_INFO("Incorrect size received, got %u, expected %u\n",
+                 (unsigned)total, (unsigned)img_size);
+        return SUIT_ERR_STORAGE_EXCEEDED;
+    }
+    if (manifest->fetch_offset == img_size) {
+        sha256_final(&manifest->fetch_digest, comp->digest);
+        suit_component_set_flag(comp, SUIT_COMPONENT_STATE_DIGESTED);
+    }
+
+    LOG_INFO("Finalizing payload store\n");
+    return suit_storage_finish(comp->storage_backend, manifest);
+}
+
 static int _get_digest(nanocbor_value_t *bstr, const uint8_t **digest, size_t
                        *digest_len)
 {
@@ -413,7 +545,11 @@ static int _validate_payload(suit_component_t *component, const uint8_t *digest,
     uint8_t payload_digest[SHA256_DIGEST_LENGTH];
     suit_storage_t *storage = component->storage_backend;
 
-    if (suit_storage_has_readptr(storage)) {
+    if (suit_component_check_flag(component, SUIT_COMPONENT_STATE_DIGESTED)) {
+        /* Computed while fetching, the size was checked then */
+        memcpy(payload_digest, component->digest, sizeof(payload_digest));
+    }
+    else if (suit_storage_has_readptr(storage)) {
         /* Direct read possible */
         const uint8_t *payload = NULL;
         size_t payload_len = 0;
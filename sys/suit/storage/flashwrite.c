@@ -91,6 +91,18 @@ static int _flashwrite_finish(suit_storage_t *storage,
            0 ? SUIT_ERR_STORAGE : SUIT_OK;
 }
 
+static int _flashwrite_read_base_ptr(suit_storage_t *storage,
+                                     const uint8_t **buf, size_t *len)
+{
+    (void)storage;
+    int slot = riotboot_slot_current();
+
+    /* The running image, as it was written to its slot */
+    *buf = (const uint8_t *)riotboot_slot_get_hdr(slot);
+    *len = riotboot_slot_size(slot);
+    return SUIT_OK;
+}
+
 static int _flashwrite_install(suit_storage_t *storage,
                                const suit_manifest_t *manifest)
 {
@@ -225,6 +237,7 @@ static const suit_storage_driver_t suit_storage_flashwrite_driver = {
     .write = _flashwrite_write,
     .finish = _flashwrite_finish,
     .read = _flashwrite_read,
+    .read_base_ptr = _flashwrite_read_base_ptr,
     .install = _flashwrite_install,
     .has_location = _flashwrite_has_location,
     .set_active_location = _flashwrite_set_active_location,
@@ -80,16 +80,17 @@ static uint8_t _manifest_buf[SUIT_MANIFEST_BUFSIZE];
 #ifdef MODULE_SUIT
 static inline void _print_download_progress(suit_manifest_t *manifest,
                                             size_t offset, size_t len,
-                                            size_t image_size)
+                                            size_t written, size_t image_size)
 {
     (void)manifest;
     (void)offset;
     (void)len;
-    DEBUG("_suit_flashwrite(): writing %u bytes at pos %u\n", len, offset);
+    (void)written;
+    DEBUG("_suit_flashwrite(): wrote %u bytes at pos %u\n", len, offset);
 #if defined(MODULE_PROGRESS_BAR)
     if (image_size != 0) {
         char _suffix[7] = { 0 };
-        uint8_t _progress = 100 * (offset + len) / image_size;
+        uint8_t _progress = 100 * written / image_size;
         sprintf(_suffix, " %3d%%", _progress);
         progress_bar_print("Fetching firmware ", _suffix, _progress);
         if (_progress == 100) {
@@ -133,46 +134,68 @@ static inline uint32_t deadline_left(uint32_t deadline)
     return left;
 }
 
-static ssize_t _nanocoap_request(sock_udp_t *sock, coap_pkt_t *pkt, size_t len)
+/**
+ * @brief   State of a confirmable request, the response is received into the
+ *          buffer of the request
+ */
+typedef struct {
+    coap_pkt_t pkt;             /**< request, and response once received */
+    size_t pdu_len;             /**< length of the request */
+    uint32_t timeout;           /**< current retransmission timeout */
+    uint32_t deadline;          /**< time of the next retransmission */
+    unsigned tries_left;        /**< number of transmissions left */
+} _request_t;
+
+static ssize_t _request_send(sock_udp_t *sock, _request_t *req)
 {
-    ssize_t res = -EAGAIN;
-    size_t pdu_len = (pkt->payload - (uint8_t *)pkt->hdr) + pkt->payload_len;
-    uint8_t *buf = (uint8_t *)pkt->hdr;
-    uint32_t id = coap_get_id(pkt);
+    coap_pkt_t *pkt = &req->pkt;
+
+    req->pdu_len = (pkt->payload - (uint8_t *)pkt->hdr) + pkt->payload_len;
 
     /* TODO: timeout random between between ACK_TIMEOUT and (ACK_TIMEOUT *
      * ACK_RANDOM_FACTOR) */
-    uint32_t timeout = CONFIG_COAP_ACK_TIMEOUT * US_PER_SEC;
-    uint32_t deadline = deadline_from_interval(timeout);
+    req->timeout = CONFIG_COAP_ACK_TIMEOUT * US_PER_SEC;
+    req->deadline = deadline_from_interval(req->timeout);
 
     /* add 1 for initial transmit */
-    unsigned tries_left = CONFIG_COAP_MAX_RETRANSMIT + 1;
+    req->tries_left = CONFIG_COAP_MAX_RETRANSMIT + 1;
 
-    while (tries_left) {
-        if (res == -EAGAIN) {
-            res = sock_udp_send(sock, buf, pdu_len, NULL);
-            if (res <= 0) {
-                DEBUG("nanocoap: error sending coap request, %d\n", (int)res);
-                break;
-            }
-        }
+    ssize_t res = sock_udp_send(sock, pkt->hdr, req->pdu_len, NULL);
+    if (res <= 0) {
+        DEBUG("nanocoap: error sending coap request, %d\n", (int)res);
+    }
+    return res;
+}
+
+static ssize_t _request_recv(sock_udp_t *sock, _request_t *req, size_t len)
+{
+    coap_pkt_t *pkt = &req->pkt;
+    uint8_t *buf = (uint8_t *)pkt->hdr;
+    unsigned id = coap_get_id(pkt);
+    ssize_t res = -ETIMEDOUT;
 
-        res = sock_udp_recv(sock, buf, len, deadline_left(deadline), NULL);
+    while (req->tries_left) {
+        res = sock_udp_recv(sock, buf, len, deadline_left(req->deadline), NULL);
         if (res <= 0) {
-            if (res == -ETIMEDOUT) {
+            /* the deadline may have passed already while the previous block
+             * was processed, then sock_udp_recv() returns -EAGAIN instead */
+            if ((res == -ETIMEDOUT) || (res == -EAGAIN)) {
                 DEBUG("nanocoap: timeout\n");
 
-                tries_left--;
-                if (!tries_left) {
+                req->tries_left--;
+                if (!req->tries_left) {
                     DEBUG("nanocoap: maximum retries reached\n");
                     break;
                 }
-                else {
-                    timeout *= 2;
-                    deadline = deadline_from_interval(timeout);
-                    res = -EAGAIN;
-                    continue;
+                req->timeout *= 2;
+                req->deadline = deadline_from_interval(req->timeout);
+                res = sock_udp_send(sock, buf, req->pdu_len, NULL);
+                if (res <= 0) {
+                    DEBUG("nanocoap: error sending coap request, %d\n",
+                          (int)res);
+                    break;
                 }
+                continue;
             }
             DEBUG("nanocoap: error receiving coap response, %d\n", (int)res);
             break;
@@ -194,9 +217,11 @@ static ssize_t _nanocoap_request(sock_udp_t *sock, coap_pkt_t *pkt, size_t len)
     return res;
 }
 
-static int _fetch_block(coap_pkt_t *pkt, uint8_t *buf, sock_udp_t *sock,
-                        const char *path, coap_blksize_t blksize, size_t num)
+static void _build_block_request(_request_t *req, uint8_t *buf,
+                                 const char *path, coap_blksize_t blksize,
+                                 size_t num)
 {
+    coap_pkt_t *pkt = &req->pkt;
     uint8_t *pktpos = buf;
     uint16_t lastonum = 0;
 
@@ -211,13 +236,16 @@ static int _fetch_block(coap_pkt_t *pkt, uint8_t *buf, sock_udp_t *sock,
 
     pkt->payload = pktpos;
     pkt->payload_len = 0;
+}
 
-    int res = _nanocoap_request(sock, pkt, 64 + (0x1 << (blksize + 4)));
+static int _recv_block(sock_udp_t *sock, _request_t *req, size_t len)
+{
+    int res = _request_recv(sock, req, len);
     if (res < 0) {
         return res;
     }
 
-    res = coap_get_code(pkt);
+    res = coap_get_code(&req->pkt);
     DEBUG("code=%i\n", res);
     if (res != 205) {
         return -res;
@@ -230,10 +258,11 @@ int suit_coap_get_blockwise(sock_udp_ep_t *remote, const char *path,
                             coap_blksize_t blksize,
                             coap_blockwise_cb_t callback, void *arg)
 {
-    /* mmmmh dynamically sized array */
-    uint8_t buf[64 + (0x1 << (blksize + 4))];
+    /* mmmmh dynamically sized array. Two buffers, so the next block can be
+     * received while the callback processes the current one. */
+    uint8_t buf[2][64 + (0x1 << (blksize + 4))];
     sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
-    coap_pkt_t pkt;
+    _request_t req[2];
 
     /* HACK: use random local port */
     local.port = 0x8000 + (xtimer_now_usec() % 0XFFF);
@@ -246,31 +275,50 @@ int suit_coap_get_blockwise(sock_udp_ep_t *remote, const char *path,
 
     int more = 1;
     size_t num = 0;
-    res = -1;
+    unsigned cur = 0;
+
+    DEBUG("fetching block %u\n", (unsigned)num);
+    _build_block_request(&req[cur], buf[cur], path, blksize, num);
+    res = _request_send(&sock, &req[cur]);
+    if (res <= 0) {
+        res = -1;
+        goto out;
+    }
+
     while (more == 1) {
-        DEBUG("fetching block %u\n", (unsigned)num);
-        res = _fetch_block(&pkt, buf, &sock, path, blksize, num);
+        res = _recv_block(&sock, &req[cur], sizeof(buf[cur]));
         DEBUG("res=%i\n", res);
 
-        if (!res) {
-            coap_block1_t block2;
-            coap_get_block2(&pkt, &block2);
-            more = block2.more;
+        if (res) {
+            DEBUG("error fetching block\n");
+            res = -1;
+            goto out;
+        }
+
+        coap_block1_t block2;
+        coap_get_block2(&req[cur].pkt, &block2);
+        more = block2.more;
 
-            if (callback(arg, block2.offset, pkt.payload, pkt.payload_len,
-                         more)) {
-                DEBUG("callback res != 0, aborting.\n");
+        /* Request the next block before handing this one to the callback,
+         * so it is transferred while the callback e.g. writes to flash */
+        if (more) {
+            DEBUG("fetching block %u\n", (unsigned)(num + 1));
+            _build_block_request(&req[!cur], buf[!cur], path, blksize, num + 1);
+            if (_request_send(&sock, &req[!cur]) <= 0) {
                 res = -1;
                 goto out;
             }
         }
-        else {
-            DEBUG("error fetching block\n");
+
+        if (callback(arg, block2.offset, req[cur].pkt.payload,
+                     req[cur].pkt.payload_len, more)) {
+            DEBUG("callback res != 0, aborting.\n");
             res = -1;
             goto out;
         }
 
         num += 1;
+        cur = !cur;
     }
 
 out:
@@ -360,8 +408,13 @@ static void _suit_handle_url(const char *url)
         manifest.urlbuf = _url;
         manifest.urlbuf_len = SUIT_URL_MAX;
 
-        int res;
-        if ((res = suit_parse(&manifest, _manifest_buf, size)) != SUIT_OK) {
+        uint32_t start = _now();
+        int res = suit_parse(&manifest, _manifest_buf, size);
+
+        /* includes fetching, storing and verifying the payload */
+        LOG_INFO("suit_coap: manifest processed in %" PRIu32 " ms\n",
+                 (uint32_t)((_now() - start) / US_PER_MS));
+        if (res != SUIT_OK) {
             LOG_INFO("suit_parse() failed. res=%i\n", res);
             return;
         }
@@ -396,7 +449,6 @@ int suit_storage_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
 
     uint32_t image_size;
     nanocbor_value_t param_size;
-    size_t total = offset + len;
     suit_component_t *comp = &manifest->components[manifest->component_current];
     suit_param_ref_t *ref_size = &comp->param_size;
 
@@ -407,28 +459,17 @@ int suit_storage_helper(void *arg, size_t offset, uint8_t *buf, size_t len,
         return -1;
     }
 
-    if (image_size < offset + len) {
-        /* Extra newline at the start to compensate for the progress bar */
-        LOG_ERROR(
-            "\n_suit_coap(): Image beyond size, offset + len=%u, "
-            "image_size=%u\n", (unsigned)(total), (unsigned)image_size);
-        return -1;
-    }
-
-    if (!more && image_size != total) {
-        LOG_INFO("Incorrect size received, got %u, expected %u\n",
-                 (unsigned)total, (unsigned)image_size);
-        return -1;
+    /* The size is checked while writing, as a delta patch is smaller than the
+     * image it produces */
+    int res = suit_payload_write(manifest, buf, offset, len, more);
+    if (res < 0) {
+        return res;
     }
 
-    _print_download_progress(manifest, offset, len, image_size);
+    size_t written = (manifest->fetch_offset == SIZE_MAX) ? offset + len
+                                                         : manifest->fetch_offset;
+    _print_download_progress(manifest, offset, len, written, image_size);
 
-    int res = suit_storage_write(comp->storage_backend, manifest, buf, offset, len);
-    if (!more) {
-        LOG_INFO("Finalizing payload store\n");
-        /* Finalize the write if no more data available */
-        res = suit_storage_finish(comp->storage_backend, manifest);
-    }
     return res;
 }
 
@@ -14,29 +14,33 @@
 #include "log.h"
 
 #include "suit.h"
-#include "suit/storage.h"
 #include "suit/transport/mock.h"
 
 /* Must be defined by the test */
 extern const suit_transport_mock_payload_t payloads[];
 extern const size_t num_payloads;
 
-static const suit_component_t *_get_component(const suit_manifest_t *manifest)
-{
-    assert(manifest->component_current < CONFIG_SUIT_COMPONENT_MAX);
-    return &manifest->components[manifest->component_current];
-}
+size_t suit_transport_mock_chunk_len;
 
-int suit_transport_mock_fetch(const suit_manifest_t *manifest)
+int suit_transport_mock_fetch(suit_manifest_t *manifest)
 {
     size_t file = manifest->component_current;
-    const suit_component_t *comp = _get_component(manifest);
+    const uint8_t *buf = payloads[file].buf;
+    size_t len = payloads[file].len;
+    size_t chunk = suit_transport_mock_chunk_len;
+    size_t offset = 0;
 
+    assert(manifest->component_current < CONFIG_SUIT_COMPONENT_MAX);
     assert(file < num_payloads);
 
     LOG_INFO("Mock writing payload %d\n", (unsigned)file);
 
-    suit_storage_write(comp->storage_backend, manifest, payloads[file].buf, 0,
-                       payloads[file].len);
+    if ((chunk != 0) && (len > 2 * chunk)) {
+        /* second chunk before the first one */
+        suit_payload_write(manifest, &buf[chunk], chunk, chunk, true);
+        suit_payload_write(manifest, buf, 0, chunk, true);
+        offset = 2 * chunk;
+    }
+    suit_payload_write(manifest, &buf[offset], offset, len - offset, false);
     return 0;
 }
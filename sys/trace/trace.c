@@ -21,32 +21,81 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "irq.h"
+#include "kernel_defines.h"
+#include "thread.h"
+#include "trace.h"
 #include "xtimer.h"
 
-#ifndef CONFIG_TRACE_BUFSIZE
-#define CONFIG_TRACE_BUFSIZE 512
+#if IS_USED(MODULE_VFS)
+#include "vfs.h"
 #endif
 
-typedef struct {
-    uint32_t time;
-    uint32_t val;
-} tracebuf_entry_t;
+/* entries drained per chunk, copied with interrupts disabled */
+#define DRAIN_CHUNK     (8U)
 
-static tracebuf_entry_t tracebuf[CONFIG_TRACE_BUFSIZE];
-static size_t tracebuf_pos;
+static trace_entry_t tracebuf[CONFIG_TRACE_BUFSIZE];
+static size_t tracebuf_idx;
+/* total number of entries added and drained, only their difference matters */
+static uint32_t tracebuf_pos;
+static uint32_t tracebuf_drained;
+static uint32_t trace_mask = CONFIG_TRACE_EVENTS_MASK;
 
-void trace(uint32_t val)
+static const char *_names[TRACE_EVENT_NUMOF] = {
+    [TRACE_USER] = "user",
+    [TRACE_SCHED_SWITCH] = "sched",
+    [TRACE_MSG_SEND] = "msg_send",
+    [TRACE_MSG_RECV] = "msg_recv",
+    [TRACE_MUTEX_CONTEND] = "mutex",
+    [TRACE_PKTBUF_ALLOC] = "pkt_alloc",
+    [TRACE_PKTBUF_FREE] = "pkt_free",
+    [TRACE_NETIF_TX] = "netif_tx",
+    [TRACE_NETIF_RX] = "netif_rx",
+};
+
+/* index of the entry @p age entries before the next one to write */
+static inline size_t _idx(uint32_t age)
+{
+    return (tracebuf_idx + CONFIG_TRACE_BUFSIZE - age) % CONFIG_TRACE_BUFSIZE;
+}
+
+static void _add(trace_event_type_t type, uint16_t arg16, uint32_t arg)
 {
+    uint8_t pid = irq_is_in() ? TRACE_PID_ISR : (uint8_t)thread_getpid();
     unsigned state = irq_disable();
+    trace_entry_t *entry = &tracebuf[tracebuf_idx];
 
-    tracebuf[tracebuf_pos % CONFIG_TRACE_BUFSIZE] =
-        (tracebuf_entry_t){ .time = xtimer_now_usec(), .val = val };
+    entry->time = xtimer_now_usec();
+    entry->type = type;
+    entry->pid = pid;
+    entry->arg16 = arg16;
+    entry->arg = arg;
+    if (++tracebuf_idx == CONFIG_TRACE_BUFSIZE) {
+        tracebuf_idx = 0;
+    }
     tracebuf_pos++;
     irq_restore(state);
 }
 
+void trace(uint32_t val)
+{
+    _add(TRACE_USER, 0, val);
+}
+
+void trace_event(trace_event_type_t type, uint16_t arg16, uint32_t arg)
+{
+    if (trace_mask & (1UL << type)) {
+        _add(type, arg16, arg);
+    }
+}
+
+void trace_set_mask(uint32_t mask)
+{
+    trace_mask = mask;
+}
+
 void trace_dump(void)
 {
     size_t n = tracebuf_pos >
@@ -54,17 +103,117 @@ void trace_dump(void)
     uint32_t t_last = 0;
 
     for (size_t i = 0; i < n; i++) {
-        printf("n=%4lu t=%s%8" PRIu32 " v=0x%08lx\n", (unsigned long)i,
+        const trace_entry_t *entry = &tracebuf[_idx(n - i)];
+
+        printf("n=%4lu t=%s%8" PRIu32 " v=0x%08lx", (unsigned long)i,
                i ? "+" : " ",
-               tracebuf[i].time - t_last, (unsigned long)tracebuf[i].val);
-        t_last = tracebuf[i].time;
+               entry->time - t_last, (unsigned long)entry->arg);
+        if (entry->type != TRACE_USER) {
+            printf(" e=%s p=%u a=%u",
+                   (entry->type < TRACE_EVENT_NUMOF) ? _names[entry->type] : "?",
+                   entry->pid, entry->arg16);
+        }
+        puts("");
+        t_last = entry->time;
     }
 }
 
+int trace_drain(trace_write_t write, void *arg)
+{
+    struct {
+        trace_hdr_t hdr;
+        trace_entry_t entries[DRAIN_CHUNK];
+    } chunk;
+    /* do not chase entries added while draining, e.g. by stdio */
+    uint32_t end = tracebuf_pos;
+    int drained = 0;
+
+    chunk.hdr.magic = TRACE_MAGIC;
+    chunk.hdr.version = TRACE_VERSION;
+    chunk.hdr.entry_size = sizeof(trace_entry_t);
+
+    while (1) {
+        unsigned state = irq_disable();
+        uint32_t avail = tracebuf_pos - tracebuf_drained;
+        unsigned count = 0;
+
+        chunk.hdr.lost = 0;
+        if (avail > CONFIG_TRACE_BUFSIZE) {
+            chunk.hdr.lost = avail - CONFIG_TRACE_BUFSIZE;
+            tracebuf_drained += chunk.hdr.lost;
+        }
+        while ((count < DRAIN_CHUNK) &&
+               ((int32_t)(end - tracebuf_drained) > 0)) {
+            chunk.entries[count++] =
+                tracebuf[_idx(tracebuf_pos - tracebuf_drained)];
+            tracebuf_drained++;
+        }
+        irq_restore(state);
+
+        if ((count == 0) && (chunk.hdr.lost == 0)) {
+            return drained;
+        }
+        chunk.hdr.count = count;
+        int res = write(arg, &chunk, sizeof(chunk.hdr) +
+                        count * sizeof(trace_entry_t));
+        if (res < 0) {
+            return res;
+        }
+        drained += count;
+        if (count < DRAIN_CHUNK) {
+            return drained;
+        }
+    }
+}
+
+static int _write_stdio(void *arg, const void *data, size_t len)
+{
+    static const char hex[] = "0123456789abcdef";
+    const uint8_t *bytes = data;
+
+    (void)arg;
+    printf("TRACE:");
+    for (size_t i = 0; i < len; i++) {
+        putchar(hex[bytes[i] >> 4]);
+        putchar(hex[bytes[i] & 0xf]);
+    }
+    puts("");
+    return 0;
+}
+
+int trace_drain_stdio(void)
+{
+    return trace_drain(_write_stdio, NULL);
+}
+
+#if IS_USED(MODULE_VFS)
+static int _write_vfs(void *arg, const void *data, size_t len)
+{
+    int fd = *(int *)arg;
+
+    while (len) {
+        ssize_t res = vfs_write(fd, data, len);
+        if (res < 0) {
+            return res;
+        }
+        data = (const uint8_t *)data + res;
+        len -= res;
+    }
+    return 0;
+}
+
+int trace_drain_vfs(int fd)
+{
+    return trace_drain(_write_vfs, &fd);
+}
+#endif
+
 void trace_reset(void)
 {
     unsigned state = irq_disable();
 
+    tracebuf_idx = 0;
     tracebuf_pos = 0;
+    tracebuf_drained = 0;
     irq_restore(state);
 }
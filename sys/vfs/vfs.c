@@ -15,6 +15,7 @@
  */
 
 #include <errno.h> /* for error codes */
+#include <stdbool.h>
 #include <string.h> /* for strncmp */
 #include <stddef.h> /* for NULL */
 #include <sys/types.h> /* for off_t etc */
@@ -24,6 +25,9 @@
 #include <unistd.h> /* for STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO */
 
 #include "vfs.h"
+#include "bitarithm.h"
+#include "irq.h"
+#include "kernel_defines.h"
 #include "mutex.h"
 #include "thread.h"
 #include "sched.h"
@@ -32,6 +36,8 @@
 #define ENABLE_DEBUG 0
 #include "debug.h"
 
+#define MIN(a, b) ((a) > (b) ? (b) : (a))
+
 #if IS_ACTIVE(ENABLE_DEBUG)
 /* Since some of these functions are called by printf, we can't really call
  * printf from our functions or we end up in an infinite recursion. */
@@ -51,12 +57,23 @@
  */
 static vfs_file_t _vfs_open_files[VFS_MAX_OPEN_FILES];
 
+/**
+ * @internal
+ * @brief Bitmap of the used entries in the _vfs_open_files array
+ *
+ * Mirrors the pid member of the entries, so a free fd is found without
+ * iterating the whole table.
+ */
+static unsigned _vfs_used_fds[(VFS_MAX_OPEN_FILES + (8 * sizeof(unsigned)) - 1) /
+                              (8 * sizeof(unsigned))];
+
 /**
  * @internal
  * @brief List handle for list of all currently mounted file systems
  *
  * This singly linked list is used to dispatch vfs calls to the appropriate file
- * system driver.
+ * system driver. It is sorted by the length of the mount point, longest first,
+ * so the first match is the most specific mount.
  */
 static clist_node_t _vfs_mounts_list;
 
@@ -130,9 +147,286 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
  */
 static inline int _fd_is_valid(int fd);
 
+/**
+ * @internal
+ * @brief Seek to position in file, bypassing the buffer of the file
+ *
+ * @param[in]  filp     pointer to open file
+ * @param[in]  off      seek offset
+ * @param[in]  whence   seek method, see vfs_lseek
+ *
+ * @return the new seek location in the file on success
+ * @return <0 on error
+ */
+static off_t _lseek(vfs_file_t *filp, off_t off, int whence);
+
 static mutex_t _mount_mutex = MUTEX_INIT;
 static mutex_t _open_mutex = MUTEX_INIT;
 
+#if IS_USED(MODULE_VFS_STAT_CACHE)
+/**
+ * @internal
+ * @brief Entry of the stat cache
+ */
+typedef struct {
+    vfs_mount_t *mp;                        /**< mount of the file, NULL if unused */
+    char path[VFS_STAT_CACHE_PATH_MAX];     /**< absolute path of the file */
+    struct stat st;                         /**< status of the file */
+} _stat_cache_entry_t;
+
+static _stat_cache_entry_t _stat_cache[VFS_STAT_CACHE_SIZE];
+static unsigned _stat_cache_next;
+static mutex_t _stat_cache_mutex = MUTEX_INIT;
+
+static bool _stat_cache_get(const char *path, struct stat *buf)
+{
+    bool found = false;
+
+    mutex_lock(&_stat_cache_mutex);
+    for (unsigned i = 0; i < VFS_STAT_CACHE_SIZE; i++) {
+        if ((_stat_cache[i].mp != NULL) &&
+            (strcmp(_stat_cache[i].path, path) == 0)) {
+            *buf = _stat_cache[i].st;
+            found = true;
+            break;
+        }
+    }
+    mutex_unlock(&_stat_cache_mutex);
+    return found;
+}
+
+static void _stat_cache_put(vfs_mount_t *mountp, const char *path,
+                            const struct stat *buf)
+{
+    if (strlen(path) >= VFS_STAT_CACHE_PATH_MAX) {
+        return;
+    }
+    mutex_lock(&_stat_cache_mutex);
+    _stat_cache_entry_t *entry = &_stat_cache[_stat_cache_next];
+    _stat_cache_next = (_stat_cache_next + 1) % VFS_STAT_CACHE_SIZE;
+    entry->mp = mountp;
+    strcpy(entry->path, path);
+    entry->st = *buf;
+    mutex_unlock(&_stat_cache_mutex);
+}
+
+/* drops all entries of @p mountp, or all entries if @p mountp is NULL */
+static void _stat_cache_invalidate(const vfs_mount_t *mountp)
+{
+    mutex_lock(&_stat_cache_mutex);
+    for (unsigned i = 0; i < VFS_STAT_CACHE_SIZE; i++) {
+        if ((mountp == NULL) || (_stat_cache[i].mp == mountp)) {
+            _stat_cache[i].mp = NULL;
+        }
+    }
+    mutex_unlock(&_stat_cache_mutex);
+}
+#else
+static inline bool _stat_cache_get(const char *path, struct stat *buf)
+{
+    (void)path;
+    (void)buf;
+    return false;
+}
+
+static inline void _stat_cache_put(vfs_mount_t *mountp, const char *path,
+                                   const struct stat *buf)
+{
+    (void)mountp;
+    (void)path;
+    (void)buf;
+}
+
+static inline void _stat_cache_invalidate(const vfs_mount_t *mountp)
+{
+    (void)mountp;
+}
+#endif
+
+/**
+ * @internal
+ * @brief Buffer of an open file (`vfs_buffered` module)
+ *
+ * The buffer either holds data written by the user that was not passed to the
+ * file system driver yet (@p dirty), or data read ahead from the file. @p pos
+ * is the offset of the file position of the user in @p data. The position of
+ * the driver is at @p data[0] while the buffer is dirty and at @p data[len]
+ * otherwise.
+ */
+typedef struct {
+    vfs_file_t *filp;                   /**< file of the buffer, NULL if unused */
+    unsigned pos;                       /**< position of the user in @p data */
+    unsigned len;                       /**< number of valid bytes in @p data */
+    bool dirty;                         /**< @p data was not written yet */
+    uint8_t data[VFS_BUFFERED_SIZE];    /**< buffered data */
+} _vfs_buffer_t;
+
+#if IS_USED(MODULE_VFS_BUFFERED)
+static _vfs_buffer_t _vfs_buffers[VFS_BUFFERED_FILES];
+#endif
+
+static inline _vfs_buffer_t *_buf_get(const vfs_file_t *filp)
+{
+#if IS_USED(MODULE_VFS_BUFFERED)
+    for (unsigned i = 0; i < VFS_BUFFERED_FILES; i++) {
+        if (_vfs_buffers[i].filp == filp) {
+            return &_vfs_buffers[i];
+        }
+    }
+#else
+    (void)filp;
+#endif
+    return NULL;
+}
+
+static inline void _buf_attach(vfs_file_t *filp)
+{
+#if IS_USED(MODULE_VFS_BUFFERED)
+    mutex_lock(&_open_mutex);
+    _vfs_buffer_t *buf = _buf_get(NULL);
+    if (buf != NULL) {
+        buf->filp = filp;
+        buf->pos = 0;
+        buf->len = 0;
+        buf->dirty = false;
+    }
+    mutex_unlock(&_open_mutex);
+#else
+    (void)filp;
+#endif
+}
+
+/* passes dirty data to the file system driver, keeps what was not written */
+static int _buf_write_back(vfs_file_t *filp, _vfs_buffer_t *buf)
+{
+    unsigned done = 0;
+    int res = 0;
+
+    if (!buf->dirty) {
+        /* data read ahead stays valid */
+        return 0;
+    }
+    while (done < buf->len) {
+        ssize_t n = filp->f_op->write(filp, &buf->data[done], buf->len - done);
+        if (n <= 0) {
+            res = (n < 0) ? n : -EIO;
+            break;
+        }
+        done += n;
+    }
+    if (done > 0) {
+        /* the size was cached before the data reached the driver */
+        _stat_cache_invalidate(filp->mp);
+    }
+    memmove(buf->data, &buf->data[done], buf->len - done);
+    buf->len -= done;
+    buf->pos = buf->len;
+    buf->dirty = (buf->len > 0);
+    return res;
+}
+
+/* passes the dirty data of all files on @p mountp to the driver */
+static int _buf_write_back_mount(const vfs_mount_t *mountp)
+{
+    int res = 0;
+
+#if IS_USED(MODULE_VFS_BUFFERED)
+    for (unsigned i = 0; i < VFS_BUFFERED_FILES; i++) {
+        _vfs_buffer_t *buf = &_vfs_buffers[i];
+        if ((buf->filp != NULL) && (buf->filp->mp == mountp)) {
+            int err = _buf_write_back(buf->filp, buf);
+            res = (res < 0) ? res : err;
+        }
+    }
+#else
+    (void)mountp;
+#endif
+    return res;
+}
+
+/* empties the buffer, so the driver is at the position of the user */
+static int _buf_sync(vfs_file_t *filp, _vfs_buffer_t *buf)
+{
+    if (buf->dirty) {
+        return _buf_write_back(filp, buf);
+    }
+    if (buf->pos < buf->len) {
+        /* the driver read ahead of the user, seek back */
+        off_t res = _lseek(filp, (off_t)buf->pos - (off_t)buf->len, SEEK_CUR);
+        if (res < 0) {
+            return res;
+        }
+    }
+    buf->pos = 0;
+    buf->len = 0;
+    return 0;
+}
+
+static ssize_t _buf_read(vfs_file_t *filp, _vfs_buffer_t *buf, uint8_t *dest,
+                         size_t count)
+{
+    size_t done = 0;
+    ssize_t res;
+
+    if (buf->dirty && ((res = _buf_write_back(filp, buf)) < 0)) {
+        return res;
+    }
+    while (done < count) {
+        if (buf->pos == buf->len) {
+            /* buffer is drained, the driver is at the position of the user */
+            buf->pos = 0;
+            buf->len = 0;
+            if ((count - done) >= VFS_BUFFERED_SIZE) {
+                /* large reads bypass the buffer */
+                res = filp->f_op->read(filp, &dest[done], count - done);
+                return (res < 0) ? ((done > 0) ? (ssize_t)done : res)
+                                 : (ssize_t)(done + res);
+            }
+            res = filp->f_op->read(filp, buf->data, VFS_BUFFERED_SIZE);
+            if (res <= 0) {
+                return (done > 0) ? (ssize_t)done : res;
+            }
+            buf->len = res;
+        }
+        size_t n = MIN(count - done, buf->len - buf->pos);
+        memcpy(&dest[done], &buf->data[buf->pos], n);
+        buf->pos += n;
+        done += n;
+    }
+    return done;
+}
+
+static ssize_t _buf_write(vfs_file_t *filp, _vfs_buffer_t *buf,
+                          const uint8_t *src, size_t count)
+{
+    size_t done = 0;
+    ssize_t res;
+
+    /* drop the data read ahead */
+    if (!buf->dirty && ((res = _buf_sync(filp, buf)) < 0)) {
+        return res;
+    }
+    while (done < count) {
+        if ((buf->len == VFS_BUFFERED_SIZE) &&
+            ((res = _buf_write_back(filp, buf)) < 0)) {
+            return (done > 0) ? (ssize_t)done : res;
+        }
+        if ((buf->len == 0) && ((count - done) >= VFS_BUFFERED_SIZE)) {
+            /* large writes bypass the buffer */
+            res = filp->f_op->write(filp, &src[done], count - done);
+            return (res < 0) ? ((done > 0) ? (ssize_t)done : res)
+                             : (ssize_t)(done + res);
+        }
+        size_t n = MIN(count - done, VFS_BUFFERED_SIZE - buf->len);
+        memcpy(&buf->data[buf->len], &src[done], n);
+        buf->len += n;
+        buf->pos = buf->len;
+        buf->dirty = true;
+        done += n;
+    }
+    return done;
+}
+
 int vfs_close(int fd)
 {
     DEBUG("vfs_close: %d\n", fd);
@@ -141,10 +435,18 @@ int vfs_close(int fd)
         return res;
     }
     vfs_file_t *filp = &_vfs_open_files[fd];
+    _vfs_buffer_t *buf = _buf_get(filp);
+    if (buf != NULL) {
+        res = _buf_write_back(filp, buf);
+        buf->filp = NULL;
+    }
     if (filp->f_op->close != NULL) {
         /* We will invalidate the fd regardless of the outcome of the file
          * system driver close() call below */
-        res = filp->f_op->close(filp);
+        int close_res = filp->f_op->close(filp);
+        if (res == 0) {
+            res = close_res;
+        }
     }
     _free_fd(fd);
     return res;
@@ -190,6 +492,11 @@ int vfs_fstat(int fd, struct stat *buf)
         /* driver does not implement fstat() */
         return -EINVAL;
     }
+    _vfs_buffer_t *fbuf = _buf_get(filp);
+    if ((fbuf != NULL) && ((res = _buf_write_back(filp, fbuf)) < 0)) {
+        /* the size would be outdated */
+        return res;
+    }
     return filp->f_op->fstat(filp, buf);
 }
 
@@ -223,6 +530,26 @@ off_t vfs_lseek(int fd, off_t off, int whence)
         return res;
     }
     vfs_file_t *filp = &_vfs_open_files[fd];
+    _vfs_buffer_t *buf = _buf_get(filp);
+    if (buf != NULL) {
+        if ((whence == SEEK_CUR) && (off == 0)) {
+            /* only query the position, keep the buffer */
+            off_t pos = _lseek(filp, 0, SEEK_CUR);
+            if (pos < 0) {
+                return pos;
+            }
+            return pos + (off_t)buf->pos - (buf->dirty ? 0 : (off_t)buf->len);
+        }
+        res = _buf_sync(filp, buf);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return _lseek(filp, off, whence);
+}
+
+static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
+{
     if (filp->f_op->lseek == NULL) {
         /* driver does not implement lseek() */
         /* default seek functionality is naive */
@@ -274,6 +601,9 @@ int vfs_open(const char *name, int flags, mode_t mode)
         atomic_fetch_sub(&mountp->open_files, 1);
         return fd;
     }
+    if (flags & (O_CREAT | O_TRUNC)) {
+        _stat_cache_invalidate(mountp);
+    }
     vfs_file_t *filp = &_vfs_open_files[fd];
     if (filp->f_op->open != NULL) {
         res = filp->f_op->open(filp, rel_path, flags, mode, name);
@@ -285,6 +615,7 @@ int vfs_open(const char *name, int flags, mode_t mode)
             return res;
         }
     }
+    _buf_attach(filp);
     DEBUG("vfs_open: opened %d\n", fd);
     return fd;
 }
@@ -308,6 +639,10 @@ ssize_t vfs_read(int fd, void *dest, size_t count)
         /* driver does not implement read() */
         return -EINVAL;
     }
+    _vfs_buffer_t *buf = _buf_get(filp);
+    if (buf != NULL) {
+        return _buf_read(filp, buf, dest, count);
+    }
     return filp->f_op->read(filp, dest, count);
 }
 
@@ -330,9 +665,35 @@ ssize_t vfs_write(int fd, const void *src, size_t count)
         /* driver does not implement write() */
         return -EINVAL;
     }
+    if (filp->mp != NULL) {
+        _stat_cache_invalidate(filp->mp);
+    }
+    _vfs_buffer_t *buf = _buf_get(filp);
+    if (buf != NULL) {
+        return _buf_write(filp, buf, src, count);
+    }
     return filp->f_op->write(filp, src, count);
 }
 
+int vfs_fsync(int fd)
+{
+    DEBUG("vfs_fsync: %d\n", fd);
+    int res = _fd_is_valid(fd);
+    if (res < 0) {
+        return res;
+    }
+    vfs_file_t *filp = &_vfs_open_files[fd];
+    _vfs_buffer_t *buf = _buf_get(filp);
+    if ((buf != NULL) && ((res = _buf_write_back(filp, buf)) < 0)) {
+        return res;
+    }
+    if (filp->f_op->fsync == NULL) {
+        /* driver does not buffer anything */
+        return 0;
+    }
+    return filp->f_op->fsync(filp);
+}
+
 int vfs_opendir(vfs_DIR *dirp, const char *dirname)
 {
     DEBUG("vfs_opendir: %p, \"%s\"\n", (void *)dirp, dirname);
@@ -481,9 +842,33 @@ int vfs_mount(vfs_mount_t *mountp)
             }
         }
     }
-    /* insert last in list */
-    clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+    /* insert after the last mount with a longer or equally long mount point */
+    clist_node_t *last = _vfs_mounts_list.next;
+    clist_node_t *prev = NULL;
+    if (last != NULL) {
+        clist_node_t *node = last->next;
+        do {
+            vfs_mount_t *it = container_of(node, vfs_mount_t, list_entry);
+            if (it->mount_point_len < mountp->mount_point_len) {
+                break;
+            }
+            prev = node;
+            node = node->next;
+        } while (prev != last);
+    }
+    if (prev == NULL) {
+        clist_lpush(&_vfs_mounts_list, &mountp->list_entry);
+    }
+    else if (prev == last) {
+        clist_rpush(&_vfs_mounts_list, &mountp->list_entry);
+    }
+    else {
+        mountp->list_entry.next = prev->next;
+        prev->next = &mountp->list_entry;
+    }
     mutex_unlock(&_mount_mutex);
+    /* the new mount may hide files of other mounts */
+    _stat_cache_invalidate(NULL);
     DEBUG("vfs_mount: mount done\n");
     return 0;
 }
@@ -529,6 +914,7 @@ int vfs_umount(vfs_mount_t *mountp)
         return -EINVAL;
     }
     mutex_unlock(&_mount_mutex);
+    _stat_cache_invalidate(mountp);
     return 0;
 }
 
@@ -574,6 +960,7 @@ int vfs_rename(const char *from_path, const char *to_path)
         return -EXDEV;
     }
     res = mountp->fs->fs_op->rename(mountp, rel_from, rel_to);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_rename: rename %p, \"%s\" -> \"%s\"", (void *)mountp, rel_from, rel_to);
     if (res < 0) {
         /* something went wrong during rename */
@@ -614,6 +1001,7 @@ int vfs_unlink(const char *name)
         return -EPERM;
     }
     res = mountp->fs->fs_op->unlink(mountp, rel_path);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_unlink: unlink %p, \"%s\"", (void *)mountp, rel_path);
     if (res < 0) {
         /* something went wrong during unlink */
@@ -651,6 +1039,7 @@ int vfs_mkdir(const char *name, mode_t mode)
         return -EPERM;
     }
     res = mountp->fs->fs_op->mkdir(mountp, rel_path, mode);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_mkdir: mkdir %p, \"%s\"", (void *)mountp, rel_path);
     if (res < 0) {
         /* something went wrong during mkdir */
@@ -688,6 +1077,7 @@ int vfs_rmdir(const char *name)
         return -EPERM;
     }
     res = mountp->fs->fs_op->rmdir(mountp, rel_path);
+    _stat_cache_invalidate(mountp);
     DEBUG("vfs_rmdir: rmdir %p, \"%s\"", (void *)mountp, rel_path);
     if (res < 0) {
         /* something went wrong during rmdir */
@@ -717,6 +1107,12 @@ int vfs_stat(const char *restrict path, struct stat *restrict buf)
         DEBUG("vfs_stat: no matching mount\n");
         return res;
     }
+    /* the size has to include data that is still buffered */
+    res = _buf_write_back_mount(mountp);
+    if ((res == 0) && _stat_cache_get(path, buf)) {
+        atomic_fetch_sub(&mountp->open_files, 1);
+        return 0;
+    }
     if ((mountp->fs->fs_op == NULL) || (mountp->fs->fs_op->stat == NULL)) {
         /* stat not supported */
         DEBUG("vfs_stat: stat not supported by fs!\n");
@@ -725,6 +1121,9 @@ int vfs_stat(const char *restrict path, struct stat *restrict buf)
         return -EPERM;
     }
     res = mountp->fs->fs_op->stat(mountp, rel_path, buf);
+    if (res == 0) {
+        _stat_cache_put(mountp, path, buf);
+    }
     /* remember to decrement the open_files count */
     atomic_fetch_sub(&mountp->open_files, 1);
     return res;
@@ -873,30 +1272,44 @@ const vfs_file_t *vfs_file_get(int fd)
     }
 }
 
+/* number of bits in an entry of _vfs_used_fds */
+#define FD_BITS     (8 * sizeof(unsigned))
+
 static inline int _allocate_fd(int fd)
 {
+    unsigned state = irq_disable();
     if (fd < 0) {
-        for (fd = 0; fd < VFS_MAX_OPEN_FILES; ++fd) {
-            if ((fd == STDIN_FILENO) || (fd == STDOUT_FILENO) || (fd == STDERR_FILENO)) {
+        for (unsigned i = 0; i < ARRAY_SIZE(_vfs_used_fds); i++) {
+            unsigned unused = ~_vfs_used_fds[i];
+            if (i == 0) {
                 /* Do not auto-allocate the stdio file descriptor numbers to
                  * avoid conflicts between normal file system users and stdio
                  * drivers such as stdio_uart, stdio_rtt which need to be able
                  * to bind to these specific file descriptor numbers. */
-                continue;
+                unused &= ~((1U << STDIN_FILENO) | (1U << STDOUT_FILENO) |
+                          (1U << STDERR_FILENO));
             }
-            if (_vfs_open_files[fd].pid == KERNEL_PID_UNDEF) {
+            if (unused != 0) {
+                fd = (i * FD_BITS) + bitarithm_lsb(unused);
                 break;
             }
         }
+        if (fd < 0) {
+            fd = VFS_MAX_OPEN_FILES;
+        }
     }
     if (fd >= VFS_MAX_OPEN_FILES) {
         /* The _vfs_open_files array is full */
+        irq_restore(state);
         return -ENFILE;
     }
     else if (_vfs_open_files[fd].pid != KERNEL_PID_UNDEF) {
         /* The desired fd is already in use */
+        irq_restore(state);
         return -EEXIST;
     }
+    _vfs_used_fds[fd / FD_BITS] |= 1U << (fd % FD_BITS);
+    irq_restore(state);
     kernel_pid_t pid = thread_getpid();
     if (pid == KERNEL_PID_UNDEF) {
         /* This happens when calling vfs_bind during boot, before threads have
@@ -914,6 +1327,9 @@ static inline void _free_fd(int fd)
         atomic_fetch_sub(&_vfs_open_files[fd].mp->open_files, 1);
     }
     _vfs_open_files[fd].pid = KERNEL_PID_UNDEF;
+    unsigned state = irq_disable();
+    _vfs_used_fds[fd / FD_BITS] &= ~(1U << (fd % FD_BITS));
+    irq_restore(state);
 }
 
 static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *mountp, int flags, void *private_data)
@@ -933,7 +1349,6 @@ static inline int _init_fd(int fd, const vfs_file_ops_t *f_op, vfs_mount_t *moun
 
 static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const char **rel_path)
 {
-    size_t longest_match = 0;
     size_t name_len = strlen(name);
     mutex_lock(&_mount_mutex);
 
@@ -944,14 +1359,11 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
         return -ENOENT;
     }
     vfs_mount_t *mountp = NULL;
+    size_t len = 0;
     do {
         node = node->next;
         vfs_mount_t *it = container_of(node, vfs_mount_t, list_entry);
-        size_t len = it->mount_point_len;
-        if (len < longest_match) {
-            /* Already found a longer prefix */
-            continue;
-        }
+        len = it->mount_point_len;
         if (len > name_len) {
             /* path name is shorter than the mount point name */
             continue;
@@ -961,12 +1373,10 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
             continue;
         }
         if (strncmp(name, it->mount_point, len) == 0) {
-            /* mount_point is a prefix of name */
-            /* special check for mount_point == "/" */
-            if (len > 1) {
-                longest_match = len;
-            }
+            /* mount_point is a prefix of name, and the list is sorted by
+             * length, so there is no longer one */
             mountp = it;
+            break;
         }
     } while (node != _vfs_mounts_list.next);
     if (mountp == NULL) {
@@ -979,7 +1389,8 @@ static inline int _find_mount(vfs_mount_t **mountpp, const char *name, const cha
     mutex_unlock(&_mount_mutex);
     *mountpp = mountp;
     if (rel_path != NULL) {
-        *rel_path = name + longest_match;
+        /* special check for mount_point == "/" */
+        *rel_path = name + ((len > 1) ? len : 0);
     }
     return 0;
 }
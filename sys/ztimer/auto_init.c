@@ -47,6 +47,7 @@
 #include "ztimer/periph_timer.h"
 #include "ztimer/periph_rtt.h"
 #include "ztimer/periph_rtc.h"
+#include "ztimer/wheel.h"
 #include "ztimer/config.h"
 
 #include "log.h"
@@ -213,6 +214,18 @@ ztimer_clock_t *const ZTIMER_SEC = &_ztimer_convert_frac_sec.super.super;
 #  endif
 #endif
 
+#if MODULE_ZTIMER_WHEEL
+#  if MODULE_ZTIMER_USEC && CONFIG_ZTIMER_USEC_WHEEL
+static ztimer_wheel_t _ztimer_wheel_usec;
+#  endif
+#  if MODULE_ZTIMER_MSEC && CONFIG_ZTIMER_MSEC_WHEEL
+static ztimer_wheel_t _ztimer_wheel_msec;
+#  endif
+#  if MODULE_ZTIMER_SEC && CONFIG_ZTIMER_SEC_WHEEL
+static ztimer_wheel_t _ztimer_wheel_sec;
+#  endif
+#endif
+
 void ztimer_init(void)
 {
 /* Step 4: initialize used ztimer-periphery */
@@ -301,5 +314,21 @@ void ztimer_init(void)
                              FREQ_1HZ, ZTIMER_SEC_CONVERT_LOWER_FREQ);
 #  endif
 #endif
+
+/* Step 6: switch clocks to timer wheel mode */
+#if MODULE_ZTIMER_WHEEL
+#  if MODULE_ZTIMER_USEC && CONFIG_ZTIMER_USEC_WHEEL
+    LOG_DEBUG("ztimer_init(): ZTIMER_USEC using timer wheel\n");
+    ztimer_wheel_init(ZTIMER_USEC, &_ztimer_wheel_usec);
+#  endif
+#  if MODULE_ZTIMER_MSEC && CONFIG_ZTIMER_MSEC_WHEEL
+    LOG_DEBUG("ztimer_init(): ZTIMER_MSEC using timer wheel\n");
+    ztimer_wheel_init(ZTIMER_MSEC, &_ztimer_wheel_msec);
+#  endif
+#  if MODULE_ZTIMER_SEC && CONFIG_ZTIMER_SEC_WHEEL
+    LOG_DEBUG("ztimer_init(): ZTIMER_SEC using timer wheel\n");
+    ztimer_wheel_init(ZTIMER_SEC, &_ztimer_wheel_sec);
+#  endif
+#endif
 }
 #endif /* IS_USED(MODULE_AUTO_INIT_ZTIMER) */
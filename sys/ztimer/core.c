@@ -23,6 +23,7 @@
  * @}
  */
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <inttypes.h>
 
@@ -32,6 +33,9 @@
 #include "pm_layered.h"
 #endif
 #include "ztimer.h"
+#ifdef MODULE_ZTIMER_WHEEL
+#include "ztimer/wheel.h"
+#endif
 
 #define ENABLE_DEBUG 0
 #include "debug.h"
@@ -48,8 +52,50 @@ static inline uint32_t _min_u32(uint32_t a, uint32_t b)
 }
 #endif
 
+static inline bool _is_wheel(const ztimer_clock_t *clock)
+{
+#ifdef MODULE_ZTIMER_WHEEL
+    return clock->wheel != NULL;
+#else
+    (void)clock;
+    return false;
+#endif
+}
+
+#ifdef MODULE_PM_LAYERED
+static bool _is_empty(const ztimer_clock_t *clock)
+{
+#ifdef MODULE_ZTIMER_WHEEL
+    if (_is_wheel(clock)) {
+        return ztimer_wheel_is_empty(clock);
+    }
+#endif
+    return clock->list.next == NULL;
+}
+#endif
+
+/* gets the ticks from clock->list.offset until the next event, if any */
+static inline bool _next_offset(const ztimer_clock_t *clock, uint32_t *offset)
+{
+#ifdef MODULE_ZTIMER_WHEEL
+    if (_is_wheel(clock)) {
+        return ztimer_wheel_next(clock, offset);
+    }
+#endif
+    if (clock->list.next) {
+        *offset = clock->list.next->offset;
+        return true;
+    }
+    return false;
+}
+
 static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
 {
+#ifdef MODULE_ZTIMER_WHEEL
+    if (_is_wheel(clock)) {
+        return t->base.pprev != NULL;
+    }
+#endif
     if (!clock->list.next) {
         return 0;
     }
@@ -103,7 +149,12 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
 
     timer->base.offset = val;
     _add_entry_to_list(clock, &timer->base);
-    if (clock->list.next == &timer->base) {
+    if (_is_wheel(clock)) {
+        /* the new timer might be filed in a slot cascading before the
+         * currently set target */
+        _ztimer_update(clock);
+    }
+    else if (clock->list.next == &timer->base) {
 #ifdef MODULE_ZTIMER_EXTEND
         if (clock->max_value < UINT32_MAX) {
             val = _min_u32(val, clock->max_value >> 1);
@@ -124,12 +175,19 @@ static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 
 #ifdef MODULE_PM_LAYERED
     /* First timer on the clock's linked list */
-    if (list->next == NULL &&
+    if (_is_empty(clock) &&
         clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
         pm_block(clock->block_pm_mode);
     }
 #endif
 
+#ifdef MODULE_ZTIMER_WHEEL
+    if (_is_wheel(clock)) {
+        ztimer_wheel_add(clock, entry);
+        return;
+    }
+#endif
+
     /* Jump past all entries which are set to an earlier target than the new entry */
     while (list->next) {
         ztimer_base_t *list_entry = list->next;
@@ -192,6 +250,13 @@ void ztimer_update_head_offset(ztimer_clock_t *clock)
     uint32_t now = ztimer_now(clock);
     uint32_t diff = now - old_base;
 
+#ifdef MODULE_ZTIMER_WHEEL
+    if (_is_wheel(clock)) {
+        ztimer_wheel_update(clock, now);
+        return;
+    }
+#endif
+
     ztimer_base_t *entry = clock->list.next;
 
     DEBUG(
@@ -235,31 +300,39 @@ static void _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 
     assert(_is_set(clock, (ztimer_t *)entry));
 
-    while (list->next) {
-        ztimer_base_t *list_entry = list->next;
-        if (list_entry == entry) {
-            if (entry == clock->last) {
-                /* if entry was the last timer, set the clocks last to the
-                 * previous entry, or NULL if that was the list ptr */
-                clock->last = (list == &clock->list) ? NULL : list;
-            }
+#ifdef MODULE_ZTIMER_WHEEL
+    if (_is_wheel(clock)) {
+        ztimer_wheel_del(clock, entry);
+    }
+    else
+#endif
+    {
+        while (list->next) {
+            ztimer_base_t *list_entry = list->next;
+            if (list_entry == entry) {
+                if (entry == clock->last) {
+                    /* if entry was the last timer, set the clocks last to the
+                     * previous entry, or NULL if that was the list ptr */
+                    clock->last = (list == &clock->list) ? NULL : list;
+                }
 
-            list->next = entry->next;
-            if (list->next) {
-                list_entry = list->next;
-                list_entry->offset += entry->offset;
-            }
+                list->next = entry->next;
+                if (list->next) {
+                    list_entry = list->next;
+                    list_entry->offset += entry->offset;
+                }
 
-            /* reset the entry's next pointer so _is_set() considers it unset */
-            entry->next = NULL;
-            break;
+                /* reset the entry's next pointer so _is_set() considers it unset */
+                entry->next = NULL;
+                break;
+            }
+            list = list->next;
         }
-        list = list->next;
     }
 
 #ifdef MODULE_PM_LAYERED
     /* The last timer just got removed from the clock's linked list */
-    if (clock->list.next == NULL &&
+    if (_is_empty(clock) &&
         clock->block_pm_mode != ZTIMER_CLOCK_NO_REQUIRED_PM_MODE) {
         pm_unblock(clock->block_pm_mode);
     }
@@ -270,6 +343,16 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
 {
     ztimer_base_t *entry = clock->list.next;
 
+#ifdef MODULE_ZTIMER_WHEEL
+    /* in timer wheel mode, the list only holds expired timers */
+    if (_is_wheel(clock)) {
+        if (entry) {
+            _del_entry_from_list(clock, entry);
+        }
+        return (ztimer_t *)entry;
+    }
+#endif
+
     if (entry && (entry->offset == 0)) {
         clock->list.next = entry->next;
         if (!entry->next) {
@@ -294,12 +377,13 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
 
 static void _ztimer_update(ztimer_clock_t *clock)
 {
+    uint32_t offset = 0;
+    bool pending = _next_offset(clock, &offset);
+
 #ifdef MODULE_ZTIMER_EXTEND
     if (clock->max_value < UINT32_MAX) {
-        if (clock->list.next) {
-            clock->ops->set(clock,
-                            _min_u32(clock->list.next->offset,
-                                     clock->max_value >> 1));
+        if (pending) {
+            clock->ops->set(clock, _min_u32(offset, clock->max_value >> 1));
         }
         else {
             clock->ops->set(clock, clock->max_value >> 1);
@@ -309,8 +393,8 @@ static void _ztimer_update(ztimer_clock_t *clock)
 #endif
     }
     else {
-        if (clock->list.next) {
-            clock->ops->set(clock, clock->list.next->offset);
+        if (pending) {
+            clock->ops->set(clock, offset);
         }
         else {
             if (IS_USED(MODULE_ZTIMER_NOW64)) {
@@ -332,13 +416,16 @@ void ztimer_handler(ztimer_clock_t *clock)
         _ztimer_print(clock);
     }
 
+    uint32_t offset = 0;
+    bool pending = _next_offset(clock, &offset);
+
 #if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64
     if (IS_USED(MODULE_ZTIMER_NOW64) || clock->max_value < UINT32_MAX) {
         /* calling now triggers checkpointing */
         uint32_t now = ztimer_now(clock);
 
-        if (clock->list.next) {
-            uint32_t target = clock->list.offset + clock->list.next->offset;
+        if (pending) {
+            uint32_t target = clock->list.offset + offset;
             int32_t diff = (int32_t)(target - now);
             if (diff > 0) {
                 DEBUG("ztimer_handler(): %p postponing by %" PRIi32 "\n",
@@ -362,8 +449,15 @@ void ztimer_handler(ztimer_clock_t *clock)
     }
 #endif
 
-    clock->list.offset += clock->list.next->offset;
-    clock->list.next->offset = 0;
+    if (_is_wheel(clock)) {
+        /* move all timers due by now to the expired timers, the event that
+         * triggered this call might as well just have been a cascade */
+        ztimer_update_head_offset(clock);
+    }
+    else {
+        clock->list.offset += offset;
+        clock->list.next->offset = 0;
+    }
 
     ztimer_t *entry = _now_next(clock);
     while (entry) {
@@ -395,6 +489,18 @@ static void _ztimer_print(const ztimer_clock_t *clock)
     const ztimer_base_t *entry = &clock->list;
     uint32_t last_offset = 0;
 
+#ifdef MODULE_ZTIMER_WHEEL
+    if (_is_wheel(clock)) {
+        printf("now %" PRIu32 ", expired %p, slot maps:", clock->list.offset,
+               (void *)clock->list.next);
+        for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+            printf(" 0x%08" PRIx32, clock->wheel->map[level]);
+        }
+        puts("");
+        return;
+    }
+#endif
+
     do {
         printf("0x%08x:%" PRIu32 "(%" PRIu32 ")%s", (unsigned)entry,
                entry->offset, entry->offset +
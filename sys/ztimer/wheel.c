@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ztimer_wheel
+ * @{
+ *
+ * @file
+ * @brief       ztimer timer wheel implementation
+ *
+ * A timer filed in level `n` has an absolute target `t` with
+ * `now + SLOTS ** n <= t < now + SLOTS ** (n + 1)` at the time of filing and
+ * is put into the slot selected by the level's digit of `t`. That slot comes
+ * up (i.e., `now` reaches a multiple of `SLOTS ** n` with the same digit)
+ * before `t` and is cascaded then: each of its timers is filed again relative
+ * to the new `now`. Level 0 slots hold timers of a single target tick.
+ *
+ * All functions are called by ztimer core with interrupts disabled.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "ztimer/wheel.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define _BITS       (CONFIG_ZTIMER_WHEEL_LEVEL_BITS)
+#define _MASK       (ZTIMER_WHEEL_SLOTS - 1)
+
+/* with a partial highest level, a rotation over all of its slots would not
+ * match the wrap around of the clock */
+static_assert((CONFIG_ZTIMER_WHEEL_LEVEL_BITS > 0) &&
+              (CONFIG_ZTIMER_WHEEL_LEVEL_BITS <= 4) &&
+              ((32 % CONFIG_ZTIMER_WHEEL_LEVEL_BITS) == 0),
+              "CONFIG_ZTIMER_WHEEL_LEVEL_BITS must be 1, 2 or 4");
+
+static inline void _link(ztimer_base_t **pprev, ztimer_base_t *entry)
+{
+    entry->next = *pprev;
+    if (entry->next) {
+        entry->next->pprev = &entry->next;
+    }
+    entry->pprev = pprev;
+    *pprev = entry;
+}
+
+static void _expire(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    /* append to the expired timers, so ztimer_handler() fires them */
+    _link(clock->last ? &clock->last->next : &clock->list.next, entry);
+    clock->last = entry;
+}
+
+static void _file(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t delta = entry->offset - clock->list.offset;
+    unsigned level = 0;
+    unsigned slot;
+
+    if (delta == 0) {
+        _expire(clock, entry);
+        return;
+    }
+    while ((level < (ZTIMER_WHEEL_LEVELS - 1)) &&
+           (delta >> ((level + 1) * _BITS))) {
+        level++;
+    }
+    slot = (entry->offset >> (level * _BITS)) & _MASK;
+    _link(&wheel->slots[level][slot], entry);
+    wheel->map[level] |= 1UL << slot;
+}
+
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel)
+{
+    unsigned state = irq_disable();
+    ztimer_base_t *entry = clock->list.next;
+    uint32_t target = clock->list.offset;
+
+    assert(clock->wheel == NULL);
+    memset(wheel, 0, sizeof(*wheel));
+    clock->list.next = NULL;
+    clock->last = NULL;
+    clock->wheel = wheel;
+    /* move timers already set (e.g. by a converter on top of this clock)
+     * from the list to the wheel */
+    while (entry) {
+        ztimer_base_t *next = entry->next;
+
+        target += entry->offset;
+        entry->offset = target;
+        _file(clock, entry);
+        entry = next;
+    }
+    irq_restore(state);
+}
+
+void ztimer_wheel_add(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    /* make the target absolute */
+    entry->offset += clock->list.offset;
+    _file(clock, entry);
+    DEBUG("ztimer_wheel_add(): %p target %" PRIu32 "\n", (void *)entry,
+          entry->offset);
+}
+
+void ztimer_wheel_del(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    ztimer_base_t **first = &wheel->slots[0][0];
+    ztimer_base_t **pprev = entry->pprev;
+
+    assert(pprev != NULL);
+    if (entry == clock->last) {
+        clock->last = (pprev == &clock->list.next)
+                    ? NULL
+                    : container_of(pprev, ztimer_base_t, next);
+    }
+    *pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = pprev;
+    }
+    /* the slot became empty if the timer was its only entry */
+    if ((pprev >= first) &&
+        (pprev < (first + (ZTIMER_WHEEL_LEVELS * ZTIMER_WHEEL_SLOTS))) &&
+        (*pprev == NULL)) {
+        unsigned idx = pprev - first;
+
+        wheel->map[idx / ZTIMER_WHEEL_SLOTS] &=
+            ~(1UL << (idx % ZTIMER_WHEEL_SLOTS));
+    }
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+static inline unsigned _lsb32(uint32_t map)
+{
+    unsigned pos = 0;
+
+    if (!(map & 0xffff)) {
+        map >>= 16;
+        pos = 16;
+    }
+    return pos + bitarithm_lsb((unsigned)(map & 0xffff));
+}
+
+/* rotates the map of a level right, so slot @p slot becomes bit 0 */
+static inline uint32_t _rotate(uint32_t map, unsigned slot)
+{
+    if (slot == 0) {
+        return map;
+    }
+    map = (map >> slot) | (map << (ZTIMER_WHEEL_SLOTS - slot));
+#if ZTIMER_WHEEL_SLOTS < 32
+    map &= (1UL << ZTIMER_WHEEL_SLOTS) - 1;
+#endif
+    return map;
+}
+
+static bool _wheel_next(const ztimer_wheel_t *wheel, uint32_t now,
+                        uint32_t *offset)
+{
+    uint64_t min = UINT64_MAX;
+
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        unsigned shift = level * _BITS;
+        unsigned cur = (now >> shift) & _MASK;
+        uint32_t map = wheel->map[level];
+        uint64_t dist;
+
+        if (map == 0) {
+            continue;
+        }
+        if (level == 0) {
+            /* level 0 slots hold timers of the next ZTIMER_WHEEL_SLOTS ticks */
+            dist = _lsb32(_rotate(map, cur));
+        }
+        else {
+            /* slots are cascaded when `now` reaches their first tick, the
+             * current slot only comes up after a full rotation */
+            uint64_t steps = _lsb32(_rotate(map, (cur + 1) & _MASK)) + 1;
+            uint32_t gran_mask = (UINT32_C(1) << shift) - 1;
+
+            dist = (steps << shift) - (now & gran_mask);
+        }
+        if (dist < min) {
+            min = dist;
+        }
+    }
+    if (min == UINT64_MAX) {
+        return false;
+    }
+    /* a full rotation of the highest level is exactly 2^32 ticks: clamping
+     * it fires one tick early, ztimer_wheel_update() then just looks again */
+    *offset = (min > UINT32_MAX) ? UINT32_MAX : (uint32_t)min;
+    return true;
+}
+
+static void _process(ztimer_clock_t *clock)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    uint32_t now = clock->list.offset;
+
+    /* cascade from top to bottom, so a timer can fall through several levels
+     * within one tick */
+    for (unsigned level = ZTIMER_WHEEL_LEVELS; level > 0; level--) {
+        unsigned shift = (level - 1) * _BITS;
+        unsigned slot = (now >> shift) & _MASK;
+        ztimer_base_t *entry;
+
+        if ((now & ((UINT32_C(1) << shift) - 1)) ||
+            !(wheel->map[level - 1] & (1UL << slot))) {
+            continue;
+        }
+        entry = wheel->slots[level - 1][slot];
+        wheel->slots[level - 1][slot] = NULL;
+        wheel->map[level - 1] &= ~(1UL << slot);
+        while (entry) {
+            ztimer_base_t *next = entry->next;
+
+            if (level == 1) {
+                _expire(clock, entry);
+            }
+            else {
+                _file(clock, entry);
+            }
+            entry = next;
+        }
+    }
+}
+
+void ztimer_wheel_update(ztimer_clock_t *clock, uint32_t now)
+{
+    uint32_t remaining = now - clock->list.offset;
+    uint32_t offset;
+
+    /* skip ticks without events */
+    while (_wheel_next(clock->wheel, clock->list.offset, &offset) &&
+           (offset <= remaining)) {
+        clock->list.offset += offset;
+        remaining -= offset;
+        _process(clock);
+    }
+    clock->list.offset = now;
+}
+
+bool ztimer_wheel_next(const ztimer_clock_t *clock, uint32_t *offset)
+{
+    if (clock->list.next) {
+        *offset = 0;
+        return true;
+    }
+    return _wheel_next(clock->wheel, clock->list.offset, offset);
+}
+
+bool ztimer_wheel_is_empty(const ztimer_clock_t *clock)
+{
+    if (clock->list.next) {
+        return false;
+    }
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        if (clock->wheel->map[level]) {
+            return false;
+        }
+    }
+    return true;
+}
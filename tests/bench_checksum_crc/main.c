@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark of the CRC implementations
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "checksum/ucrc16.h"
+#include "kernel_defines.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define BUF_SIZE        (1024U)
+#define ROUNDS          (64U)       /**< 64 KiB per CRC */
+
+typedef struct {
+    const char *name;
+    uint32_t (*calc)(const uint8_t *buf, size_t len);
+} _crc_t;
+
+static uint8_t _buf[BUF_SIZE];
+
+static uint32_t _ucrc16(const uint8_t *buf, size_t len)
+{
+    return ucrc16_calc_be(buf, len, UCRC16_CCITT_POLY_BE, 0x1d0f);
+}
+
+static uint32_t _crc16_ccitt(const uint8_t *buf, size_t len)
+{
+    return crc16_ccitt_calc(buf, len);
+}
+
+static uint32_t _crc32(const uint8_t *buf, size_t len)
+{
+    return crc32_calc(buf, len);
+}
+
+static uint32_t _crc32c(const uint8_t *buf, size_t len)
+{
+    return crc32c_calc(buf, len);
+}
+
+static const _crc_t _crcs[] = {
+    { .name = "ucrc16", .calc = _ucrc16 },
+    { .name = "crc16_ccitt", .calc = _crc16_ccitt },
+    { .name = "crc32", .calc = _crc32 },
+    { .name = "crc32c", .calc = _crc32c },
+};
+
+int main(void)
+{
+    bool success = true;
+
+    random_bytes(_buf, sizeof(_buf));
+    /* both CRC16 implementations calculate the same checksum */
+    if (_ucrc16(_buf, sizeof(_buf)) != _crc16_ccitt(_buf, sizeof(_buf))) {
+        puts("crc16 mismatch");
+        success = false;
+    }
+    printf("CRC32 slices: %u\n", CONFIG_CHECKSUM_CRC32_SLICES);
+    for (unsigned i = 0; i < ARRAY_SIZE(_crcs); i++) {
+        volatile uint32_t crc;
+        uint32_t start = xtimer_now_usec();
+
+        for (unsigned j = 0; j < ROUNDS; j++) {
+            crc = _crcs[i].calc(_buf, sizeof(_buf));
+        }
+        uint32_t time = xtimer_now_usec() - start;
+
+        (void)crc;
+        printf("{ \"crc\" : \"%s\", \"kb_per_s\" : %" PRIu32 " }\n",
+               _crcs[i].name,
+               (uint32_t)(((uint64_t)ROUNDS * BUF_SIZE * US_PER_MS) /
+                          ((time > 0) ? time : 1)));
+    }
+    puts(success ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       TCP Reno benchmark over a simulated bottleneck link
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+
+#if IS_USED(MODULE_CONGURE_RENO)
+#include "congure/reno.h"
+#endif
+
+#define MSS             (100U)      /**< segment size in bytes */
+#define SEGMENTS        (2000U)     /**< segments to transfer */
+#define LINK_MS         (10U)       /**< serialization delay per segment */
+#define DELAY_MS        (50U)       /**< one-way propagation delay */
+#define QUEUE_LEN       (8U)        /**< bottleneck queue in segments */
+#define RWND            (64U)       /**< receive window in segments */
+#define FIXED_WND       (32U)       /**< window without congestion control */
+#define RTO_MS          (500U)
+#define TIME_MAX_MS     (3600U * 1000U)
+#define FIFO_LEN        (64U)
+
+typedef struct {
+    uint32_t time[FIFO_LEN];
+    uint16_t seq[FIFO_LEN];
+    unsigned head;
+    unsigned num;
+} _fifo_t;
+
+static const unsigned _loss[] = { 0, 10, 20, 50 };  /* in permille */
+
+static _fifo_t _queue;      /* bottleneck queue */
+static _fifo_t _wire;       /* segments on their way to the receiver */
+static _fifo_t _acks;       /* ACKs on their way to the sender */
+static bool _rcvd[SEGMENTS];
+static uint32_t _now, _link_free, _rto;
+static unsigned _snd_una, _snd_nxt, _snd_max, _rcv_nxt, _retrans;
+static bool _fr_pending;
+static uint32_t _seed;
+
+#if IS_USED(MODULE_CONGURE_RENO)
+static void _fr(congure_reno_snd_t *c)
+{
+    (void)c;
+    _fr_pending = true;
+}
+
+static const congure_reno_snd_consts_t _consts = {
+    .fr = _fr,
+    .init_mss = MSS,
+    .init_ssthresh = RWND * MSS,
+    .frthresh = 3,
+};
+static congure_reno_snd_t _cong;
+#endif
+
+static unsigned _rand(unsigned max)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return (_seed >> 16) % max;
+}
+
+static bool _fifo_push(_fifo_t *fifo, uint16_t seq, uint32_t time)
+{
+    unsigned i;
+
+    if (fifo->num >= FIFO_LEN) {
+        return false;
+    }
+    i = (fifo->head + fifo->num++) % FIFO_LEN;
+    fifo->seq[i] = seq;
+    fifo->time[i] = time;
+    return true;
+}
+
+static bool _fifo_pop(_fifo_t *fifo, uint16_t *seq)
+{
+    if ((fifo->num == 0) || ((int32_t)(fifo->time[fifo->head] - _now) > 0)) {
+        return false;
+    }
+    *seq = fifo->seq[fifo->head];
+    fifo->head = (fifo->head + 1) % FIFO_LEN;
+    fifo->num--;
+    return true;
+}
+
+static void _send(unsigned seq, unsigned loss)
+{
+    if (seq < _snd_max) {
+        _retrans++;
+    }
+    else {
+        _snd_max = seq + 1;
+    }
+    if ((_rand(1000) < loss) || (_queue.num >= QUEUE_LEN)) {
+        return;
+    }
+    _fifo_push(&_queue, seq, _now);
+}
+
+static bool _may_send(void)
+{
+    if ((_snd_nxt >= SEGMENTS) || ((_snd_nxt - _snd_una) >= RWND)) {
+        return false;
+    }
+#if IS_USED(MODULE_CONGURE_RENO)
+    return congure_reno_usable_wnd(&_cong) >= MSS;
+#else
+    return (_snd_nxt - _snd_una) < FIXED_WND;
+#endif
+}
+
+static void _sender_ack(unsigned ack)
+{
+#if IS_USED(MODULE_CONGURE_RENO)
+    congure_snd_msg_t msg = { .size = 0 };
+    congure_snd_ack_t cack = { .recv_time = _now, .id = ack * MSS,
+                               .wnd = RWND * MSS, .clean = 1 };
+#endif
+
+    if (ack > _snd_una) {
+#if IS_USED(MODULE_CONGURE_RENO)
+        msg.size = (ack - _snd_una) * MSS;
+#endif
+        _snd_una = ack;
+        if (_snd_nxt < _snd_una) {
+            _snd_nxt = _snd_una;
+        }
+        _rto = _now + RTO_MS;
+    }
+    else if ((ack != _snd_una) || (_snd_nxt == _snd_una)) {
+        return;
+    }
+#if IS_USED(MODULE_CONGURE_RENO)
+    _cong.super.driver->report_msg_acked(&_cong.super, &msg, &cack);
+#endif
+}
+
+static void _sender_timeout(void)
+{
+#if IS_USED(MODULE_CONGURE_RENO)
+    congure_snd_msg_t msg = { .size = (_snd_nxt - _snd_una) * MSS };
+
+    msg.super.next = &msg.super;
+    _cong.super.driver->report_msgs_timeout(&_cong.super, &msg);
+#endif
+    /* go back N */
+    _snd_nxt = _snd_una;
+    _fr_pending = false;
+    _rto = _now + RTO_MS;
+}
+
+static void _sender(unsigned loss)
+{
+    if (_fr_pending) {
+        _fr_pending = false;
+        _send(_snd_una, loss);
+    }
+    while (_may_send()) {
+        if (_snd_nxt == _snd_una) {
+            _rto = _now + RTO_MS;
+        }
+        _send(_snd_nxt++, loss);
+#if IS_USED(MODULE_CONGURE_RENO)
+        _cong.super.driver->report_msg_sent(&_cong.super, MSS);
+#endif
+    }
+}
+
+static uint32_t _run(unsigned loss)
+{
+    memset(&_queue, 0, sizeof(_queue));
+    memset(&_wire, 0, sizeof(_wire));
+    memset(&_acks, 0, sizeof(_acks));
+    memset(_rcvd, 0, sizeof(_rcvd));
+    _now = _link_free = 0;
+    _snd_una = _snd_nxt = _snd_max = _rcv_nxt = _retrans = 0;
+    _fr_pending = false;
+    _rto = RTO_MS;
+    _seed = 1;
+#if IS_USED(MODULE_CONGURE_RENO)
+    congure_reno_snd_setup(&_cong, &_consts);
+    _cong.super.driver->init(&_cong.super, NULL);
+#endif
+    for (; _now < TIME_MAX_MS; _now++) {
+        uint16_t seq;
+
+        /* receiver acknowledges every segment cumulatively */
+        while (_fifo_pop(&_wire, &seq)) {
+            _rcvd[seq] = true;
+            while ((_rcv_nxt < SEGMENTS) && _rcvd[_rcv_nxt]) {
+                _rcv_nxt++;
+            }
+            _fifo_push(&_acks, _rcv_nxt, _now + DELAY_MS);
+        }
+        while (_fifo_pop(&_acks, &seq)) {
+            _sender_ack(seq);
+        }
+        if (_snd_una == SEGMENTS) {
+            return _now;
+        }
+        if ((_snd_nxt > _snd_una) && (_now >= _rto)) {
+            _sender_timeout();
+        }
+        _sender(loss);
+        /* bottleneck link */
+        if ((_now >= _link_free) && (_queue.num > 0)) {
+            _fifo_pop(&_queue, &seq);
+            _link_free = _now + LINK_MS;
+            _fifo_push(&_wire, seq, _link_free + DELAY_MS);
+        }
+    }
+    return UINT32_MAX;
+}
+
+int main(void)
+{
+    printf("TCP Reno benchmark (%s)\n",
+           IS_USED(MODULE_CONGURE_RENO) ? "congure_reno" : "fixed window");
+    for (unsigned i = 0; i < ARRAY_SIZE(_loss); i++) {
+        uint32_t time = _run(_loss[i]);
+
+        if (time == UINT32_MAX) {
+            printf("Transfer with %u permille loss did not complete\n",
+                   _loss[i]);
+            return 1;
+        }
+        printf("{ \"loss\" : %u, \"time\" : %" PRIu32 ", \"goodput\" : %" PRIu32
+               ", \"retransmissions\" : %u }\n", _loss[i], time,
+               (uint32_t)(((uint64_t)SEGMENTS * MSS * 1000U) / time),
+               _retrans);
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2021 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for _ in range(4):
+        child.expect(r"{ \"loss\" : \d+, \"time\" : \d+, \"goodput\" : \d+, "
+                     r"\"retransmissions\" : \d+ }")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
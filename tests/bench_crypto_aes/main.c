@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of AES in the ECB, CTR and CCM modes
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/ciphers.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "macros/units.h"
+#include "test_utils/expect.h"
+#include "xtimer.h"
+
+#define RUNS            (1000U)
+#define MSG_LEN         (128U)
+#define ADATA_LEN       (16U)
+#define NONCE_LEN       (13U)
+#define MAC_LEN         (8U)
+
+static const uint8_t _key[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+static uint8_t _adata[ADATA_LEN];
+static uint8_t _nonce[NONCE_LEN];
+static uint8_t _msg[MSG_LEN];
+static uint8_t _out[MSG_LEN + MAC_LEN];
+static uint8_t _plain[MSG_LEN];
+
+static cipher_t _cipher;
+
+static void _print(const char *mode, uint32_t time)
+{
+    printf("{ \"mode\" : \"%s\", \"ns_per_byte\" : %" PRIu32, mode,
+           (uint32_t)(((uint64_t)time * 1000) / (RUNS * MSG_LEN)));
+#ifdef CLOCK_CORECLOCK
+    printf(", \"cycles_per_byte\" : %" PRIu32,
+           (uint32_t)(((uint64_t)time * (CLOCK_CORECLOCK / MHZ(1))) /
+                      (RUNS * MSG_LEN)));
+#endif
+    puts(" }");
+}
+
+static void _bench_ecb(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        expect(cipher_encrypt_ecb(&_cipher, _msg, MSG_LEN, _out) == MSG_LEN);
+    }
+    _print("ecb", xtimer_now_usec() - start);
+}
+
+static void _bench_ctr(void)
+{
+    uint8_t ctr[16] = { 0 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        expect(cipher_encrypt_ctr(&_cipher, ctr, NONCE_LEN, _msg, MSG_LEN,
+                                  _out) == MSG_LEN);
+    }
+    _print("ctr", xtimer_now_usec() - start);
+}
+
+static void _bench_ccm_encrypt(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        expect(cipher_encrypt_ccm(&_cipher, _adata, ADATA_LEN, MAC_LEN,
+                                  15 - NONCE_LEN, _nonce, NONCE_LEN,
+                                  _msg, MSG_LEN, _out) == MSG_LEN + MAC_LEN);
+    }
+    _print("ccm encrypt", xtimer_now_usec() - start);
+}
+
+static void _bench_ccm_decrypt(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        expect(cipher_decrypt_ccm(&_cipher, _adata, ADATA_LEN, MAC_LEN,
+                                  15 - NONCE_LEN, _nonce, NONCE_LEN,
+                                  _out, MSG_LEN + MAC_LEN,
+                                  _plain) == MSG_LEN);
+    }
+    _print("ccm decrypt", xtimer_now_usec() - start);
+    expect(memcmp(_plain, _msg, MSG_LEN) == 0);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < MSG_LEN; i++) {
+        _msg[i] = i;
+    }
+    memset(_adata, 0xad, sizeof(_adata));
+    memset(_nonce, 0x42, sizeof(_nonce));
+    expect(cipher_init(&_cipher, CIPHER_AES, _key, sizeof(_key)) ==
+           CIPHER_INIT_SUCCESS);
+
+    _bench_ecb();
+    _bench_ctr();
+    _bench_ccm_encrypt();
+    /* decrypts the output of the last encryption */
+    _bench_ccm_decrypt();
+
+    puts("SUCCESS");
+    return 0;
+}
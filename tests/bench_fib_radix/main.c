@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       FIB look-up benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/fib.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#ifndef LOOKUPS
+#define LOOKUPS     (10000U)
+#endif
+
+#define ROUTES_MAX  (1024U)
+#define IFACE       (6)
+#define ADDR_LEN    (16U)
+
+static const unsigned _sizes[] = { 16, 128, 512, ROUTES_MAX };
+
+static fib_entry_t _entries[ROUTES_MAX];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = ROUTES_MAX,
+                              .mtx_access = MUTEX_INIT,
+                              .notify_rp_pos = 0 };
+static uint8_t _next_hop[ADDR_LEN] = { 0xfe, 0x80, [15] = 0x01 };
+static uint32_t _seed = 1;
+
+static unsigned _rand(unsigned max)
+{
+    /* cheap LCG, so the generator does not dominate the measurement */
+    _seed = (_seed * 1103515245U) + 12345U;
+    return (_seed >> 16) % max;
+}
+
+static unsigned _route_pfx(uint8_t *pfx, unsigned i)
+{
+    /* every second route is a more specific route of the one before */
+    memset(pfx, 0, ADDR_LEN);
+    pfx[0] = 0x20;
+    pfx[1] = 0x01;
+    pfx[2] = 0x0d;
+    pfx[3] = 0xb8;
+    pfx[4] = (i & ~1U) >> 8;
+    pfx[5] = (i & ~1U) & 0xff;
+    if (i & 1) {
+        pfx[6] = i >> 8;
+        pfx[7] = i & 0xff;
+        return 64;
+    }
+    return 48;
+}
+
+static uint32_t _fill(unsigned num)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < num; i++) {
+        uint8_t pfx[ADDR_LEN];
+        unsigned pfx_len = _route_pfx(pfx, i);
+
+        if (fib_add_entry(&_table, IFACE, pfx, ADDR_LEN,
+                          pfx_len << FIB_FLAG_NET_PREFIX_SHIFT,
+                          _next_hop, ADDR_LEN, 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) < 0) {
+            return UINT32_MAX;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _bench_get_next_hop(unsigned num)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        uint8_t dst[ADDR_LEN], next_hop[ADDR_LEN];
+        size_t next_hop_size = sizeof(next_hop);
+        uint32_t next_hop_flags;
+        kernel_pid_t iface;
+
+        _route_pfx(dst, _rand(num));
+        dst[14] = i >> 8;
+        dst[15] = i & 0xff;
+        if (fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                             &next_hop_flags, dst, ADDR_LEN, 0) < 0) {
+            return UINT32_MAX;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    printf("FIB look-up benchmark (%s)\n",
+           IS_USED(MODULE_FIB_RADIX) ? "radix tree" : "linear scan");
+    fib_init(&_table);
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        unsigned num = _sizes[i];
+        uint32_t add, get_next_hop;
+
+        add = _fill(num);
+        if (add == UINT32_MAX) {
+            printf("Unable to fill FIB with %u entries\n", num);
+            return 1;
+        }
+        get_next_hop = _bench_get_next_hop(num);
+        fib_deinit(&_table);
+        fib_init(&_table);
+        if (get_next_hop == UINT32_MAX) {
+            puts("Look-up failed");
+            return 1;
+        }
+        printf("{ \"entries\" : %u, \"get_next_hop\" : %" PRIu32
+               ", \"add\" : %" PRIu32 " }\n", num,
+               (uint32_t)(((uint64_t)get_next_hop * NS_PER_US) / LOOKUPS),
+               (uint32_t)(((uint64_t)add * NS_PER_US) / num));
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       NIB look-up benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#include "_nib-internal.h"
+
+#ifndef LOOKUPS
+#define LOOKUPS     (10000U)
+#endif
+
+#define IFACE       (6)
+
+static const unsigned _sizes[] = { 16, 64, 256, 500 };
+
+static _nib_onl_entry_t *_nbrs[CONFIG_GNRC_IPV6_NIB_NUMOF];
+static _nib_offl_entry_t *_routes[CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
+static uint32_t _seed = 1;
+
+static unsigned _rand(unsigned max)
+{
+    /* cheap LCG, so the generator does not dominate the measurement */
+    _seed = (_seed * 1103515245U) + 12345U;
+    return (_seed >> 16) % max;
+}
+
+static void _nbr_addr(ipv6_addr_t *addr, unsigned i)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    addr->u32[2].u32 = 0;
+    addr->u32[3] = byteorder_htonl(i + 1);
+}
+
+static void _route_pfx(ipv6_addr_t *pfx, unsigned *pfx_len, unsigned i)
+{
+    /* every second route is a more specific route of the one before */
+    ipv6_addr_set_unspecified(pfx);
+    pfx->u16[0] = byteorder_htons(0x2001);
+    pfx->u16[1] = byteorder_htons(0x0db8);
+    pfx->u16[2] = byteorder_htons(i & ~1U);
+    if (i & 1) {
+        pfx->u16[3] = byteorder_htons(i);
+        *pfx_len = 64;
+    }
+    else {
+        *pfx_len = 48;
+    }
+}
+
+static int _fill(unsigned num)
+{
+    ipv6_addr_t next_hop;
+
+    ipv6_addr_set_unspecified(&next_hop);
+    ipv6_addr_set_link_local_prefix(&next_hop);
+    next_hop.u16[7] = byteorder_htons(0xffff);
+    for (unsigned i = 0; i < num; i++) {
+        ipv6_addr_t addr;
+        unsigned pfx_len;
+
+        _nbr_addr(&addr, i);
+        _nbrs[i] = _nib_nc_add(&addr, IFACE,
+                               GNRC_IPV6_NIB_NC_INFO_NUD_STATE_STALE);
+        _route_pfx(&addr, &pfx_len, i);
+        _routes[i] = _nib_ft_add(&next_hop, IFACE, &addr, pfx_len);
+        if ((_nbrs[i] == NULL) || (_routes[i] == NULL)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void _clear(unsigned num)
+{
+    for (unsigned i = 0; i < num; i++) {
+        _nib_ft_remove(_routes[i]);
+        _nib_nc_remove(_nbrs[i]);
+    }
+}
+
+static uint32_t _bench_nc_get(unsigned num)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        ipv6_addr_t addr;
+
+        _nbr_addr(&addr, _rand(num));
+        if (_nib_onl_get(&addr, IFACE) == NULL) {
+            return UINT32_MAX;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _bench_get_route(unsigned num)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        gnrc_ipv6_nib_ft_t fte;
+        ipv6_addr_t dst;
+        unsigned pfx_len;
+
+        _route_pfx(&dst, &pfx_len, _rand(num));
+        dst.u16[7] = byteorder_htons(i);
+        if (_nib_get_route(&dst, NULL, &fte) < 0) {
+            return UINT32_MAX;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    printf("NIB look-up benchmark (%s)\n",
+           IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_IDX) ? "index" : "linear scan");
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        unsigned num = _sizes[i];
+        uint32_t nc_get, get_route;
+
+        if (_fill(num) < 0) {
+            printf("Unable to fill NIB with %u entries\n", num);
+            return 1;
+        }
+        nc_get = _bench_nc_get(num);
+        get_route = _bench_get_route(num);
+        _clear(num);
+        if ((nc_get == UINT32_MAX) || (get_route == UINT32_MAX)) {
+            puts("Look-up failed");
+            return 1;
+        }
+        printf("{ \"entries\" : %u, \"nc_get\" : %" PRIu32
+               ", \"get_route\" : %" PRIu32 " }\n", num,
+               (uint32_t)(((uint64_t)nc_get * NS_PER_US) / LOOKUPS),
+               (uint32_t)(((uint64_t)get_route * NS_PER_US) / LOOKUPS));
+    }
+    puts("SUCCESS");
+    return 0;
+}
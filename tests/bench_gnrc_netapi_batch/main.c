@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       GNRC receive throughput with and without batched netapi
+ *              dispatch
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/netdev_test.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_DURATION_US
+#define TEST_DURATION_US    (1000000U)
+#endif
+
+#ifndef BURST
+#define BURST               (8U)
+#endif
+
+#define UDP_PORT            (4242U)
+#define QUEUE_SIZE          (16U)
+
+/* Ethernet header, IPv6 header fe80::1 -> ff02::1, UDP header 1234 -> 4242 */
+static const uint8_t _frame[] = {
+    0x33, 0x33, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x86, 0xdd,
+    0x60, 0x00, 0x00, 0x00, 0x00, 0x10, 0x11, 0x40,
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x04, 0xd2, 0x10, 0x92, 0x00, 0x10, 0x85, 0x70,
+    'R', 'I', 'O', 'T', 'b', 'n', 'c', 'h',
+};
+
+static netdev_test_t _dev;
+static gnrc_netif_t _netif;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _stack[THREAD_STACKSIZE_MAIN];
+static msg_t _queue[QUEUE_SIZE];
+static uint32_t _frames;
+static uint32_t _pkts;
+static uint32_t _msgs;
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    static const uint8_t addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+    (void)dev;
+    expect(max_len >= sizeof(addr));
+    memcpy(value, addr, sizeof(addr));
+    return sizeof(addr);
+}
+
+static int _recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_frame);
+    }
+    expect(len >= (int)sizeof(_frame));
+    memcpy(buf, _frame, sizeof(_frame));
+    _frames++;
+    return sizeof(_frame);
+}
+
+static void _isr(netdev_t *dev)
+{
+    for (unsigned i = 0; i < BURST; i++) {
+        dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+    }
+}
+
+static void *_receiver(void *arg)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(UDP_PORT,
+                                                           thread_getpid());
+
+    (void)arg;
+    msg_init_queue(_queue, QUEUE_SIZE);
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+    gnrc_netapi_batch_accept(&entry);
+#endif
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        _msgs++;
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                _pkts++;
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+#if IS_USED(MODULE_GNRC_NETAPI_BATCH)
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH: {
+                gnrc_pktsnip_t *batch = msg.content.ptr;
+
+                for (unsigned i = 0; i < gnrc_netapi_batch_numof(batch); i++) {
+                    _pkts++;
+                    gnrc_pktbuf_release(gnrc_netapi_batch_get(batch, i));
+                }
+                gnrc_pktbuf_release(batch);
+                break;
+            }
+#endif
+            default:
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    netdev_test_setup(&_dev, NULL);
+    netdev_test_set_get_cb(&_dev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_dev, NETOPT_MAX_PDU_SIZE, _get_max_packet_size);
+    netdev_test_set_get_cb(&_dev, NETOPT_ADDRESS, _get_address);
+    netdev_test_set_recv_cb(&_dev, _recv);
+    netdev_test_set_isr_cb(&_dev, _isr);
+    expect(gnrc_netif_ethernet_create(&_netif, _netif_stack,
+                                      sizeof(_netif_stack), GNRC_NETIF_PRIO,
+                                      "netdev_test",
+                                      &_dev.netdev.netdev) == 0);
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _receiver, NULL, "receiver");
+
+    /* all threads of the stack have a higher priority than main, so each
+     * burst is handled completely before the next one is triggered */
+    uint32_t start = ztimer_now(ZTIMER_USEC);
+    while ((ztimer_now(ZTIMER_USEC) - start) < TEST_DURATION_US) {
+        netdev_trigger_event_isr(&_dev.netdev.netdev);
+    }
+    ztimer_sleep(ZTIMER_USEC, 10 * US_PER_MS);
+
+    printf("{ \"burst\" : %u, \"frames\" : %" PRIu32 ", \"result\" : %" PRIu32
+           ", \"msgs\" : %" PRIu32 " }\n", (unsigned)BURST, _frames, _pkts,
+           _msgs);
+
+    return 0;
+}
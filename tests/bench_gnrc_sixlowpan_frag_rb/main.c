@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of the 6LoWPAN reassembly buffer for fragments
+ *              arriving in different orders
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/ipv6.h"
+#include "net/sixlowpan.h"
+#include "test_utils/expect.h"
+#include "xtimer.h"
+
+#ifndef FRAG_PAYLOAD
+#define FRAG_PAYLOAD    (48U)
+#endif
+
+#define ROUNDS          (100U)
+#define DATAGRAM_SIZE   (IPV6_MIN_MTU)
+#define DATAGRAMS_NUMOF (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+#define FRAGS_NUMOF     ((DATAGRAM_SIZE + FRAG_PAYLOAD - 1) / FRAG_PAYLOAD)
+
+#define TEST_SRC        { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_DST        { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_PAGE       (0U)
+
+static_assert((FRAG_PAYLOAD % 8) == 0,
+              "FRAG_PAYLOAD must be a multiple of 8");
+
+static const uint8_t _test_src[] = TEST_SRC;
+static const uint8_t _test_dst[] = TEST_DST;
+static struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[sizeof(_test_src)];
+    uint8_t dst[sizeof(_test_dst)];
+} _netif_hdr;
+
+static gnrc_pktsnip_t *_frags[DATAGRAMS_NUMOF];
+static unsigned _order[FRAGS_NUMOF];
+static uint16_t _tag;
+static uint32_t _seed = 1;
+
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 8;
+}
+
+static gnrc_pktsnip_t *_fragment(uint16_t tag, unsigned idx)
+{
+    size_t offset = idx * FRAG_PAYLOAD;
+    size_t len = DATAGRAM_SIZE - offset;
+    size_t hdr_len = (idx == 0) ? sizeof(sixlowpan_frag_t) + 1
+                                : sizeof(sixlowpan_frag_n_t);
+    gnrc_pktsnip_t *pkt;
+    sixlowpan_frag_n_t *hdr;
+
+    len = (len < FRAG_PAYLOAD) ? len : FRAG_PAYLOAD;
+    pkt = gnrc_pktbuf_add(NULL, NULL, hdr_len + len, GNRC_NETTYPE_SIXLOWPAN);
+    expect(pkt != NULL);
+    memset(pkt->data, 0, pkt->size);
+    hdr = pkt->data;
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    if (idx == 0) {
+        uint8_t *data = (uint8_t *)pkt->data + sizeof(sixlowpan_frag_t);
+
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        data[0] = SIXLOWPAN_UNCOMP;
+        /* IPv6 version */
+        data[1] = 0x60;
+    }
+    else {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->offset = offset / 8;
+    }
+    return pkt;
+}
+
+static uint32_t _round(void)
+{
+    unsigned complete = 0;
+    uint32_t time = 0;
+
+    /* the fragments of all datagrams are interleaved, as they would be
+     * received from several neighbors */
+    for (unsigned i = 0; i < FRAGS_NUMOF; i++) {
+        uint32_t start;
+
+        for (unsigned d = 0; d < DATAGRAMS_NUMOF; d++) {
+            _frags[d] = _fragment(_tag + d, _order[i]);
+        }
+        start = xtimer_now_usec();
+        for (unsigned d = 0; d < DATAGRAMS_NUMOF; d++) {
+            gnrc_sixlowpan_frag_rb_t *entry;
+
+            entry = gnrc_sixlowpan_frag_rb_add(&_netif_hdr.hdr, _frags[d],
+                                               _order[i] * FRAG_PAYLOAD,
+                                               TEST_PAGE);
+            expect(entry != NULL);
+            if (gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                    entry, &_netif_hdr.hdr) > 0) {
+                complete++;
+            }
+        }
+        time += xtimer_now_usec() - start;
+    }
+    /* without receivers the reassembled datagrams are released right away */
+    expect(complete == DATAGRAMS_NUMOF);
+    _tag += DATAGRAMS_NUMOF;
+    return time;
+}
+
+static void _bench(const char *name)
+{
+    uint32_t time = 0;
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        time += _round();
+    }
+    printf("{ \"order\" : \"%s\", \"fragments\" : %u, "
+           "\"ns_per_fragment\" : %" PRIu32 " }\n", name, (unsigned)FRAGS_NUMOF,
+           (uint32_t)(((uint64_t)time * 1000U) /
+                      (ROUNDS * FRAGS_NUMOF * DATAGRAMS_NUMOF)));
+}
+
+int main(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_netif_hdr_init(&_netif_hdr.hdr, sizeof(_test_src), sizeof(_test_dst));
+    gnrc_netif_hdr_set_src_addr(&_netif_hdr.hdr, (uint8_t *)_test_src,
+                                sizeof(_test_src));
+    gnrc_netif_hdr_set_dst_addr(&_netif_hdr.hdr, (uint8_t *)_test_dst,
+                                sizeof(_test_dst));
+
+    for (unsigned i = 0; i < FRAGS_NUMOF; i++) {
+        _order[i] = i;
+    }
+    _bench("in order");
+
+    for (unsigned i = 0; i < FRAGS_NUMOF; i++) {
+        _order[i] = FRAGS_NUMOF - 1 - i;
+    }
+    _bench("reverse");
+
+    for (unsigned i = FRAGS_NUMOF - 1; i > 0; i--) {
+        unsigned j = _rand() % (i + 1);
+        unsigned tmp = _order[i];
+
+        _order[i] = _order[j];
+        _order[j] = tmp;
+    }
+    _bench("shuffled");
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of the 6LoWPAN IPHC encoder for repeating flows
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev_test.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PACKETS         (2000U)
+#define FRAME_MAX       (127U)
+#define PAYLOAD_MAGIC   "iphc bench"
+#define PAYLOAD_LEN     (sizeof(PAYLOAD_MAGIC) + 1)
+
+#define TEST_SRC        { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_DST        { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_LL_SRC     { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                          0x28, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_LL_DST     { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                          0x58, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_CTX_SRC    { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                          0x28, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_CTX_DST    { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34 }
+#define TEST_MC_DST     { 0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }
+#define TEST_CTX_ID     (0U)
+#define TEST_CTX_LEN    (64U)
+
+typedef struct {
+    const char *name;
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    uint16_t src_port;
+    uint16_t dst_port;
+    bool unicast;       /**< send to TEST_DST instead of broadcast */
+} _flow_t;
+
+static const uint8_t _test_src[] = TEST_SRC;
+static const uint8_t _test_dst[] = TEST_DST;
+
+static const _flow_t _flows[] = {
+    {
+        .name = "link local udp",
+        .src = { .u8 = TEST_LL_SRC },
+        .dst = { .u8 = TEST_LL_DST },
+        .src_port = 0xf0b1,
+        .dst_port = 0xf0b2,
+        .unicast = true,
+    },
+    {
+        .name = "context udp",
+        .src = { .u8 = TEST_CTX_SRC },
+        .dst = { .u8 = TEST_CTX_DST },
+        .src_port = 49153,
+        .dst_port = 5683,
+        .unicast = true,
+    },
+    {
+        .name = "multicast udp",
+        .src = { .u8 = TEST_LL_SRC },
+        .dst = { .u8 = TEST_MC_DST },
+        .src_port = 5683,
+        .dst_port = 5683,
+        .unicast = false,
+    },
+};
+
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t _netif;
+
+static uint8_t _frame[FRAME_MAX];
+static size_t _frame_len;
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_netdev_max_pdu_size(netdev_t *netdev, void *value,
+                                    size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = FRAME_MAX;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_test_src);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len >= sizeof(_test_src));
+    memcpy(value, _test_src, sizeof(_test_src));
+    return sizeof(_test_src);
+}
+
+static int _netdev_send(netdev_t *netdev, const iolist_t *iolist)
+{
+    size_t len = 0;
+
+    (void)netdev;
+    /* skip MAC header */
+    for (iolist = iolist->iol_next; iolist != NULL; iolist = iolist->iol_next) {
+        expect((len + iolist->iol_len) <= sizeof(_frame));
+        memcpy(&_frame[len], iolist->iol_base, iolist->iol_len);
+        len += iolist->iol_len;
+    }
+    /* only keep frames of the benchmark, not those of the NIB */
+    if ((len >= PAYLOAD_LEN) &&
+        (memcmp(&_frame[len - PAYLOAD_LEN], PAYLOAD_MAGIC,
+                sizeof(PAYLOAD_MAGIC)) == 0)) {
+        _frame_len = len;
+    }
+    return len;
+}
+
+static void _init_mock_netif(void)
+{
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_PROTO,
+                           _get_netdev_proto);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_MAX_PDU_SIZE,
+                           _get_netdev_max_pdu_size);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_SRC_LEN,
+                           _get_netdev_src_len);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _get_netdev_addr_long);
+    netdev_test_set_send_cb(&_mock_dev, _netdev_send);
+    gnrc_netif_ieee802154_create(&_netif, _mock_netif_stack,
+                                 THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+                                 "mock_netif", &_mock_dev.netdev.netdev);
+    thread_yield_higher();
+}
+
+static void _set_ctx(void)
+{
+    const ipv6_addr_t *prefix = &_flows[1].dst;
+
+    expect(gnrc_sixlowpan_ctx_update(TEST_CTX_ID, prefix, TEST_CTX_LEN,
+                                     60, true) != NULL);
+}
+
+static gnrc_pktsnip_t *_build(const _flow_t *flow, uint8_t seq)
+{
+    gnrc_pktsnip_t *pkt, *udp, *ipv6;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    expect(pkt != NULL);
+    memcpy(pkt->data, PAYLOAD_MAGIC, sizeof(PAYLOAD_MAGIC));
+    ((uint8_t *)pkt->data)[PAYLOAD_LEN - 1] = seq;
+    udp = gnrc_udp_hdr_build(pkt, flow->src_port, flow->dst_port);
+    expect(udp != NULL);
+    ((udp_hdr_t *)udp->data)->length = byteorder_htons(gnrc_pkt_len(udp));
+    ipv6 = gnrc_ipv6_hdr_build(udp, &flow->src, &flow->dst);
+    expect(ipv6 != NULL);
+    ((ipv6_hdr_t *)ipv6->data)->hl = 64;
+    expect(gnrc_udp_calc_csum(udp, ipv6) == 0);
+    pkt = gnrc_netif_hdr_build(NULL, 0,
+                               flow->unicast ? _test_dst : NULL,
+                               flow->unicast ? sizeof(_test_dst) : 0);
+    expect(pkt != NULL);
+    gnrc_netif_hdr_set_netif(pkt->data, &_netif);
+    if (!flow->unicast) {
+        ((gnrc_netif_hdr_t *)pkt->data)->flags |= GNRC_NETIF_HDR_FLAGS_MULTICAST;
+    }
+    pkt->next = ipv6;
+    return pkt;
+}
+
+static size_t _send(const _flow_t *flow, uint8_t seq)
+{
+    _frame_len = 0;
+    gnrc_sixlowpan_iphc_send(_build(flow, seq), NULL, 0);
+    /* the interface thread has a higher priority, so the frame is sent when
+     * it gets to run */
+    thread_yield_higher();
+    return _frame_len;
+}
+
+static void _check(const _flow_t *flow)
+{
+    uint8_t first[FRAME_MAX];
+    size_t first_len = _send(flow, 0);
+
+    expect(first_len > 0);
+    memcpy(first, _frame, first_len);
+    /* the same packet again must result in the same frame, even when its
+     * header was taken from the cache */
+    expect(_send(flow, 0) == first_len);
+    expect(memcmp(first, _frame, first_len) == 0);
+}
+
+static void _check_invalidation(void)
+{
+    const _flow_t *flow = &_flows[1];
+    size_t len_ctx = _send(flow, 0);
+
+    expect(len_ctx > 0);
+    gnrc_sixlowpan_ctx_remove(TEST_CTX_ID);
+    /* without context the prefixes have to be carried inline */
+    expect(_send(flow, 0) > len_ctx);
+    _set_ctx();
+    expect(_send(flow, 0) == len_ctx);
+}
+
+static void _bench(const _flow_t *flow)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < PACKETS; i++) {
+        _send(flow, i);
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    printf("{ \"flow\" : \"%s\", \"ns_per_packet\" : %" PRIu32 " }\n",
+           flow->name, (uint32_t)(((uint64_t)time * 1000U) / PACKETS));
+}
+
+int main(void)
+{
+    _init_mock_netif();
+    _set_ctx();
+    for (unsigned i = 0; i < ARRAY_SIZE(_flows); i++) {
+        _check(&_flows[i]);
+    }
+    _check_invalidation();
+    for (unsigned i = 0; i < ARRAY_SIZE(_flows); i++) {
+        _bench(&_flows[i]);
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of SHA-256, HMAC-SHA-256 and PBKDF2
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/pbkdf2.h"
+#include "hashes/sha256.h"
+#include "kernel_defines.h"
+#include "macros/units.h"
+#include "test_utils/expect.h"
+#include "xtimer.h"
+
+#define BUF_LEN         (4096U)
+#define RUNS            (32U)
+#define MULTI_LEN       (64U)
+#define HMAC_LEN        (64U)
+#define HMAC_RUNS       (256U)
+#define PBKDF2_ITER     (1000U)
+
+static uint8_t _buf[BUF_LEN];
+static uint8_t _digest[BUF_LEN / MULTI_LEN][SHA256_DIGEST_LENGTH];
+
+static void _print(const char *hash, uint32_t time, uint32_t bytes)
+{
+    printf("{ \"hash\" : \"%s\", \"ns_per_byte\" : %" PRIu32, hash,
+           (uint32_t)(((uint64_t)time * 1000) / bytes));
+#ifdef CLOCK_CORECLOCK
+    printf(", \"cycles_per_byte\" : %" PRIu32,
+           (uint32_t)(((uint64_t)time * (CLOCK_CORECLOCK / MHZ(1))) / bytes));
+#endif
+    puts(" }");
+}
+
+static void _bench_sha256(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        sha256(_buf, BUF_LEN, _digest[0]);
+    }
+    _print("sha256", xtimer_now_usec() - start, RUNS * BUF_LEN);
+}
+
+static void _bench_sha256_multi(void)
+{
+    const void *msgs[ARRAY_SIZE(_digest)];
+    void *digests[ARRAY_SIZE(_digest)];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_digest); i++) {
+        msgs[i] = &_buf[i * MULTI_LEN];
+        digests[i] = _digest[i];
+    }
+
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        sha256_multi(msgs, MULTI_LEN, ARRAY_SIZE(msgs), digests);
+    }
+    _print("sha256_multi", xtimer_now_usec() - start, RUNS * BUF_LEN);
+
+    /* the results match hashing the messages one by one */
+    for (unsigned i = 0; i < ARRAY_SIZE(_digest); i++) {
+        uint8_t digest[SHA256_DIGEST_LENGTH];
+
+        sha256(msgs[i], MULTI_LEN, digest);
+        expect(memcmp(digest, _digest[i], sizeof(digest)) == 0);
+    }
+}
+
+static void _bench_hmac(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < HMAC_RUNS; i++) {
+        hmac_sha256(_buf, 32, _buf, HMAC_LEN, _digest[0]);
+    }
+    _print("hmac_sha256", xtimer_now_usec() - start, HMAC_RUNS * HMAC_LEN);
+}
+
+static void _bench_pbkdf2(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    pbkdf2_sha256(_buf, 16, &_buf[16], 16, PBKDF2_ITER, _digest[0]);
+    printf("{ \"hash\" : \"pbkdf2\", \"ns_per_iteration\" : %" PRIu32 " }\n",
+           (uint32_t)(((uint64_t)(xtimer_now_usec() - start) * 1000) /
+                      PBKDF2_ITER));
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < BUF_LEN; i++) {
+        _buf[i] = i;
+    }
+
+    _bench_sha256();
+    _bench_sha256_multi();
+    _bench_hmac();
+    _bench_pbkdf2();
+
+    puts("SUCCESS");
+    return 0;
+}
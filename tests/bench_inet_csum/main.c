@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark of the Internet checksum
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "architecture.h"
+#include "kernel_defines.h"
+#include "net/inet_csum.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define BYTES_PER_SIZE  (128UL * 1024UL)    /**< bytes summed up per size */
+#define BUF_SIZE        (1280U)
+
+static const uint16_t _sizes[] = { 8, 16, 40, 64, 128, 256, 512, BUF_SIZE };
+
+/* one extra byte for the unaligned runs */
+static uint8_t WORD_ALIGNED _buf[BUF_SIZE + 1];
+
+/* byte-wise implementation for reference */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+/* returns throughput in kB/s */
+static uint32_t _bench(bool ref, const uint8_t *buf, uint16_t len,
+                       uint16_t *res)
+{
+    unsigned rounds = BYTES_PER_SIZE / len;
+    uint16_t sum = 0;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < rounds; i++) {
+        /* chain the results, so no call can be optimized out */
+        sum = (ref) ? _ref_csum(sum, buf, len) : inet_csum(sum, buf, len);
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    *res = sum;
+    return (uint32_t)(((uint64_t)rounds * len * US_PER_MS) /
+                      ((time > 0) ? time : 1));
+}
+
+int main(void)
+{
+    bool success = true;
+
+    random_bytes(_buf, sizeof(_buf));
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        uint16_t len = _sizes[i];
+        uint16_t ref_sum, sum, unaligned_sum;
+        uint32_t ref_kbs = _bench(true, &_buf[1], len, &ref_sum);
+        uint32_t kbs = _bench(false, &_buf[1], len, &unaligned_sum);
+        uint32_t unaligned_kbs = kbs;
+
+        /* copy the data into the aligned buffer, so all results must match */
+        for (unsigned j = 0; j < len; j++) {
+            _buf[j] = _buf[j + 1];
+        }
+        kbs = _bench(false, _buf, len, &sum);
+        if ((sum != ref_sum) || (unaligned_sum != ref_sum)) {
+            printf("size %u: checksum mismatch\n", len);
+            success = false;
+        }
+        printf("{ \"size\" : %u, \"ref\" : %" PRIu32 ", \"inet_csum\" : %" PRIu32
+               ", \"inet_csum_unaligned\" : %" PRIu32 " }\n",
+               len, ref_kbs, kbs, unaligned_kbs);
+    }
+    puts(success ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Message queue throughput and interrupt latency benchmark
+ *
+ * @}
+ */
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include "macros/units.h"
+#include "thread.h"
+
+#include "msg.h"
+#include "ztimer.h"
+
+#ifndef TEST_DURATION_US
+#define TEST_DURATION_US    (1000000U)
+#endif
+
+#ifndef ISR_PERIOD_US
+#define ISR_PERIOD_US       (500U)
+#endif
+
+#define QUEUE_SIZE          (16U)
+#define MSG_TYPE_ISR        (0x4242)
+
+static char _stack[THREAD_STACKSIZE_MAIN];
+static msg_t _queue[QUEUE_SIZE];
+static kernel_pid_t _other;
+static uint32_t _isr_msgs;
+static uint32_t _isr_expected;
+static uint32_t _isr_latency_max;
+
+static void _timer_callback(void *flag)
+{
+    atomic_flag_clear(flag);
+}
+
+static void _isr_callback(void *arg)
+{
+    ztimer_t *timer = arg;
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+    msg_t msg = { .type = MSG_TYPE_ISR };
+
+    if ((now - _isr_expected) > _isr_latency_max) {
+        _isr_latency_max = now - _isr_expected;
+    }
+    msg_send_int(&msg, _other);
+    _isr_expected = now + ISR_PERIOD_US;
+    ztimer_set(ZTIMER_USEC, timer, ISR_PERIOD_US);
+}
+
+static void *_second_thread(void *arg)
+{
+    (void)arg;
+
+    msg_init_queue(_queue, QUEUE_SIZE);
+    while (1) {
+        msg_t test;
+        msg_receive(&test);
+        if (test.type == MSG_TYPE_ISR) {
+            _isr_msgs++;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    _other = thread_create(_stack,
+                           sizeof(_stack),
+                           (THREAD_PRIORITY_MAIN - 1),
+                           THREAD_CREATE_STACKTEST,
+                           _second_thread,
+                           NULL,
+                           "second_thread");
+
+    atomic_flag flag = ATOMIC_FLAG_INIT;
+    uint32_t n = 0;
+
+    ztimer_t timer = {
+        .callback = _timer_callback,
+        .arg = &flag,
+    };
+    ztimer_t isr_timer = {
+        .callback = _isr_callback,
+        .arg = &isr_timer,
+    };
+
+    atomic_flag_test_and_set(&flag);
+    _isr_expected = ztimer_now(ZTIMER_USEC) + ISR_PERIOD_US;
+    ztimer_set(ZTIMER_USEC, &isr_timer, ISR_PERIOD_US);
+    ztimer_set(ZTIMER_USEC, &timer, TEST_DURATION_US);
+
+    while (atomic_flag_test_and_set(&flag)) {
+        msg_t test = { .type = 0 };
+        msg_send(&test, _other);
+        n++;
+    }
+    ztimer_remove(ZTIMER_USEC, &isr_timer);
+
+    printf("{ \"result\" : %"PRIu32", \"isr\" : %"PRIu32
+           ", \"isr_latency_max\" : %"PRIu32, n, _isr_msgs, _isr_latency_max);
+#ifdef CLOCK_CORECLOCK
+    printf(", \"ticks\" : %"PRIu32,
+           (uint32_t)((TEST_DURATION_US/US_PER_MS) * (CLOCK_CORECLOCK/KHZ(1)))/n);
+#endif
+    puts(" }");
+
+    return 0;
+}
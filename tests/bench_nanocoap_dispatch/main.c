@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       nanocoap request dispatch benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/nanocoap.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#ifndef DISPATCHES
+#define DISPATCHES  (10000U)
+#endif
+
+#define REQUESTS    (32U)
+#define BUF_SIZE    (32U)
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)ctx;
+    return coap_build_reply(pkt, COAP_CODE_CONTENT, buf, len, 0);
+}
+
+/* sorted by construction, as the digits are listed in ASCII order */
+#define _RES(p)     { p, COAP_GET, _handler, NULL },
+#define _RES16(p)   _RES(p "0") _RES(p "1") _RES(p "2") _RES(p "3") \
+                    _RES(p "4") _RES(p "5") _RES(p "6") _RES(p "7") \
+                    _RES(p "8") _RES(p "9") _RES(p "a") _RES(p "b") \
+                    _RES(p "c") _RES(p "d") _RES(p "e") _RES(p "f")
+#define _RES256(p)  _RES16(p "0") _RES16(p "1") _RES16(p "2") _RES16(p "3") \
+                    _RES16(p "4") _RES16(p "5") _RES16(p "6") _RES16(p "7") \
+                    _RES16(p "8") _RES16(p "9") _RES16(p "a") _RES16(p "b") \
+                    _RES16(p "c") _RES16(p "d") _RES16(p "e") _RES16(p "f")
+
+const coap_resource_t coap_resources[] = {
+    _RES256("/res/0") _RES256("/res/1") _RES256("/res/2") _RES256("/res/3")
+};
+
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static const unsigned _sizes[] = { 16, 64, 256, ARRAY_SIZE(coap_resources) };
+
+static uint8_t _req_buf[REQUESTS][BUF_SIZE];
+static coap_pkt_t _req[REQUESTS];
+static uint32_t _seed = 1;
+
+static unsigned _rand(unsigned max)
+{
+    /* cheap LCG, so the generator does not dominate the measurement */
+    _seed = (_seed * 1103515245U) + 12345U;
+    return (_seed >> 16) % max;
+}
+
+static int _build_requests(unsigned num)
+{
+    for (unsigned i = 0; i < REQUESTS; i++) {
+        coap_pkt_t pkt;
+        ssize_t len = coap_build_hdr((coap_hdr_t *)_req_buf[i], COAP_TYPE_NON,
+                                     NULL, 0, COAP_METHOD_GET, i);
+
+        coap_pkt_init(&pkt, _req_buf[i], BUF_SIZE, len);
+        coap_opt_add_uri_path(&pkt, coap_resources[_rand(num)].path);
+        len = coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+        if ((len < 0) || (coap_parse(&_req[i], _req_buf[i], len) < 0)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static uint32_t _bench_dispatch(unsigned num)
+{
+    uint8_t resp_buf[BUF_SIZE];
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < DISPATCHES; i++) {
+        if (coap_tree_handler(&_req[i % REQUESTS], resp_buf, sizeof(resp_buf),
+                              coap_resources, num) < 0) {
+            return UINT32_MAX;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    printf("nanocoap request dispatch benchmark (%s)\n",
+           IS_ACTIVE(CONFIG_NANOCOAP_RESOURCE_LINEAR) ? "linear scan"
+                                                      : "binary search");
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        unsigned num = _sizes[i];
+        uint32_t dispatch;
+
+        if (_build_requests(num) < 0) {
+            puts("Unable to build requests");
+            return 1;
+        }
+        dispatch = _bench_dispatch(num);
+        if (dispatch == UINT32_MAX) {
+            puts("Dispatch failed");
+            return 1;
+        }
+        printf("{ \"resources\" : %u, \"dispatch\" : %" PRIu32 " }\n", num,
+               (uint32_t)(((uint64_t)dispatch * NS_PER_US) / DISPATCHES));
+    }
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of VFS path resolution and file descriptor handling
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include "fs/constfs.h"
+#include "kernel_defines.h"
+#include "test_utils/expect.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define RUNS            (1000U)
+
+static const uint8_t _data[] = "VFS benchmark file";
+
+static const constfs_file_t _files[] = {
+    {
+        .path = "/a.txt",
+        .data = _data,
+        .size = sizeof(_data),
+    },
+    {
+        .path = "/b.txt",
+        .data = _data,
+        .size = sizeof(_data),
+    },
+};
+
+static const constfs_t _fs = {
+    .files = _files,
+    .nfiles = ARRAY_SIZE(_files),
+};
+
+#define MOUNT(path) { \
+        .mount_point = path, \
+        .fs = &constfs_file_system, \
+        .private_data = (void *)&_fs, \
+    }
+
+static vfs_mount_t _mounts[] = {
+    MOUNT("/const"),
+    MOUNT("/data"),
+    MOUNT("/data/log"),
+    MOUNT("/mnt/a"),
+    MOUNT("/mnt/b"),
+};
+
+static const char *_paths[] = {
+    "/const/a.txt",
+    "/data/a.txt",
+    "/data/log/a.txt",
+    "/mnt/a/a.txt",
+    "/mnt/b/a.txt",
+    "/const/b.txt",
+    "/data/b.txt",
+    "/data/log/b.txt",
+    "/mnt/a/b.txt",
+    "/mnt/b/b.txt",
+};
+
+static void _print(const char *op, uint32_t time, unsigned ops)
+{
+    printf("{ \"op\" : \"%s\", \"ns_per_op\" : %" PRIu32 " }\n",
+           op, (uint32_t)(((uint64_t)time * 1000) / ops));
+}
+
+static void _bench_open_close(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(_paths); j++) {
+            int fd = vfs_open(_paths[j], O_RDONLY, 0);
+
+            expect(fd >= 0);
+            expect(vfs_close(fd) == 0);
+        }
+    }
+    _print("open+close", xtimer_now_usec() - start, RUNS * ARRAY_SIZE(_paths));
+}
+
+static void _bench_stat(void)
+{
+    struct stat st;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS; i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(_paths); j++) {
+            expect(vfs_stat(_paths[j], &st) == 0);
+        }
+    }
+    _print("stat", xtimer_now_usec() - start, RUNS * ARRAY_SIZE(_paths));
+}
+
+static void _bench_stat_same(void)
+{
+    struct stat st;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS * ARRAY_SIZE(_paths); i++) {
+        expect(vfs_stat(_paths[2], &st) == 0);
+    }
+    _print("stat same", xtimer_now_usec() - start, RUNS * ARRAY_SIZE(_paths));
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_mounts); i++) {
+        expect(vfs_mount(&_mounts[i]) == 0);
+    }
+
+    _bench_open_close();
+    _bench_stat();
+    _bench_stat_same();
+
+    puts("SUCCESS");
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark of logging small records to littlefs2 through the
+ *              VFS
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "fs/littlefs2_fs.h"
+#include "mtd.h"
+#include "test_utils/expect.h"
+#include "vfs.h"
+#include "xtimer.h"
+
+#define RECORDS         (2000U)
+#define RECORD_SIZE     (16U)
+#define LOG_FILE        "/lfs/log"
+
+static littlefs2_desc_t _fs_desc = {
+    .lock = MUTEX_INIT,
+};
+
+static vfs_mount_t _mount = {
+    .fs = &littlefs2_file_system,
+    .mount_point = "/lfs",
+    .private_data = &_fs_desc,
+};
+
+static void _print(const char *op, uint32_t time)
+{
+    printf("{ \"op\" : \"%s\", \"ns_per_record\" : %" PRIu32 " }\n",
+           op, (uint32_t)(((uint64_t)time * 1000) / RECORDS));
+}
+
+static void _make_record(uint8_t *record, unsigned num)
+{
+    memset(record, num, RECORD_SIZE);
+    memcpy(record, &num, sizeof(num));
+}
+
+static void _bench_write(void)
+{
+    uint8_t record[RECORD_SIZE];
+    uint32_t start = xtimer_now_usec();
+    int fd = vfs_open(LOG_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0);
+
+    expect(fd >= 0);
+    for (unsigned i = 0; i < RECORDS; i++) {
+        _make_record(record, i);
+        expect(vfs_write(fd, record, sizeof(record)) == (ssize_t)sizeof(record));
+    }
+    expect(vfs_fsync(fd) == 0);
+    expect(vfs_close(fd) == 0);
+    _print("log write", xtimer_now_usec() - start);
+}
+
+static void _bench_read(void)
+{
+    uint8_t expected[RECORD_SIZE];
+    uint8_t record[RECORD_SIZE];
+    uint32_t start = xtimer_now_usec();
+    int fd = vfs_open(LOG_FILE, O_RDONLY, 0);
+
+    expect(fd >= 0);
+    for (unsigned i = 0; i < RECORDS; i++) {
+        expect(vfs_read(fd, record, sizeof(record)) == (ssize_t)sizeof(record));
+        _make_record(expected, i);
+        expect(memcmp(record, expected, sizeof(record)) == 0);
+    }
+    expect(vfs_close(fd) == 0);
+    _print("log read", xtimer_now_usec() - start);
+}
+
+int main(void)
+{
+    _fs_desc.dev = MTD_0;
+    expect(vfs_format(&_mount) == 0);
+    expect(vfs_mount(&_mount) == 0);
+
+    _bench_write();
+    _bench_read();
+
+    expect(vfs_umount(&_mount) == 0);
+    puts("SUCCESS");
+    return 0;
+}
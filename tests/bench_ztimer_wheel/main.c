@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer_set()/ztimer_remove() duration over the number of
+ *              timers set
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TIMERS_NUMOF
+#define TIMERS_NUMOF    (256U)
+#endif
+
+#define LOOPS           (1000U)
+/* timers must not fire while measuring */
+#define OFFSET_MIN      (60U * MS_PER_SEC)
+#define OFFSET_RANGE    (3600U * MS_PER_SEC)
+
+static ztimer_t _timers[TIMERS_NUMOF];
+static uint32_t _seed = 1;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    puts("timer fired unexpectedly");
+}
+
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 8;
+}
+
+static uint32_t _offset(void)
+{
+    return OFFSET_MIN + (_rand() % OFFSET_RANGE);
+}
+
+static void _bench(unsigned numof)
+{
+    uint32_t set_sum = 0, set_max = 0;
+    uint32_t remove_sum = 0, remove_max = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        _timers[i].callback = _cb;
+        ztimer_set(ZTIMER_MSEC, &_timers[i], _offset());
+    }
+    for (unsigned n = 0; n < LOOPS; n++) {
+        ztimer_t *timer = &_timers[_rand() % numof];
+        uint32_t offset = _offset();
+        uint32_t start, diff;
+
+        start = ztimer_now(ZTIMER_USEC);
+        ztimer_remove(ZTIMER_MSEC, timer);
+        diff = ztimer_now(ZTIMER_USEC) - start;
+        remove_sum += diff;
+        if (diff > remove_max) {
+            remove_max = diff;
+        }
+
+        start = ztimer_now(ZTIMER_USEC);
+        ztimer_set(ZTIMER_MSEC, timer, offset);
+        diff = ztimer_now(ZTIMER_USEC) - start;
+        set_sum += diff;
+        if (diff > set_max) {
+            set_max = diff;
+        }
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_remove(ZTIMER_MSEC, &_timers[i]);
+    }
+    printf("{ \"timers\" : %u, \"set_avg\" : %lu, \"set_max\" : %lu, "
+           "\"remove_avg\" : %lu, \"remove_max\" : %lu }\n", numof,
+           (unsigned long)(((uint64_t)set_sum * NS_PER_US) / LOOPS),
+           (unsigned long)set_max,
+           (unsigned long)(((uint64_t)remove_sum * NS_PER_US) / LOOPS),
+           (unsigned long)remove_max);
+}
+
+int main(void)
+{
+    static const unsigned numof[] = {
+        TIMERS_NUMOF / 32, TIMERS_NUMOF / 8, TIMERS_NUMOF / 2, TIMERS_NUMOF,
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(numof); i++) {
+        _bench(numof[i] ? numof[i] : 1);
+    }
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the size-class packet buffer
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf/sizeclass.h"
+
+#define TEST_STRING "Packet buffer contents"
+
+static gnrc_pktbuf_sizeclass_stats_t _stats;
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+}
+
+static void test_pktbuf_sizeclass_init(void)
+{
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_sizeclass_get_stats(&_stats);
+    TEST_ASSERT_EQUAL_INT(0, _stats.used);
+    TEST_ASSERT_EQUAL_INT(CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_NUMOF,
+                          _stats.classes[1].numof);
+}
+
+static void test_pktbuf_sizeclass_add_release(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 40, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_sizeclass_get_stats(&_stats);
+    TEST_ASSERT_EQUAL_INT(1, _stats.classes[0].used);
+    TEST_ASSERT_EQUAL_INT(1, _stats.classes[1].used);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_sizeclass_get_stats(&_stats);
+    TEST_ASSERT_EQUAL_INT(1, _stats.classes[1].max_used);
+    TEST_ASSERT(_stats.max_used > 0);
+}
+
+static void test_pktbuf_sizeclass_add__too_large(void)
+{
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL,
+                                     CONFIG_GNRC_PKTBUF_SIZECLASS_LARGE_SIZE + 1,
+                                     GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_sizeclass_add__fallback(void)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_PKTBUF_SIZECLASS_SMALL_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_pktbuf_add(NULL, NULL, 40, GNRC_NETTYPE_TEST));
+    }
+    TEST_ASSERT_NOT_NULL(gnrc_pktbuf_add(NULL, NULL, 40, GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_sizeclass_get_stats(&_stats);
+    TEST_ASSERT_EQUAL_INT(0, _stats.classes[1].fallbacks);
+    TEST_ASSERT_EQUAL_INT(1, _stats.classes[2].fallbacks);
+}
+
+static void test_pktbuf_sizeclass_add__exhausted(void)
+{
+    TEST_ASSERT_NOT_NULL(gnrc_pktbuf_add(NULL, NULL, 1000, GNRC_NETTYPE_TEST));
+    for (unsigned i = 0; i < CONFIG_GNRC_PKTBUF_SIZECLASS_MEDIUM_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(gnrc_pktbuf_add(NULL, NULL, 200, GNRC_NETTYPE_TEST));
+    }
+    /* enough bytes are left in the small classes, but not in one block */
+    TEST_ASSERT_NULL(gnrc_pktbuf_add(NULL, NULL, 250, GNRC_NETTYPE_TEST));
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_sizeclass_get_stats(&_stats);
+    TEST_ASSERT_EQUAL_INT(1, _stats.failed);
+    TEST_ASSERT_EQUAL_INT(1, _stats.failed_frag);
+    gnrc_pktbuf_sizeclass_reset_stats();
+    gnrc_pktbuf_sizeclass_get_stats(&_stats);
+    TEST_ASSERT_EQUAL_INT(0, _stats.failed);
+}
+
+static void test_pktbuf_sizeclass_mark(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING,
+                                          sizeof(TEST_STRING),
+                                          GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 7, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(pkt->next == hdr);
+    TEST_ASSERT_EQUAL_INT(7, hdr->size);
+    TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING) - 7, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING, hdr->data, 7));
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING + 7, pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+static void test_pktbuf_sizeclass_realloc_data(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, "abcd", 4, GNRC_NETTYPE_TEST);
+    void *data;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* grows beyond a snip sized block */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 50));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("abcd", pkt->data, 4));
+    data = pkt->data;
+    /* still fits the small block */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 60));
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 0));
+    TEST_ASSERT_NULL(pkt->data);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_sizeclass_start_write(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, TEST_STRING,
+                                          sizeof(TEST_STRING),
+                                          GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *copy;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_pktbuf_hold(pkt, 1);
+    copy = gnrc_pktbuf_start_write(pkt);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT(copy != pkt);
+    TEST_ASSERT_EQUAL_STRING(TEST_STRING, copy->data);
+    gnrc_pktbuf_release(copy);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+
+static Test *tests_pktbuf_sizeclass(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktbuf_sizeclass_init),
+        new_TestFixture(test_pktbuf_sizeclass_add_release),
+        new_TestFixture(test_pktbuf_sizeclass_add__too_large),
+        new_TestFixture(test_pktbuf_sizeclass_add__fallback),
+        new_TestFixture(test_pktbuf_sizeclass_add__exhausted),
+        new_TestFixture(test_pktbuf_sizeclass_mark),
+        new_TestFixture(test_pktbuf_sizeclass_realloc_data),
+        new_TestFixture(test_pktbuf_sizeclass_start_write),
+    };
+
+    EMB_UNIT_TESTCALLER(pktbuf_sizeclass_tests, set_up, NULL, fixtures);
+
+    return (Test *)&pktbuf_sizeclass_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_pktbuf_sizeclass());
+    TESTS_END();
+
+    return 0;
+}
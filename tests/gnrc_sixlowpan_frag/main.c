@@ -315,6 +315,44 @@ static void test_rbuf_add__success_duplicate_fragments(void)
     _check_pktbuf(entry);
 }
 
+static void test_rbuf_add__out_of_order(void)
+{
+    static const uint16_t offsets[] = {
+        TEST_FRAGMENT3_OFFSET, TEST_FRAGMENT1_OFFSET, TEST_FRAGMENT4_OFFSET,
+        /* duplicate that is not the interval received last */
+        TEST_FRAGMENT3_OFFSET,
+    };
+    uint8_t *frags[] = { _fragment3, _fragment1, _fragment4, _fragment3 };
+    size_t sizes[] = {
+        sizeof(_fragment3), sizeof(_fragment1), sizeof(_fragment4),
+        sizeof(_fragment3),
+    };
+    const gnrc_sixlowpan_frag_rb_t *entry = NULL;
+    const gnrc_sixlowpan_frag_rb_int_t *ptr;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(offsets); i++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, frags[i], sizes[i],
+                                              GNRC_NETTYPE_SIXLOWPAN);
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        TEST_ASSERT_NOT_NULL((entry = gnrc_sixlowpan_frag_rb_add(
+                &_test_netif_hdr.hdr, pkt, offsets[i], TEST_PAGE
+            )));
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE - (TEST_FRAGMENT3_OFFSET -
+                                                TEST_FRAGMENT2_OFFSET),
+                          entry->super.current_size);
+    /* intervals are sorted by descending start */
+    TEST_ASSERT_NOT_NULL((ptr = entry->super.ints));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT4_OFFSET, ptr->start);
+    TEST_ASSERT_NOT_NULL((ptr = ptr->next));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET, ptr->start);
+    TEST_ASSERT_NOT_NULL((ptr = ptr->next));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT1_OFFSET, ptr->start);
+    TEST_ASSERT_NULL(ptr->next);
+    _check_pktbuf(entry);
+}
+
 static void test_rbuf_add__success_complete(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
@@ -555,6 +593,40 @@ static void test_rbuf_get_by_dg(void)
     _check_pktbuf(entry);
 }
 
+static void test_rbuf_get_by_dg__multiple(void)
+{
+    const gnrc_sixlowpan_frag_rb_t *entry;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        gnrc_pktsnip_t *pkt;
+
+        _set_fragment_tag(_fragment1, TEST_TAG + i);
+        pkt = gnrc_pktbuf_add(NULL, _fragment1, sizeof(_fragment1),
+                              GNRC_NETTYPE_SIXLOWPAN);
+        TEST_ASSERT_NOT_NULL(pkt);
+        TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, TEST_FRAGMENT1_OFFSET, TEST_PAGE
+        ));
+    }
+    /* remove the first datagram, all others must still be found */
+    gnrc_sixlowpan_frag_rb_rm_by_datagram(&_test_netif_hdr.hdr, TEST_TAG);
+    TEST_ASSERT_NULL(
+        gnrc_sixlowpan_frag_rb_get_by_datagram(&_test_netif_hdr.hdr, TEST_TAG)
+    );
+    for (unsigned i = 1; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        entry = gnrc_sixlowpan_frag_rb_get_by_datagram(&_test_netif_hdr.hdr,
+                                                       TEST_TAG + i);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL_INT(TEST_TAG + i, entry->super.tag);
+        /* intentionally discarding const qualifier since we enter rbuf's
+         * internal context again */
+        gnrc_pktbuf_release(entry->pkt);
+        gnrc_sixlowpan_frag_rb_remove((gnrc_sixlowpan_frag_rb_t *)entry);
+    }
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+}
+
 static void test_rbuf_exists(void)
 {
     const gnrc_sixlowpan_frag_rb_t *entry;
@@ -645,12 +717,14 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_add__success_first_fragment),
         new_TestFixture(test_rbuf_add__success_subsequent_fragment),
         new_TestFixture(test_rbuf_add__success_duplicate_fragments),
+        new_TestFixture(test_rbuf_add__out_of_order),
         new_TestFixture(test_rbuf_add__success_complete),
         new_TestFixture(test_rbuf_add__full_rbuf),
         new_TestFixture(test_rbuf_add__too_big_fragment),
         new_TestFixture(test_rbuf_add__overlap_lhs),
         new_TestFixture(test_rbuf_add__overlap_rhs),
         new_TestFixture(test_rbuf_get_by_dg),
+        new_TestFixture(test_rbuf_get_by_dg__multiple),
         new_TestFixture(test_rbuf_exists),
         new_TestFixture(test_rbuf_rm_by_dg),
         new_TestFixture(test_rbuf_rm),
@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "net/sock/udp.h"
 #include "test_utils/expect.h"
@@ -493,6 +494,57 @@ static void test_sock_udp_recv_buf__success(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_multi__EAGAIN(void)
+{
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_msg_t msgs[2] = {
+        { .data = _test_buffer, .max_len = sizeof(_test_buffer) },
+        { .data = _test_buffer, .max_len = sizeof(_test_buffer) },
+    };
+
+    expect(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    expect(-EAGAIN == sock_udp_recv_multi(&_sock, msgs, ARRAY_SIZE(msgs), 0));
+    expect(_check_net());
+}
+
+static void test_sock_udp_recv_multi__success(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    static const char *payloads[] = { "ABCD", "EFGHIJKL", "MN" };
+    sock_udp_msg_t msgs[ARRAY_SIZE(payloads) + 1];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(msgs); i++) {
+        msgs[i].data = &_test_buffer[i * (sizeof(_test_buffer) / ARRAY_SIZE(msgs))];
+        msgs[i].max_len = sizeof(_test_buffer) / ARRAY_SIZE(msgs);
+    }
+    /* too small for the second message */
+    msgs[1].max_len = strlen(payloads[1]);
+    expect(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    for (unsigned i = 0; i < ARRAY_SIZE(payloads); i++) {
+        expect(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE + i,
+                              _TEST_PORT_LOCAL, (void *)payloads[i],
+                              strlen(payloads[i]) + 1, _TEST_NETIF));
+    }
+    expect((int)ARRAY_SIZE(payloads) == sock_udp_recv_multi(&_sock, msgs,
+                                                            ARRAY_SIZE(msgs),
+                                                            SOCK_NO_TIMEOUT));
+    expect((ssize_t)sizeof("ABCD") == msgs[0].len);
+    expect(strcmp(payloads[0], msgs[0].data) == 0);
+    expect(-ENOBUFS == msgs[1].len);
+    expect((ssize_t)sizeof("MN") == msgs[2].len);
+    expect(strcmp(payloads[2], msgs[2].data) == 0);
+    for (unsigned i = 0; i < ARRAY_SIZE(payloads); i++) {
+        expect(AF_INET6 == msgs[i].remote.family);
+        expect(memcmp(&msgs[i].remote.addr, &src_addr, sizeof(src_addr)) == 0);
+        expect(_TEST_PORT_REMOTE + i == msgs[i].remote.port);
+    }
+    expect(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -629,6 +681,30 @@ static void test_sock_udp_send__socketed(void)
     expect(_check_net());
 }
 
+static void test_sock_udp_sendv__socketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { NULL, (void *)"CD", sizeof("CD") };
+    iolist_t empty = { &tail, NULL, 0 };
+    iolist_t head = { &empty, (void *)"AB", 2 };
+
+    expect(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    expect(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    expect(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    expect(_check_net());
+}
+
 static void test_sock_udp_send__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
@@ -798,6 +874,8 @@ int main(void)
     CALL(test_sock_udp_recv__non_blocking());
     CALL(test_sock_udp_recv__aux());
     CALL(test_sock_udp_recv_buf__success());
+    CALL(test_sock_udp_recv_multi__EAGAIN());
+    CALL(test_sock_udp_recv_multi__success());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -808,6 +886,7 @@ int main(void)
     CALL(test_sock_udp_send__socketed_no_netif());
     CALL(test_sock_udp_send__socketed_no_local());
     CALL(test_sock_udp_send__socketed());
+    CALL(test_sock_udp_sendv__socketed());
     CALL(test_sock_udp_send__socketed_other_remote());
     CALL(test_sock_udp_send__unsocketed_no_local_no_netif());
     CALL(test_sock_udp_send__unsocketed_no_netif());
@@ -119,6 +119,21 @@ bool _check_net(void)
     return (gnrc_pktbuf_is_sane() && gnrc_pktbuf_is_empty());
 }
 
+static bool _check_payload(gnrc_pktsnip_t *payload, const uint8_t *data,
+                           size_t data_len)
+{
+    if (gnrc_pkt_len(payload) != data_len) {
+        return false;
+    }
+    for (; payload != NULL; payload = payload->next) {
+        if (memcmp(data, payload->data, payload->size) != 0) {
+            return false;
+        }
+        data += payload->size;
+    }
+    return true;
+}
+
 static inline bool _res(gnrc_pktsnip_t *pkt, bool res)
 {
     gnrc_pktbuf_release(pkt);
@@ -170,6 +185,5 @@ bool _check_packet(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                 (random_src_port || (src_port == byteorder_ntohs(udp_hdr->src_port))) &&
                 (dst_port == byteorder_ntohs(udp_hdr->dst_port)) &&
                 (udp->next != NULL) &&
-                (data_len == udp->next->size) &&
-                (memcmp(data, udp->next->data, data_len) == 0));
+                _check_payload(udp->next, data, data_len));
 }
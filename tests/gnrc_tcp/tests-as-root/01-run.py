@@ -8,11 +8,13 @@
 
 import os
 import sys
+import time
 import random
 import pexpect
 import base64
+import subprocess
 
-from scapy.all import Ether, IPv6, TCP, raw, sendp
+from scapy.all import Ether, IPv6, TCP, raw, sendp, AsyncSniffer
 
 from helpers import Runner, RiotTcpServer, RiotTcpClient, HostTcpServer, HostTcpClient, \
                     generate_port_number, sudo_guard
@@ -216,6 +218,169 @@ def test_gnrc_tcp_garbage_packets_option_parsing(child):
         riot_srv.close()
 
 
+@Runner(timeout=10)
+def test_send_large_data_from_host_to_riot(child):
+    """ Send Data exceeding the receive window from Host system to RIOT node.
+        The host stack negotiates window scaling and SACK.
+    """
+    # Setup RIOT as server
+    with RiotTcpServer(child, generate_port_number()) as riot_srv:
+        # Setup Host as client
+        with HostTcpClient(riot_srv) as host_cli:
+            riot_srv.accept(timeout_ms=1000)
+
+            # Send Data from Host system to RIOT, receive in chunks
+            data = '0123456789' * 400
+            host_cli.send(data)
+            for i in range(0, len(data), 1000):
+                riot_srv.receive(timeout_ms=1000, sent_payload=data[i:i + 1000])
+
+            riot_srv.close()
+
+
+def _send_and_sniff(riot_srv, host_cli, tcp_hdr, payload=b''):
+    """ Send a TCP segment to riot_srv and return the segment sent in reply """
+    sniffer = AsyncSniffer(
+        iface=host_cli.interface, count=1, timeout=2,
+        lfilter=lambda p: TCP in p and p[TCP].sport == int(riot_srv.listen_port) and
+        p[TCP].dport == tcp_hdr.sport
+    )
+    sniffer.start()
+    time.sleep(0.1)
+    sendp(
+        Ether(dst=riot_srv.mac) / IPv6(src=host_cli.address, dst=riot_srv.address) /
+        tcp_hdr / payload, iface=host_cli.interface, verbose=0
+    )
+    sniffer.join()
+    assert len(sniffer.results) == 1
+    return sniffer.results[0][TCP]
+
+
+@Runner(timeout=15)
+def test_gnrc_tcp_reassembly_sack_and_window_scale(child):
+    """ Negotiate window scaling and SACK, then deliver payload out of order.
+        Note: the values must match REASS_QUEUE_SIZE, ENABLE_SACK and
+        WND_SCALE from the makefile
+    """
+    sport = 2342
+    seq = 100
+    # Keep the host kernel from resetting the connection it does not know about
+    rule = ['OUTPUT', '-p', 'tcp', '--sport', str(sport), '--tcp-flags', 'RST', 'RST',
+            '-j', 'DROP']
+    subprocess.check_call(['ip6tables', '-A'] + rule)
+    try:
+        with RiotTcpServer(child, generate_port_number()) as riot_srv:
+            host_cli = HostTcpClient(riot_srv)
+            dport = int(riot_srv.listen_port)
+            child.sendline('gnrc_tcp_accept 5000')
+
+            # Handshake: SYN-ACK must carry window scale and SACK permitted
+            syn_ack = _send_and_sniff(riot_srv, host_cli, TCP(
+                sport=sport, dport=dport, flags='S', seq=seq,
+                options=[('MSS', 1220), ('WScale', 1), ('SAckOK', b'')]
+            ))
+            assert syn_ack.flags == 'SA'
+            assert syn_ack.ack == seq + 1
+            options = dict(syn_ack.options)
+            assert options['WScale'] == 2
+            assert 'SAckOK' in options
+            seq += 1
+            ack = syn_ack.seq + 1
+            sendp(
+                Ether(dst=riot_srv.mac) / IPv6(src=host_cli.address, dst=riot_srv.address) /
+                TCP(sport=sport, dport=dport, flags='A', seq=seq, ack=ack),
+                iface=host_cli.interface, verbose=0
+            )
+            child.expect_exact('gnrc_tcp_accept: returns 0')
+            riot_srv.opened = True
+
+            # Second half first: duplicate ACK reports the queued segment
+            dup_ack = _send_and_sniff(riot_srv, host_cli, TCP(
+                sport=sport, dport=dport, flags='A', seq=seq + 5, ack=ack
+            ), b'56789')
+            assert dup_ack.ack == seq
+            assert dict(dup_ack.options)['SAck'] == (seq + 5, seq + 10)
+
+            # Fill the gap: cumulative ACK covers both segments
+            full_ack = _send_and_sniff(riot_srv, host_cli, TCP(
+                sport=sport, dport=dport, flags='A', seq=seq, ack=ack
+            ), b'01234')
+            assert full_ack.ack == seq + 10
+            assert 'SAck' not in dict(full_ack.options)
+
+            riot_srv.receive(timeout_ms=1000, sent_payload='0123456789')
+            riot_srv.abort()
+    finally:
+        subprocess.check_call(['ip6tables', '-D'] + rule)
+
+
+@Runner(timeout=15)
+def test_gnrc_tcp_fast_retransmit(child):
+    """ Three duplicate ACKs make RIOT send an unacknowledged segment again
+        before the retransmission timeout expires.
+        Note: requires CONGURE_RENO from the makefile
+    """
+    sport = 2343
+    seq = 100
+    data = '0123456789'
+    # Keep the host kernel from resetting the connection it does not know about
+    rule = ['OUTPUT', '-p', 'tcp', '--sport', str(sport), '--tcp-flags', 'RST', 'RST',
+            '-j', 'DROP']
+    subprocess.check_call(['ip6tables', '-A'] + rule)
+    try:
+        with RiotTcpServer(child, generate_port_number()) as riot_srv:
+            host_cli = HostTcpClient(riot_srv)
+            dport = int(riot_srv.listen_port)
+            child.sendline('gnrc_tcp_accept 5000')
+
+            syn_ack = _send_and_sniff(riot_srv, host_cli, TCP(
+                sport=sport, dport=dport, flags='S', seq=seq
+            ))
+            assert syn_ack.flags == 'SA'
+            seq += 1
+            ack = syn_ack.seq + 1
+            pkt = Ether(dst=riot_srv.mac) / IPv6(src=host_cli.address, dst=riot_srv.address)
+            sendp(pkt / TCP(sport=sport, dport=dport, flags='A', seq=seq, ack=ack),
+                  iface=host_cli.interface, verbose=0)
+            child.expect_exact('gnrc_tcp_accept: returns 0')
+            riot_srv.opened = True
+
+            # Capture the segment and its retransmission
+            sniffer = AsyncSniffer(
+                iface=host_cli.interface, count=2, timeout=3,
+                lfilter=lambda p: TCP in p and p[TCP].sport == dport and
+                p[TCP].dport == sport and len(p[TCP].payload) > 0
+            )
+            sniffer.start()
+            time.sleep(0.1)
+            assert riot_srv._setup_internal_buffer() >= len(data)
+            riot_srv._write_data_to_internal_buffer(data)
+            child.sendline('gnrc_tcp_send 5000 {}'.format(len(data)))
+            time.sleep(0.1)
+
+            # Report the segment as lost by three duplicate ACKs
+            for _ in range(3):
+                sendp(pkt / TCP(sport=sport, dport=dport, flags='A', seq=seq, ack=ack),
+                      iface=host_cli.interface, verbose=0)
+            sniffer.join()
+            assert len(sniffer.results) == 2
+            first, second = sniffer.results
+            assert first[TCP].seq == ack
+            assert second[TCP].seq == ack
+            assert raw(second[TCP].payload) == data.encode('utf-8')
+            # The retransmission timeout is at least one second
+            assert second.time - first.time < 0.8
+
+            # Acknowledge the segment, gnrc_tcp_send returns
+            sendp(pkt / TCP(sport=sport, dport=dport, flags='A', seq=seq,
+                            ack=ack + len(data)),
+                  iface=host_cli.interface, verbose=0)
+            child.expect_exact('gnrc_tcp_send: sent {}'.format(len(data)))
+            riot_srv.abort()
+    finally:
+        subprocess.check_call(['ip6tables', '-D'] + rule)
+
+
 @Runner(timeout=5)
 def test_gnrc_tcp_recv_behavior_on_closed_connection(child):
     """ This test ensures that a gnrc_tcp_recv doesn't block if a connection
@@ -1142,6 +1142,36 @@ static void test_sock_udp_recv_buf6__success(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_multi6__success(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR6_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR6_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_msg_t msgs[2] = {
+        { .data = &_test_buffer[0], .max_len = sizeof(_test_buffer) / 2 },
+        { .data = &_test_buffer[sizeof(_test_buffer) / 2],
+          .max_len = sizeof(_test_buffer) / 2 },
+    };
+
+    expect(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    expect(_inject_6packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                           _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                           _TEST_NETIF));
+    expect(_inject_6packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE + 1,
+                           _TEST_PORT_LOCAL, "EF", sizeof("EF"),
+                           _TEST_NETIF));
+    expect(2 == sock_udp_recv_multi(&_sock, msgs, 2, SOCK_NO_TIMEOUT));
+    expect((ssize_t)sizeof("ABCD") == msgs[0].len);
+    expect(memcmp("ABCD", msgs[0].data, sizeof("ABCD")) == 0);
+    expect(_TEST_PORT_REMOTE == msgs[0].remote.port);
+    expect((ssize_t)sizeof("EF") == msgs[1].len);
+    expect(memcmp("EF", msgs[1].data, sizeof("EF")) == 0);
+    expect(_TEST_PORT_REMOTE + 1 == msgs[1].remote.port);
+    expect(-EAGAIN == sock_udp_recv_multi(&_sock, msgs, 2, 0));
+    expect(_check_net());
+}
+
 static void test_sock_udp_send6__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR6_REMOTE },
@@ -1288,6 +1318,29 @@ static void test_sock_udp_send6__socketed(void)
     expect(_check_net());
 }
 
+static void test_sock_udp_sendv6__socketed(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR6_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR6_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR6_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR6_REMOTE },
+                                          .family = AF_INET6,
+                                          .port = _TEST_PORT_REMOTE };
+    iolist_t tail = { NULL, (void *)"CD", sizeof("CD") };
+    iolist_t head = { &tail, (void *)"AB", 2 };
+
+    expect(0 == sock_udp_create(&_sock, &local, &remote, SOCK_FLAGS_REUSE_EP));
+    expect(sizeof("ABCD") == sock_udp_sendv(&_sock, &head, NULL));
+    expect(_check_6packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                          _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let lwIP stack finish */
+    expect(_check_net());
+}
+
 static void test_sock_udp_send6__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR6_LOCAL };
@@ -1520,6 +1573,7 @@ int main(void)
     CALL(test_sock_udp_recv6__non_blocking());
     CALL(test_sock_udp_recv6__aux());
     CALL(test_sock_udp_recv_buf6__success());
+    CALL(test_sock_udp_recv_multi6__success());
     _prepare_send_checks();
     CALL(test_sock_udp_send6__EAFNOSUPPORT());
     CALL(test_sock_udp_send6__EINVAL_addr());
@@ -1531,6 +1585,7 @@ int main(void)
     CALL(test_sock_udp_send6__socketed_no_netif());
     CALL(test_sock_udp_send6__socketed_no_local());
     CALL(test_sock_udp_send6__socketed());
+    CALL(test_sock_udp_sendv6__socketed());
     CALL(test_sock_udp_send6__socketed_other_remote());
     CALL(test_sock_udp_send6__unsocketed_no_local_no_netif());
     CALL(test_sock_udp_send6__unsocketed_no_netif());
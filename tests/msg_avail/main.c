@@ -23,8 +23,10 @@
 #include <stdio.h>
 #include <inttypes.h>
 
+#include "kernel_defines.h"
 #include "log.h"
 #include "msg.h"
+#include "thread.h"
 
 #define MSG_QUEUE_LENGTH                (8)
 
@@ -59,6 +61,30 @@ int main(void)
             return 1;
         }
     }
+#if IS_USED(MODULE_CORE_MSG_MPSC)
+    /* a slot reserved by a preempted sender hides the messages behind it */
+    cib_t *queue = &thread_get_active()->msg_queue;
+    unsigned reserved = queue->write_count++ & queue->mask;
+    msg_t msg = { .type = 1 };
+
+    msg_send_to_self(&msg);
+    if (msg_avail() != 0) {
+        puts("[FAILED]");
+        return 1;
+    }
+    /* publish it */
+    msg_queue[reserved].sender_pid = thread_getpid();
+    if (msg_avail() != 2) {
+        puts("[FAILED]");
+        return 1;
+    }
+    msg_receive(&msg);
+    msg_receive(&msg);
+    if ((msg.type != 1) || (msg_avail() != 0)) {
+        puts("[FAILED]");
+        return 1;
+    }
+#endif
     puts("[SUCCESS]");
     return 0;
 }
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_async module test
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "event.h"
+#include "event/thread.h"
+#include "mtd.h"
+#include "mtd_async.h"
+
+/* Test mock object implementing a RAM-based mtd that logs the operations */
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT 8
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 4
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 64
+#endif
+
+#define SECTOR_SIZE         (PAGE_SIZE * PAGE_PER_SECTOR)
+#define MEMORY_SIZE         (SECTOR_SIZE * SECTOR_COUNT)
+#define LOG_SIZE            (8U)
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+
+typedef struct {
+    char op;                /**< 'r', 'w', or 'e' */
+    uint32_t page;          /**< first page, or sector */
+} _log_entry_t;
+
+static uint8_t _dummy_memory[MEMORY_SIZE];
+static _log_entry_t _log[LOG_SIZE];
+static unsigned _log_len;
+
+static uint8_t _buffer[SECTOR_SIZE];
+
+static void _log_op(char op, uint32_t page)
+{
+    if (_log_len < LOG_SIZE) {
+        _log[_log_len].op = op;
+        _log[_log_len].page = page;
+        _log_len++;
+    }
+}
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+static int _read_page(mtd_dev_t *dev, void *buff, uint32_t page,
+                      uint32_t offset, uint32_t size)
+{
+    uint32_t addr = page * dev->page_size + offset;
+
+    if (page >= dev->sector_count * dev->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+
+    size = MIN(dev->page_size - offset, size);
+    memcpy(buff, _dummy_memory + addr, size);
+    _log_op('r', page);
+
+    return size;
+}
+
+static int _write_page(mtd_dev_t *dev, const void *buff, uint32_t page,
+                       uint32_t offset, uint32_t size)
+{
+    uint32_t addr = page * dev->page_size + offset;
+
+    if (page >= dev->sector_count * dev->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+
+    size = MIN(dev->page_size - offset, size);
+    memcpy(_dummy_memory + addr, buff, size);
+    _log_op('w', page);
+
+    return size;
+}
+
+static int _erase_sector(mtd_dev_t *dev, uint32_t sector, uint32_t count)
+{
+    uint32_t addr = sector * dev->page_size * dev->pages_per_sector;
+
+    if (sector + count > dev->sector_count) {
+        return -EOVERFLOW;
+    }
+
+    memset(_dummy_memory + addr, 0xff,
+           count * dev->page_size * dev->pages_per_sector);
+    _log_op('e', sector);
+
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = _init,
+    .read_page    = _read_page,
+    .write_page   = _write_page,
+    .erase_sector = _erase_sector,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtd_async_t _async;
+static event_queue_t _queue;
+
+static mtd_async_req_t *_done[LOG_SIZE];
+static unsigned _done_len;
+
+static void _done_handler(event_t *event)
+{
+    if (_done_len < LOG_SIZE) {
+        _done[_done_len++] = (mtd_async_req_t *)event;
+    }
+}
+
+static mtd_async_req_t _reqs[4] = {
+    { .super.handler = _done_handler },
+    { .super.handler = _done_handler },
+    { .super.handler = _done_handler },
+    { .super.handler = _done_handler },
+};
+
+/* handles the completion events of @p num requests */
+static void _wait(unsigned num)
+{
+    while (num--) {
+        event_t *event = event_wait(&_queue);
+        event->handler(event);
+    }
+}
+
+static void setup(void)
+{
+    memset(_dummy_memory, 0x00, sizeof(_dummy_memory));
+    _log_len = 0;
+    _done_len = 0;
+}
+
+static void test_mtd_async_init(void)
+{
+    event_queue_init(&_queue);
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(&dev));
+    mtd_async_init(&_async, &dev, EVENT_PRIO_LOWEST);
+}
+
+static void test_mtd_async_invalid(void)
+{
+    mtd_async_req_t req = { .super.handler = NULL };
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          mtd_async_erase_sector(&_async, &req, &_queue, 0, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          mtd_async_erase_sector(&_async, &_reqs[0], NULL, 0, 1));
+}
+
+static void test_mtd_async_write_read(void)
+{
+    static const uint8_t data[] = "mtd_async";
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_async, &_reqs[0], &_queue,
+                                                    2, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_write_page_raw(&_async, &_reqs[1],
+                                                      &_queue, data,
+                                                      2 * PAGE_PER_SECTOR, 8,
+                                                      sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_read_page(&_async, &_reqs[2], &_queue,
+                                                 _buffer, 2 * PAGE_PER_SECTOR,
+                                                 0, SECTOR_SIZE));
+    /* the requests were only queued */
+    TEST_ASSERT_EQUAL_INT(-EINPROGRESS, _reqs[2].res);
+    TEST_ASSERT_EQUAL_INT(0, _log_len);
+
+    _wait(3);
+    TEST_ASSERT_EQUAL_INT(3, _done_len);
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT(_done[i] == &_reqs[i]);
+        TEST_ASSERT_EQUAL_INT(0, _reqs[i].res);
+    }
+    for (unsigned i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_INT(0xff, _buffer[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_buffer[8], data, sizeof(data)));
+    for (unsigned i = 8 + sizeof(data); i < SECTOR_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0xff, _buffer[i]);
+    }
+}
+
+static void test_mtd_async_reorder(void)
+{
+    static const uint8_t data[PAGE_SIZE];
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_async, &_reqs[0], &_queue,
+                                                    1, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_write_page_raw(&_async, &_reqs[1],
+                                                      &_queue, data,
+                                                      PAGE_PER_SECTOR + 1, 0,
+                                                      PAGE_SIZE));
+    /* depends on the write, has to wait for it */
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_read_page(&_async, &_reqs[2], &_queue,
+                                                 _buffer, PAGE_PER_SECTOR + 1,
+                                                 0, 1));
+    /* independent of the erase and the write, is executed first */
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_read_page(&_async, &_reqs[3], &_queue,
+                                                 _buffer, 0, 0, PAGE_SIZE));
+
+    _wait(4);
+    TEST_ASSERT_EQUAL_INT(4, _log_len);
+    TEST_ASSERT_EQUAL_INT('r', _log[0].op);
+    TEST_ASSERT_EQUAL_INT(0, _log[0].page);
+    TEST_ASSERT_EQUAL_INT('e', _log[1].op);
+    TEST_ASSERT_EQUAL_INT(1, _log[1].page);
+    TEST_ASSERT_EQUAL_INT('w', _log[2].op);
+    TEST_ASSERT_EQUAL_INT('r', _log[3].op);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR + 1, _log[3].page);
+
+    TEST_ASSERT(_done[0] == &_reqs[3]);
+    TEST_ASSERT(_done[1] == &_reqs[0]);
+    TEST_ASSERT(_done[2] == &_reqs[1]);
+    TEST_ASSERT(_done[3] == &_reqs[2]);
+}
+
+static void test_mtd_async_cancel(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_async, &_reqs[0], &_queue,
+                                                    0, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_async, &_reqs[1], &_queue,
+                                                    1, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_cancel(&_async, &_reqs[1]));
+
+    _wait(1);
+    TEST_ASSERT(_done[0] == &_reqs[0]);
+    TEST_ASSERT_EQUAL_INT(-EALREADY, mtd_async_cancel(&_async, &_reqs[0]));
+    TEST_ASSERT_EQUAL_INT(1, _log_len);
+    TEST_ASSERT(event_get(&_queue) == NULL);
+}
+
+static void test_mtd_async_error(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_async_erase_sector(&_async, &_reqs[0], &_queue,
+                                                    SECTOR_COUNT, 1));
+    _wait(1);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, _reqs[0].res);
+}
+
+Test *tests_mtd_async_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_async_init),
+        new_TestFixture(test_mtd_async_invalid),
+        new_TestFixture(test_mtd_async_write_read),
+        new_TestFixture(test_mtd_async_reorder),
+        new_TestFixture(test_mtd_async_cancel),
+        new_TestFixture(test_mtd_async_error),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_async_tests, setup, NULL, fixtures);
+
+    return (Test *)&mtd_async_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_async_tests());
+    TESTS_END();
+    return 0;
+}
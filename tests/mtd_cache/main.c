@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       mtd_cache module test
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_cache.h"
+
+/* Test mock object implementing a RAM-based mtd with NOR flash semantics */
+#ifndef SECTOR_COUNT
+#define SECTOR_COUNT 8
+#endif
+#ifndef PAGE_PER_SECTOR
+#define PAGE_PER_SECTOR 4
+#endif
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 64
+#endif
+
+#define SECTOR_SIZE         (PAGE_SIZE * PAGE_PER_SECTOR)
+#define MEMORY_SIZE         (SECTOR_SIZE * SECTOR_COUNT)
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+
+static uint8_t _dummy_memory[MEMORY_SIZE];
+static unsigned _erase_count;
+static uint32_t _program_count;
+static uint32_t _fail_page = UINT32_MAX;
+static bool _powered_down;
+
+static uint8_t _buffer[SECTOR_SIZE];
+
+static int _init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    return 0;
+}
+
+static int _read_page(mtd_dev_t *dev, void *buff, uint32_t page,
+                      uint32_t offset, uint32_t size)
+{
+    uint32_t addr = page * dev->page_size + offset;
+
+    if (page >= dev->sector_count * dev->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+
+    size = MIN(dev->page_size - offset, size);
+    memcpy(buff, _dummy_memory + addr, size);
+
+    return size;
+}
+
+static int _write_page(mtd_dev_t *dev, const void *buff, uint32_t page,
+                       uint32_t offset, uint32_t size)
+{
+    uint32_t addr = page * dev->page_size + offset;
+    const uint8_t *src = buff;
+
+    if (page >= dev->sector_count * dev->pages_per_sector) {
+        return -EOVERFLOW;
+    }
+    if (page == _fail_page) {
+        return -EIO;
+    }
+
+    size = MIN(dev->page_size - offset, size);
+    /* programming can only clear bits */
+    for (uint32_t i = 0; i < size; i++) {
+        _dummy_memory[addr + i] &= src[i];
+    }
+    _program_count += size;
+
+    return size;
+}
+
+static int _erase_sector(mtd_dev_t *dev, uint32_t sector, uint32_t count)
+{
+    uint32_t addr = sector * dev->page_size * dev->pages_per_sector;
+
+    if (sector + count > dev->sector_count) {
+        return -EOVERFLOW;
+    }
+
+    memset(_dummy_memory + addr, 0xff,
+           count * dev->page_size * dev->pages_per_sector);
+    _erase_count += count;
+
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    (void)dev;
+    _powered_down = (power == MTD_POWER_DOWN);
+    return 0;
+}
+
+static const mtd_desc_t driver = {
+    .init = _init,
+    .power = _power,
+    .read_page    = _read_page,
+    .write_page   = _write_page,
+    .erase_sector = _erase_sector,
+    .flags = MTD_DRIVER_FLAG_CLEARING_OVERWRITE,
+};
+
+/* same device, but pages can only be programmed once after an erase */
+static const mtd_desc_t driver_ecc = {
+    .init = _init,
+    .power = _power,
+    .read_page    = _read_page,
+    .write_page   = _write_page,
+    .erase_sector = _erase_sector,
+};
+
+static mtd_dev_t dev = {
+    .driver = &driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static mtd_cache_t _cache = MTD_CACHE_INIT(&dev);
+static mtd_dev_t *_dev = &_cache.mtd;
+
+static void _test_mem(const uint8_t *buffer, size_t len, uint8_t expected)
+{
+    for (size_t i = 0; i < len; i++) {
+        TEST_ASSERT_EQUAL_INT(expected, buffer[i]);
+    }
+}
+
+static void _reset_counters(void)
+{
+    _erase_count = 0;
+    _program_count = 0;
+}
+
+static void setup(void)
+{
+    /* start every test with an empty cache on erased memory */
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    memset(_dummy_memory, 0xff, sizeof(_dummy_memory));
+    for (unsigned i = 0; i < CONFIG_MTD_CACHE_SECTORS; i++) {
+        _cache.slots[i].valid = false;
+    }
+    memset(&_cache.stats, 0, sizeof(_cache.stats));
+    _reset_counters();
+    _fail_page = UINT32_MAX;
+    dev.driver = &driver;
+}
+
+static void test_mtd_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, mtd_init(_dev));
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, _dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, _dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _dev->page_size);
+}
+
+static void test_mtd_write_read(void)
+{
+    /* small writes to one sector are served from the cache */
+    for (uint32_t i = 0; i < SECTOR_SIZE; i += 16) {
+        memset(_buffer, i, 16);
+        TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 0, i, 16));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    TEST_ASSERT_EQUAL_INT(0, _program_count);
+    _test_mem(_dummy_memory, SECTOR_SIZE, 0xff);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_read_page(_dev, _buffer, 0, 0, SECTOR_SIZE));
+    for (uint32_t i = 0; i < SECTOR_SIZE; i += 16) {
+        _test_mem(&_buffer[i], 16, i);
+    }
+
+    /* only cleared bits were written to an erased sector, no erase needed */
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    TEST_ASSERT_EQUAL_INT(SECTOR_SIZE, _program_count);
+    for (uint32_t i = 0; i < SECTOR_SIZE; i += 16) {
+        _test_mem(&_dummy_memory[i], 16, i);
+    }
+}
+
+static void test_mtd_overwrite(void)
+{
+    memset(_buffer, 0x00, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 1, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    _reset_counters();
+
+    /* setting bits again requires an erase, but only one for many writes */
+    for (unsigned i = 0; i < PAGE_SIZE; i++) {
+        uint8_t val = 0xa5;
+        TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, &val, 1, i, 1));
+    }
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    /* the other pages are still erased and don't need to be programmed */
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _program_count);
+    _test_mem(&_dummy_memory[PAGE_SIZE], PAGE_SIZE, 0xa5);
+    _test_mem(&_dummy_memory[0], PAGE_SIZE, 0xff);
+}
+
+static void test_mtd_erase(void)
+{
+    memset(_dummy_memory, 0x00, 2 * SECTOR_SIZE);
+
+    /* the erase is deferred and merged with the following write */
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase_sector(_dev, 1, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_read_page(_dev, _buffer, PAGE_PER_SECTOR, 0,
+                                           SECTOR_SIZE));
+    _test_mem(_buffer, SECTOR_SIZE, 0xff);
+    memset(_buffer, 0x5a, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer,
+                                                PAGE_PER_SECTOR, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _program_count);
+    _test_mem(_dummy_memory, SECTOR_SIZE, 0x00);
+    _test_mem(&_dummy_memory[SECTOR_SIZE], PAGE_SIZE, 0x5a);
+    _test_mem(&_dummy_memory[SECTOR_SIZE + PAGE_SIZE], SECTOR_SIZE - PAGE_SIZE,
+              0xff);
+
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase_sector(_dev, SECTOR_COUNT, 1));
+}
+
+static void test_mtd_write_back_error(void)
+{
+    memset(_dummy_memory, 0x00, SECTOR_SIZE);
+
+    /* setting bits in page 2 requires to erase and program the whole
+     * sector, programming page 1 fails after the erase */
+    memset(_buffer, 0xa5, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 2, 0, PAGE_SIZE));
+    _fail_page = 1;
+    TEST_ASSERT_EQUAL_INT(-EIO, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    _test_mem(&_dummy_memory[PAGE_SIZE], SECTOR_SIZE - PAGE_SIZE, 0xff);
+
+    /* the retry programs the remaining pages without another erase */
+    _fail_page = UINT32_MAX;
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    _test_mem(_dummy_memory, 2 * PAGE_SIZE, 0x00);
+    _test_mem(&_dummy_memory[2 * PAGE_SIZE], PAGE_SIZE, 0xa5);
+    _test_mem(&_dummy_memory[3 * PAGE_SIZE], PAGE_SIZE, 0x00);
+}
+
+static void test_mtd_no_clearing_overwrite(void)
+{
+    dev.driver = &driver_ecc;
+
+    /* writing an erased page doesn't need an erase */
+    memset(_buffer, 0xf0, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 1, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _program_count);
+    _reset_counters();
+
+    /* writing the same data again changes nothing */
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 1, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    TEST_ASSERT_EQUAL_INT(0, _program_count);
+
+    /* clearing bits of a programmed page can't be done in place */
+    memset(_buffer, 0x30, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 1, 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _program_count);
+    _test_mem(_dummy_memory, PAGE_SIZE, 0xff);
+    _test_mem(&_dummy_memory[PAGE_SIZE], 1, 0x30);
+    _test_mem(&_dummy_memory[PAGE_SIZE + 1], PAGE_SIZE - 1, 0xf0);
+}
+
+static void test_mtd_no_clearing_overwrite_coalesce(void)
+{
+    dev.driver = &driver_ecc;
+
+    /* several writes to an erased page before a flush program it once */
+    memset(_buffer, 0x0f, 2);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 1, 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 1, 8, 2));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _program_count);
+    _test_mem(&_dummy_memory[PAGE_SIZE], 1, 0x0f);
+    _test_mem(&_dummy_memory[PAGE_SIZE + 1], 7, 0xff);
+    _test_mem(&_dummy_memory[PAGE_SIZE + 8], 2, 0x0f);
+    _reset_counters();
+
+    /* even if bits cleared by an earlier write are set again */
+    memset(_buffer, 0xf0, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 2, 0, 1));
+    memset(_buffer, 0xff, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 2, 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 2, 1, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+    _test_mem(&_dummy_memory[2 * PAGE_SIZE], PAGE_SIZE, 0xff);
+
+    /* once the page is programmed, changing it needs an erase */
+    memset(_buffer, 0x0f, 1);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 1, 1, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _erase_count);
+    _test_mem(&_dummy_memory[PAGE_SIZE], 2, 0x0f);
+}
+
+static void test_mtd_evict(void)
+{
+    /* touch one more sector than the cache holds, the first one is evicted */
+    for (unsigned i = 0; i <= CONFIG_MTD_CACHE_SECTORS; i++) {
+        memset(_buffer, i, 8);
+        TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer,
+                                                    i * PAGE_PER_SECTOR, 0, 8));
+    }
+    _test_mem(_dummy_memory, 8, 0);
+    for (unsigned i = 1; i <= CONFIG_MTD_CACHE_SECTORS; i++) {
+        _test_mem(&_dummy_memory[i * SECTOR_SIZE], 8, 0xff);
+    }
+
+    /* the evicted sector is read from the backing device */
+    TEST_ASSERT_EQUAL_INT(0, mtd_read_page(_dev, _buffer, 0, 0, 8));
+    _test_mem(_buffer, 8, 0);
+}
+
+static void test_mtd_stats(void)
+{
+    mtd_cache_stats_t stats;
+
+    for (unsigned i = 0; i < PAGE_SIZE; i += 4) {
+        uint32_t val = 0;
+        TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, &val, 0, i, 4));
+    }
+    memset(_buffer, 0xff, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 0, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 2, 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+
+    mtd_cache_get_stats(&_cache, &stats);
+    TEST_ASSERT_EQUAL_INT(2 * PAGE_SIZE + 1, stats.written);
+    /* the pages are erased on the device, so they are neither programmed
+     * nor is the sector erased */
+    TEST_ASSERT_EQUAL_INT(0, stats.programmed);
+    TEST_ASSERT_EQUAL_INT(0, stats.erased);
+    TEST_ASSERT_EQUAL_INT(0, _erase_count);
+}
+
+static void test_mtd_power_down(void)
+{
+    memset(_buffer, 0x42, PAGE_SIZE);
+    TEST_ASSERT_EQUAL_INT(0, mtd_write_page_raw(_dev, _buffer, 0, 0, PAGE_SIZE));
+    _test_mem(_dummy_memory, PAGE_SIZE, 0xff);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_power(_dev, MTD_POWER_DOWN));
+    TEST_ASSERT(_powered_down);
+    _test_mem(_dummy_memory, PAGE_SIZE, 0x42);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_power(_dev, MTD_POWER_UP));
+    TEST_ASSERT(!_powered_down);
+}
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_init),
+        new_TestFixture(test_mtd_write_read),
+        new_TestFixture(test_mtd_overwrite),
+        new_TestFixture(test_mtd_erase),
+        new_TestFixture(test_mtd_write_back_error),
+        new_TestFixture(test_mtd_no_clearing_overwrite),
+        new_TestFixture(test_mtd_no_clearing_overwrite_coalesce),
+        new_TestFixture(test_mtd_evict),
+        new_TestFixture(test_mtd_stats),
+        new_TestFixture(test_mtd_power_down),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, setup, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_mtd_cache_tests());
+    TESTS_END();
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for the batched receive path of netdev_tap
+ *
+ * The TAP is replaced by a datagram socket pair, which keeps the frame
+ * boundaries just like a TAP does.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "embUnit.h"
+#include "net/ethernet.h"
+#include "net/netdev.h"
+#include "netdev_tap.h"
+#include "netdev_tap_params.h"
+
+#define BCAST_ADDR      { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }
+#define OTHER_ADDR      { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 }
+#define TEST_ADDR       { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 }
+#define FRAMES_NUMOF    (CONFIG_NETDEV_TAP_RX_BATCH)
+
+static const uint8_t _bcast_addr[] = BCAST_ADDR;
+static const uint8_t _other_addr[] = OTHER_ADDR;
+static const uint8_t _test_addr[] = TEST_ADDR;
+
+static netdev_tap_t _dev;
+static int _host = -1;
+
+static uint8_t _frame[ETHERNET_FRAME_LEN];
+static unsigned _events;
+static unsigned _frames;
+static size_t _lens[FRAMES_NUMOF];
+static bool _drop;
+
+static void _event_cb(netdev_t *netdev, netdev_event_t event)
+{
+    int len;
+
+    TEST_ASSERT_EQUAL_INT(NETDEV_EVENT_RX_COMPLETE, event);
+    _events++;
+    /* read the frame the way gnrc_netif_ethernet does */
+    len = netdev->driver->recv(netdev, NULL, 0, NULL);
+    TEST_ASSERT(len > 0);
+    if (_drop) {
+        netdev->driver->recv(netdev, NULL, len, NULL);
+        return;
+    }
+    int res = netdev->driver->recv(netdev, _frame, len, NULL);
+    /* frames not addressed to us are read, but not passed on */
+    if (res > 0) {
+        TEST_ASSERT_EQUAL_INT(len, res);
+        TEST_ASSERT(_frames < FRAMES_NUMOF);
+        _lens[_frames++] = len;
+    }
+}
+
+/* sends a frame of ETHERNET_MIN_LEN + pad bytes from the host side */
+static void _send(const uint8_t *dst, size_t pad)
+{
+    uint8_t frame[ETHERNET_MIN_LEN + pad];
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)frame;
+
+    memset(frame, 0, sizeof(frame));
+    memcpy(hdr->dst, dst, ETHERNET_ADDR_LEN);
+    memcpy(hdr->src, _other_addr, ETHERNET_ADDR_LEN);
+    TEST_ASSERT_EQUAL_INT(sizeof(frame), send(_host, frame, sizeof(frame), 0));
+}
+
+static void setup(void)
+{
+    int fds[2];
+
+    memset(&_dev, 0, sizeof(_dev));
+    _events = 0;
+    _frames = 0;
+    _drop = false;
+    netdev_tap_setup(&_dev, &netdev_tap_params[0]);
+    _dev.netdev.event_callback = _event_cb;
+    _dev.netdev.driver->set(&_dev.netdev, NETOPT_ADDRESS, _test_addr,
+                            sizeof(_test_addr));
+    socketpair(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK, 0, fds);
+    _dev.tap_fd = fds[0];
+    _host = fds[1];
+}
+
+static void teardown(void)
+{
+    close(_dev.tap_fd);
+    close(_host);
+}
+
+static void test_netdev_tap_rx_empty(void)
+{
+    _dev.netdev.driver->isr(&_dev.netdev);
+    TEST_ASSERT_EQUAL_INT(0, _events);
+}
+
+static void test_netdev_tap_rx_batch(void)
+{
+    for (unsigned i = 0; i < FRAMES_NUMOF; i++) {
+        _send(_test_addr, i);
+    }
+    _dev.netdev.driver->isr(&_dev.netdev);
+    /* one event per frame, each with its exact length */
+    TEST_ASSERT_EQUAL_INT(FRAMES_NUMOF, _events);
+    TEST_ASSERT_EQUAL_INT(FRAMES_NUMOF, _frames);
+    for (unsigned i = 0; i < FRAMES_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(ETHERNET_MIN_LEN + i, _lens[i]);
+    }
+    /* the batch drained the TAP */
+    _dev.netdev.driver->isr(&_dev.netdev);
+    TEST_ASSERT_EQUAL_INT(FRAMES_NUMOF, _events);
+}
+
+static void test_netdev_tap_rx_filter(void)
+{
+    _send(_other_addr, 0);
+    _send(_test_addr, 1);
+    _send(_other_addr, 2);
+    _send(_bcast_addr, 3);
+    _dev.netdev.driver->isr(&_dev.netdev);
+    /* frames for others don't reach the upper layer */
+    TEST_ASSERT_EQUAL_INT(4, _events);
+    TEST_ASSERT_EQUAL_INT(2, _frames);
+    TEST_ASSERT_EQUAL_INT(ETHERNET_MIN_LEN + 1, _lens[0]);
+    TEST_ASSERT_EQUAL_INT(ETHERNET_MIN_LEN + 3, _lens[1]);
+}
+
+static void test_netdev_tap_rx_drop(void)
+{
+    _send(_test_addr, 0);
+    _send(_test_addr, 1);
+    _drop = true;
+    _dev.netdev.driver->isr(&_dev.netdev);
+    TEST_ASSERT_EQUAL_INT(2, _events);
+    TEST_ASSERT_EQUAL_INT(0, _frames);
+    TEST_ASSERT_EQUAL_INT(-1, _dev.netdev.driver->recv(&_dev.netdev, _frame,
+                                                       sizeof(_frame), NULL));
+}
+
+Test *tests_netdev_tap(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netdev_tap_rx_empty),
+        new_TestFixture(test_netdev_tap_rx_batch),
+        new_TestFixture(test_netdev_tap_rx_filter),
+        new_TestFixture(test_netdev_tap_rx_drop),
+    };
+
+    EMB_UNIT_TESTCALLER(netdev_tap_tests, setup, teardown, fixtures);
+
+    return (Test *)&netdev_tap_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_netdev_tap());
+    TESTS_END();
+    return 0;
+}
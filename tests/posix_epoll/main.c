@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for module posix_epoll
+ *
+ * @}
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "xtimer.h"
+
+#define TEST_PORT           (0x2c94)
+#define TEST_TIMEOUT_MS     (1000)
+/* time for lwIP to complete a handshake over the loopback interface */
+#define TEST_SETTLE_US      (100U * US_PER_MS)
+
+static int _ep = -1;
+static struct sockaddr_in _addr;
+static struct epoll_event _events[2];
+
+static void setup(void)
+{
+    memset(&_addr, 0, sizeof(_addr));
+    _addr.sin_family = AF_INET;
+    _addr.sin_port = htons(TEST_PORT);
+    inet_pton(AF_INET, "127.0.0.1", &_addr.sin_addr);
+    _ep = epoll_create1(0);
+}
+
+static void teardown(void)
+{
+    close(_ep);
+    _ep = -1;
+}
+
+static int _wait(int timeout)
+{
+    memset(_events, 0, sizeof(_events));
+    return epoll_wait(_ep, _events, ARRAY_SIZE(_events), timeout);
+}
+
+static int _add(int fd, uint32_t events)
+{
+    struct epoll_event event = { .events = events, .data.fd = fd };
+
+    return epoll_ctl(_ep, EPOLL_CTL_ADD, fd, &event);
+}
+
+static int _udp_socket(void)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if ((fd < 0) ||
+        (bind(fd, (struct sockaddr *)&_addr, sizeof(_addr)) < 0)) {
+        return -1;
+    }
+    return fd;
+}
+
+/* sends a datagram to the socket itself */
+static int _udp_send(int fd)
+{
+    static const char data[] = "epoll";
+
+    return sendto(fd, data, sizeof(data), 0, (struct sockaddr *)&_addr,
+                  sizeof(_addr));
+}
+
+static void test_epoll_ctl_errors(void)
+{
+    int fd = _udp_socket();
+
+    TEST_ASSERT(_ep >= 0);
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(-1, _add(_ep, EPOLLIN));
+    TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+    TEST_ASSERT_EQUAL_INT(0, _add(fd, EPOLLIN));
+    TEST_ASSERT_EQUAL_INT(-1, _add(fd, EPOLLIN));
+    TEST_ASSERT_EQUAL_INT(EEXIST, errno);
+    TEST_ASSERT_EQUAL_INT(0, epoll_ctl(_ep, EPOLL_CTL_DEL, fd, NULL));
+    TEST_ASSERT_EQUAL_INT(-1, epoll_ctl(_ep, EPOLL_CTL_DEL, fd, NULL));
+    TEST_ASSERT_EQUAL_INT(ENOENT, errno);
+    close(fd);
+}
+
+static void test_epoll_level_triggered(void)
+{
+    char buf[16];
+    int fd = _udp_socket();
+
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(0, _add(fd, EPOLLIN));
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+    TEST_ASSERT(_udp_send(fd) > 0);
+    TEST_ASSERT_EQUAL_INT(1, _wait(TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_INT(EPOLLIN, _events[0].events);
+    TEST_ASSERT_EQUAL_INT(fd, _events[0].data.fd);
+    /* still readable, so it is reported again */
+    TEST_ASSERT_EQUAL_INT(1, _wait(0));
+    TEST_ASSERT_EQUAL_INT(EPOLLIN, _events[0].events);
+    TEST_ASSERT(recv(fd, buf, sizeof(buf), 0) > 0);
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+    close(fd);
+}
+
+static void test_epoll_edge_triggered(void)
+{
+    char buf[16];
+    int fd = _udp_socket();
+
+    TEST_ASSERT(fd >= 0);
+    TEST_ASSERT_EQUAL_INT(0, _add(fd, EPOLLIN | EPOLLET));
+    TEST_ASSERT(_udp_send(fd) > 0);
+    TEST_ASSERT_EQUAL_INT(1, _wait(TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_INT(EPOLLIN, _events[0].events);
+    /* only reported again on the next datagram, not while data is left */
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+    TEST_ASSERT(_udp_send(fd) > 0);
+    TEST_ASSERT_EQUAL_INT(1, _wait(TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_INT(EPOLLIN, _events[0].events);
+    TEST_ASSERT(recv(fd, buf, sizeof(buf), 0) > 0);
+    TEST_ASSERT(recv(fd, buf, sizeof(buf), 0) > 0);
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+    close(fd);
+}
+
+static void test_epoll_oneshot(void)
+{
+    char buf[16];
+    struct epoll_event event = { .events = EPOLLIN | EPOLLONESHOT };
+    int fd = _udp_socket();
+
+    TEST_ASSERT(fd >= 0);
+    event.data.fd = fd;
+    TEST_ASSERT_EQUAL_INT(0, _add(fd, event.events));
+    TEST_ASSERT(_udp_send(fd) > 0);
+    TEST_ASSERT_EQUAL_INT(1, _wait(TEST_TIMEOUT_MS));
+    /* disabled after the first report */
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+    TEST_ASSERT(_udp_send(fd) > 0);
+    TEST_ASSERT_EQUAL_INT(0, _wait(TEST_TIMEOUT_MS / 10));
+    /* re-arming reports the data that is still pending */
+    TEST_ASSERT_EQUAL_INT(0, epoll_ctl(_ep, EPOLL_CTL_MOD, fd, &event));
+    TEST_ASSERT_EQUAL_INT(1, _wait(0));
+    TEST_ASSERT_EQUAL_INT(EPOLLIN, _events[0].events);
+    TEST_ASSERT(recv(fd, buf, sizeof(buf), 0) > 0);
+    TEST_ASSERT(recv(fd, buf, sizeof(buf), 0) > 0);
+    close(fd);
+}
+
+static void test_epoll_listen_accept_hup(void)
+{
+    char buf[4] = "abc";
+    int srv = socket(AF_INET, SOCK_STREAM, 0);
+    int client = socket(AF_INET, SOCK_STREAM, 0);
+    int conn;
+
+    TEST_ASSERT(srv >= 0);
+    TEST_ASSERT(client >= 0);
+    TEST_ASSERT_EQUAL_INT(0, bind(srv, (struct sockaddr *)&_addr,
+                                  sizeof(_addr)));
+    TEST_ASSERT_EQUAL_INT(0, listen(srv, 1));
+    TEST_ASSERT_EQUAL_INT(0, connect(client, (struct sockaddr *)&_addr,
+                                     sizeof(_addr)));
+    xtimer_usleep(TEST_SETTLE_US);
+
+    /* the connection that is already pending is reported on registration
+     * and as long as it isn't accepted */
+    TEST_ASSERT_EQUAL_INT(0, _add(srv, EPOLLIN));
+    TEST_ASSERT_EQUAL_INT(1, _wait(0));
+    TEST_ASSERT_EQUAL_INT(EPOLLIN, _events[0].events);
+    TEST_ASSERT_EQUAL_INT(srv, _events[0].data.fd);
+    TEST_ASSERT_EQUAL_INT(1, _wait(0));
+    conn = accept(srv, NULL, NULL);
+    TEST_ASSERT(conn >= 0);
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+
+    TEST_ASSERT_EQUAL_INT(0, _add(conn, EPOLLIN));
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), write(client, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _wait(TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_INT(EPOLLIN, _events[0].events);
+    TEST_ASSERT_EQUAL_INT(conn, _events[0].data.fd);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), read(conn, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+
+    /* EPOLLHUP is reported without being requested, and stays set */
+    close(client);
+    TEST_ASSERT_EQUAL_INT(1, _wait(TEST_TIMEOUT_MS));
+    TEST_ASSERT(_events[0].events & EPOLLHUP);
+    TEST_ASSERT_EQUAL_INT(1, _wait(0));
+    TEST_ASSERT(_events[0].events & EPOLLHUP);
+
+    close(conn);
+    close(srv);
+    TEST_ASSERT_EQUAL_INT(0, _wait(0));
+}
+
+Test *tests_posix_epoll(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_epoll_ctl_errors),
+        new_TestFixture(test_epoll_level_triggered),
+        new_TestFixture(test_epoll_edge_triggered),
+        new_TestFixture(test_epoll_oneshot),
+        new_TestFixture(test_epoll_listen_accept_hup),
+    };
+
+    EMB_UNIT_TESTCALLER(posix_epoll_tests, setup, teardown, fixtures);
+
+    return (Test *)&posix_epoll_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_posix_epoll());
+    TESTS_END();
+    return 0;
+}
@@ -57,10 +57,21 @@ def _check_ps(child):
     child.expect_exact('>')
 
 
+def _check_schedstat(child):
+    child.sendline('schedstat')
+    child.expect_exact('ISRs:')
+    child.expect(r'IRQs disabled: max \d+ usec from (0x[0-9a-f]+|\(nil\))')
+    child.expect_exact('Ready-to-running latency')
+    # the threads of priority 6 became ready
+    child.expect(r'    6 \|( +\d+)+')
+    child.expect_exact('>')
+
+
 def testfunc(child):
     _check_startup(child)
     _check_help(child)
     _check_ps(child)
+    _check_schedstat(child)
 
 
 if __name__ == "__main__":
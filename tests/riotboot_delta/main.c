@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for module riotboot_delta
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "riotboot/delta.h"
+
+#define BASE_LEN        (64U)
+#define INSERT_LEN      (70U)
+#define NEW_LEN         (8U + 3U + 4U + INSERT_LEN)
+
+/* copy 8 bytes from 4, insert "XYZ", copy 4 bytes from 0, insert INSERT_LEN
+ * bytes of 0xaa */
+static const uint8_t _cmds[] = {
+    8 << 1, 4 << 1,
+    (3 << 1) | 1, 'X', 'Y', 'Z',
+    4 << 1, (12 << 1) - 1,
+    0x80 | (((INSERT_LEN << 1) | 1) & 0x7f), (INSERT_LEN << 1) >> 7,
+};
+
+static uint8_t _base[BASE_LEN];
+static uint8_t _expected[NEW_LEN];
+static uint8_t _patch[RIOTBOOT_DELTA_HDR_LEN + sizeof(_cmds) + INSERT_LEN];
+
+static uint8_t _out[2 * NEW_LEN];
+static size_t _out_len;
+static unsigned _writes;
+static int _write_res;
+
+static riotboot_delta_t _delta;
+
+static int _write(void *arg, const uint8_t *buf, size_t len)
+{
+    (void)arg;
+    if (_write_res) {
+        return _write_res;
+    }
+    if (_out_len + len > sizeof(_out)) {
+        return -ENOSPC;
+    }
+    memcpy(&_out[_out_len], buf, len);
+    _out_len += len;
+    _writes++;
+    return 0;
+}
+
+static size_t _make_hdr(uint8_t *buf, size_t new_len)
+{
+    memcpy(buf, RIOTBOOT_DELTA_MAGIC, 4);
+    byteorder_htolebufl(&buf[4], BASE_LEN);
+    byteorder_htolebufl(&buf[8], new_len);
+    sha256(_base, BASE_LEN, &buf[12]);
+    return RIOTBOOT_DELTA_HDR_LEN;
+}
+
+static void setup(void)
+{
+    uint8_t *pos = _patch;
+
+    for (unsigned i = 0; i < BASE_LEN; i++) {
+        _base[i] = i;
+    }
+
+    pos += _make_hdr(pos, NEW_LEN);
+    memcpy(pos, _cmds, sizeof(_cmds));
+    pos += sizeof(_cmds);
+    memset(pos, 0xaa, INSERT_LEN);
+
+    memcpy(_expected, &_base[4], 8);
+    memcpy(&_expected[8], "XYZ", 3);
+    memcpy(&_expected[11], _base, 4);
+    memset(&_expected[15], 0xaa, INSERT_LEN);
+
+    memset(_out, 0, sizeof(_out));
+    _out_len = 0;
+    _writes = 0;
+    _write_res = 0;
+    riotboot_delta_init(&_delta, _base, BASE_LEN + 16, _write, &_delta);
+}
+
+static void test_riotboot_delta_is_patch(void)
+{
+    TEST_ASSERT(riotboot_delta_is_patch(_patch, sizeof(_patch)));
+    TEST_ASSERT(!riotboot_delta_is_patch(_patch, 3));
+    TEST_ASSERT(!riotboot_delta_is_patch(_base, sizeof(_base)));
+}
+
+static void test_riotboot_delta_apply(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, riotboot_delta_putbytes(&_delta, _patch,
+                                                     sizeof(_patch)));
+    TEST_ASSERT_EQUAL_INT(0, riotboot_delta_finish(&_delta));
+    TEST_ASSERT_EQUAL_INT(NEW_LEN, _out_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_out, _expected, NEW_LEN));
+    TEST_ASSERT_EQUAL_INT(sizeof(_patch), _delta.patch_pos);
+    /* inserted bytes are passed on without copying them */
+    TEST_ASSERT_EQUAL_INT(4, _writes);
+}
+
+static void test_riotboot_delta_apply_chunked(void)
+{
+    for (unsigned chunk = 1; chunk < 8; chunk++) {
+        setup();
+        for (size_t pos = 0; pos < sizeof(_patch); pos += chunk) {
+            size_t len = sizeof(_patch) - pos;
+            len = (len < chunk) ? len : chunk;
+            TEST_ASSERT_EQUAL_INT(0, riotboot_delta_putbytes(&_delta,
+                                                             &_patch[pos],
+                                                             len));
+            /* incomplete until the last byte */
+            if (pos + len < sizeof(_patch)) {
+                TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_delta_finish(&_delta));
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(0, riotboot_delta_finish(&_delta));
+        TEST_ASSERT_EQUAL_INT(NEW_LEN, _out_len);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(_out, _expected, NEW_LEN));
+    }
+}
+
+static void test_riotboot_delta_base_mismatch(void)
+{
+    _base[BASE_LEN - 1] ^= 1;
+    TEST_ASSERT_EQUAL_INT(-ENOENT, riotboot_delta_putbytes(&_delta, _patch,
+                                                           sizeof(_patch)));
+    TEST_ASSERT_EQUAL_INT(0, _out_len);
+
+    /* base image longer than the available region */
+    setup();
+    riotboot_delta_init(&_delta, _base, BASE_LEN - 1, _write, &_delta);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, riotboot_delta_putbytes(&_delta, _patch,
+                                                           sizeof(_patch)));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_delta_finish(&_delta));
+}
+
+static void test_riotboot_delta_copy_out_of_bounds(void)
+{
+    static const uint8_t beyond_end[] = { 8 << 1, (BASE_LEN - 4) << 1 };
+    static const uint8_t before_start[] = { 8 << 1, 1 };
+    static const uint8_t seek_beyond_end[] = {
+        1 << 1, 0x80 | ((BASE_LEN + 1) << 1 & 0x7f), ((BASE_LEN + 1) << 1) >> 7,
+    };
+    const struct {
+        const uint8_t *cmds;
+        size_t len;
+    } cases[] = {
+        { beyond_end, sizeof(beyond_end) },
+        { before_start, sizeof(before_start) },
+        { seek_beyond_end, sizeof(seek_beyond_end) },
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(cases); i++) {
+        setup();
+        memcpy(&_patch[RIOTBOOT_DELTA_HDR_LEN], cases[i].cmds, cases[i].len);
+        TEST_ASSERT_EQUAL_INT(-EINVAL,
+                              riotboot_delta_putbytes(&_delta, _patch,
+                                                      RIOTBOOT_DELTA_HDR_LEN +
+                                                      cases[i].len));
+        TEST_ASSERT_EQUAL_INT(0, _out_len);
+    }
+}
+
+static void test_riotboot_delta_too_long(void)
+{
+    /* the image ends in the middle of the last insert */
+    _make_hdr(_patch, NEW_LEN - 1);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_delta_putbytes(&_delta, _patch,
+                                                           sizeof(_patch)));
+    TEST_ASSERT_EQUAL_INT(15, _out_len);
+
+    /* data after the end of the image */
+    setup();
+    TEST_ASSERT_EQUAL_INT(0, riotboot_delta_putbytes(&_delta, _patch,
+                                                     sizeof(_patch)));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_delta_putbytes(&_delta, _patch, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_delta_finish(&_delta));
+}
+
+static void test_riotboot_delta_write_error(void)
+{
+    _write_res = -ENOSPC;
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, riotboot_delta_putbytes(&_delta, _patch,
+                                                           sizeof(_patch)));
+    /* the patch can't continue after an error */
+    _write_res = 0;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, riotboot_delta_putbytes(&_delta, _patch, 1));
+}
+
+Test *tests_riotboot_delta(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_riotboot_delta_is_patch),
+        new_TestFixture(test_riotboot_delta_apply),
+        new_TestFixture(test_riotboot_delta_apply_chunked),
+        new_TestFixture(test_riotboot_delta_base_mismatch),
+        new_TestFixture(test_riotboot_delta_copy_out_of_bounds),
+        new_TestFixture(test_riotboot_delta_too_long),
+        new_TestFixture(test_riotboot_delta_write_error),
+    };
+
+    EMB_UNIT_TESTCALLER(riotboot_delta_tests, setup, NULL, fixtures);
+
+    return (Test *)&riotboot_delta_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_riotboot_delta());
+    TESTS_END();
+    return 0;
+}
@@ -103,10 +103,42 @@ static void test_suit_manifest_01_manifests(void)
     }
 }
 
+static void test_suit_manifest_02_fetch_twice(void)
+{
+    char _url[SUIT_URL_MAX];
+    suit_manifest_t manifest;
+    suit_component_t *comp = &manifest.components[0];
+
+    memset(&manifest, 0, sizeof(manifest));
+    manifest.urlbuf = _url;
+    manifest.urlbuf_len = SUIT_URL_MAX;
+
+    /* first fetch in order, the digest is taken while writing */
+    suit_storage_set_seq_no_all(1);
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, suit_parse(&manifest, manifest3_bin,
+                                              sizeof(manifest3_bin)));
+    TEST_ASSERT(suit_component_check_flag(comp,
+                                          SUIT_COMPONENT_STATE_DIGESTED));
+
+    /* second fetch into the same context, out of order: the stale digest of
+     * the first fetch must not be used to validate the payload */
+    manifest.state = 0;
+    suit_component_clear_flag(comp, SUIT_COMPONENT_STATE_FETCHED);
+    memset(comp->digest, 0, sizeof(comp->digest));
+    suit_transport_mock_chunk_len = 1;
+    suit_storage_set_seq_no_all(1);
+    int res = suit_parse(&manifest, manifest3_bin, sizeof(manifest3_bin));
+    suit_transport_mock_chunk_len = 0;
+    TEST_ASSERT_EQUAL_INT(SUIT_OK, res);
+    TEST_ASSERT(!suit_component_check_flag(comp,
+                                           SUIT_COMPONENT_STATE_DIGESTED));
+}
+
 Test *tests_suit_manifest(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_suit_manifest_01_manifests),
+        new_TestFixture(test_suit_manifest_02_fetch_twice),
     };
 
     EMB_UNIT_TESTCALLER(suit_manifest_tests, NULL, NULL, fixtures);
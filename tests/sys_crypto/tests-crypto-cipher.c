@@ -60,6 +60,34 @@ static void test_crypto_cipher_aes_decrypt(void)
     TEST_ASSERT_MESSAGE(1 == cmp, "wrong plaintext");
 }
 
+static void test_crypto_cipher_aes_encrypt_blocks(void)
+{
+    cipher_t cipher;
+    int err, cmp;
+    uint8_t inp[3 * 16], data[3 * 16], block[16];
+
+    err = cipher_init(&cipher, CIPHER_AES, TEST_KEY, 16);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    for (unsigned i = 0; i < sizeof(inp); i++) {
+        inp[i] = i;
+    }
+    memcpy(inp, TEST_INP, 16);
+
+    /* an odd number of blocks, in place */
+    memcpy(data, inp, sizeof(data));
+    err = cipher_encrypt_blocks(&cipher, data, data, 3);
+    TEST_ASSERT_EQUAL_INT(1, err);
+
+    cmp = compare(TEST_ENC_AES, data, 16);
+    TEST_ASSERT_MESSAGE(1 == cmp, "wrong ciphertext");
+    for (unsigned i = 1; i < 3; i++) {
+        cipher_encrypt(&cipher, &inp[16 * i], block);
+        cmp = compare(block, &data[16 * i], 16);
+        TEST_ASSERT_MESSAGE(1 == cmp, "wrong ciphertext");
+    }
+}
+
 static void test_crypto_cipher_init_aes_key_length(void)
 {
     cipher_t cipher;
@@ -80,6 +108,7 @@ Test *tests_crypto_cipher_tests(void)
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_cipher_aes_encrypt),
         new_TestFixture(test_crypto_cipher_aes_decrypt),
+        new_TestFixture(test_crypto_cipher_aes_encrypt_blocks),
         new_TestFixture(test_crypto_cipher_init_aes_key_length),
     };
 
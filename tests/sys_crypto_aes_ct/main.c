@@ -0,0 +1 @@
+../sys_crypto/main.c
\ No newline at end of file
@@ -0,0 +1 @@
+../sys_crypto/tests-crypto-modes-ctr.c
\ No newline at end of file
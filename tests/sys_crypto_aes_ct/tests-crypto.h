@@ -0,0 +1 @@
+../sys_crypto/tests-crypto.h
\ No newline at end of file
@@ -28,8 +28,10 @@ int main(void)
 {
     trace(0);
     trace(1);
+    trace_event(TRACE_MSG_SEND, 2, 0x1234);
 
     trace_dump();
+    trace_drain_stdio();
 
     return 0;
 }
@@ -7,6 +7,10 @@ from testrunner import run
 def testfunc(child):
     child.expect(r"n=   0 t=\ +\d+ v=0x00000000\r\n")
     child.expect(r"n=   1 t=\+\ +\d+ v=0x00000001\r\n")
+    child.expect(r"n=   2 t=\+\ +\d+ v=0x00001234 e=msg_send p=\d+ a=2\r\n")
+    # one chunk of three entries, either endianness
+    child.expect(r"TRACE:(52545243010c030000000000|43525452010c000300000000)"
+                 r"[0-9a-f]{72}\r\n")
 
 
 if __name__ == "__main__":
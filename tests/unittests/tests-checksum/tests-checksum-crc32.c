@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "checksum/crc32.h"
+
+#include "tests-checksum.h"
+
+static void test_checksum_crc32_sequence_empty(void)
+{
+    unsigned char buf[] = "";
+
+    TEST_ASSERT_EQUAL_INT(0x00000000, crc32_calc(buf, sizeof(buf) - 1));
+    TEST_ASSERT_EQUAL_INT(0x00000000, crc32c_calc(buf, sizeof(buf) - 1));
+}
+
+static void test_checksum_crc32_sequence_1to9(void)
+{
+    unsigned char buf[] = "123456789";
+
+    TEST_ASSERT_EQUAL_INT(0xcbf43926, crc32_calc(buf, sizeof(buf) - 1));
+    TEST_ASSERT_EQUAL_INT(0xe3069283, crc32c_calc(buf, sizeof(buf) - 1));
+}
+
+static void test_checksum_crc32_sequence_256a(void)
+{
+    unsigned char buf[256];
+
+    memset(buf, 'A', sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0x49975b13, crc32_calc(buf, sizeof(buf)));
+}
+
+static void test_checksum_crc32_sequence_200(void)
+{
+    uint8_t buf[200];
+
+    /* long enough for every block size of the folding on x86 hosts */
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i * 7;
+    }
+    TEST_ASSERT_EQUAL_INT(0xb2dc5f40, crc32_calc(buf, sizeof(buf)));
+}
+
+static void test_checksum_crc32c_iscsi(void)
+{
+    /* RFC 3720, appendix B.4 */
+    uint8_t buf[32];
+
+    memset(buf, 0x00, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0x8a9136aa, crc32c_calc(buf, sizeof(buf)));
+    memset(buf, 0xff, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0x62a8ab43, crc32c_calc(buf, sizeof(buf)));
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i;
+    }
+    TEST_ASSERT_EQUAL_INT(0x46dd794e, crc32c_calc(buf, sizeof(buf)));
+}
+
+static void test_checksum_crc32_update(void)
+{
+    uint8_t buf[67];
+
+    for (unsigned i = 0; i < sizeof(buf); i++) {
+        buf[i] = i * 7;
+    }
+    /* splits at every offset, so every slicing path gets unaligned input */
+    for (unsigned split = 0; split <= sizeof(buf); split++) {
+        uint32_t crc = crc32_calc(buf, split);
+        uint32_t crc_c = crc32c_calc(buf, split);
+
+        crc = crc32_update(crc, &buf[split], sizeof(buf) - split);
+        crc_c = crc32c_update(crc_c, &buf[split], sizeof(buf) - split);
+        TEST_ASSERT_EQUAL_INT(crc32_calc(buf, sizeof(buf)), crc);
+        TEST_ASSERT_EQUAL_INT(crc32c_calc(buf, sizeof(buf)), crc_c);
+    }
+}
+
+Test *tests_checksum_crc32_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_checksum_crc32_sequence_empty),
+        new_TestFixture(test_checksum_crc32_sequence_1to9),
+        new_TestFixture(test_checksum_crc32_sequence_256a),
+        new_TestFixture(test_checksum_crc32_sequence_200),
+        new_TestFixture(test_checksum_crc32c_iscsi),
+        new_TestFixture(test_checksum_crc32_update),
+    };
+
+    EMB_UNIT_TESTCALLER(checksum_crc32_tests, NULL, NULL, fixtures);
+
+    return (Test *)&checksum_crc32_tests;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the CongURE implementations
+ */
+
+#include "embUnit.h"
+#include "congure/cocoa.h"
+#include "congure/reno.h"
+
+#include "tests-congure.h"
+
+#define MSS             (100U)
+#define PEER_WND        (1000U)
+
+static void _fr(congure_reno_snd_t *c);
+
+static const congure_reno_snd_consts_t _reno_consts = {
+    .fr = _fr,
+    .init_mss = MSS,
+    .init_ssthresh = 600,
+    .frthresh = 3,
+};
+static congure_reno_snd_t _reno;
+static congure_cocoa_snd_t _cocoa;
+static unsigned _fr_calls;
+
+static void _fr(congure_reno_snd_t *c)
+{
+    TEST_ASSERT(c == &_reno);
+    _fr_calls++;
+}
+
+static void set_up(void)
+{
+    _fr_calls = 0;
+    congure_reno_snd_setup(&_reno, &_reno_consts);
+    _reno.super.driver->init(&_reno.super, NULL);
+    congure_cocoa_snd_setup(&_cocoa);
+    _cocoa.super.driver->init(&_cocoa.super, NULL);
+}
+
+static void _sent(unsigned size)
+{
+    _reno.super.driver->report_msg_sent(&_reno.super, size);
+}
+
+static void _ack(unsigned acked, uint32_t id, unsigned size, unsigned wnd)
+{
+    congure_snd_msg_t msg = { .size = acked };
+    congure_snd_ack_t ack = { .id = id, .size = size, .wnd = wnd,
+                              .clean = 1 };
+
+    _reno.super.driver->report_msg_acked(&_reno.super, &msg, &ack);
+}
+
+static void test_congure_reno_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(4 * MSS, _reno.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(600, _reno.ssthresh);
+    TEST_ASSERT_EQUAL_INT(4 * MSS, congure_reno_usable_wnd(&_reno));
+    _sent(3 * MSS);
+    TEST_ASSERT_EQUAL_INT(MSS, congure_reno_usable_wnd(&_reno));
+    _reno.super.driver->report_msg_discarded(&_reno.super, MSS);
+    TEST_ASSERT_EQUAL_INT(2 * MSS, congure_reno_usable_wnd(&_reno));
+}
+
+static void test_congure_reno_init_mss(void)
+{
+    congure_reno_snd_setup(&_reno, &_reno_consts);
+    congure_reno_set_mss(&_reno, 1200);
+    _reno.super.driver->init(&_reno.super, NULL);
+    TEST_ASSERT_EQUAL_INT(1200, _reno.mss);
+    TEST_ASSERT_EQUAL_INT(3 * 1200, _reno.super.cwnd);
+}
+
+static void test_congure_reno_slow_start(void)
+{
+    _sent(4 * MSS);
+    _ack(MSS, 100, 0, PEER_WND);
+    TEST_ASSERT_EQUAL_INT(5 * MSS, _reno.super.cwnd);
+    _ack(MSS, 200, 0, PEER_WND);
+    TEST_ASSERT_EQUAL_INT(6 * MSS, _reno.super.cwnd);
+    /* congestion avoidance from ssthresh on */
+    _ack(MSS, 300, 0, PEER_WND);
+    TEST_ASSERT_EQUAL_INT((6 * MSS) + ((MSS * MSS) / (6 * MSS)),
+                          _reno.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(MSS, _reno.in_flight_size);
+    TEST_ASSERT_EQUAL_INT(0, _fr_calls);
+}
+
+static void test_congure_reno_no_dup_ack(void)
+{
+    _sent(4 * MSS);
+    _ack(MSS, 100, 0, PEER_WND);
+    /* carries data */
+    for (unsigned i = 0; i < 4; i++) {
+        _ack(0, 100, 10, PEER_WND);
+    }
+    /* window update */
+    for (unsigned i = 0; i < 4; i++) {
+        _ack(0, 100, 0, PEER_WND + i + 1);
+    }
+    TEST_ASSERT_EQUAL_INT(0, _fr_calls);
+    TEST_ASSERT(!_reno.in_recovery);
+    TEST_ASSERT_EQUAL_INT(5 * MSS, _reno.super.cwnd);
+}
+
+static void test_congure_reno_fast_recovery(void)
+{
+    _sent(4 * MSS);
+    _ack(MSS, 100, 0, PEER_WND);
+    _sent(2 * MSS);
+    TEST_ASSERT_EQUAL_INT(5 * MSS, _reno.in_flight_size);
+    _ack(0, 100, 0, PEER_WND);
+    _ack(0, 100, 0, PEER_WND);
+    TEST_ASSERT_EQUAL_INT(0, _fr_calls);
+    _ack(0, 100, 0, PEER_WND);
+    TEST_ASSERT_EQUAL_INT(1, _fr_calls);
+    TEST_ASSERT(_reno.in_recovery);
+    TEST_ASSERT_EQUAL_INT(250, _reno.ssthresh);
+    TEST_ASSERT_EQUAL_INT(250 + (3 * MSS), _reno.super.cwnd);
+    /* window inflation */
+    _ack(0, 100, 0, PEER_WND);
+    TEST_ASSERT_EQUAL_INT(250 + (4 * MSS), _reno.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(1, _fr_calls);
+    /* partial acknowledgement retransmits again */
+    _ack(MSS, 200, 0, PEER_WND);
+    TEST_ASSERT_EQUAL_INT(2, _fr_calls);
+    TEST_ASSERT(_reno.in_recovery);
+    TEST_ASSERT_EQUAL_INT(250 + (4 * MSS), _reno.super.cwnd);
+    /* full acknowledgement */
+    _ack(4 * MSS, 600, 0, PEER_WND);
+    TEST_ASSERT(!_reno.in_recovery);
+    TEST_ASSERT_EQUAL_INT(0, _reno.in_flight_size);
+    TEST_ASSERT_EQUAL_INT(MSS, _reno.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(2, _fr_calls);
+}
+
+static void test_congure_reno_timeout(void)
+{
+    congure_snd_msg_t msg = { .size = 4 * MSS };
+
+    msg.super.next = &msg.super;
+    _sent(4 * MSS);
+    _reno.super.driver->report_msgs_timeout(&_reno.super, &msg);
+    TEST_ASSERT_EQUAL_INT(MSS, _reno.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(2 * MSS, _reno.ssthresh);
+    TEST_ASSERT_EQUAL_INT(0, _reno.in_flight_size);
+}
+
+static void test_congure_reno_ecn_ce(void)
+{
+    _sent(4 * MSS);
+    _reno.super.driver->report_ecn_ce(&_reno.super, 0);
+    TEST_ASSERT_EQUAL_INT(2 * MSS, _reno.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(2 * MSS, _reno.ssthresh);
+}
+
+static void _cocoa_ack(uint32_t rtt, uint8_t resends, ztimer_now_t now)
+{
+    congure_snd_msg_t msg = { .send_time = now - rtt, .size = 1,
+                              .resends = resends };
+    congure_snd_ack_t ack = { .recv_time = now };
+
+    _cocoa.super.driver->report_msg_sent(&_cocoa.super, 1);
+    _cocoa.super.driver->report_msg_acked(&_cocoa.super, &msg, &ack);
+}
+
+static void test_congure_cocoa_estimators(void)
+{
+    TEST_ASSERT_EQUAL_INT(CONFIG_CONGURE_COCOA_NSTART, _cocoa.super.cwnd);
+    TEST_ASSERT_EQUAL_INT(CONFIG_CONGURE_COCOA_INIT_RTO_MS,
+                          congure_cocoa_snd_rto(&_cocoa, 0));
+    /* strong: E = 100 + 4 * 50, RTO = E / 2 + 2000 / 2 */
+    _cocoa_ack(100, 0, 1000);
+    TEST_ASSERT_EQUAL_INT(1150, _cocoa.rto);
+    /* weak: E = 400 + 200, RTO = E / 4 + (3 * 1150) / 4 */
+    _cocoa_ack(400, 1, 2000);
+    TEST_ASSERT_EQUAL_INT(1012, _cocoa.rto);
+    /* too many resends to be used */
+    _cocoa_ack(5000, 3, 3000);
+    TEST_ASSERT_EQUAL_INT(1012, _cocoa.rto);
+    TEST_ASSERT_EQUAL_INT(2000, _cocoa.last_update);
+    TEST_ASSERT_EQUAL_INT(0, _cocoa.in_flight);
+    TEST_ASSERT_EQUAL_INT(1012, congure_cocoa_snd_rto(&_cocoa, 100000));
+}
+
+static void test_congure_cocoa_aging(void)
+{
+    _cocoa.rto = 500;
+    _cocoa.last_update = 0;
+    TEST_ASSERT_EQUAL_INT(500, congure_cocoa_snd_rto(&_cocoa, 8000));
+    TEST_ASSERT_EQUAL_INT(1000, congure_cocoa_snd_rto(&_cocoa, 8001));
+    _cocoa.rto = 4000;
+    _cocoa.last_update = 0;
+    TEST_ASSERT_EQUAL_INT(4000, congure_cocoa_snd_rto(&_cocoa, 16000));
+    TEST_ASSERT_EQUAL_INT(3000, congure_cocoa_snd_rto(&_cocoa, 16001));
+    TEST_ASSERT_EQUAL_INT(16001, _cocoa.last_update);
+}
+
+static void test_congure_cocoa_backoff(void)
+{
+    TEST_ASSERT_EQUAL_INT(1500, congure_cocoa_backoff(500, 500));
+    TEST_ASSERT_EQUAL_INT(4000, congure_cocoa_backoff(2000, 2000));
+    TEST_ASSERT_EQUAL_INT(6000, congure_cocoa_backoff(4000, 4000));
+}
+
+Test *tests_congure_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_congure_reno_init),
+        new_TestFixture(test_congure_reno_init_mss),
+        new_TestFixture(test_congure_reno_slow_start),
+        new_TestFixture(test_congure_reno_no_dup_ack),
+        new_TestFixture(test_congure_reno_fast_recovery),
+        new_TestFixture(test_congure_reno_timeout),
+        new_TestFixture(test_congure_reno_ecn_ce),
+        new_TestFixture(test_congure_cocoa_estimators),
+        new_TestFixture(test_congure_cocoa_aging),
+        new_TestFixture(test_congure_cocoa_backoff),
+    };
+
+    EMB_UNIT_TESTCALLER(congure_tests, set_up, NULL, fixtures);
+
+    return (Test *)&congure_tests;
+}
+
+void tests_congure(void)
+{
+    TESTS_RUN(tests_congure_tests());
+}
+/** @} */
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the radix tree of the FIB
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "net/fib.h"
+
+#include "tests-fib_radix.h"
+
+#define TABLE_SIZE      (32U)
+#define RANDOM_NUMOF    (24U)
+#define LOOKUPS_NUMOF   (200U)
+
+static fib_entry_t _entries[TABLE_SIZE];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = TABLE_SIZE,
+                              .mtx_access = MUTEX_INIT,
+                              .notify_rp_pos = 0 };
+
+/* all entries share one next hop and are told apart by their interface */
+static uint8_t _next_hop[] = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+                               0, 0, 0, 0, 0, 0, 0, 0x01 };
+static uint32_t _seed;
+
+static int _add(const uint8_t *dst, size_t dst_size, unsigned pfx_len,
+                kernel_pid_t iface)
+{
+    return fib_add_entry(&_table, iface, (uint8_t *)dst, dst_size,
+                         pfx_len << FIB_FLAG_NET_PREFIX_SHIFT,
+                         _next_hop, sizeof(_next_hop), 0,
+                         (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+static int _lookup(const uint8_t *dst, size_t dst_size)
+{
+    uint8_t next_hop[sizeof(_next_hop)];
+    size_t next_hop_size = sizeof(next_hop);
+    uint32_t next_hop_flags;
+    kernel_pid_t iface;
+    int res;
+
+    res = fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                           &next_hop_flags, (uint8_t *)dst, dst_size, 0);
+    return (res == 0) ? iface : res;
+}
+
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed >> 8;
+}
+
+static bool _prefix_eq(const uint8_t *a, const uint8_t *b, unsigned bits)
+{
+    for (unsigned i = 0; i < bits; i++) {
+        if (((a[i / 8] ^ b[i / 8]) >> (7 - (i % 8))) & 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void set_up(void)
+{
+    _seed = 1;
+}
+
+static void tear_down(void)
+{
+    fib_deinit(&_table);
+}
+
+/*
+ * @brief longest prefix wins, also after removing entries
+ */
+static void test_fib_radix_nested(void)
+{
+    static const uint8_t pfx16[16] = { 0x20, 0x01 };
+    static const uint8_t pfx32[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    static const uint8_t pfx48[16] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01 };
+    static const uint8_t pfx64[16] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0x02 };
+    static const uint8_t dflt[16] = { 0 };
+    uint8_t dst[16] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0x01, 0, 0x02 };
+
+    /* add in an order that needs splits and glue nodes */
+    TEST_ASSERT_EQUAL_INT(0, _add(pfx48, sizeof(pfx48), 48, 3));
+    TEST_ASSERT_EQUAL_INT(0, _add(pfx16, sizeof(pfx16), 16, 1));
+    TEST_ASSERT_EQUAL_INT(0, _add(pfx64, sizeof(pfx64), 64, 4));
+    TEST_ASSERT_EQUAL_INT(0, _add(dflt, sizeof(dflt), 0, 5));
+    TEST_ASSERT_EQUAL_INT(0, _add(pfx32, sizeof(pfx32), 32, 2));
+
+    dst[15] = 0x42;
+    TEST_ASSERT_EQUAL_INT(4, _lookup(dst, sizeof(dst)));
+    dst[7] = 0x03;
+    TEST_ASSERT_EQUAL_INT(3, _lookup(dst, sizeof(dst)));
+    dst[5] = 0x02;
+    TEST_ASSERT_EQUAL_INT(2, _lookup(dst, sizeof(dst)));
+    dst[2] = 0xde;
+    TEST_ASSERT_EQUAL_INT(1, _lookup(dst, sizeof(dst)));
+    dst[0] = 0x30;
+    TEST_ASSERT_EQUAL_INT(5, _lookup(dst, sizeof(dst)));
+
+    fib_remove_entry(&_table, (uint8_t *)pfx48, sizeof(pfx48));
+    memcpy(dst, pfx64, sizeof(dst));
+    TEST_ASSERT_EQUAL_INT(4, _lookup(dst, sizeof(dst)));
+    dst[7] = 0x03;
+    TEST_ASSERT_EQUAL_INT(2, _lookup(dst, sizeof(dst)));
+
+    fib_remove_entry(&_table, (uint8_t *)dflt, sizeof(dflt));
+    dst[0] = 0x30;
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, _lookup(dst, sizeof(dst)));
+    TEST_ASSERT_EQUAL_INT(3, fib_get_num_used_entries(&_table));
+}
+
+/*
+ * @brief exact destinations are preferred, entries may share their prefix
+ */
+static void test_fib_radix_same_prefix(void)
+{
+    uint8_t a[4] = { 10, 0, 0, 1 };
+    uint8_t b[4] = { 10, 0, 0, 2 };
+    uint8_t host[4] = { 10, 0, 0, 3 };
+    uint8_t dst[4] = { 10, 9, 9, 9 };
+    int res;
+
+    TEST_ASSERT_EQUAL_INT(0, _add(a, sizeof(a), 8, 1));
+    TEST_ASSERT_EQUAL_INT(0, _add(b, sizeof(b), 8, 2));
+    /* no prefix length: host route */
+    TEST_ASSERT_EQUAL_INT(0, _add(host, sizeof(host), 0, 3));
+
+    TEST_ASSERT_EQUAL_INT(1, _lookup(a, sizeof(a)));
+    TEST_ASSERT_EQUAL_INT(2, _lookup(b, sizeof(b)));
+    TEST_ASSERT_EQUAL_INT(3, _lookup(host, sizeof(host)));
+    res = _lookup(dst, sizeof(dst));
+    TEST_ASSERT((res == 1) || (res == 2));
+
+    /* adding the same destination again updates the entry */
+    TEST_ASSERT_EQUAL_INT(0, _add(a, sizeof(a), 8, 1));
+    TEST_ASSERT_EQUAL_INT(3, fib_get_num_used_entries(&_table));
+
+    fib_remove_entry(&_table, a, sizeof(a));
+    TEST_ASSERT_EQUAL_INT(2, _lookup(a, sizeof(a)));
+    TEST_ASSERT_EQUAL_INT(2, _lookup(dst, sizeof(dst)));
+    fib_remove_entry(&_table, b, sizeof(b));
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, _lookup(dst, sizeof(dst)));
+    TEST_ASSERT_EQUAL_INT(3, _lookup(host, sizeof(host)));
+    host[3] = 4;
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, _lookup(host, sizeof(host)));
+}
+
+/*
+ * @brief addresses of different sizes never match each other
+ */
+static void test_fib_radix_address_sizes(void)
+{
+    uint8_t dflt4[4] = { 0 };
+    uint8_t dflt16[16] = { 0 };
+    uint8_t short_addr[2] = { 0x12, 0x34 };
+    uint8_t dst4[4] = { 1, 2, 3, 4 };
+    uint8_t dst16[16] = { 1, 2, 3, 4 };
+
+    TEST_ASSERT_EQUAL_INT(0, _add(dflt4, sizeof(dflt4), 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, _add(dflt16, sizeof(dflt16), 0, 2));
+    TEST_ASSERT_EQUAL_INT(0, _add(short_addr, sizeof(short_addr), 0, 3));
+
+    TEST_ASSERT_EQUAL_INT(1, _lookup(dst4, sizeof(dst4)));
+    TEST_ASSERT_EQUAL_INT(2, _lookup(dst16, sizeof(dst16)));
+    TEST_ASSERT_EQUAL_INT(3, _lookup(short_addr, sizeof(short_addr)));
+    short_addr[1]++;
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          _lookup(short_addr, sizeof(short_addr)));
+}
+
+static int _reference(uint8_t pfx[][16], const unsigned *len,
+                      const bool *used, const uint8_t *dst)
+{
+    int best = -EHOSTUNREACH;
+    unsigned best_len = 0;
+
+    for (unsigned i = 0; i < RANDOM_NUMOF; i++) {
+        if (!used[i]) {
+            continue;
+        }
+        if (memcmp(pfx[i], dst, 16) == 0) {
+            return i + 1;
+        }
+        if (_prefix_eq(pfx[i], dst, len[i]) &&
+            ((best < 0) || (len[i] > best_len))) {
+            best = i + 1;
+            best_len = len[i];
+        }
+    }
+    return best;
+}
+
+static void _random_addr(uint8_t *addr)
+{
+    static const uint8_t bytes[] = { 0x20, 0x21, 0xa0 };
+
+    memset(addr, 0, 16);
+    for (unsigned i = 0; i < 4; i++) {
+        addr[i] = bytes[_rand() % ARRAY_SIZE(bytes)];
+    }
+}
+
+/*
+ * @brief random prefixes give the same results as a brute force search
+ */
+static void test_fib_radix_random(void)
+{
+    uint8_t pfx[RANDOM_NUMOF][16];
+    unsigned len[RANDOM_NUMOF];
+    bool used[RANDOM_NUMOF];
+
+    for (unsigned i = 0; i < RANDOM_NUMOF; i++) {
+        bool dup;
+
+        do {
+            _random_addr(pfx[i]);
+            len[i] = 1 + (_rand() % 32);
+            /* clear the bits beyond the prefix */
+            for (unsigned b = len[i]; b < 32; b++) {
+                pfx[i][b / 8] &= ~(0x80 >> (b % 8));
+            }
+            dup = (pfx[i][0] == 0);
+            for (unsigned j = 0; j < i; j++) {
+                dup |= (memcmp(pfx[i], pfx[j], 16) == 0);
+            }
+        } while (dup);
+        TEST_ASSERT_EQUAL_INT(0, _add(pfx[i], 16, len[i], i + 1));
+        used[i] = true;
+    }
+    for (unsigned round = 0; round < 2; round++) {
+        for (unsigned n = 0; n < LOOKUPS_NUMOF; n++) {
+            uint8_t dst[16];
+
+            _random_addr(dst);
+            dst[15] = _rand();
+            TEST_ASSERT_EQUAL_INT(_reference(pfx, len, used, dst),
+                                  _lookup(dst, sizeof(dst)));
+        }
+        for (unsigned i = 0; i < RANDOM_NUMOF; i++) {
+            TEST_ASSERT_EQUAL_INT(used[i] ? (int)(i + 1) : _reference(pfx, len, used, pfx[i]),
+                                  _lookup(pfx[i], 16));
+        }
+        /* remove every other entry for the second round */
+        for (unsigned i = 0; i < RANDOM_NUMOF; i += 2) {
+            fib_remove_entry(&_table, pfx[i], 16);
+            used[i] = false;
+        }
+    }
+}
+
+/*
+ * @brief the tree is rebuilt correctly after running full and flushing
+ */
+static void test_fib_radix_full_flush(void)
+{
+    uint8_t dst[16] = { 0x20, 0x01 };
+
+    for (unsigned round = 0; round < 2; round++) {
+        for (unsigned i = 0; i < TABLE_SIZE; i++) {
+            dst[15] = _rand();
+            dst[14] = i;
+            TEST_ASSERT_EQUAL_INT(0, _add(dst, sizeof(dst), 0, i + 1));
+        }
+        dst[14] = TABLE_SIZE;
+        TEST_ASSERT_EQUAL_INT(-ENOMEM, _add(dst, sizeof(dst), 0, 42));
+        TEST_ASSERT_EQUAL_INT(TABLE_SIZE, fib_get_num_used_entries(&_table));
+        fib_flush(&_table, KERNEL_PID_UNDEF);
+        TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&_table));
+        TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, _lookup(dst, sizeof(dst)));
+    }
+}
+
+Test *tests_fib_radix_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fib_radix_nested),
+        new_TestFixture(test_fib_radix_same_prefix),
+        new_TestFixture(test_fib_radix_address_sizes),
+        new_TestFixture(test_fib_radix_random),
+        new_TestFixture(test_fib_radix_full_flush),
+    };
+
+    EMB_UNIT_TESTCALLER(fib_radix_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&fib_radix_tests;
+}
+
+void tests_fib_radix(void)
+{
+    fib_init(&_table);
+    TESTS_RUN(tests_fib_radix_tests());
+}
+/** @} */
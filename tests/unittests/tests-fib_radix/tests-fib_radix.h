@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``fib_radix`` module
+ */
+#ifndef TESTS_FIB_RADIX_H
+#define TESTS_FIB_RADIX_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_fib_radix(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_FIB_RADIX_H */
+/** @} */
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nib/conf.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+
+#include "_nib-idx.h"
+#include "_nib-internal.h"
+
+#include "unittests-constants.h"
+
+#include "tests-gnrc_ipv6_nib.h"
+
+#define GLOBAL_PREFIX       { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0 }
+#define GLOBAL_PREFIX_LEN   (30)
+#define IFACE               (6)
+
+static void set_up(void)
+{
+    evtimer_event_t *tmp;
+
+    for (evtimer_event_t *ptr = _nib_evtimer.events;
+         (ptr != NULL) && (tmp = (ptr->next), 1);
+         ptr = tmp) {
+        evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
+    }
+    _nib_init();
+}
+
+/* checks that dst is routed via the route to pfx/pfx_len */
+static void _assert_route(const ipv6_addr_t *dst, const ipv6_addr_t *pfx,
+                          unsigned pfx_len)
+{
+    gnrc_ipv6_nib_ft_t fte;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(dst, NULL, &fte));
+    TEST_ASSERT_EQUAL_INT(pfx_len, fte.dst_len);
+    TEST_ASSERT(ipv6_addr_match_prefix(pfx, &fte.dst) >= pfx_len);
+}
+
+/* gets the number of index candidates for addr */
+static unsigned _onl_candidates(const ipv6_addr_t *addr)
+{
+    unsigned res = 0;
+
+    for (unsigned i = _nib_idx_onl_first(addr); i != _NIB_IDX_NONE;
+         i = _nib_idx_onl_next(i)) {
+        res++;
+    }
+    return res;
+}
+
+/*
+ * Adds overlapping routes 2001:db8::/30, 2001:db8::/48, 2001:db8::/64,
+ * 2001:db8:0:1::/64 and 2001:db8::<TEST_UINT64>/128 out of order, then
+ * gets routes for destinations covered by a varying number of them.
+ * Expected result: gnrc_ipv6_nib_ft_get() always returns the route with the
+ * longest covering prefix, even if the destination shares more bits with a
+ * shorter prefix (2001:db8::1 and 2001:db8::/30 share 127 bits)
+ */
+static void test_nib_idx_offl__longest_match(void)
+{
+    static const ipv6_addr_t pfx = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+    static const ipv6_addr_t host = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                               { .u64 = TEST_UINT64 } } };
+    ipv6_addr_t sibling = pfx;
+    ipv6_addr_t dst = pfx;
+    gnrc_ipv6_nib_ft_t fte;
+
+    sibling.u8[7] = 1;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 64, NULL, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&host, 128, NULL, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, GLOBAL_PREFIX_LEN,
+                                                  NULL, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&sibling, 64, NULL, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 48, NULL, IFACE, 0));
+    _assert_route(&host, &host, 128);
+    dst.u8[15] = 1;
+    _assert_route(&dst, &pfx, 64);
+    dst.u8[7] = 1;
+    _assert_route(&dst, &sibling, 64);
+    dst.u8[7] = 2;
+    _assert_route(&dst, &pfx, 48);
+    dst.u8[5] = 1;
+    _assert_route(&dst, &pfx, GLOBAL_PREFIX_LEN);
+    /* 2001:dbb:1:2::1 is still within 2001:db8::/30 */
+    dst.u8[3] = 0xbb;
+    _assert_route(&dst, &pfx, GLOBAL_PREFIX_LEN);
+    dst.u8[3] = 0xbc;
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+}
+
+/*
+ * Adds overlapping routes 2001:db8::/30, 2001:db8::/48 and 2001:db8::/64 and
+ * removes them again, the one in the middle first.
+ * Expected result: gnrc_ipv6_nib_ft_get() falls back to the next shorter
+ * covering route after each removal and fails once all are removed. Removing
+ * a route that is not in the forwarding table changes nothing.
+ */
+static void test_nib_idx_offl__remove(void)
+{
+    static const ipv6_addr_t pfx = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+    ipv6_addr_t dst = pfx;
+    gnrc_ipv6_nib_ft_t fte;
+
+    dst.u8[15] = 1;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, GLOBAL_PREFIX_LEN,
+                                                  NULL, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 48, NULL, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 64, NULL, IFACE, 0));
+    gnrc_ipv6_nib_ft_del(&pfx, 48);
+    _assert_route(&dst, &pfx, 64);
+    gnrc_ipv6_nib_ft_del(&pfx, 56);
+    _assert_route(&dst, &pfx, 64);
+    gnrc_ipv6_nib_ft_del(&pfx, 64);
+    _assert_route(&dst, &pfx, GLOBAL_PREFIX_LEN);
+    /* re-adding a removed route makes it the best match again */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 48, NULL, IFACE, 0));
+    _assert_route(&dst, &pfx, 48);
+    gnrc_ipv6_nib_ft_del(&pfx, 48);
+    _assert_route(&dst, &pfx, GLOBAL_PREFIX_LEN);
+    gnrc_ipv6_nib_ft_del(&pfx, GLOBAL_PREFIX_LEN);
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+}
+
+/*
+ * Creates CONFIG_GNRC_IPV6_NIB_NUMOF on-link entries. As there are fewer hash
+ * buckets than entries (see Makefile.include), some of them share a bucket.
+ * Then clears every second entry and allocates it again.
+ * Expected result: _nib_onl_get() finds every allocated entry and none of
+ * the cleared ones, also when they shared a bucket with each other
+ */
+static void test_nib_idx_onl__collisions(void)
+{
+    _nib_onl_entry_t *nodes[CONFIG_GNRC_IPV6_NIB_NUMOF];
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+    unsigned candidates = 0;
+
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+        nodes[i]->mode |= _NC;
+        addr.u64[1].u64++;
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+        candidates += _onl_candidates(&addr);
+        addr.u64[1].u64++;
+    }
+    /* at least one entry had to be told apart from another one */
+    TEST_ASSERT(candidates > CONFIG_GNRC_IPV6_NIB_NUMOF);
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i += 2) {
+        nodes[i]->mode = _EMPTY;
+        TEST_ASSERT(_nib_onl_clear(nodes[i]));
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        if (i % 2) {
+            TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+        }
+        else {
+            TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
+        }
+        addr.u64[1].u64++;
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i += 2) {
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+        nodes[i]->mode |= _NC;
+        addr.u64[1].u64 += 2;
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+        addr.u64[1].u64++;
+    }
+}
+
+/*
+ * Fills the forwarding table with CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF /64 routes
+ * that branch off from each other at different bits, so the index needs a
+ * glue node for almost every route, and tries to add another one. Then
+ * removes all routes and fills the table again with different routes.
+ * Expected result: the index never runs out of nodes, every route is found
+ * for its destinations and none after removal
+ */
+static void test_nib_idx_offl__full(void)
+{
+    ipv6_addr_t pfx = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+    gnrc_ipv6_nib_ft_t fte;
+
+    for (unsigned round = 0; round < 2; round++) {
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+            pfx.u32[1].u32 = byteorder_htonl(i * 0x9e3779b9U + round).u32;
+            TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&pfx, 64, NULL,
+                                                          IFACE, 0));
+        }
+        pfx.u8[3]++;
+        TEST_ASSERT_EQUAL_INT(-ENOMEM, gnrc_ipv6_nib_ft_add(&pfx, 64, NULL,
+                                                            IFACE, 0));
+        pfx.u8[3]--;
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+            ipv6_addr_t dst;
+
+            pfx.u32[1].u32 = byteorder_htonl(i * 0x9e3779b9U + round).u32;
+            dst = pfx;
+            dst.u64[1].u64 = TEST_UINT64;
+            _assert_route(&dst, &pfx, 64);
+        }
+        for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+            pfx.u32[1].u32 = byteorder_htonl(i * 0x9e3779b9U + round).u32;
+            gnrc_ipv6_nib_ft_del(&pfx, 64);
+            TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_ipv6_nib_ft_get(&pfx, NULL,
+                                                                     &fte));
+        }
+    }
+}
+
+Test *tests_gnrc_ipv6_nib_idx_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_nib_idx_offl__longest_match),
+        new_TestFixture(test_nib_idx_offl__remove),
+        new_TestFixture(test_nib_idx_onl__collisions),
+        new_TestFixture(test_nib_idx_offl__full),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&tests;
+}
@@ -22,4 +22,5 @@ void tests_gnrc_ipv6_nib(void)
     TESTS_RUN(tests_gnrc_ipv6_nib_ft_tests());
     TESTS_RUN(tests_gnrc_ipv6_nib_nc_tests());
     TESTS_RUN(tests_gnrc_ipv6_nib_pl_tests());
+    TESTS_RUN(tests_gnrc_ipv6_nib_idx_tests());
 }
@@ -64,6 +64,13 @@ Test *tests_gnrc_ipv6_nib_nc_tests(void);
  */
 Test *tests_gnrc_ipv6_nib_pl_tests(void);
 
+/**
+ * @brief   Generates tests for the NIB lookup index
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_gnrc_ipv6_nib_idx_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,7 @@
 #include "embUnit/embUnit.h"
 
 #include "hashes/sha256.h"
+#include "kernel_defines.h"
 
 #include "tests-hashes.h"
 
@@ -266,6 +267,36 @@ static void test_hashes_sha256_hash_sequence_abc_long(void)
     TEST_ASSERT(calc_and_compare_hash_wrapper(teststring, h_fips_multiblock));
 }
 
+static void test_hashes_sha256_multi(void)
+{
+    /* covers one and two padding blocks, and an odd number of messages */
+    static const size_t lens[] = { 0, 3, 55, 56, 64, 119, 200 };
+    static uint8_t data[3][200];
+    uint8_t digest[3][SHA256_DIGEST_LENGTH];
+    uint8_t expected[SHA256_DIGEST_LENGTH];
+    const void *msgs[] = { data[0], data[1], data[2] };
+    void *digests[] = { digest[0], digest[1], digest[2] };
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i / sizeof(data[0])][i % sizeof(data[0])] = i * 7;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+        sha256_multi(msgs, lens[i], ARRAY_SIZE(msgs), digests);
+        for (unsigned j = 0; j < ARRAY_SIZE(msgs); j++) {
+            sha256(data[j], lens[i], expected);
+            TEST_ASSERT_EQUAL_INT(0, memcmp(expected, digest[j],
+                                            SHA256_DIGEST_LENGTH));
+        }
+    }
+
+    /* a known digest */
+    msgs[0] = "abc";
+    sha256_multi(msgs, 3, 1, digests);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(h_fips_oneblock, digest[0],
+                                    SHA256_DIGEST_LENGTH));
+}
+
 Test *tests_hashes_sha256_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -284,6 +315,7 @@ Test *tests_hashes_sha256_tests(void)
 
         new_TestFixture(test_hashes_sha256_hash_sequence_abc),
         new_TestFixture(test_hashes_sha256_hash_sequence_abc_long),
+        new_TestFixture(test_hashes_sha256_multi),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,73 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    /* source: https://www.cloudshark.org/captures/ea72fbab241b (No. 56) */
+    static const uint8_t data[] = {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 source */
+        0x5a, 0x6d, 0x8f, 0xff, 0xfe, 0x56, 0x30, 0x09,
+        0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 destination */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x3a, /* payload length + next header */
+        0x86, 0x00, 0xab, 0x32, 0x40, 0x58, 0x07, 0x08, /* ICMPv6 payload */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x03, 0x04, 0x40, 0xc0, 0x00, 0x00, 0x00, 0x1e,
+        0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00,
+        0x20, 0x02, 0x18, 0x3d, 0xdb, 0xa4, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0x01, 0x58, 0x6d, 0x8f, 0x56, 0x30, 0x09
+    };
+    uint32_t buf[(sizeof(data) / sizeof(uint32_t)) + 2];
+
+    /* the result must not depend on the alignment of the buffer, neither on
+     * how it is split into slices */
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        uint8_t *ptr = (uint8_t *)buf + offset;
+        uint16_t sum;
+
+        memcpy(ptr, data, sizeof(data));
+        TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, ptr, sizeof(data)));
+        sum = inet_csum_slice(0, ptr, 41, 0);
+        sum = inet_csum_slice(sum, ptr + 41, 23, 41);
+        sum = inet_csum_slice(sum, ptr + 64, sizeof(data) - 64, 64);
+        TEST_ASSERT_EQUAL_INT(0xffff, sum);
+    }
+}
+
+static void test_inet_csum__update16_rfc_example(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update16(0xdd2f, 0x5555, 0x3285));
+}
+
+static void test_inet_csum__update(void)
+{
+    /* source: https://www.cloudshark.org/captures/ea72fbab241b (No. 1) */
+    uint8_t data[] = {
+        0xc0, 0xa8, 0x01, 0x91, 0x4b, 0x4b, 0x4b, 0x4b, /* IPv4 source + dest*/
+        0xf6, 0xfb, 0x00, 0x35, 0x00, 0x27, 0x00, 0x00, /* UDP header */
+        0xa5, 0x6f, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, /* DNS payload */
+        0x00, 0x00, 0x00, 0x00, 0x09, 0x74, 0x65, 0x73,
+        0x74, 0x2d, 0x69, 0x70, 0x76, 0x36, 0x03, 0x63,
+        0x6f, 0x6d, 0x00, 0x00, 0x01, 0x00, 0x01,
+    };
+    const uint8_t new_src[] = { 0x0a, 0x00, 0x00, 0x01 };
+    uint16_t csum = 0xd1a2;
+
+    /* rewrite source address */
+    csum = inet_csum_update(csum, data, new_src, sizeof(new_src));
+    memcpy(data, new_src, sizeof(new_src));
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(17 + 39, data, sizeof(data)),
+                          csum);
+    /* rewrite source port */
+    csum = inet_csum_update16(csum, 0xf6fb, 0x1633);
+    data[8] = 0x16;
+    data[9] = 0x33;
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(17 + 39, data, sizeof(data)),
+                          csum);
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +244,9 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__update16_rfc_example),
+        new_TestFixture(test_inet_csum__update),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
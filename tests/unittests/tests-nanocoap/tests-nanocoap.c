@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include "embUnit.h"
+#include "kernel_defines.h"
 
 #include "net/nanocoap.h"
 
@@ -866,6 +867,104 @@ static void test_nanocoap__token_length_over_limit(void)
     TEST_ASSERT_EQUAL_INT(-EBADMSG, res);
 }
 
+static const coap_resource_t _find_resources[] = {
+    { "/", COAP_GET, NULL, NULL },
+    { "/a", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+    { "/a/b", COAP_GET, NULL, NULL },
+    { "/b", COAP_PUT, NULL, NULL },
+    { "/b", COAP_GET, NULL, NULL },
+    { "/b/", COAP_POST | COAP_MATCH_SUBTREE, NULL, NULL },
+    { "/b/c", COAP_GET, NULL, NULL },
+    { "/ba", COAP_GET, NULL, NULL },
+    { "/c/", COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+    { "/c/d", COAP_DELETE, NULL, NULL },
+};
+
+static const struct {
+    const char *uri;
+    coap_method_flags_t method;
+    int res;
+} _find_expected[] = {
+    { "/", COAP_GET, 0 },
+    { "/", COAP_PUT, -EPERM },
+    { "/a", COAP_GET, 1 },
+    { "/a/b", COAP_GET, 1 },
+    { "/ab", COAP_GET, 1 },
+    { "/a/b", COAP_PUT, -EPERM },
+    { "/b", COAP_GET, 4 },
+    { "/b", COAP_PUT, 3 },
+    { "/b", COAP_POST, -EPERM },
+    { "/b/x", COAP_POST, 5 },
+    { "/b/c", COAP_GET, 6 },
+    { "/b/c", COAP_POST, 5 },
+    { "/b/c", COAP_PUT, -EPERM },
+    { "/ba", COAP_GET, 7 },
+    { "/bb", COAP_GET, -ENOENT },
+    { "/c", COAP_GET, -ENOENT },
+    { "/c/d", COAP_GET, 8 },
+    { "/c/d", COAP_DELETE, 9 },
+    { "/c/e/f", COAP_DELETE, -EPERM },
+    { "/d", COAP_GET, -ENOENT },
+    { "", COAP_GET, -ENOENT },
+};
+
+/*
+ * Verifies coap_find_resource() with exact and subtree matching and several
+ * resources for the same path.
+ */
+static void test_nanocoap__find_resource(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_find_expected); i++) {
+        int res = coap_find_resource(_find_resources,
+                                     ARRAY_SIZE(_find_resources),
+                                     (uint8_t *)_find_expected[i].uri,
+                                     _find_expected[i].method);
+
+        TEST_ASSERT_EQUAL_INT(_find_expected[i].res, res);
+    }
+}
+
+/*
+ * Verifies that coap_find_resource() finds the same resource as a linear scan
+ * with coap_match_path() for any prefix of any resource path.
+ */
+static void test_nanocoap__find_resource_linear(void)
+{
+    static const coap_method_flags_t methods[] = {
+        COAP_GET, COAP_POST, COAP_PUT, COAP_DELETE
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_find_resources); i++) {
+        const char *path = _find_resources[i].path;
+
+        for (unsigned len = 0; len <= strlen(path) + 1; len++) {
+            uint8_t uri[8] = { 0 };
+
+            memcpy(uri, path, (len > strlen(path)) ? strlen(path) : len);
+            if (len > strlen(path)) {
+                uri[len - 1] = 'x';
+            }
+            for (unsigned m = 0; m < ARRAY_SIZE(methods); m++) {
+                int expected = -ENOENT;
+
+                for (unsigned j = 0; j < ARRAY_SIZE(_find_resources); j++) {
+                    if (coap_match_path(&_find_resources[j], uri) == 0) {
+                        if (_find_resources[j].methods & methods[m]) {
+                            expected = j;
+                            break;
+                        }
+                        expected = -EPERM;
+                    }
+                }
+                TEST_ASSERT_EQUAL_INT(expected,
+                    coap_find_resource(_find_resources,
+                                       ARRAY_SIZE(_find_resources), uri,
+                                       methods[m]));
+            }
+        }
+    }
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -894,6 +993,8 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__add_path_unterminated_string),
         new_TestFixture(test_nanocoap__add_get_proxy_uri),
         new_TestFixture(test_nanocoap__token_length_over_limit),
+        new_TestFixture(test_nanocoap__find_resource),
+        new_TestFixture(test_nanocoap__find_resource_linear),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
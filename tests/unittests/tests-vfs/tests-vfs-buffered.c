@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for buffered file access through the VFS
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "embUnit/embUnit.h"
+#include "kernel_defines.h"
+
+#include "vfs.h"
+
+#include "tests-vfs.h"
+
+#define _RAM_FILE_SIZE  (4 * VFS_BUFFERED_SIZE)
+#define _RECORD_SIZE    (10)
+
+/* a single RAM file, that counts the calls to the driver */
+static uint8_t _ram_file[_RAM_FILE_SIZE];
+static size_t _ram_file_len;
+static unsigned _ram_reads;
+static unsigned _ram_writes;
+static unsigned _ram_syncs;
+
+static int _ram_open(vfs_file_t *filp, const char *name, int flags,
+                     mode_t mode, const char *abs_path)
+{
+    (void)filp;
+    (void)name;
+    (void)mode;
+    (void)abs_path;
+    if (flags & O_TRUNC) {
+        _ram_file_len = 0;
+    }
+    return 0;
+}
+
+static ssize_t _ram_read(vfs_file_t *filp, void *dest, size_t nbytes)
+{
+    size_t n = 0;
+
+    _ram_reads++;
+    if ((size_t)filp->pos < _ram_file_len) {
+        n = _ram_file_len - filp->pos;
+        n = (nbytes < n) ? nbytes : n;
+    }
+    memcpy(dest, &_ram_file[filp->pos], n);
+    filp->pos += n;
+    return n;
+}
+
+static ssize_t _ram_write(vfs_file_t *filp, const void *src, size_t nbytes)
+{
+    size_t n = _RAM_FILE_SIZE - filp->pos;
+
+    _ram_writes++;
+    n = (nbytes < n) ? nbytes : n;
+    if (n == 0) {
+        return -ENOSPC;
+    }
+    memcpy(&_ram_file[filp->pos], src, n);
+    filp->pos += n;
+    if ((size_t)filp->pos > _ram_file_len) {
+        _ram_file_len = filp->pos;
+    }
+    return n;
+}
+
+static off_t _ram_lseek(vfs_file_t *filp, off_t off, int whence)
+{
+    if (whence == SEEK_CUR) {
+        off += filp->pos;
+    }
+    else if (whence == SEEK_END) {
+        off += _ram_file_len;
+    }
+    if ((off < 0) || (off > _RAM_FILE_SIZE)) {
+        return -EINVAL;
+    }
+    filp->pos = off;
+    return off;
+}
+
+static int _ram_fstat(vfs_file_t *filp, struct stat *buf)
+{
+    (void)filp;
+    memset(buf, 0, sizeof(*buf));
+    buf->st_size = _ram_file_len;
+    return 0;
+}
+
+static int _ram_fsync(vfs_file_t *filp)
+{
+    (void)filp;
+    _ram_syncs++;
+    return 0;
+}
+
+static const vfs_file_ops_t _ram_file_ops = {
+    .open = _ram_open,
+    .read = _ram_read,
+    .write = _ram_write,
+    .lseek = _ram_lseek,
+    .fstat = _ram_fstat,
+    .fsync = _ram_fsync,
+};
+
+static int _ram_stat(vfs_mount_t *mountp, const char *restrict path,
+                     struct stat *restrict buf)
+{
+    (void)mountp;
+    (void)path;
+    memset(buf, 0, sizeof(*buf));
+    buf->st_size = _ram_file_len;
+    return 0;
+}
+
+static const vfs_file_system_ops_t _ram_fs_ops = {
+    .stat = _ram_stat,
+};
+
+static const vfs_file_system_t _ram_fs = {
+    .f_op = &_ram_file_ops,
+    .fs_op = &_ram_fs_ops,
+};
+
+static vfs_mount_t _test_vfs_mount_ram = {
+    .mount_point = "/ram",
+    .fs = &_ram_fs,
+};
+
+static uint8_t _buf[_RAM_FILE_SIZE];
+static uint8_t _dest[_RAM_FILE_SIZE];
+
+static void setup(void)
+{
+    _ram_file_len = 0;
+    _ram_reads = 0;
+    _ram_writes = 0;
+    _ram_syncs = 0;
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = i;
+    }
+    vfs_mount(&_test_vfs_mount_ram);
+}
+
+static void teardown(void)
+{
+    vfs_umount(&_test_vfs_mount_ram);
+}
+
+static void test_vfs_buffered__write_records(void)
+{
+    const unsigned records = VFS_BUFFERED_SIZE / _RECORD_SIZE + 1;
+    int fd = vfs_open("/ram/log", O_WRONLY | O_CREAT | O_TRUNC, 0);
+    TEST_ASSERT(fd >= 0);
+
+    for (unsigned i = 0; i < records; i++) {
+        TEST_ASSERT_EQUAL_INT(_RECORD_SIZE,
+                              vfs_write(fd, &_buf[i * _RECORD_SIZE],
+                                        _RECORD_SIZE));
+    }
+    TEST_ASSERT_EQUAL_INT(records * _RECORD_SIZE,
+                          vfs_lseek(fd, 0, SEEK_CUR));
+    if (IS_USED(MODULE_VFS_BUFFERED)) {
+        /* only the full buffer was passed to the driver */
+        TEST_ASSERT_EQUAL_INT(1, _ram_writes);
+        TEST_ASSERT_EQUAL_INT(VFS_BUFFERED_SIZE, _ram_file_len);
+    }
+    else {
+        TEST_ASSERT_EQUAL_INT(records, _ram_writes);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, vfs_fsync(fd));
+    TEST_ASSERT_EQUAL_INT(1, _ram_syncs);
+    TEST_ASSERT_EQUAL_INT(records * _RECORD_SIZE, _ram_file_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_ram_file, _buf, _ram_file_len));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+}
+
+static void test_vfs_buffered__close(void)
+{
+    struct stat st;
+    int fd = vfs_open("/ram/log", O_WRONLY | O_CREAT | O_TRUNC, 0);
+    TEST_ASSERT(fd >= 0);
+
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_write(fd, _buf, _RECORD_SIZE));
+    /* the size includes buffered data */
+    TEST_ASSERT_EQUAL_INT(0, vfs_fstat(fd, &st));
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, st.st_size);
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_write(fd, _buf, _RECORD_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+    TEST_ASSERT_EQUAL_INT(2 * _RECORD_SIZE, _ram_file_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_ram_file[_RECORD_SIZE], _buf,
+                                    _RECORD_SIZE));
+}
+
+static void test_vfs_buffered__read_ahead(void)
+{
+    uint8_t data[_RECORD_SIZE];
+
+    memcpy(_ram_file, _buf, sizeof(_buf));
+    _ram_file_len = sizeof(_buf);
+
+    int fd = vfs_open("/ram/log", O_RDONLY, 0);
+    TEST_ASSERT(fd >= 0);
+
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_read(fd, data, sizeof(data)));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(data, &_buf[i * _RECORD_SIZE],
+                                        sizeof(data)));
+    }
+    TEST_ASSERT_EQUAL_INT(IS_USED(MODULE_VFS_BUFFERED)
+                          ? (3 * _RECORD_SIZE) / VFS_BUFFERED_SIZE + 1 : 3,
+                          _ram_reads);
+
+    /* seeking drops the data read ahead */
+    TEST_ASSERT_EQUAL_INT(3 * _RECORD_SIZE, vfs_lseek(fd, 0, SEEK_CUR));
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_lseek(fd, -2 * _RECORD_SIZE,
+                                                  SEEK_CUR));
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_read(fd, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, &_buf[_RECORD_SIZE], sizeof(data)));
+
+    /* large reads bypass the buffer */
+    TEST_ASSERT_EQUAL_INT(2 * VFS_BUFFERED_SIZE,
+                          vfs_read(fd, _dest, 2 * VFS_BUFFERED_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_dest, &_buf[2 * _RECORD_SIZE],
+                                    2 * VFS_BUFFERED_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+}
+
+static void test_vfs_buffered__read_after_write(void)
+{
+    uint8_t data[_RECORD_SIZE];
+
+    memset(_ram_file, 0, sizeof(_ram_file));
+    _ram_file_len = sizeof(_ram_file);
+
+    int fd = vfs_open("/ram/log", O_RDWR, 0);
+    TEST_ASSERT(fd >= 0);
+
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_read(fd, data, sizeof(data)));
+    /* overwrites the second record, though the driver read ahead */
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_write(fd, _buf, _RECORD_SIZE));
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_read(fd, data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_ram_file[_RECORD_SIZE], _buf,
+                                    _RECORD_SIZE));
+    for (unsigned i = 0; i < _RECORD_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, data[i]);
+        TEST_ASSERT_EQUAL_INT(0, _ram_file[i]);
+        TEST_ASSERT_EQUAL_INT(0, _ram_file[2 * _RECORD_SIZE + i]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+}
+
+static void test_vfs_buffered__fstat_after_read(void)
+{
+    uint8_t data[_RECORD_SIZE];
+    struct stat st;
+
+    memcpy(_ram_file, _buf, sizeof(_buf));
+    _ram_file_len = sizeof(_buf);
+
+    for (unsigned i = 0; i < 2; i++) {
+        int fd = vfs_open("/ram/log", i ? O_RDWR : O_RDONLY, 0);
+        TEST_ASSERT(fd >= 0);
+
+        TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_read(fd, data, sizeof(data)));
+        /* the data read ahead must not be written back */
+        TEST_ASSERT_EQUAL_INT(0, vfs_fstat(fd, &st));
+        TEST_ASSERT_EQUAL_INT(sizeof(_buf), st.st_size);
+        TEST_ASSERT_EQUAL_INT(0, vfs_fsync(fd));
+        TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_read(fd, data, sizeof(data)));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(data, &_buf[_RECORD_SIZE],
+                                        sizeof(data)));
+        TEST_ASSERT_EQUAL_INT(2 * _RECORD_SIZE, vfs_lseek(fd, 0, SEEK_CUR));
+        TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+        TEST_ASSERT_EQUAL_INT(0, _ram_writes);
+        TEST_ASSERT_EQUAL_INT(sizeof(_buf), _ram_file_len);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(_ram_file, _buf, sizeof(_buf)));
+    }
+}
+
+static void test_vfs_buffered__stat(void)
+{
+    struct stat st;
+    int fd = vfs_open("/ram/log", O_WRONLY | O_CREAT | O_TRUNC, 0);
+    TEST_ASSERT(fd >= 0);
+
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_write(fd, _buf, _RECORD_SIZE));
+    /* includes the buffered data */
+    TEST_ASSERT_EQUAL_INT(0, vfs_stat("/ram/log", &st));
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, st.st_size);
+
+    TEST_ASSERT_EQUAL_INT(_RECORD_SIZE, vfs_write(fd, _buf, _RECORD_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd));
+    /* the size cached before the data was flushed is outdated */
+    TEST_ASSERT_EQUAL_INT(0, vfs_stat("/ram/log", &st));
+    TEST_ASSERT_EQUAL_INT(2 * _RECORD_SIZE, st.st_size);
+}
+
+Test *tests_vfs_buffered_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_vfs_buffered__write_records),
+        new_TestFixture(test_vfs_buffered__close),
+        new_TestFixture(test_vfs_buffered__read_ahead),
+        new_TestFixture(test_vfs_buffered__read_after_write),
+        new_TestFixture(test_vfs_buffered__fstat_after_read),
+        new_TestFixture(test_vfs_buffered__stat),
+    };
+
+    EMB_UNIT_TESTCALLER(vfs_buffered_tests, setup, teardown, fixtures);
+
+    return (Test *)&vfs_buffered_tests;
+}
+
+/** @} */
@@ -55,6 +55,19 @@ static const constfs_t fs_data = {
     .nfiles = ARRAY_SIZE(_files),
 };
 
+static const constfs_file_t _sub_files[] = {
+    {
+        .path = "/sub.bin",
+        .data = bin_data,
+        .size = sizeof(bin_data) / 2,
+    },
+};
+
+static const constfs_t fs_sub_data = {
+    .files = _sub_files,
+    .nfiles = ARRAY_SIZE(_sub_files),
+};
+
 static vfs_mount_t _test_vfs_mount_invalid_mount = {
     .mount_point = "test",
     .fs = &constfs_file_system,
@@ -67,6 +80,12 @@ static vfs_mount_t _test_vfs_mount = {
     .private_data = (void *)&fs_data,
 };
 
+static vfs_mount_t _test_vfs_mount_sub = {
+    .mount_point = "/test/sub",
+    .fs = &constfs_file_system,
+    .private_data = (void *)&fs_sub_data,
+};
+
 static void test_vfs_mount_umount(void)
 {
     int res;
@@ -171,6 +190,90 @@ static void test_vfs_constfs_read_lseek(void)
     TEST_ASSERT_EQUAL_INT(0, res);
 }
 
+static void _test_nested_mounts(void)
+{
+    struct stat st;
+
+    TEST_ASSERT_EQUAL_INT(0, vfs_stat("/test/test.txt", &st));
+    TEST_ASSERT_EQUAL_INT(sizeof(str_data), st.st_size);
+    TEST_ASSERT_EQUAL_INT(0, vfs_stat("/test/sub/sub.bin", &st));
+    TEST_ASSERT_EQUAL_INT(sizeof(bin_data) / 2, st.st_size);
+    /* the longest matching mount point wins */
+    TEST_ASSERT_EQUAL_INT(-ENOENT, vfs_stat("/test/sub/test.txt", &st));
+    /* mount points only match on directory boundaries */
+    TEST_ASSERT_EQUAL_INT(-ENOENT, vfs_stat("/testsub/sub.bin", &st));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, vfs_stat("/tes", &st));
+}
+
+static void test_vfs_mount__nested(void)
+{
+    struct stat st;
+
+    TEST_ASSERT_EQUAL_INT(0, vfs_mount(&_test_vfs_mount));
+    TEST_ASSERT_EQUAL_INT(0, vfs_mount(&_test_vfs_mount_sub));
+    _test_nested_mounts();
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_test_vfs_mount));
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_test_vfs_mount_sub));
+
+    /* same in the reverse mount order */
+    TEST_ASSERT_EQUAL_INT(0, vfs_mount(&_test_vfs_mount_sub));
+    TEST_ASSERT_EQUAL_INT(0, vfs_mount(&_test_vfs_mount));
+    _test_nested_mounts();
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_test_vfs_mount_sub));
+    /* files of an unmounted file system are gone, even if their status was
+     * cached before */
+    TEST_ASSERT_EQUAL_INT(-ENOENT, vfs_stat("/test/sub/sub.bin", &st));
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_test_vfs_mount));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, vfs_stat("/test/test.txt", &st));
+}
+
+static void test_vfs_constfs__fd_reuse(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, vfs_mount(&_test_vfs_mount));
+
+    int fd1 = vfs_open("/test/test.txt", O_RDONLY, 0);
+    TEST_ASSERT(fd1 > STDERR_FILENO);
+    int fd2 = vfs_open("/test/data.bin", O_RDONLY, 0);
+    TEST_ASSERT(fd2 > STDERR_FILENO);
+    TEST_ASSERT(fd1 != fd2);
+
+    /* the lowest free fd is allocated */
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd1));
+    int fd3 = vfs_open("/test/data.bin", O_RDONLY, 0);
+    TEST_ASSERT_EQUAL_INT(fd1, fd3);
+
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd2));
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fd3));
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_test_vfs_mount));
+}
+
+static void test_vfs_constfs__fd_exhaust(void)
+{
+    int fds[VFS_MAX_OPEN_FILES];
+    unsigned num = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, vfs_mount(&_test_vfs_mount));
+    for (; num < ARRAY_SIZE(fds); num++) {
+        fds[num] = vfs_open("/test/test.txt", O_RDONLY, 0);
+        if (fds[num] < 0) {
+            break;
+        }
+    }
+    TEST_ASSERT(num > 0);
+    TEST_ASSERT(num < ARRAY_SIZE(fds));
+    TEST_ASSERT_EQUAL_INT(-ENFILE, fds[num]);
+
+    /* a freed fd can be allocated again */
+    TEST_ASSERT_EQUAL_INT(0, vfs_close(fds[num - 1]));
+    fds[num - 1] = vfs_open("/test/test.txt", O_RDONLY, 0);
+    TEST_ASSERT(fds[num - 1] >= 0);
+
+    while (num--) {
+        TEST_ASSERT_EQUAL_INT(0, vfs_close(fds[num]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, vfs_umount(&_test_vfs_mount));
+}
+
 #if MODULE_NEWLIB || MODULE_PICOLIBC || defined(BOARD_NATIVE)
 static void test_vfs_constfs__posix(void)
 {
@@ -210,6 +313,9 @@ Test *tests_vfs_mount_constfs_tests(void)
         new_TestFixture(test_vfs_umount__invalid_mount),
         new_TestFixture(test_vfs_constfs_open),
         new_TestFixture(test_vfs_constfs_read_lseek),
+        new_TestFixture(test_vfs_mount__nested),
+        new_TestFixture(test_vfs_constfs__fd_reuse),
+        new_TestFixture(test_vfs_constfs__fd_exhaust),
 #if MODULE_NEWLIB || MODULE_PICOLIBC || defined(BOARD_NATIVE)
         new_TestFixture(test_vfs_constfs__posix),
 #endif
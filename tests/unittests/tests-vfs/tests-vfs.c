@@ -20,6 +20,7 @@
 #include "tests-vfs.h"
 
 Test *tests_vfs_bind_tests(void);
+Test *tests_vfs_buffered_tests(void);
 Test *tests_vfs_mount_constfs_tests(void);
 Test *tests_vfs_open_close_tests(void);
 Test *tests_vfs_normalize_path_tests(void);
@@ -32,6 +33,7 @@ void tests_vfs(void)
     TESTS_RUN(tests_vfs_open_close_tests());
     TESTS_RUN(tests_vfs_bind_tests());
     TESTS_RUN(tests_vfs_mount_constfs_tests());
+    TESTS_RUN(tests_vfs_buffered_tests());
     TESTS_RUN(tests_vfs_normalize_path_tests());
     TESTS_RUN(tests_vfs_null_file_ops_tests());
     TESTS_RUN(tests_vfs_null_file_system_ops_tests());
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2021 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ztimer timer wheel
+ */
+
+#include "ztimer.h"
+#include "ztimer/mock.h"
+#include "ztimer/wheel.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer.h"
+
+#define TIMERS_NUMOF    (64U)
+
+typedef struct {
+    ztimer_t timer;
+    uint32_t target;
+    uint32_t fired_at;
+    unsigned count;
+} _timer_t;
+
+static ztimer_mock_t _zmock;
+static ztimer_wheel_t _wheel;
+static _timer_t _timers[TIMERS_NUMOF];
+static uint32_t _seed;
+
+static void _cb_record(void *arg)
+{
+    _timer_t *t = arg;
+
+    t->fired_at = ztimer_now(&_zmock.super);
+    t->count++;
+}
+
+static void _cb_incr(void *arg)
+{
+    uint32_t *ptr = arg;
+
+    *ptr += 1;
+}
+
+static uint32_t _rand(void)
+{
+    _seed = (_seed * 1103515245U) + 12345U;
+    return _seed;
+}
+
+static void _set_timers(uint32_t range)
+{
+    ztimer_clock_t *z = &_zmock.super;
+    uint32_t now = ztimer_now(z);
+
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        uint32_t val = _rand() % range;
+
+        _timers[i].timer.callback = _cb_record;
+        _timers[i].timer.arg = &_timers[i];
+        _timers[i].target = now + val;
+        _timers[i].count = 0;
+        ztimer_set(z, &_timers[i].timer, val);
+    }
+}
+
+static void set_up(void)
+{
+    _seed = 1;
+}
+
+/**
+ * @brief   Same sequence as test_ztimer_mock_set32(), but in wheel mode
+ */
+static void test_ztimer_wheel_set32(void)
+{
+    ztimer_clock_t *z = &_zmock.super;
+    uint32_t count = 0;
+    ztimer_t alarm = { .callback = _cb_incr, .arg = &count, };
+
+    ztimer_mock_init(&_zmock, 32);
+    ztimer_wheel_init(z, &_wheel);
+    ztimer_set(z, &alarm, 1000);
+    ztimer_mock_advance(&_zmock, 999);      /* now =  999 */
+    TEST_ASSERT_EQUAL_INT(0, count);
+    TEST_ASSERT(ztimer_is_set(z, &alarm));
+    ztimer_mock_advance(&_zmock, 1);        /* now = 1000 */
+    TEST_ASSERT_EQUAL_INT(1, count);
+    TEST_ASSERT(!ztimer_is_set(z, &alarm));
+    ztimer_mock_advance(&_zmock, 1001);     /* now = 2001 */
+    ztimer_set(z, &alarm, 3);
+    ztimer_mock_advance(&_zmock, 999);      /* now = 3000 */
+    TEST_ASSERT_EQUAL_INT(2, count);
+    ztimer_set(z, &alarm, 4000001000ul);
+    ztimer_mock_advance(&_zmock, 1000);     /* now = 4000 */
+    TEST_ASSERT_EQUAL_INT(2, count);
+    ztimer_mock_advance(&_zmock, 3999999999ul);
+    TEST_ASSERT_EQUAL_INT(2, count);
+    ztimer_mock_advance(&_zmock, 1);        /* now = 4000004000 */
+    TEST_ASSERT_EQUAL_INT(3, count);
+    ztimer_set(z, &alarm, 15);
+    ztimer_mock_advance(&_zmock, 14);
+    ztimer_remove(z, &alarm);
+    TEST_ASSERT(!ztimer_is_set(z, &alarm));
+    ztimer_mock_advance(&_zmock, 1000);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    TEST_ASSERT(ztimer_wheel_is_empty(z));
+}
+
+/**
+ * @brief   Many timers fire exactly at their target, also across the wrap
+ *          around of the 32 bit clock and with a 16 bit (extended) clock
+ */
+static void _test_targets(unsigned width, uint32_t start, uint32_t range,
+                          uint32_t step)
+{
+    ztimer_clock_t *z = &_zmock.super;
+    uint32_t elapsed = 0;
+
+    ztimer_mock_init(&_zmock, width);
+    ztimer_wheel_init(z, &_wheel);
+    ztimer_mock_advance(&_zmock, start);
+    _set_timers(range);
+    /* removed timers must not fire */
+    for (unsigned i = 0; i < TIMERS_NUMOF; i += 4) {
+        ztimer_remove(z, &_timers[i].timer);
+    }
+    while (elapsed < range) {
+        ztimer_mock_advance(&_zmock, step);
+        elapsed += step;
+    }
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        if ((i % 4) == 0) {
+            TEST_ASSERT_EQUAL_INT(0, _timers[i].count);
+        }
+        else {
+            TEST_ASSERT_EQUAL_INT(1, _timers[i].count);
+            TEST_ASSERT_EQUAL_INT(_timers[i].target, _timers[i].fired_at);
+        }
+    }
+    TEST_ASSERT(ztimer_wheel_is_empty(z));
+}
+
+static void test_ztimer_wheel_targets_short(void)
+{
+    _test_targets(32, 0, 100, 1);
+}
+
+static void test_ztimer_wheel_targets_long(void)
+{
+    _test_targets(32, 12345, 1000000, 777);
+}
+
+static void test_ztimer_wheel_targets_wrap(void)
+{
+    _test_targets(32, UINT32_MAX - 5000, 100000, 99);
+}
+
+static void test_ztimer_wheel_targets_extend(void)
+{
+    _test_targets(16, 1000, 300000, 1000);
+}
+
+/**
+ * @brief   A target almost 2^32 ticks ahead lands in the current slot of the
+ *          highest level and is only cascaded after a full rotation
+ *
+ * Run with each allowed CONFIG_ZTIMER_WHEEL_LEVEL_BITS.
+ */
+static void test_ztimer_wheel_top_level_wrap(void)
+{
+    static const uint32_t starts[] = { 0, 1000, 0x7fffffff, UINT32_MAX - 10 };
+    ztimer_clock_t *z = &_zmock.super;
+    uint32_t count = 0;
+    ztimer_t alarm = { .callback = _cb_incr, .arg = &count, };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(starts); i++) {
+        count = 0;
+        ztimer_mock_init(&_zmock, 32);
+        ztimer_wheel_init(z, &_wheel);
+        ztimer_mock_advance(&_zmock, starts[i]);
+        ztimer_set(z, &alarm, UINT32_MAX - 100);
+        ztimer_mock_advance(&_zmock, 0x80000000ul);
+        ztimer_mock_advance(&_zmock, 0x7ffffffful - 101);
+        TEST_ASSERT_EQUAL_INT(0, count);
+        ztimer_mock_advance(&_zmock, 1);
+        TEST_ASSERT_EQUAL_INT(1, count);
+        TEST_ASSERT(ztimer_wheel_is_empty(z));
+    }
+}
+
+/**
+ * @brief   Timers already set on the clock are moved to the wheel
+ */
+static void test_ztimer_wheel_init_set(void)
+{
+    ztimer_clock_t *z = &_zmock.super;
+
+    ztimer_mock_init(&_zmock, 32);
+    _set_timers(5000);
+    ztimer_wheel_init(z, &_wheel);
+    ztimer_mock_advance(&_zmock, 5000);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(1, _timers[i].count);
+        TEST_ASSERT_EQUAL_INT(_timers[i].target, _timers[i].fired_at);
+    }
+}
+
+/**
+ * @brief   Re-setting a timer replaces its previous target
+ */
+static void test_ztimer_wheel_reset(void)
+{
+    ztimer_clock_t *z = &_zmock.super;
+    uint32_t count = 0;
+    ztimer_t alarm = { .callback = _cb_incr, .arg = &count, };
+
+    ztimer_mock_init(&_zmock, 32);
+    ztimer_wheel_init(z, &_wheel);
+    ztimer_set(z, &alarm, 100000);
+    ztimer_set(z, &alarm, 10);
+    ztimer_mock_advance(&_zmock, 10);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_mock_advance(&_zmock, 100000);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_set(z, &alarm, 0);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_mock_advance(&_zmock, 1);
+    TEST_ASSERT_EQUAL_INT(2, count);
+}
+
+Test *tests_ztimer_wheel_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_wheel_set32),
+        new_TestFixture(test_ztimer_wheel_targets_short),
+        new_TestFixture(test_ztimer_wheel_targets_long),
+        new_TestFixture(test_ztimer_wheel_targets_wrap),
+        new_TestFixture(test_ztimer_wheel_targets_extend),
+        new_TestFixture(test_ztimer_wheel_top_level_wrap),
+        new_TestFixture(test_ztimer_wheel_init_set),
+        new_TestFixture(test_ztimer_wheel_reset),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ztimer_tests;
+}
+
+/** @} */